@@ -459,6 +459,8 @@ typedef struct centity_s {
 	qboolean		cloaked;
 
 	int				vChatTime;
+
+	bgPlayerBones_t	playerBones;
 } centity_t;
 
 
@@ -443,6 +443,9 @@ typedef struct cgameImport_s {
 
 	struct {
 		float			(*R_Font_StrLenPixels)					( const char *text, const int iFontIndex, const float scale );
+		int				(*G2API_GetBoneNumber)					( void *ghoul2, int modelIndex, const char *boneName );
+		qboolean		(*G2API_SetBoneAnglesNum)				( void *ghoul2, int modelIndex, int boneNum, const vec3_t angles, const int flags, const int up, const int right, const int forward, int blendTime, int currentTime );
+		qboolean		(*G2API_SetBoneAnimNum)					( void *ghoul2, const int modelIndex, int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime );
 	} ext;
 } cgameImport_t;
 
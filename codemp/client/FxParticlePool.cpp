@@ -0,0 +1,403 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+#include "client.h"
+#include "FxScheduler.h"
+#include "FxParticlePool.h"
+
+#if defined(__SSE__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 1 )
+	#define FX_POOL_SSE
+	#include <xmmintrin.h>
+#endif
+
+extern int		drawnFx;
+
+void ClampRGB( const vec3_t in, byte *out );	// FxPrimitives.cpp
+
+CParticlePool	theParticlePool[2];
+
+//----------------------------
+// FX_PoolPerc
+//
+// Same biasing as CParticle::UpdateSize/RGB/Alpha, minus the random part,
+//	for the transition group found at shift
+//----------------------------
+static inline float FX_PoolPerc( unsigned int flags, int shift, float parm, int timeStart, int timeEnd, int time )
+{
+	// completely biased towards start if it doesn't get overridden
+	float	perc1 = 1.0f, perc2 = 1.0f;
+	const unsigned int type = ( flags >> shift ) & FX_GENERIC_MASK;
+
+	if ( type & FX_LINEAR )
+	{
+		// calculate element biasing
+		perc1 = 1.0f - (float)(time - timeStart) / (float)(timeEnd - timeStart);
+	}
+
+	// We can combine FX_LINEAR with _either_ FX_NONLINEAR, FX_WAVE, or FX_CLAMP
+	switch ( type & FX_PARM_MASK )
+	{
+	case FX_NONLINEAR:
+		if ( time > parm )
+		{
+			// get percent done, using parm as the start of the non-linear fade
+			perc2 = 1.0f - (float)(time - parm) / (float)(timeEnd - parm);
+		}
+
+		perc1 = ( type & FX_LINEAR ) ? perc1 * 0.5f + perc2 * 0.5f : perc2;
+		break;
+
+	case FX_WAVE:
+		// wave gen, with parm being the frequency multiplier
+		perc1 = perc1 * cosf( (time - timeStart) * parm );
+		break;
+
+	case FX_CLAMP:
+		if ( time < parm )
+		{
+			perc2 = (float)(parm - time) / (float)(parm - timeStart);
+		}
+		else
+		{
+			perc2 = 0.0f;
+		}
+
+		perc1 = ( type & FX_LINEAR ) ? perc1 * 0.5f + perc2 * 0.5f : perc2;
+		break;
+	}
+
+	return perc1;
+}
+
+//----------------------------
+// FX_PoolBlend
+//
+// out = start * perc + end * ( 1 - perc )
+//----------------------------
+static void FX_PoolBlend( float *out, const float *start, const float *end, const float *perc, int count )
+{
+	int i = 0;
+
+#ifdef FX_POOL_SSE
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		const __m128 p = _mm_loadu_ps( perc + i );
+		const __m128 s = _mm_mul_ps( _mm_loadu_ps( start + i ), p );
+		const __m128 e = _mm_mul_ps( _mm_loadu_ps( end + i ), _mm_sub_ps( one, p ));
+
+		_mm_storeu_ps( out + i, _mm_add_ps( s, e ));
+	}
+#endif
+
+	for ( ; i < count; i++ )
+	{
+		out[i] = ( start[i] * perc[i] ) + ( end[i] * ( 1.0f - perc[i] ));
+	}
+}
+
+//----------------------------
+bool CParticlePool::Add( const vec3_t org, const vec3_t vel, const vec3_t accel,
+							float size1, float size2, float sizeParm,
+							float alpha1, float alpha2, float alphaParm,
+							const vec3_t sRGB, const vec3_t eRGB, float rgbParm,
+							float rotation, float rotationDelta,
+							int deathID, int killTime, qhandle_t shader, int flags )
+{
+	if ( mCount >= MAX_POOLED_PARTICLES )
+	{
+		// let the caller fall back to a regular primitive
+		return false;
+	}
+
+	const int i = mCount++;
+
+	for ( int j = 0; j < 3; j++ )
+	{
+		mOrg[j][i] = org ? org[j] : 0.0f;
+		mVel[j][i] = vel ? vel[j] : 0.0f;
+		mAccel[j][i] = accel ? accel[j] : 0.0f;
+		mRGBStart[j][i] = sRGB ? sRGB[j] : 0.0f;
+		mRGBEnd[j][i] = eRGB ? eRGB[j] : 0.0f;
+	}
+
+	mSizeStart[i] = size1;
+	mSizeEnd[i] = size2;
+	mSizeParm[i] = sizeParm;
+
+	mAlphaStart[i] = alpha1;
+	mAlphaEnd[i] = alpha2;
+	mAlphaParm[i] = alphaParm;
+
+	mRGBParm[i] = rgbParm;
+
+	mRotation[i] = rotation;
+	mRotationDelta[i] = rotationDelta;
+
+	mTimeStart[i] = theFxHelper.mTime;
+	mTimeEnd[i] = theFxHelper.mTime + killTime;
+	mFlags[i] = flags;
+	mShader[i] = shader;
+	mDeathFxID[i] = deathID;
+
+	return true;
+}
+
+//----------------------------
+void CParticlePool::Remove( int i )
+{
+	const int last = --mCount;
+
+	if ( i == last )
+	{
+		return;
+	}
+
+	for ( int j = 0; j < 3; j++ )
+	{
+		mOrg[j][i] = mOrg[j][last];
+		mVel[j][i] = mVel[j][last];
+		mAccel[j][i] = mAccel[j][last];
+		mRGBStart[j][i] = mRGBStart[j][last];
+		mRGBEnd[j][i] = mRGBEnd[j][last];
+	}
+
+	mSizeStart[i] = mSizeStart[last];
+	mSizeEnd[i] = mSizeEnd[last];
+	mSizeParm[i] = mSizeParm[last];
+	mRGBParm[i] = mRGBParm[last];
+	mAlphaStart[i] = mAlphaStart[last];
+	mAlphaEnd[i] = mAlphaEnd[last];
+	mAlphaParm[i] = mAlphaParm[last];
+	mRotation[i] = mRotation[last];
+	mRotationDelta[i] = mRotationDelta[last];
+	mTimeStart[i] = mTimeStart[last];
+	mTimeEnd[i] = mTimeEnd[last];
+	mFlags[i] = mFlags[last];
+	mShader[i] = mShader[last];
+	mDeathFxID[i] = mDeathFxID[last];
+}
+
+//----------------------------
+// Integrate
+//
+// vel += accel * step, org += vel * step, same as CParticle::UpdateOrigin without physics
+//----------------------------
+void CParticlePool::Integrate( int count )
+{
+	for ( int j = 0; j < 3; j++ )
+	{
+		float		*org = mOrg[j];
+		float		*vel = mVel[j];
+		const float	*accel = mAccel[j];
+		int			i = 0;
+
+#ifdef FX_POOL_SSE
+		for ( ; i + 4 <= count; i += 4 )
+		{
+			const __m128 step = _mm_loadu_ps( mStep + i );
+			const __m128 v = _mm_add_ps( _mm_loadu_ps( vel + i ), _mm_mul_ps( _mm_loadu_ps( accel + i ), step ));
+
+			_mm_storeu_ps( vel + i, v );
+			_mm_storeu_ps( org + i, _mm_add_ps( _mm_loadu_ps( org + i ), _mm_mul_ps( v, step )));
+		}
+#endif
+
+		for ( ; i < count; i++ )
+		{
+			vel[i] = vel[i] + accel[i] * mStep[i];
+			org[i] = org[i] + mStep[i] * vel[i];
+		}
+	}
+}
+
+//----------------------------
+// Lerp
+//
+// Size, color and alpha for everything, randomized transitions get redone at draw time
+//----------------------------
+void CParticlePool::Lerp( int count )
+{
+	const int time = theFxHelper.mTime;
+
+	for ( int i = 0; i < count; i++ )
+	{
+		mSizePerc[i] = FX_PoolPerc( mFlags[i], FX_SIZE_SHIFT, mSizeParm[i], mTimeStart[i], mTimeEnd[i], time );
+		mRGBPerc[i] = FX_PoolPerc( mFlags[i], FX_RGB_SHIFT, mRGBParm[i], mTimeStart[i], mTimeEnd[i], time );
+		mAlphaPerc[i] = FX_PoolPerc( mFlags[i], FX_ALPHA_SHIFT, mAlphaParm[i], mTimeStart[i], mTimeEnd[i], time );
+	}
+
+	FX_PoolBlend( mRadius, mSizeStart, mSizeEnd, mSizePerc, count );
+	FX_PoolBlend( mRGB[0], mRGBStart[0], mRGBEnd[0], mRGBPerc, count );
+	FX_PoolBlend( mRGB[1], mRGBStart[1], mRGBEnd[1], mRGBPerc, count );
+	FX_PoolBlend( mRGB[2], mRGBStart[2], mRGBEnd[2], mRGBPerc, count );
+	FX_PoolBlend( mAlpha, mAlphaStart, mAlphaEnd, mAlphaPerc, count );
+}
+
+//----------------------------
+// Update
+//----------------------------
+void CParticlePool::Update( void )
+{
+	const int	time = theFxHelper.mTime;
+	int			i;
+
+	// Retire anything that timed out, or that was born in the future because of game pausing
+	for ( i = 0; i < mCount; )
+	{
+		const bool expired = ( time > mTimeEnd[i] );
+
+		if ( !expired && mTimeStart[i] <= time )
+		{
+			i++;
+			continue;
+		}
+
+		// an expired effect has FX_KILL_ON_IMPACT cleared before CParticle::Die gets a look at it
+		if (( mFlags[i] & FX_DEATH_RUNS_FX ) && ( expired || !( mFlags[i] & FX_KILL_ON_IMPACT )))
+		{
+			mDeathID[mNumDeaths] = mDeathFxID[i];
+			VectorSet( mDeathOrg[mNumDeaths], mOrg[0][i], mOrg[1][i], mOrg[2][i] );
+			mNumDeaths++;
+		}
+
+		Remove( i );
+	}
+
+	const int count = mCount;
+
+	// Particles added this frame don't move yet
+	for ( i = 0; i < count; i++ )
+	{
+		mStep[i] = ( mTimeStart[i] < time ) ? theFxHelper.mRealTime : 0.0f;
+	}
+
+	Integrate( count );
+	Lerp( count );
+
+	const float		*vieworg = theFxHelper.refdef->vieworg;
+	const float		*viewaxis = theFxHelper.refdef->viewaxis[0];
+	const float		nearCull = fx_nearCull->value;
+	const float		rotationScale = theFxHelper.mFrameTime * 0.01f;
+	const float		rotationDecay = 1.0f - ( theFxHelper.mFrameTime * 0.0007f );
+	miniRefEntity_t	refEnt;
+
+	memset( &refEnt, 0, sizeof( refEnt ));
+	refEnt.reType = RT_SPRITE;
+
+	for ( i = 0; i < count; i++ )
+	{
+		const unsigned int flags = mFlags[i];
+		vec3_t	dir;
+
+		VectorSet( dir, mOrg[0][i] - vieworg[0], mOrg[1][i] - vieworg[1], mOrg[2][i] - vieworg[2] );
+
+		// Same culling as CParticle::Cull, only visible particles get rotated and drawn
+		if ( DotProduct( viewaxis, dir ) < 0 )
+		{
+			continue;
+		}
+
+		if ( !( flags & FX_DEPTH_HACK ) && VectorLengthSquared( dir ) < nearCull )
+		{
+			continue;
+		}
+
+		// Size----------------
+		if ( flags & FX_SIZE_RAND )
+		{
+			const float perc = flrand( 0.0f, mSizePerc[i] );
+			refEnt.radius = ( mSizeStart[i] * perc ) + ( mSizeEnd[i] * ( 1.0f - perc ));
+		}
+		else
+		{
+			refEnt.radius = mRadius[i];
+		}
+
+		// RGB----------------
+		vec3_t	rgb;
+
+		if ( flags & FX_RGB_RAND )
+		{
+			const float perc = flrand( 0.0f, mRGBPerc[i] );
+
+			for ( int j = 0; j < 3; j++ )
+			{
+				rgb[j] = mRGBStart[j][i] * perc + ( 1.0f - perc ) * mRGBEnd[j][i];
+			}
+		}
+		else
+		{
+			VectorSet( rgb, mRGB[0][i], mRGB[1][i], mRGB[2][i] );
+		}
+
+		ClampRGB( rgb, refEnt.shaderRGBA );
+
+		// Alpha----------------
+		float perc = Com_Clamp( 0.0f, 1.0f, mAlpha[i] );
+
+		if ( flags & FX_ALPHA_RAND )
+		{
+			perc = flrand( 0.0f, perc );
+		}
+
+		const int alpha = Com_Clamp( 0, 255, perc * 255.0f );
+
+		if ( flags & FX_USE_ALPHA )
+		{
+			refEnt.shaderRGBA[3] = (byte)alpha;
+		}
+		else
+		{
+			refEnt.shaderRGBA[0] = ((int)refEnt.shaderRGBA[0] * alpha) >> 8;
+			refEnt.shaderRGBA[1] = ((int)refEnt.shaderRGBA[1] * alpha) >> 8;
+			refEnt.shaderRGBA[2] = ((int)refEnt.shaderRGBA[2] * alpha) >> 8;
+			refEnt.shaderRGBA[3] = 0;
+		}
+
+		// Rotation----------------
+		mRotation[i] += rotationScale * mRotationDelta[i];
+		mRotationDelta[i] *= rotationDecay;
+
+		refEnt.rotation = mRotation[i];
+		refEnt.customShader = mShader[i];
+		refEnt.shaderTime = ( flags & FX_SET_SHADER_TIME ) ? mTimeStart[i] * 0.001f : 0.0f;
+		refEnt.renderfx = ( flags & FX_DEPTH_HACK ) ? RF_DEPTHHACK : 0;
+		VectorSet( refEnt.origin, mOrg[0][i], mOrg[1][i], mOrg[2][i] );
+
+		theFxHelper.AddFxToScene( &refEnt );
+		drawnFx++;
+	}
+
+	// Now that the arrays are settled, death effects may add new particles
+	const int numDeaths = mNumDeaths;
+	mNumDeaths = 0;
+
+	for ( i = 0; i < numDeaths; i++ )
+	{
+		vec3_t	norm;
+
+		VectorSet( norm, flrand(-1.0f, 1.0f), flrand(-1.0f, 1.0f), flrand(-1.0f, 1.0f));
+		VectorNormalize( norm );
+
+		theFxScheduler.PlayEffect( mDeathID[i], mDeathOrg[i], norm );
+	}
+}
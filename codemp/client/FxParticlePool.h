@@ -0,0 +1,104 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+#pragma once
+
+#include "FxPrimitives.h"
+
+#define MAX_POOLED_PARTICLES	2048	// per scene, overflow goes back to regular primitives
+
+// Flags that need the per-object CParticle path (bolts, traces, 2D view effects)
+#define FX_UNPOOLED_FLAGS		( FX_RELATIVE | FX_APPLY_PHYSICS | FX_PLAYER_VIEW )
+
+//------------------------------
+// Plain particles stored as structure of arrays.  They behave exactly like
+//	a CParticle that has no bolt, physics or player view flags, but are
+//	integrated and lerped in batches instead of through a virtual Update.
+//	Dead particles are compacted out by moving the last one into their slot.
+//------------------------------
+class CParticlePool
+{
+public:
+
+	CParticlePool() : mCount(0), mNumDeaths(0) {}
+
+	static inline bool CanPool( int flags ) { return !( flags & FX_UNPOOLED_FLAGS ); }
+
+	bool	Add( const vec3_t org, const vec3_t vel, const vec3_t accel,
+					float size1, float size2, float sizeParm,
+					float alpha1, float alpha2, float alphaParm,
+					const vec3_t sRGB, const vec3_t eRGB, float rgbParm,
+					float rotation, float rotationDelta,
+					int deathID, int killTime, qhandle_t shader, int flags );
+
+	void	Update( void );		// moves, culls and draws everything, and retires dead particles
+	void	Clear( void )		{ mCount = 0; mNumDeaths = 0; }
+
+	inline int	GetCount( void ) const { return mCount; }
+
+private:
+
+	void	Remove( int i );
+	void	Integrate( int count );
+	void	Lerp( int count );
+
+	int			mCount;
+
+	float		mOrg[3][MAX_POOLED_PARTICLES];
+	float		mVel[3][MAX_POOLED_PARTICLES];
+	float		mAccel[3][MAX_POOLED_PARTICLES];
+
+	float		mSizeStart[MAX_POOLED_PARTICLES];
+	float		mSizeEnd[MAX_POOLED_PARTICLES];
+	float		mSizeParm[MAX_POOLED_PARTICLES];
+
+	float		mRGBStart[3][MAX_POOLED_PARTICLES];
+	float		mRGBEnd[3][MAX_POOLED_PARTICLES];
+	float		mRGBParm[MAX_POOLED_PARTICLES];
+
+	float		mAlphaStart[MAX_POOLED_PARTICLES];
+	float		mAlphaEnd[MAX_POOLED_PARTICLES];
+	float		mAlphaParm[MAX_POOLED_PARTICLES];
+
+	float		mRotation[MAX_POOLED_PARTICLES];
+	float		mRotationDelta[MAX_POOLED_PARTICLES];
+
+	int			mTimeStart[MAX_POOLED_PARTICLES];
+	int			mTimeEnd[MAX_POOLED_PARTICLES];
+	unsigned int	mFlags[MAX_POOLED_PARTICLES];
+	qhandle_t	mShader[MAX_POOLED_PARTICLES];
+	int			mDeathFxID[MAX_POOLED_PARTICLES];
+
+	// Per frame scratch
+	float		mStep[MAX_POOLED_PARTICLES];
+	float		mSizePerc[MAX_POOLED_PARTICLES];
+	float		mRGBPerc[MAX_POOLED_PARTICLES];
+	float		mAlphaPerc[MAX_POOLED_PARTICLES];
+	float		mRadius[MAX_POOLED_PARTICLES];
+	float		mRGB[3][MAX_POOLED_PARTICLES];
+	float		mAlpha[MAX_POOLED_PARTICLES];
+
+	// Death effects are played after the update so they can safely add new particles
+	int			mNumDeaths;
+	int			mDeathID[MAX_POOLED_PARTICLES];
+	vec3_t		mDeathOrg[MAX_POOLED_PARTICLES];
+};
+
+extern CParticlePool	theParticlePool[2];	// regular and portal scene
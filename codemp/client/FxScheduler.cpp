@@ -47,6 +47,8 @@ CMediaHandles &CMediaHandles::operator=(const CMediaHandles &that )
 CFxScheduler::CFxScheduler()
 {
 	mNextFree2DEffect = 0;
+	mNumDispatchedFx = 0;
+	mDispatchTime = 0;
 	memset( &mEffectTemplates, 0, sizeof( mEffectTemplates ));
 	memset( &mLoopedEffectArray, 0, sizeof( mLoopedEffectArray ));
 }
@@ -190,20 +192,16 @@ SEffectTemplate &SEffectTemplate::operator=(const SEffectTemplate &that)
 void CFxScheduler::Clean(bool bRemoveTemplates /*= true*/, int idToPreserve /*= 0*/)
 {
 	int								i, j;
-	TScheduledEffect::iterator		itr, next;
 
 	// Ditch any scheduled effects
-	itr = mFxSchedule.begin();
-
-	while ( itr != mFxSchedule.end() )
+	for ( i = 0; i < 2; i++ )
 	{
-		next = itr;
-		++next;
-
-		mScheduledEffectsPool.Free (*itr);
-		mFxSchedule.erase(itr);
+		for ( j = 0; j < (int)mFxSchedule[i].size(); j++ )
+		{
+			mScheduledEffectsPool.Free( mFxSchedule[i][j] );
+		}
 
-		itr = next;
+		mFxSchedule[i].clear();
 	}
 
 	if (bRemoveTemplates)
@@ -980,7 +978,10 @@ void CFxScheduler::PlayEffect( int id, vec3_t origin, matrix3_t axis, const int
 					sfx->mStartTime++;
 				}
 
-				mFxSchedule.push_front( sfx );
+				TScheduledEffect &schedule = mFxSchedule[isPortal];
+
+				schedule.push_back( sfx );
+				std::push_heap( schedule.begin(), schedule.end(), SScheduledEffectLater() );
 			}
 		}
 	}
@@ -1054,7 +1055,7 @@ bool gEffectsInPortal = qfalse; //this is just because I don't want to have to a
 
 void CFxScheduler::AddScheduledEffects( bool portal )
 {
-	TScheduledEffect::iterator	itr, next;
+	TScheduledEffect			&schedule = mFxSchedule[portal];
 	vec3_t						origin;
 	matrix3_t					axis;
 	int							oldEntNum = -1, oldBoltIndex = -1, oldModelNum = -1;
@@ -1069,71 +1070,82 @@ void CFxScheduler::AddScheduledEffects( bool portal )
 		AddLoopedEffects();
 	}
 
-	for ( itr = mFxSchedule.begin(); itr != mFxSchedule.end(); /* do nothing */ )
+	const int64_t dispatchStart = fx_debug->integer ? Sys_Microseconds() : 0;
+
+	// Pull everything that is due before creating any of it, effects scheduled
+	//	while we create these don't get a look in until the next frame
+	mFxDue.clear();
+
+	while ( !schedule.empty() && schedule.front()->mStartTime <= theFxHelper.mTime )
 	{
-		SScheduledEffect *effect = *itr;
+		std::pop_heap( schedule.begin(), schedule.end(), SScheduledEffectLater() );
+		mFxDue.push_back( schedule.back() );
+		schedule.pop_back();
+	}
 
-		if (portal == effect->mPortalEffect && effect->mStartTime <= theFxHelper.mTime )
-		{ //only render portal fx on the skyportal pass and vice versa
-			if (effect->mBoltNum == -1)
-			{// ok, are we spawning a bolt on effect or a normal one?
-				if ( effect->mEntNum != ENTITYNUM_NONE )
-				{
-					// Find out where the entity currently is
-					TCGVectorData	*data = (TCGVectorData*)cl.mSharedMemory;
+	for ( size_t i = 0; i < mFxDue.size(); i++ )
+	{
+		SScheduledEffect *effect = mFxDue[i];
 
-					data->mEntityNum = effect->mEntNum;
-					CGVM_GetLerpOrigin();
+		if (effect->mBoltNum == -1)
+		{// ok, are we spawning a bolt on effect or a normal one?
+			if ( effect->mEntNum != ENTITYNUM_NONE )
+			{
+				// Find out where the entity currently is
+				TCGVectorData	*data = (TCGVectorData*)cl.mSharedMemory;
+
+				data->mEntityNum = effect->mEntNum;
+				CGVM_GetLerpOrigin();
+				CreateEffect( effect->mpTemplate,
+							data->mPoint, effect->mAxis,
+							theFxHelper.mTime - effect->mStartTime );
+			}
+			else
+			{
+				CreateEffect( effect->mpTemplate,
+							effect->mOrigin, effect->mAxis,
+							theFxHelper.mTime - effect->mStartTime );
+			}
+		}
+		else
+		{	//bolted on effect
+			// do we need to go and re-get the bolt matrix again? Since it takes time lets try to do it only once
+			if ((effect->mModelNum != oldModelNum) ||
+				(effect->mEntNum != oldEntNum) ||
+				(effect->mBoltNum != oldBoltIndex))
+			{
+				oldModelNum = effect->mModelNum;
+				oldEntNum = effect->mEntNum;
+				oldBoltIndex = effect->mBoltNum;
+
+				doesBoltExist = theFxHelper.GetOriginAxisFromBolt(effect->ghoul2, effect->mEntNum, effect->mModelNum, effect->mBoltNum, origin, axis);
+			}
+
+			// only do this if we found the bolt
+			if (doesBoltExist)
+			{
+				if (effect->mIsRelative )
+				{
 					CreateEffect( effect->mpTemplate,
-								data->mPoint, effect->mAxis,
-								theFxHelper.mTime - effect->mStartTime );
+								origin, axis, 0, -1,
+								effect->ghoul2, effect->mEntNum, effect->mModelNum, effect->mBoltNum );
 				}
 				else
 				{
 					CreateEffect( effect->mpTemplate,
-								effect->mOrigin, effect->mAxis,
+								origin, axis,
 								theFxHelper.mTime - effect->mStartTime );
 				}
 			}
-			else
-			{	//bolted on effect
-				// do we need to go and re-get the bolt matrix again? Since it takes time lets try to do it only once
-				if ((effect->mModelNum != oldModelNum) ||
-					(effect->mEntNum != oldEntNum) ||
-					(effect->mBoltNum != oldBoltIndex))
-				{
-					oldModelNum = effect->mModelNum;
-					oldEntNum = effect->mEntNum;
-					oldBoltIndex = effect->mBoltNum;
-
-					doesBoltExist = theFxHelper.GetOriginAxisFromBolt(effect->ghoul2, effect->mEntNum, effect->mModelNum, effect->mBoltNum, origin, axis);
-				}
+		}
 
-				// only do this if we found the bolt
-				if (doesBoltExist)
-				{
-					if (effect->mIsRelative )
-					{
-						CreateEffect( effect->mpTemplate,
-									origin, axis, 0, -1,
-									effect->ghoul2, effect->mEntNum, effect->mModelNum, effect->mBoltNum );
-					}
-					else
-					{
-						CreateEffect( effect->mpTemplate,
-									origin, axis,
-									theFxHelper.mTime - effect->mStartTime );
-					}
-				}
-			}
+		mScheduledEffectsPool.Free (effect);
+	}
 
-			mScheduledEffectsPool.Free (effect);
-			itr = mFxSchedule.erase(itr);
-		}
-		else
-		{
-			++itr;
-		}
+	if ( !portal )
+	{
+		mNumDispatchedFx = (int)mFxDue.size();
+		mDispatchTime = fx_debug->integer ? (int)( Sys_Microseconds() - dispatchStart ) : 0;
 	}
 
 	// Add all active effects into the scene
@@ -376,13 +376,15 @@ class PoolAllocator
 public:
 	PoolAllocator()
 		: pool (new T[N])
-		, freeAndAllocated (new int[N])
+		, freeList (new int[N])
+		, allocated (new bool[N])
 		, numFree (N)
 		, highWatermark (0)
 	{
 		for ( int i = 0; i < N; i++ )
 		{
-			freeAndAllocated[i] = i;
+			freeList[i] = N - 1 - i;
+			allocated[i] = false;
 		}
 	}
 
@@ -393,10 +395,10 @@ public:
 			return NULL;
 		}
 
-		T *ptr = new (&pool[freeAndAllocated[0]]) T;
+		const int index = freeList[--numFree];
+		T *ptr = new (&pool[index]) T;
 
-		std::rotate (freeAndAllocated, freeAndAllocated + 1, freeAndAllocated + N);
-		numFree--;
+		allocated[index] = true;
 
 		highWatermark = Q_max(highWatermark, N - numFree);
 
@@ -405,14 +407,20 @@ public:
 
 	void TransferTo ( PoolAllocator<T, N>& allocator )
 	{
-		allocator.freeAndAllocated = freeAndAllocated;
+		delete [] allocator.freeList;
+		delete [] allocator.allocated;
+		delete [] allocator.pool;
+
+		allocator.freeList = freeList;
+		allocator.allocated = allocated;
 		allocator.highWatermark = highWatermark;
 		allocator.numFree = numFree;
 		allocator.pool = pool;
 
 		highWatermark = 0;
-		numFree = N;
-		freeAndAllocated = NULL;
+		numFree = 0;
+		freeList = NULL;
+		allocated = NULL;
 		pool = NULL;
 	}
 
@@ -423,37 +431,36 @@ public:
 
 	void Free ( T *ptr )
 	{
-		for ( int i = numFree; i < N; i++ )
-		{
-			T *p = &pool[freeAndAllocated[i]];
+		const int index = (int)(ptr - pool);
 
-			if ( p == ptr )
-			{
-				if ( i > numFree )
-				{
-					std::rotate (freeAndAllocated + numFree, freeAndAllocated + i, freeAndAllocated + i + 1);
-				}
+		if ( !allocated[index] )
+		{
+			return;
+		}
 
-				p->~T();
-				numFree++;
+		ptr->~T();
 
-				break;
-			}
-		}
+		allocated[index] = false;
+		freeList[numFree++] = index;
 	}
 
 	int GetHighWatermark() const { return highWatermark; }
 
 	~PoolAllocator()
 	{
-		for ( int i = numFree; i < N; i++ )
+		if ( allocated )
 		{
-			T *p = &pool[freeAndAllocated[i]];
-
-			p->~T();
+			for ( int i = 0; i < N; i++ )
+			{
+				if ( allocated[i] )
+				{
+					pool[i].~T();
+				}
+			}
 		}
 
-		delete [] freeAndAllocated;
+		delete [] allocated;
+		delete [] freeList;
 		delete [] pool;
 	}
 
@@ -463,9 +470,9 @@ private:
 
 	T *pool;
 
-	// The first 'numFree' elements are the indexes of the free slots.
-	// The remaining elements are the indexes of the allocated slots.
-	int *freeAndAllocated;
+	// Stack of free slot indexes, the first 'numFree' entries are valid.
+	int *freeList;
+	bool *allocated;
 	int numFree;
 
 	int highWatermark;
@@ -616,7 +623,16 @@ private:
 	// this makes looking up the index based on the string name much easier
 	typedef std::map<std::string, int>				TEffectID;
 
-	typedef std::list<SScheduledEffect*>			TScheduledEffect;
+	// scheduled effects are kept as a min-heap on mStartTime, so a frame only looks at what is due
+	typedef std::vector<SScheduledEffect*>			TScheduledEffect;
+
+	struct SScheduledEffectLater
+	{
+		bool operator()( const SScheduledEffect *a, const SScheduledEffect *b ) const
+		{
+			return a->mStartTime > b->mStartTime;
+		}
+	};
 
 	// Effects
 	SEffectTemplate		mEffectTemplates[FX_MAX_EFFECTS];
@@ -626,8 +642,13 @@ private:
 	CScheduled2DEffect	m2DEffects[FX_MAX_2DEFFECTS];
 	int					mNextFree2DEffect;
 
-	// List of scheduled effects that will need to be created at the correct time.
-	TScheduledEffect	mFxSchedule;
+	// Scheduled effects that will need to be created at the correct time, for the regular and the portal scene.
+	TScheduledEffect	mFxSchedule[2];
+	TScheduledEffect	mFxDue;			// effects being created by the current AddScheduledEffects
+
+	// fx_debug stats for the last AddScheduledEffects
+	int					mNumDispatchedFx;
+	int					mDispatchTime;	// microseconds
 
 	PagedPoolAllocator<SScheduledEffect, 1024> mScheduledEffectsPool;
 
@@ -666,7 +687,9 @@ public:
 	void	Draw2DEffects(float screenXScale, float screenYScale);
 
 	int		GetHighWatermark() const { return mScheduledEffectsPool.GetHighWatermark(); }
-	int		NumScheduledFx()	{ return (int)mFxSchedule.size();	}
+	int		NumScheduledFx()	{ return (int)( mFxSchedule[0].size() + mFxSchedule[1].size() );	}
+	int		NumDispatchedFx()	{ return mNumDispatchedFx;	}
+	int		GetDispatchTime()	{ return mDispatchTime;		}
 	void	Clean(bool bRemoveTemplates = true, int idToPreserve = 0);	// clean out the system
 
 	// FX Override functions
@@ -22,6 +22,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "client.h"
 #include "FxScheduler.h"
+#include "FxParticlePool.h"
 
 vec3_t	WHITE = {1.0f, 1.0f, 1.0f};
 
@@ -61,6 +62,9 @@ bool FX_Free( bool templates )
 
 	activeFx = 0;
 
+	theParticlePool[0].Clear();
+	theParticlePool[1].Clear();
+
 	theFxScheduler.Clean( templates );
 	return true;
 }
@@ -84,6 +88,9 @@ void FX_Stop( void )
 
 	activeFx = 0;
 
+	theParticlePool[0].Clear();
+	theParticlePool[1].Clear();
+
 	theFxScheduler.Clean(false);
 }
 
@@ -220,12 +227,15 @@ void FX_Add( bool portal )
 		}
 	}
 
+	theParticlePool[portal].Update();
 
 	if ( fx_debug->integer && !portal)
 	{
 		theFxHelper.Print( "Active    FX: %i\n", activeFx );
+		theFxHelper.Print( "Pooled    FX: %i\n", theParticlePool[0].GetCount() + theParticlePool[1].GetCount() );
 		theFxHelper.Print( "Drawn     FX: %i\n", drawnFx );
 		theFxHelper.Print( "Scheduled FX: %i High: %i\n", theFxScheduler.NumScheduledFx(), theFxScheduler.GetHighWatermark() );
+		theFxHelper.Print( "Dispatched FX: %i in %.3f ms\n", theFxScheduler.NumDispatchedFx(), theFxScheduler.GetDispatchTime() * 0.001f );
 	}
 }
 
@@ -256,7 +266,7 @@ void FX_AddPrimitive( CEffect **pEffect, int killTime )
 //-------------------------
 //  FX_AddParticle
 //-------------------------
-CParticle *FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel, float size1, float size2, float sizeParm,
+bool FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel, float size1, float size2, float sizeParm,
 							float alpha1, float alpha2, float alphaParm,
 							vec3_t sRGB, vec3_t eRGB, float rgbParm,
 							float rotation, float rotationDelta,
@@ -268,7 +278,35 @@ CParticle *FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel, float size1, fl
 {
 	if ( theFxHelper.mFrameTime < 1 )
 	{ // disallow adding effects when the system is paused
-		return 0;
+		return false;
+	}
+
+	if ( CParticlePool::CanPool( flags ) )
+	{
+		float	rgbParm2 = rgbParm, alphaParm2 = alphaParm, sizeParm2 = sizeParm;
+
+		// same parm conversions as below
+		if (( flags & FX_RGB_PARM_MASK ) == FX_RGB_WAVE )
+			rgbParm2 = rgbParm * PI * 0.001f;
+		else if ( flags & FX_RGB_PARM_MASK )
+			rgbParm2 = rgbParm * 0.01f * killTime + theFxHelper.mTime;
+
+		if (( flags & FX_ALPHA_PARM_MASK ) == FX_ALPHA_WAVE )
+			alphaParm2 = alphaParm * PI * 0.001f;
+		else if ( flags & FX_ALPHA_PARM_MASK )
+			alphaParm2 = alphaParm * 0.01f * killTime + theFxHelper.mTime;
+
+		if (( flags & FX_SIZE_PARM_MASK ) == FX_SIZE_WAVE )
+			sizeParm2 = sizeParm * PI * 0.001f;
+		else if ( flags & FX_SIZE_PARM_MASK )
+			sizeParm2 = sizeParm * 0.01f * killTime + theFxHelper.mTime;
+
+		if ( theParticlePool[gEffectsInPortal].Add( org, vel, accel, size1, size2, sizeParm2,
+				alpha1, alpha2, alphaParm2, sRGB, eRGB, rgbParm2, rotation, rotationDelta,
+				deathID, killTime, shader, flags ))
+		{
+			return true;
+		}
 	}
 
 	CParticle *fx = new CParticle;
@@ -346,7 +384,7 @@ CParticle *FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel, float size1, fl
 		FX_AddPrimitive( (CEffect**)&fx, killTime );
 	}
 
-	return fx;
+	return fx != NULL;
 }
 
 
@@ -1245,3 +1283,90 @@ CBezier *FX_AddBezier( vec3_t start, vec3_t end,
 
 	return fx;
 }
+
+//-------------------------
+// FX_Bench_f
+//
+// fx_bench <effect> [count] [frames]
+//
+// Spawns count copies of an effect in front of the view and times the fx
+// update over a fixed number of 16ms frames.  Nothing gets rendered, the
+// scene is cleared after every frame, and any running effects are stopped.
+//-------------------------
+void FX_Bench_f( void )
+{
+	if ( Cmd_Argc() < 2 )
+	{
+		Com_Printf( "usage: fx_bench <effect> [count] [frames]\n" );
+		return;
+	}
+
+	if ( !cls.cgameStarted || !theFxHelper.refdef )
+	{
+		Com_Printf( "fx_bench: needs a running map\n" );
+		return;
+	}
+
+	const int id = theFxScheduler.RegisterEffect( Cmd_Argv( 1 ) );
+
+	if ( !id )
+	{
+		Com_Printf( "fx_bench: couldn't register effect %s\n", Cmd_Argv( 1 ) );
+		return;
+	}
+
+	const int count = ( Cmd_Argc() > 2 ) ? Com_Clampi( 1, 65536, atoi( Cmd_Argv( 2 ) ) ) : 100;
+	const int frames = ( Cmd_Argc() > 3 ) ? Com_Clampi( 1, 65536, atoi( Cmd_Argv( 3 ) ) ) : 300;
+
+	// the cgame clock is put back afterwards, so the next real frame just sees a normal delta
+	const SFxHelper	saved = theFxHelper;
+	const refdef_t	*refdef = theFxHelper.refdef;
+	int				time = saved.mTime;
+	int64_t			total = 0, worst = 0;
+	int				peakActive = 0, peakPooled = 0, peakDrawn = 0;
+	vec3_t			up = { 0.0f, 0.0f, 1.0f };
+
+	FX_Stop();
+
+	for ( int frame = 0; frame < frames; frame++ )
+	{
+		time += 16;
+		theFxHelper.AdjustTime( time );
+
+		const int64_t start = Sys_Microseconds();
+
+		if ( frame == 0 )
+		{
+			// lay the copies out on a grid facing the view
+			for ( int i = 0; i < count; i++ )
+			{
+				vec3_t org;
+
+				VectorMA( refdef->vieworg, 256.0f, refdef->viewaxis[0], org );
+				VectorMA( org, ( ( i & 31 ) - 16 ) * 16.0f, refdef->viewaxis[1], org );
+				VectorMA( org, ( ( ( i >> 5 ) & 31 ) - 16 ) * 16.0f, refdef->viewaxis[2], org );
+
+				theFxScheduler.PlayEffect( id, org, up );
+			}
+		}
+
+		theFxScheduler.AddScheduledEffects( false );
+
+		const int64_t elapsed = Sys_Microseconds() - start;
+
+		re->ClearScene();
+
+		total += elapsed;
+		worst = Q_max( worst, elapsed );
+		peakActive = Q_max( peakActive, activeFx );
+		peakPooled = Q_max( peakPooled, theParticlePool[0].GetCount() );
+		peakDrawn = Q_max( peakDrawn, drawnFx );
+	}
+
+	FX_Stop();
+	theFxHelper = saved;
+
+	Com_Printf( "fx_bench: %s x%i, %i frames\n", Cmd_Argv( 1 ), count, frames );
+	Com_Printf( "  avg %.3f ms, worst %.3f ms per frame\n", total / 1000.0 / frames, worst / 1000.0 );
+	Com_Printf( "  peak %i primitives, %i pooled particles, %i drawn\n", peakActive, peakPooled, peakDrawn );
+}
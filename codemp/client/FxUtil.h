@@ -29,9 +29,10 @@ int		FX_Init( refdef_t* refdef );	// called in CG_Init to purge the fx system.
 void	FX_SetRefDef(refdef_t *refdef);
 void	FX_Add( bool portal );		// called every cgame frame to add all fx into the scene.
 void	FX_Stop( void );	// ditches all active effects without touching the templates.
+void	FX_Bench_f( void );	// fx_bench console command, times the fx update on copies of one effect.
 
-
-CParticle *FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel,
+// Plain particles go into the pooled particle arrays, the rest get a CParticle.  Returns false if nothing was added
+bool FX_AddParticle( vec3_t org, vec3_t vel, vec3_t accel,
 							float size1, float size2, float sizeParm,
 							float alpha1, float alpha2, float alphaParm,
 							vec3_t rgb1, vec3_t rgb2, float rgbParm,
@@ -592,7 +592,9 @@ void CL_CGameRendering( stereoFrame_t stereo ) {
 	re->G2API_SetTime(cl.serverTime, 1);
 	//rww - RAGDOLL_END
 
+	const int64_t start = Sys_Microseconds();
 	CGVM_DrawActiveFrame( cl.serverTime, stereo, clc.demoplaying );
+	CL_TimeDemoPhase( TIMEDEMO_CGAME, start );
 }
 
 
@@ -809,6 +811,7 @@ void CL_SetCGameTime( void ) {
 	if ( cl_timedemo->integer ) {
 		if (!clc.timeDemoStart) {
 			clc.timeDemoStart = Sys_Milliseconds();
+			CL_TimeDemoBegin();
 		}
 		clc.timeDemoFrames++;
 		cl.serverTime = clc.timeDemoBaseTime + clc.timeDemoFrames * 50;
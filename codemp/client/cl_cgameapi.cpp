@@ -445,6 +445,21 @@ static qboolean CL_G2API_SetBoneAnim( void *ghoul2, const int modelIndex, const
 	return re->G2API_SetBoneAnim( *((CGhoul2Info_v *)ghoul2), modelIndex, boneName, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime );
 }
 
+static int CL_G2API_GetBoneNumber( void *ghoul2, int modelIndex, const char *boneName ) {
+	if ( !ghoul2 ) return -1;
+	return re->ext.G2API_GetBoneNumber( *((CGhoul2Info_v *)ghoul2), modelIndex, boneName );
+}
+
+static qboolean CL_G2API_SetBoneAnglesNum( void *ghoul2, int modelIndex, int boneNum, const vec3_t angles, const int flags, const int up, const int right, const int forward, int blendTime, int currentTime ) {
+	if ( !ghoul2 ) return qfalse;
+	return re->ext.G2API_SetBoneAnglesNum( *((CGhoul2Info_v *)ghoul2), modelIndex, boneNum, angles, flags, (const Eorientations)up, (const Eorientations)right, (const Eorientations)forward, blendTime, currentTime );
+}
+
+static qboolean CL_G2API_SetBoneAnimNum( void *ghoul2, const int modelIndex, int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime ) {
+	if ( !ghoul2 ) return qfalse;
+	return re->ext.G2API_SetBoneAnimNum( *((CGhoul2Info_v *)ghoul2), modelIndex, boneNum, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime );
+}
+
 static qboolean CL_G2API_GetBoneAnim( void *ghoul2, const char *boneName, const int currentTime, float *currentFrame, int *startFrame, int *endFrame, int *flags, float *animSpeed, int *modelList, const int modelIndex ) {
 	if ( !ghoul2 ) return qfalse;
 	CGhoul2Info_v &g2 = *((CGhoul2Info_v *)ghoul2);
@@ -947,6 +962,9 @@ void CL_BindCGame( void ) {
 		cgi.G2API_GetSurfaceName				= CL_G2API_GetSurfaceName;
 
 		cgi.ext.R_Font_StrLenPixels				= re->ext.Font_StrLenPixels;
+		cgi.ext.G2API_GetBoneNumber				= CL_G2API_GetBoneNumber;
+		cgi.ext.G2API_SetBoneAnglesNum			= CL_G2API_SetBoneAnglesNum;
+		cgi.ext.G2API_SetBoneAnimNum			= CL_G2API_SetBoneAnimNum;
 
 		ret = GetCGameAPI( CGAME_API_VERSION, &cgi );
 		if ( !ret ) {
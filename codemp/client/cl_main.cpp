@@ -35,6 +35,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "cl_uiapi.h"
 #include "cl_lan.h"
 #include "snd_local.h"
+#include "FxUtil.h"
 
 cvar_t	*cl_nodelta;
 cvar_t	*cl_debugMove;
@@ -404,6 +405,7 @@ void CL_DemoCompleted( void ) {
 			Com_Printf ("%i frames, %3.1f seconds: %3.1f fps\n", clc.timeDemoFrames,
 			time/1000.0, clc.timeDemoFrames*1000.0 / time);
 		}
+		CL_TimeDemoEnd( qtrue );
 	}
 
 /*	CL_Disconnect( qtrue );
@@ -470,7 +472,10 @@ void CL_ReadDemoMessage( void ) {
 
 	clc.lastPacketTime = cls.realtime;
 	buf.readcount = 0;
+
+	const int64_t start = Sys_Microseconds();
 	CL_ParseServerMessage( &buf );
+	CL_TimeDemoPhase( TIMEDEMO_PARSE, start );
 }
 
 /*
@@ -786,6 +791,8 @@ void CL_Disconnect( qboolean showMainMenu ) {
 		clc.demofile = 0;
 	}
 
+	CL_TimeDemoEnd( qfalse );
+
 	if ( cls.uiStarted && showMainMenu ) {
 		UIVM_SetActiveMenu( UIMENU_NONE );
 	}
@@ -2196,21 +2203,28 @@ void CL_Frame ( int msec ) {
 	SCR_UpdateScreen();
 
 	// update audio
-	S_Update();
+	if ( !CL_TimeDemoHeadless() ) {
+		const int64_t start = Sys_Microseconds();
+		S_Update();
+		CL_TimeDemoPhase( TIMEDEMO_SOUND, start );
+	}
 
 	// advance local effects for next frame
 	SCR_RunCinematic();
 
 	Con_RunConsole();
 
-	// reset the heap for Ghoul2 vert transform space gameside
-	if (G2VertSpaceServer)
+	// reset the heap for Ghoul2 vert transform space gameside, through the
+	// renderer so the trace cache drops the verts that were in it
+	if (G2VertSpaceServer && re)
 	{
-		G2VertSpaceServer->ResetHeap();
+		re->ext.G2API_ResetVertSpace(G2VertSpaceServer);
 	}
 
 	cls.framecount++;
 
+	CL_TimeDemoFrame();
+
 	if ( takeVideoFrame ) {
 		// save the current screen
 		CL_TakeVideoFrame( );
@@ -2361,6 +2375,7 @@ void CL_InitRef( void ) {
 	ri.Error = Com_Error;
 	ri.OPrintf = Com_OPrintf;
 	ri.Milliseconds = Sys_Milliseconds2; //FIXME: unix+mac need this
+	ri.Microseconds = Sys_Microseconds;
 	ri.Hunk_AllocateTempMemory = Hunk_AllocateTempMemory;
 	ri.Hunk_FreeTempMemory = Hunk_FreeTempMemory;
 	ri.Hunk_Alloc = Hunk_Alloc;
@@ -2667,6 +2682,7 @@ void CL_Init( void ) {
 	cl_activeAction = Cvar_Get( "activeAction", "", CVAR_TEMP );
 
 	cl_timedemo = Cvar_Get ("timedemo", "0", 0);
+	CL_TimeDemoInit();
 	cl_aviFrameRate = Cvar_Get ("cl_aviFrameRate", "25", CVAR_ARCHIVE);
 	cl_aviMotionJpeg = Cvar_Get ("cl_aviMotionJpeg", "1", CVAR_ARCHIVE);
 	cl_avi2GBLimit = Cvar_Get ("cl_avi2GBLimit", "1", CVAR_ARCHIVE );
@@ -2792,6 +2808,7 @@ void CL_Init( void ) {
 	Cmd_AddCommand ("forcepowers", CL_SetForcePowers_f );
 	Cmd_AddCommand ("video", CL_Video_f, "Record demo to avi" );
 	Cmd_AddCommand ("stopvideo", CL_StopVideo_f, "Stop avi recording" );
+	Cmd_AddCommand ("fx_bench", FX_Bench_f, "Time the fx system on copies of an effect" );
 
 	CL_InitRef();
 
@@ -2866,6 +2883,7 @@ void CL_Shutdown( void ) {
 	Cmd_RemoveCommand ("forcepowers");
 	Cmd_RemoveCommand ("video");
 	Cmd_RemoveCommand ("stopvideo");
+	Cmd_RemoveCommand ("fx_bench");
 
 	CL_ShutdownInput();
 	Con_Shutdown();
@@ -511,11 +511,13 @@ void SCR_UpdateScreen( void ) {
 			SCR_DrawScreenField( STEREO_CENTER );
 		}
 
+		const int64_t start = Sys_Microseconds();
 		if ( com_speeds->integer ) {
 			re->EndFrame( &time_frontend, &time_backend );
 		} else {
 			re->EndFrame( NULL, NULL );
 		}
+		CL_TimeDemoPhase( TIMEDEMO_RENDER, start );
 	}
 
 	recursive = 0;
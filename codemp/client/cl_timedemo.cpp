@@ -0,0 +1,311 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// cl_timedemo.cpp -- per frame timing of timedemo runs
+//
+// Every client frame of a timedemo is timed, along with the time spent
+// parsing demo messages, in the cgame (prediction, entities, effects and the
+// renderer front end it drives), in the renderer back end and in sound.  When
+// the demo ends the frame time percentiles, a histogram and the average per
+// subsystem are printed, and written as JSON to timedemo_json if it's set.
+//
+// "timedemo 2" is the headless mode: the GL back end and the sound mixer are
+// skipped, so only the CPU side of the client is measured.
+
+#include "client.h"
+
+#include <algorithm>
+#include <vector>
+
+typedef struct timeDemoFrame_s {
+	int		usec;
+	int		phases[TIMEDEMO_NUM_PHASES];
+} timeDemoFrame_t;
+
+static const char *timeDemoPhaseNames[TIMEDEMO_NUM_PHASES] = {
+	"parse",
+	"cgame",
+	"render",
+	"sound"
+};
+
+// upper bounds of the histogram buckets, in milliseconds
+static const int timeDemoBuckets[] = { 2, 4, 8, 16, 33, 50, 100 };
+
+static cvar_t	*timedemo_json;
+static cvar_t	*timedemo_quit;
+
+static struct {
+	qboolean		active;
+	qboolean		headless;
+	char			skipBackEnd[MAX_CVAR_VALUE_STRING];
+	int64_t			lastFrame;
+	timeDemoFrame_t	current;
+	std::vector<timeDemoFrame_t>	frames;
+} td;
+
+/*
+==================
+CL_TimeDemoInit
+==================
+*/
+void CL_TimeDemoInit( void ) {
+	timedemo_json = Cvar_Get( "timedemo_json", "", 0, "File to write timedemo results to as JSON" );
+	timedemo_quit = Cvar_Get( "timedemo_quit", "0", 0, "Quit once a timedemo finishes" );
+}
+
+/*
+==================
+CL_TimeDemoBegin
+
+Called on the first timed frame of a demo
+==================
+*/
+void CL_TimeDemoBegin( void ) {
+	td.active = qtrue;
+	td.headless = (qboolean)( cl_timedemo->integer == 2 );
+	td.lastFrame = 0;
+	td.frames.clear();
+	td.frames.reserve( 8192 );
+	memset( &td.current, 0, sizeof( td.current ) );
+
+	if ( td.headless ) {
+		Cvar_VariableStringBuffer( "r_skipBackEnd", td.skipBackEnd, sizeof( td.skipBackEnd ) );
+		Cvar_Set( "r_skipBackEnd", "1" );
+		S_StopAllSounds();
+	}
+}
+
+/*
+==================
+CL_TimeDemoHeadless
+
+Whether sound mixing and the render back end should be skipped
+==================
+*/
+qboolean CL_TimeDemoHeadless( void ) {
+	return (qboolean)( td.active && td.headless );
+}
+
+/*
+==================
+CL_TimeDemoPhase
+
+Adds the time since start to the given subsystem for this frame
+==================
+*/
+void CL_TimeDemoPhase( timeDemoPhase_t phase, int64_t start ) {
+	if ( td.active ) {
+		td.current.phases[phase] += (int)( Sys_Microseconds() - start );
+	}
+}
+
+/*
+==================
+CL_TimeDemoFrame
+
+Called at the end of every client frame
+==================
+*/
+void CL_TimeDemoFrame( void ) {
+	if ( !td.active ) {
+		return;
+	}
+
+	const int64_t now = Sys_Microseconds();
+
+	// the first frame only starts the clock
+	if ( td.lastFrame ) {
+		td.current.usec = (int)( now - td.lastFrame );
+		td.frames.push_back( td.current );
+	}
+
+	td.lastFrame = now;
+	memset( &td.current, 0, sizeof( td.current ) );
+}
+
+static float CL_TimeDemoPercentile( const std::vector<int> &sorted, float percentile ) {
+	const size_t index = Q_min( (size_t)( percentile * sorted.size() / 100.0f ), sorted.size() - 1 );
+
+	return sorted[index] / 1000.0f;
+}
+
+/*
+==================
+CL_TimeDemoEscape
+
+Escapes a string for a JSON string literal, control characters become \u00XX
+==================
+*/
+static void CL_TimeDemoEscape( const char *in, char *out, int size ) {
+	int len = 0;
+
+	for ( ; *in; in++ ) {
+		const byte	c = (byte)*in;
+		char		esc[8];
+
+		if ( c == '"' || c == '\\' ) {
+			Com_sprintf( esc, sizeof( esc ), "\\%c", c );
+		} else if ( c < ' ' ) {
+			Com_sprintf( esc, sizeof( esc ), "\\u%04x", c );
+		} else {
+			esc[0] = c;
+			esc[1] = '\0';
+		}
+
+		const int escLen = (int)strlen( esc );
+		if ( len + escLen >= size ) {
+			break;
+		}
+		memcpy( out + len, esc, escLen );
+		len += escLen;
+	}
+	out[len] = '\0';
+}
+
+/*
+==================
+CL_TimeDemoReport
+==================
+*/
+static void CL_TimeDemoReport( void ) {
+	const size_t	numFrames = td.frames.size();
+	std::vector<int>	sorted( numFrames );
+	int64_t			total = 0, phaseTotals[TIMEDEMO_NUM_PHASES] = { 0 };
+	int				buckets[ARRAY_LEN( timeDemoBuckets ) + 1] = { 0 };
+	char			demoName[MAX_QPATH * 6];
+	size_t			i;
+	int				j;
+
+	if ( !numFrames ) {
+		return;
+	}
+
+	for ( i = 0; i < numFrames; i++ ) {
+		const timeDemoFrame_t *frame = &td.frames[i];
+
+		sorted[i] = frame->usec;
+		total += frame->usec;
+		for ( j = 0; j < TIMEDEMO_NUM_PHASES; j++ ) {
+			phaseTotals[j] += frame->phases[j];
+		}
+
+		for ( j = 0; j < (int)ARRAY_LEN( timeDemoBuckets ) && frame->usec >= timeDemoBuckets[j] * 1000; j++ ) {
+		}
+		buckets[j]++;
+	}
+	std::sort( sorted.begin(), sorted.end() );
+
+	const float percentiles[] = { 50.0f, 90.0f, 95.0f, 99.0f, 99.9f };
+	const float seconds = total / 1000000.0f;
+	const float avg = total / 1000.0f / numFrames;
+	int64_t other = total;
+
+	Com_Printf( "timedemo %s%s: %i frames, %.2f seconds, %.1f fps\n", clc.demoName, td.headless ? " (headless)" : "", (int)numFrames, seconds, numFrames / seconds );
+	Com_Printf( "  frame ms: min %.2f", sorted[0] / 1000.0f );
+	for ( j = 0; j < (int)ARRAY_LEN( percentiles ); j++ ) {
+		Com_Printf( ", p%g %.2f", percentiles[j], CL_TimeDemoPercentile( sorted, percentiles[j] ) );
+	}
+	Com_Printf( ", max %.2f, avg %.2f\n", sorted[numFrames - 1] / 1000.0f, avg );
+
+	Com_Printf( "  per frame:" );
+	for ( j = 0; j < TIMEDEMO_NUM_PHASES; j++ ) {
+		Com_Printf( " %s %.3f ms,", timeDemoPhaseNames[j], phaseTotals[j] / 1000.0f / numFrames );
+		other -= phaseTotals[j];
+	}
+	Com_Printf( " other %.3f ms\n", other / 1000.0f / numFrames );
+
+	Com_Printf( "  histogram:" );
+	for ( j = 0; j < (int)ARRAY_LEN( buckets ); j++ ) {
+		if ( j < (int)ARRAY_LEN( timeDemoBuckets ) ) {
+			Com_Printf( " <%ims %i", timeDemoBuckets[j], buckets[j] );
+		} else {
+			Com_Printf( " more %i", buckets[j] );
+		}
+	}
+	Com_Printf( "\n" );
+
+	if ( !timedemo_json->string[0] ) {
+		return;
+	}
+
+	fileHandle_t f = FS_FOpenFileWrite( timedemo_json->string );
+	if ( !f ) {
+		Com_Printf( "Couldn't write %s\n", timedemo_json->string );
+		return;
+	}
+
+	CL_TimeDemoEscape( clc.demoName, demoName, sizeof( demoName ) );
+	FS_Printf( f, "{\n\t\"demo\": \"%s\",\n\t\"headless\": %s,\n", demoName, td.headless ? "true" : "false" );
+	FS_Printf( f, "\t\"frames\": %i,\n\t\"seconds\": %.4f,\n\t\"fps\": %.2f,\n", (int)numFrames, seconds, numFrames / seconds );
+
+	FS_Printf( f, "\t\"frame_ms\": { \"min\": %.3f", sorted[0] / 1000.0f );
+	for ( j = 0; j < (int)ARRAY_LEN( percentiles ); j++ ) {
+		FS_Printf( f, ", \"p%g\": %.3f", percentiles[j], CL_TimeDemoPercentile( sorted, percentiles[j] ) );
+	}
+	FS_Printf( f, ", \"max\": %.3f, \"avg\": %.3f },\n", sorted[numFrames - 1] / 1000.0f, avg );
+
+	FS_Printf( f, "\t\"subsystem_ms\": {" );
+	for ( j = 0; j < TIMEDEMO_NUM_PHASES; j++ ) {
+		FS_Printf( f, " \"%s\": %.4f,", timeDemoPhaseNames[j], phaseTotals[j] / 1000.0f / numFrames );
+	}
+	FS_Printf( f, " \"other\": %.4f },\n", other / 1000.0f / numFrames );
+
+	FS_Printf( f, "\t\"histogram\": [" );
+	for ( j = 0; j < (int)ARRAY_LEN( buckets ); j++ ) {
+		if ( j < (int)ARRAY_LEN( timeDemoBuckets ) ) {
+			FS_Printf( f, "%s { \"below_ms\": %i, \"frames\": %i }", j ? "," : "", timeDemoBuckets[j], buckets[j] );
+		} else {
+			FS_Printf( f, ", { \"below_ms\": null, \"frames\": %i }", buckets[j] );
+		}
+	}
+	FS_Printf( f, " ]\n}\n" );
+
+	FS_FCloseFile( f );
+	Com_Printf( "Wrote %s\n", timedemo_json->string );
+}
+
+/*
+==================
+CL_TimeDemoEnd
+
+Reports the run if the demo played to the end, and undoes the headless settings
+==================
+*/
+void CL_TimeDemoEnd( qboolean completed ) {
+	if ( !td.active ) {
+		return;
+	}
+
+	if ( completed ) {
+		CL_TimeDemoReport();
+	}
+
+	if ( td.headless ) {
+		Cvar_Set( "r_skipBackEnd", td.skipBackEnd );
+	}
+
+	td.active = qfalse;
+	td.frames.clear();
+
+	if ( completed && timedemo_quit->integer ) {
+		Cbuf_AddText( "quit\n" );
+	}
+}
@@ -590,3 +590,21 @@ void CL_WriteAVIVideoFrame( const byte *imageBuffer, int size );
 void CL_WriteAVIAudioFrame( const byte *pcmBuffer, int size );
 qboolean CL_CloseAVI( void );
 qboolean CL_VideoRecording( void );
+
+//
+// cl_timedemo.cpp
+//
+typedef enum {
+	TIMEDEMO_PARSE,			// CL_ParseServerMessage
+	TIMEDEMO_CGAME,			// CGVM_DrawActiveFrame, including the renderer front end
+	TIMEDEMO_RENDER,		// re->EndFrame
+	TIMEDEMO_SOUND,			// S_Update
+	TIMEDEMO_NUM_PHASES
+} timeDemoPhase_t;
+
+void CL_TimeDemoInit( void );
+void CL_TimeDemoBegin( void );
+void CL_TimeDemoEnd( qboolean completed );
+void CL_TimeDemoFrame( void );
+void CL_TimeDemoPhase( timeDemoPhase_t phase, int64_t start );
+qboolean CL_TimeDemoHeadless( void );
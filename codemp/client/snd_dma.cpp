@@ -488,6 +488,7 @@ void S_Init( void ) {
 	Cmd_AddCommand("soundstop", S_StopAllSounds, "Stops all sounds including music" );
 	Cmd_AddCommand("mp3_calcvols", S_MP3_CalcVols_f);
 	Cmd_AddCommand("s_dynamic", S_SetDynamicMusic_f, "Change dynamic music state" );
+	Cmd_AddCommand("s_mixbench", S_MixBench_f, "Time the software mixer against the reference mixer" );
 
 #ifdef USE_OPENAL
 	cv = Cvar_Get("s_UseOpenAL" , "0",CVAR_ARCHIVE|CVAR_LATCH);
@@ -735,6 +736,7 @@ void S_Shutdown( void )
 	Cmd_RemoveCommand("soundstop");
 	Cmd_RemoveCommand("mp3_calcvols");
 	Cmd_RemoveCommand("s_dynamic");
+	Cmd_RemoveCommand("s_mixbench");
 	AS_Free();
 }
 
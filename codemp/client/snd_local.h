@@ -205,11 +205,13 @@ void	SNDDMA_Submit(void);
 
 //====================================================================
 
-#define	MAX_CHANNELS			32
+#define	MAX_CHANNELS			64
 extern	channel_t   s_channels[MAX_CHANNELS];
 
 extern	int		s_paintedtime;
 extern	int		s_rawend;
+extern	sfx_t	s_knownSfx[];
+extern	int		s_numSfx;
 extern	vec3_t	listener_origin;
 extern	dma_t	dma;
 
@@ -236,6 +238,7 @@ qboolean S_LoadSound( sfx_t *sfx );
 
 
 void S_PaintChannels(int endtime);
+void S_MixBench_f( void );
 
 // picks a channel based on priorities, empty slots, number of channels
 channel_t *S_PickChannel(int entnum, int entchannel);
@@ -26,20 +26,40 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "client.h"
 #include "snd_local.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+	#define SND_MIX_SSE2
+	#include <emmintrin.h>
+#endif
+
 portable_samplepair_t paintbuffer[PAINTBUFFER_SIZE];
 int 	*snd_p, snd_linear_count, snd_vol;
 short	*snd_out;
 
+static qboolean	s_mixReference = qfalse;	// s_mixbench, paint with the old nearest sample mixer
 
 
 // FIXME: proper fix for that ?
 #if !defined(_MSC_VER) || !id386
 void S_WriteLinearBlastStereo16 (void)
 {
-	int		i;
+	int		i = 0;
 	int		val;
 
-	for (i=0 ; i<snd_linear_count ; i+=2)
+#ifdef SND_MIX_SSE2
+	if ( !s_mixReference )
+	{
+		// the saturating pack does the same clamp as below
+		for ( ; i + 8 <= snd_linear_count; i += 8 )
+		{
+			const __m128i a = _mm_srai_epi32( _mm_loadu_si128( (const __m128i *)( snd_p + i ) ), 8 );
+			const __m128i b = _mm_srai_epi32( _mm_loadu_si128( (const __m128i *)( snd_p + i + 4 ) ), 8 );
+
+			_mm_storeu_si128( (__m128i *)( snd_out + i ), _mm_packs_epi32( a, b ) );
+		}
+	}
+#endif
+
+	for ( ; i<snd_linear_count ; i+=2)
 	{
 		val = snd_p[i]>>8;
 		if (val > 0x7fff)
@@ -268,7 +288,101 @@ CHANNEL MIXING
 
 ===============================================================================
 */
-static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sfx, int count, int sampleOffset, int bufferOffset )
+// Volumes and pitch of a channel, worked out once per paint
+typedef struct mixChannel_s {
+	float	leftVol;		// 8 bit fixed point output scale, ie. ( vol * snd_vol ) >> 8
+	float	rightVol;
+	float	step;			// source samples per output sample, above 1 for doppler
+} mixChannel_t;
+
+/*
+===================
+S_MixMono16
+
+Adds count mono samples into the paint buffer at the given volumes
+===================
+*/
+static void S_MixMono16( portable_samplepair_t *dest, const short *src, int count, float leftVol, float rightVol )
+{
+	int i = 0;
+
+#ifdef SND_MIX_SSE2
+	const __m128 lv = _mm_set1_ps( leftVol );
+	const __m128 rv = _mm_set1_ps( rightVol );
+
+	for ( ; i + 4 <= count; i += 4 )
+	{
+		const __m128i	s16 = _mm_loadl_epi64( (const __m128i *)( src + i ) );
+		const __m128	s = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s16, s16 ), 16 ) );
+		const __m128i	l = _mm_cvttps_epi32( _mm_mul_ps( s, lv ) );
+		const __m128i	r = _mm_cvttps_epi32( _mm_mul_ps( s, rv ) );
+		__m128i			*d = (__m128i *)( dest + i );
+
+		// paint buffer is interleaved left/right
+		_mm_storeu_si128( d, _mm_add_epi32( _mm_loadu_si128( d ), _mm_unpacklo_epi32( l, r ) ) );
+		_mm_storeu_si128( d + 1, _mm_add_epi32( _mm_loadu_si128( d + 1 ), _mm_unpackhi_epi32( l, r ) ) );
+	}
+#endif
+
+	for ( ; i < count; i++ )
+	{
+		dest[i].left  += (int)( src[i] * leftVol );
+		dest[i].right += (int)( src[i] * rightVol );
+	}
+}
+
+/*
+===================
+S_MixResample16
+
+Linear interpolating version of S_MixMono16 for pitched (doppler) channels,
+reading from sampleOffset at step source samples per output sample.
+Looping sounds wrap, others stop at the end of the data.
+===================
+*/
+static void S_MixResample16( portable_samplepair_t *dest, const sfx_t *sfx, qboolean loop, int sampleOffset, int count, const mixChannel_t *mix )
+{
+	const short	*data = sfx->pSoundData;
+	const int	length = sfx->iSoundLengthInSamples;
+	float		ofst = sampleOffset;
+
+	for ( int i = 0; i < count; i++, ofst += mix->step )
+	{
+		if ( ofst >= length )
+		{
+			if ( !loop )
+			{
+				break;
+			}
+
+			ofst = fmodf( ofst, (float)length );
+		}
+
+		const int	pos = (int)ofst;
+		int			next = pos + 1;
+
+		if ( next >= length )
+		{
+			next = loop ? 0 : pos;
+		}
+
+		const float frac = ofst - pos;
+		const float sample = data[pos] + ( data[next] - data[pos] ) * frac;
+
+		dest[i].left  += (int)( sample * mix->leftVol );
+		dest[i].right += (int)( sample * mix->rightVol );
+	}
+}
+
+/*
+===================
+S_PaintChannelFrom16_Nearest
+
+The original nearest sample mixer, only kept as the s_mixbench reference.
+Doppler used to read past the end of the sample, that at least is clamped.
+===================
+*/
+static void S_PaintChannelFrom16_Nearest( channel_t *ch, const sfx_t *sfx, int count, int sampleOffset, int bufferOffset )
 {
 	portable_samplepair_t	*pSamplesDest;
 	int iData;
@@ -279,7 +393,7 @@ static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sfx, int count, in
 
 	pSamplesDest	= &paintbuffer[ bufferOffset ];
 
-	for ( int i=0 ; i<count ; i++ )
+	for ( int i=0 ; i<count && (int)ofst < sfx->iSoundLengthInSamples ; i++ )
 	{
 		iData = sfx->pSoundData[ (int)ofst ];
 
@@ -293,69 +407,47 @@ static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sfx, int count, in
 	}
 }
 
-
-void S_PaintChannelFromMP3( channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset )
+static void S_PaintChannelFrom16( channel_t *ch, const sfx_t *sfx, int count, int sampleOffset, int bufferOffset, const mixChannel_t *mix )
 {
-	int data;
-	int leftvol, rightvol;
-	signed short *sfx;
-	int	i;
-	portable_samplepair_t	*samp;
-	static short tempMP3Buffer[PAINTBUFFER_SIZE];
-
-	MP3Stream_GetSamples( ch, sampleOffset, count, tempMP3Buffer, qfalse );	// qfalse = not stereo
-
-	leftvol = ch->leftvol*snd_vol;
-	rightvol = ch->rightvol*snd_vol;
-	sfx = tempMP3Buffer;
-
-	samp = &paintbuffer[ bufferOffset ];
-
-
-	while ( count & 3 ) {
-		data = *sfx;
-		samp->left += (data * leftvol)>>8;
-		samp->right += (data * rightvol)>>8;
-
-		sfx++;
-		samp++;
-		count--;
+	if ( s_mixReference )
+	{
+		S_PaintChannelFrom16_Nearest( ch, sfx, count, sampleOffset, bufferOffset );
 	}
+	else if ( mix->step > 1.0f )
+	{
+		S_MixResample16( &paintbuffer[ bufferOffset ], sfx, ch->loopSound, sampleOffset, count, mix );
+	}
+	else
+	{
+		S_MixMono16( &paintbuffer[ bufferOffset ], sfx->pSoundData + sampleOffset, count, mix->leftVol, mix->rightVol );
+	}
+}
 
-	for ( i=0 ; i<count ; i += 4 ) {
-		data = sfx[i];
-		samp[i].left += (data * leftvol)>>8;
-		samp[i].right += (data * rightvol)>>8;
 
-		data = sfx[i+1];
-		samp[i+1].left += (data * leftvol)>>8;
-		samp[i+1].right += (data * rightvol)>>8;
+void S_PaintChannelFromMP3( channel_t *ch, const sfx_t *sc, int count, int sampleOffset, int bufferOffset, const mixChannel_t *mix )
+{
+	static short tempMP3Buffer[PAINTBUFFER_SIZE];
 
-		data = sfx[i+2];
-		samp[i+2].left += (data * leftvol)>>8;
-		samp[i+2].right += (data * rightvol)>>8;
+	MP3Stream_GetSamples( ch, sampleOffset, count, tempMP3Buffer, qfalse );	// qfalse = not stereo
 
-		data = sfx[i+3];
-		samp[i+3].left += (data * leftvol)>>8;
-		samp[i+3].right += (data * rightvol)>>8;
-	}
+	S_MixMono16( &paintbuffer[ bufferOffset ], tempMP3Buffer, count, mix->leftVol, mix->rightVol );
 }
 
 
 // subroutinised to save code dup (called twice)	-ste
 //
-void ChannelPaint(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset)
+void ChannelPaint(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int bufferOffset, const mixChannel_t *mix)
 {
 	switch (sc->eSoundCompressionMethod)
 	{
 		case ct_16:
 
-			S_PaintChannelFrom16		(ch, sc, count, sampleOffset, bufferOffset);
+			S_PaintChannelFrom16		(ch, sc, count, sampleOffset, bufferOffset, mix);
 			break;
 
 		case ct_MP3:
 
-			S_PaintChannelFromMP3		(ch, sc, count, sampleOffset, bufferOffset);
+			S_PaintChannelFromMP3		(ch, sc, count, sampleOffset, bufferOffset, mix);
 			break;
 
 		default:
@@ -367,7 +459,7 @@ void ChannelPaint(channel_t *ch, sfx_t *sc, int count, int sampleOffset, int buf
 
 
 
-void S_PaintChannels( int endtime ) {
+static void S_PaintChannelsFrom( channel_t *channels, int numChannels, int endtime ) {
 	int 	i;
 	int 	end;
 	channel_t *ch;
@@ -375,6 +467,7 @@ void S_PaintChannels( int endtime ) {
 	int		ltime, count;
 	int		sampleOffset;
 	int	normal_vol,voice_vol;
+	mixChannel_t	mix;
 
 	snd_vol = normal_vol = s_volume->value*256;
 	voice_vol  = (int)(s_volumeVoice->value*256);
@@ -416,8 +509,8 @@ void S_PaintChannels( int endtime ) {
 		}
 
 		// paint in the channels.
-		ch = s_channels;
-		for ( i = 0; i < MAX_CHANNELS ; i++, ch++ ) {
+		ch = channels;
+		for ( i = 0; i < numChannels ; i++, ch++ ) {
 			if ( !ch->thesfx || (ch->leftvol<0.25 && ch->rightvol<0.25 )) {
 				continue;
 			}
@@ -427,6 +520,10 @@ void S_PaintChannels( int endtime ) {
 			else
 				snd_vol = normal_vol;
 
+			mix.leftVol = ch->leftvol * snd_vol * (1.0f / 256.0f);
+			mix.rightVol = ch->rightvol * snd_vol * (1.0f / 256.0f);
+			mix.step = ( ch->doppler && ch->dopplerScale > 1 ) ? ch->dopplerScale : 1.0f;
+
 			ltime = s_paintedtime;
 			sc = ch->thesfx;
 
@@ -448,7 +545,7 @@ void S_PaintChannels( int endtime ) {
 				}
 
 				if ( count > 0 ) {
-					ChannelPaint(ch, sc, count, sampleOffset, ltime - s_paintedtime);
+					ChannelPaint(ch, sc, count, sampleOffset, ltime - s_paintedtime, &mix);
 					ltime += count;
 				}
 			} while ( ltime < end && ch->loopSound );
@@ -495,3 +592,140 @@ void S_PaintChannels( int endtime ) {
 		s_paintedtime = end;
 	}
 }
+
+void S_PaintChannels( int endtime ) {
+	S_PaintChannelsFrom( s_channels, MAX_CHANNELS, endtime );
+}
+
+/*
+===================
+S_MixBench_f
+
+s_mixbench [channels] [seconds]
+
+Mixes the cached sounds on looping channels, a third of them pitched, into
+a private 16 bit stereo buffer standing in for the dma device.  This is done
+once with the old nearest sample mixer and once with the current one, then
+the cpu time of both and how far apart their output is are printed.
+===================
+*/
+#define MIXBENCH_SPEED		44100
+#define MIXBENCH_SAMPLES	16384	// mono samples in the stand-in dma buffer
+#define MIXBENCH_CHUNK		1024	// sample pairs per paint, must divide MIXBENCH_SAMPLES / 2
+
+void S_MixBench_f( void ) {
+	if ( CL_VideoRecording() ) {
+		Com_Printf( "s_mixbench: not while recording video\n" );
+		return;
+	}
+
+	// anything the paint loop can take straight from memory
+	sfx_t	*sounds[256];
+	int		numSounds = 0;
+
+	for ( int i = 1; i < s_numSfx && numSounds < (int)ARRAY_LEN( sounds ); i++ ) {
+		sfx_t *sfx = &s_knownSfx[i];
+
+		if ( sfx->bInMemory && !sfx->bDefaultSound && sfx->eSoundCompressionMethod == ct_16 && sfx->pSoundData && sfx->iSoundLengthInSamples > 0 ) {
+			sounds[numSounds++] = sfx;
+		}
+	}
+
+	if ( !numSounds ) {
+		Com_Printf( "s_mixbench: no sounds in memory, load a map first\n" );
+		return;
+	}
+
+	const int	numChannels = ( Cmd_Argc() > 1 ) ? Com_Clampi( 1, MAX_CHANNELS, atoi( Cmd_Argv( 1 ) ) ) : MAX_CHANNELS;
+	const int	seconds = ( Cmd_Argc() > 2 ) ? Com_Clampi( 1, 60, atoi( Cmd_Argv( 2 ) ) ) : 10;
+	const int	total = seconds * MIXBENCH_SPEED;
+	int			seed = 0x5eed;
+	int			numPitched = 0;
+
+	channel_t	*channels = (channel_t *)Z_Malloc( numChannels * sizeof( channel_t ), TAG_TEMP_WORKSPACE, qtrue );
+	short		*output[2];
+
+	for ( int i = 0; i < numChannels; i++ ) {
+		channel_t *ch = &channels[i];
+
+		ch->thesfx = sounds[i % numSounds];
+		ch->entnum = ENTITYNUM_WORLD;
+		ch->entchannel = CHAN_AUTO;
+		ch->leftvol = 64 + (int)( Q_random( &seed ) * 191 );
+		ch->rightvol = 64 + (int)( Q_random( &seed ) * 191 );
+		ch->loopSound = qtrue;
+
+		if ( i % 3 == 2 ) {
+			ch->doppler = qtrue;
+			ch->dopplerScale = 1.05f + Q_random( &seed );
+			numPitched++;
+		}
+	}
+
+	output[0] = (short *)Z_Malloc( total * 2 * sizeof( short ), TAG_TEMP_WORKSPACE, qfalse );
+	output[1] = (short *)Z_Malloc( total * 2 * sizeof( short ), TAG_TEMP_WORKSPACE, qfalse );
+
+	// keep the real device from reading while its description points at our buffer
+	SNDDMA_BeginPainting();
+
+	const dma_t	savedDma = dma;
+	const int	savedPaintedTime = s_paintedtime;
+	const int	savedRawEnd = s_rawend;
+	int64_t		cost[2];
+
+	dma.channels = 2;
+	dma.samplebits = 16;
+	dma.speed = MIXBENCH_SPEED;
+	dma.samples = MIXBENCH_SAMPLES;
+	dma.submission_chunk = 1;
+	dma.buffer = (byte *)Z_Malloc( MIXBENCH_SAMPLES * sizeof( short ), TAG_TEMP_WORKSPACE, qtrue );
+	s_rawend = 0;
+
+	for ( int pass = 0; pass < 2; pass++ ) {
+		s_mixReference = ( pass == 0 ) ? qtrue : qfalse;
+		s_paintedtime = 0;
+		cost[pass] = 0;
+
+		for ( int t = 0; t < total; t += MIXBENCH_CHUNK ) {
+			const int end = Q_min( t + MIXBENCH_CHUNK, total );
+			const int64_t start = Sys_Microseconds();
+
+			S_PaintChannelsFrom( channels, numChannels, end );
+
+			cost[pass] += Sys_Microseconds() - start;
+
+			const int pos = t & ( ( MIXBENCH_SAMPLES >> 1 ) - 1 );
+			memcpy( output[pass] + t * 2, (short *)dma.buffer + pos * 2, ( end - t ) * 2 * sizeof( short ) );
+		}
+	}
+
+	s_mixReference = qfalse;
+
+	Z_Free( dma.buffer );
+	dma = savedDma;
+	s_paintedtime = savedPaintedTime;
+	s_rawend = savedRawEnd;
+
+	SNDDMA_Submit();
+
+	int		maxDiff = 0;
+	double	sumSq = 0.0;
+
+	for ( int i = 0; i < total * 2; i++ ) {
+		const int diff = abs( output[0][i] - output[1][i] );
+
+		maxDiff = Q_max( maxDiff, diff );
+		sumSq += (double)diff * diff;
+	}
+
+	Com_Printf( "s_mixbench: %i channels (%i pitched) from %i sounds, %i seconds at %i Hz\n", numChannels, numPitched, numSounds, seconds, MIXBENCH_SPEED );
+	Com_Printf( "  reference %.2f ms, mixer %.2f ms", cost[0] / 1000.0, cost[1] / 1000.0 );
+	if ( cost[1] > 0 ) {
+		Com_Printf( " (%.2fx)", (double)cost[0] / cost[1] );
+	}
+	Com_Printf( "\n  output difference: max %i, rms %.2f\n", maxDiff, sqrt( sumSq / ( total * 2 ) ) );
+
+	Z_Free( output[1] );
+	Z_Free( output[0] );
+	Z_Free( channels );
+}
@@ -83,7 +83,7 @@ static void DeathUpdate( Vehicle_t *pVeh )
 			}
 
 			parent->e_ThinkFunc = thinkF_G_FreeEntity;
-			parent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( parent, level.time + FRAMETIME );
 		}*/
 	}
 }
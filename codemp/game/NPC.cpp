@@ -131,7 +131,7 @@ void NPC_RemoveBody( gentity_t *self )
 {
 	CorpsePhysics( self );
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 
 	if ( self->NPC->nextBStateThink <= level.time )
 	{
@@ -189,7 +189,7 @@ void NPC_RemoveBody( gentity_t *self )
 		// should I check NPC_class here instead of TEAM ? - dmv
 		if( self->client->playerTeam == NPCTEAM_ENEMY || self->client->NPC_class == CLASS_PROTOCOL )
 		{
-			self->nextthink = level.time + FRAMETIME; // try back in a second
+			G_SetNextThink( self, level.time + FRAMETIME ); // try back in a second
 
 			/*
 			if ( DistanceSquared( g_entities[0].r.currentOrigin, self->r.currentOrigin ) <= REMOVE_DISTANCE_SQR )
@@ -505,7 +505,7 @@ static void DeadThink ( void )
 				//if ( !NPC->taskManager || !NPC->taskManager->IsRunning() )
 				{
 					NPCS.NPC->think = G_FreeEntity;
-					NPCS.NPC->nextthink = level.time + FRAMETIME;
+					G_SetNextThink( NPCS.NPC, level.time + FRAMETIME );
 				}
 			}
 			else
@@ -517,7 +517,7 @@ static void DeadThink ( void )
 
 				//FIXME: keep it running through physics somehow?
 				NPCS.NPC->think = NPC_RemoveBody;
-				NPCS.NPC->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( NPCS.NPC, level.time + FRAMETIME );
 			//	if ( NPC->client->playerTeam == NPCTEAM_FORGE )
 			//		NPCInfo->timeOfDeath = level.time + FRAMETIME * 8;
 			//	else if ( NPC->client->playerTeam == NPCTEAM_BOTS )
@@ -1769,7 +1769,7 @@ void NPC_Think ( gentity_t *self)//, int msec )
 	int i = 0;
 	gentity_t *player;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 
 	SetNPCGlobals( self );
 
@@ -1809,7 +1809,7 @@ void NPC_Think ( gentity_t *self)//, int msec )
 		return;
 	}
 
-	self->nextthink = level.time + FRAMETIME/2;
+	G_SetNextThink( self, level.time + FRAMETIME/2 );
 
 
 	while (i < MAX_CLIENTS)
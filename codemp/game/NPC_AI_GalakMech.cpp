@@ -241,7 +241,7 @@ void GM_Dying( gentity_t *self )
 		G_PlayEffectID( G_EffectIndex("galak/explode"), self->r.currentOrigin, vec3_origin );
 //		G_PlayEffect( "small_chunks", self->r.currentOrigin );
 //		G_PlayEffect( "env/exp_trail_comp", self->r.currentOrigin, self->currentAngles );
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 		self->think = G_FreeEntity;
 	}
 }
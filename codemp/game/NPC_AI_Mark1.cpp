@@ -241,7 +241,7 @@ void Mark1_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 			self->contents = CONTENTS_CORPSE;
 			// G_FreeEntity( self ); // Is this safe?  I can't see why we'd mark it nodraw and then just leave it around??
 			self->e_ThinkFunc = thinkF_G_FreeEntity;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( self, level.time + FRAMETIME );
 		}
 		return;
 	}
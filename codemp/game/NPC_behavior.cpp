@@ -205,7 +205,7 @@ void Disappear(gentity_t *self)
 //	ClientDisconnect(self);
 	self->s.eFlags |= EF_NODRAW;
 	self->think = 0;
-	self->nextthink = -1;
+	G_SetNextThink( self, -1 );
 }
 
 void MakeOwnerInvis (gentity_t *self);
@@ -216,12 +216,12 @@ void BeamOut (gentity_t *self)
 /*
 	tent->owner = self;
 	tent->think = MakeOwnerInvis;
-	tent->nextthink = level.time + 1800;
+	G_SetNextThink( tent, level.time + 1800 );
 	//G_AddEvent( ent, EV_PLAYER_TELEPORT, 0 );
 	tent = G_TempEntity( self->client->pcurrentOrigin, EV_PLAYER_TELEPORT );
 */
 	//fixme: doesn't actually go away!
-	self->nextthink = level.time + 1500;
+	G_SetNextThink( self, level.time + 1500 );
 	self->think = Disappear;
 	self->client->squadname = NULL;
 	self->s.teamowner = self->client->playerTeam = NPCTEAM_FREE;
@@ -950,10 +950,11 @@ void NPC_BSRemove (void)
 		NPCS.NPC->r.contents = 0;
 		NPCS.NPC->health = 0;
 		NPCS.NPC->targetname = NULL;
+		G_UpdateEntityIndex( NPCS.NPC );
 
 		//Disappear in half a second
 		NPCS.NPC->think = G_FreeEntity;
-		NPCS.NPC->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( NPCS.NPC, level.time + FRAMETIME );
 	}//FIXME: else allow for out of FOV???
 }
 
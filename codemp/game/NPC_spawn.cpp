@@ -880,13 +880,13 @@ void NPC_Begin (gentity_t *ent)
 
 				//Kill us
 				ent->think = G_FreeEntity;
-				ent->nextthink = level.time + 100;
+				G_SetNextThink( ent, level.time + 100 );
 			}
 			else
 			{
 				G_DebugPrint( WL_DEBUG, "NPC %s could not spawn, waiting %4.2 secs to try again\n", ent->targetname, ent->wait/1000.0f );
 				ent->think = NPC_Begin;
-				ent->nextthink = level.time + ent->wait;//try again in half a second
+				G_SetNextThink( ent, level.time + ent->wait );//try again in half a second
 			}
 			return;
 		}
@@ -1131,7 +1131,7 @@ void NPC_Begin (gentity_t *ent)
 
 	ent->use   = NPC_Use;
 	ent->think = NPC_Think;
-	ent->nextthink = level.time + FRAMETIME + Q_irand(0, 100);
+	G_SetNextThink( ent, level.time + FRAMETIME + Q_irand(0, 100) );
 
 	NPC_SetMiscDefaultData( ent );
 	if ( ent->health <= 0 )
@@ -1312,13 +1312,13 @@ qboolean NPC_StasisSpawn_Go( gentity_t *ent )
 
 				//Kill us
 				ent->e_ThinkFunc = thinkF_G_FreeEntity;
-				ent->nextthink = level.time + 100;
+				G_SetNextThink( ent, level.time + 100 );
 			}
 			else
 			{
 				//Try to spawn again in one second
 				ent->e_ThinkFunc = thinkF_NPC_Spawn_Go;
-				ent->nextthink = level.time + 1000;
+				G_SetNextThink( ent, level.time + 1000 );
 			}
 			return qfalse;
 		}
@@ -1331,7 +1331,7 @@ qboolean NPC_StasisSpawn_Go( gentity_t *ent )
 	//Can't have anything in the way
 	if ( tr.allsolid || tr.startsolid )
 	{
-		ent->nextthink = level.time + 1000;
+		G_SetNextThink( ent, level.time + 1000 );
 		return qfalse;
 	}
 
@@ -1693,7 +1693,7 @@ gentity_t *NPC_Spawn_Do( gentity_t *ent )
 	newent->s.eFlags |= EF_NODRAW;//So he's ignored until he's fully spawned
 
 	newent->think = NPC_Begin;
-	newent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( newent, level.time + FRAMETIME );
 	NPC_DefaultScriptFlags( newent );
 
 	//copy over team variables, too
@@ -1800,7 +1800,7 @@ NPC_ShySpawn
 
 void NPC_ShySpawn( gentity_t *ent )
 {
-	ent->nextthink = level.time + SHY_THINK_TIME;
+	G_SetNextThink( ent, level.time + SHY_THINK_TIME );
 	ent->think = NPC_ShySpawn;
 
 	//rwwFIXMEFIXME: Care about other clients not just 0?
@@ -1812,7 +1812,7 @@ void NPC_ShySpawn( gentity_t *ent )
 			return;
 
 	ent->think = 0;
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 
 	NPC_Spawn_Go( ent );
 }
@@ -1844,7 +1844,7 @@ void NPC_Spawn ( gentity_t *ent, gentity_t *other, gentity_t *activator )
 			ent->think = NPC_Spawn_Go;
 		}
 
-		ent->nextthink = level.time + ent->delay;
+		G_SetNextThink( ent, level.time + ent->delay );
 	}
 	else
 	{
@@ -1963,7 +1963,7 @@ void SP_NPC_spawner( gentity_t *self)
 	if (!g_allowNPC.integer)
 	{
 		self->think = G_FreeEntity;
-		self->nextthink = level.time;
+		G_SetNextThink( self, level.time );
 		return;
 	}
 	if ( !self->fullName || !self->fullName[0] )
@@ -2041,7 +2041,7 @@ void SP_NPC_spawner( gentity_t *self)
 		if (1) //just gonna always do this I suppose.
 		{//in entity spawn stage - map starting up
 			self->think = NPC_Spawn_Go;
-			self->nextthink = level.time + START_TIME_REMOVE_ENTS + 50;
+			G_SetNextThink( self, level.time + START_TIME_REMOVE_ENTS + 50 );
 		}
 		else
 		{//else spawn right now
@@ -2163,7 +2163,7 @@ void NPC_VehicleSpawnUse( gentity_t *self, gentity_t *other, gentity_t *activato
 	if ( self->delay )
 	{
 		self->think = G_VehicleSpawn;
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink( self, level.time + self->delay );
 	}
 	else
 	{
@@ -2229,7 +2229,7 @@ void SP_NPC_Vehicle( gentity_t *self)
 				return;
 			}
 			self->think = G_VehicleSpawn;
-			self->nextthink = level.time + self->delay;
+			G_SetNextThink( self, level.time + self->delay );
 		}
 		else
 		{
@@ -3967,7 +3967,7 @@ gentity_t *NPC_SpawnType( gentity_t *ent, char *npc_type, char *targetname, qboo
 	}
 
 	NPCspawner->think = G_FreeEntity;
-	NPCspawner->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( NPCspawner, level.time + FRAMETIME );
 
 	if ( !npc_type )
 	{
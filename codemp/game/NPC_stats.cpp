@@ -225,6 +225,7 @@ extern qboolean BG_ParseLiteral( const char **data, const char *string );
 //
 #define MAX_NPC_DATA_SIZE 0x40000
 char	NPCParms[MAX_NPC_DATA_SIZE];
+defIndex_t	npcDefs;
 
 /*
 team_t TranslateTeamName( const char *name )
@@ -593,30 +594,16 @@ void NPC_Precache ( gentity_t *spawner )
 	}
 	strcpy(customSkin,"default");
 
-	p = NPCParms;
-	Com_sprintf( sessionName, sizeof(sessionName), "NPC_Precache(%s)", spawner->NPC_type );
-	COM_BeginParseSession(sessionName);
-
 	// look for the right NPC
-	while ( p )
-	{
-		token = COM_ParseExt( &p, qtrue );
-		if ( token[0] == 0 )
-			return;
-
-		if ( !Q_stricmp( token, spawner->NPC_type ) )
-		{
-			break;
-		}
-
-		SkipBracedSection( &p, 0 );
-	}
-
+	p = BG_FindDef( &npcDefs, spawner->NPC_type );
 	if ( !p )
 	{
 		return;
 	}
 
+	Com_sprintf( sessionName, sizeof(sessionName), "NPC_Precache(%s)", spawner->NPC_type );
+	COM_BeginParseSession(sessionName);
+
 	if ( BG_ParseLiteral( &p, "{" ) )
 	{
 		return;
@@ -1089,31 +1076,16 @@ qboolean NPC_ParseParms( const char *NPCName, gentity_t *NPC )
 	{
 		int fp;
 
-		p = NPCParms;
-		Com_sprintf( sessionName, sizeof(sessionName), "NPC_ParseParms(%s)", NPCName );
-		COM_BeginParseSession(sessionName);
-
 		// look for the right NPC
-		while ( p )
-		{
-			token = COM_ParseExt( &p, qtrue );
-			if ( token[0] == 0 )
-			{
-				return qfalse;
-			}
-
-			if ( !Q_stricmp( token, NPCName ) )
-			{
-				break;
-			}
-
-			SkipBracedSection( &p, 0 );
-		}
+		p = BG_FindDef( &npcDefs, NPCName );
 		if ( !p )
 		{
 			return qfalse;
 		}
 
+		Com_sprintf( sessionName, sizeof(sessionName), "NPC_ParseParms(%s)", NPCName );
+		COM_BeginParseSession(sessionName);
+
 		if ( BG_ParseLiteral( &p, "{" ) )
 		{
 			return qfalse;
@@ -3597,4 +3569,6 @@ void NPC_LoadParms( void )
 			//rww  12/19/02-actually the probelm was npcParseBuffer not being nul-term'd, which could cause issues in the strcat too
 		}
 	}
+
+	BG_BuildDefIndex( &npcDefs, NPCParms, "NPC_LoadParms" );
 }
@@ -3271,3 +3271,188 @@ int BG_GetGametypeForString( const char *gametype )
 	else if ( !Q_stricmp( gametype, "cty" ) )			return GT_CTY;
 	else												return -1;
 }
+
+/*
+=============================================================================
+
+DEFINITION INDEX
+
+Sabers and NPCs are looked up by name in one big buffer of every .sab or
+.npc file.  Finding one used to mean tokenizing every block before it, and
+that happens whenever someone changes saber or an NPC spawns.  The index
+records where each block starts when the buffer is loaded.  Parsing the
+block itself still happens on every lookup, since the parse functions
+register sounds, models and effects as they go.
+
+=============================================================================
+*/
+
+static int BG_DefIndexHash( const char *name ) {
+	return (int)( Q_HashStringFNVNoCase( name ) & ( DEF_INDEX_HASH_SIZE - 1 ) );
+}
+
+static const defIndexEntry_t *BG_DefIndexEntry( const defIndex_t *index, const char *name ) {
+	for ( int i = index->hash[BG_DefIndexHash( name )]; i != -1; i = index->entries[i].next ) {
+		if ( !Q_stricmp( index->names + index->entries[i].name, name ) ) {
+			return &index->entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+=============
+BG_FindDefScan
+
+The old way, tokenizing from the start of the buffer.  Returns the text
+just past the name, or NULL
+=============
+*/
+const char *BG_FindDefScan( const char *buffer, const char *name, const char *sessionName ) {
+	const char	*p = buffer;
+	const char	*token;
+
+	COM_BeginParseSession( sessionName );
+
+	while ( p ) {
+		token = COM_ParseExt( &p, qtrue );
+		if ( !token[0] ) {
+			return NULL;
+		}
+
+		if ( !Q_stricmp( token, name ) ) {
+			return p;
+		}
+
+		SkipBracedSection( &p, 0 );
+	}
+
+	return NULL;
+}
+
+/*
+=============
+BG_BuildDefIndex
+
+Walks the buffer the same way BG_FindDefScan does, so a name finds the same
+block either way, the first one if it's defined more than once
+=============
+*/
+void BG_BuildDefIndex( defIndex_t *index, const char *buffer, const char *sessionName ) {
+	const char	*p = buffer;
+	const char	*token;
+
+	memset( index->hash, -1, sizeof( index->hash ) );
+	index->buffer = buffer;
+	index->numEntries = 0;
+	index->namesUsed = 0;
+	index->complete = qtrue;
+
+	COM_BeginParseSession( sessionName );
+
+	while ( p ) {
+		token = COM_ParseExt( &p, qtrue );
+		if ( !token[0] ) {
+			break;
+		}
+
+		if ( !BG_DefIndexEntry( index, token ) ) {
+			const int len = strlen( token ) + 1;
+
+			if ( index->numEntries == MAX_DEF_INDEX_ENTRIES || index->namesUsed + len > DEF_INDEX_NAMES_SIZE ) {
+				// anything past here gets found the slow way
+				Com_Printf( S_COLOR_YELLOW "WARNING: %s: too many definitions to index\n", sessionName );
+				index->complete = qfalse;
+				return;
+			}
+
+			defIndexEntry_t *entry = &index->entries[index->numEntries];
+			const int hash = BG_DefIndexHash( token );
+
+			entry->name = index->namesUsed;
+			entry->body = p ? p - buffer : -1;
+			entry->next = index->hash[hash];
+			index->hash[hash] = index->numEntries++;
+
+			memcpy( index->names + index->namesUsed, token, len );
+			index->namesUsed += len;
+		}
+
+		SkipBracedSection( &p, 0 );
+	}
+}
+
+/*
+=============
+BG_FindDef
+
+Returns the text just past the name of the block, ready for parsing its
+braced section, or NULL
+=============
+*/
+const char *BG_FindDef( const defIndex_t *index, const char *name ) {
+	const defIndexEntry_t *entry;
+
+	if ( !index->buffer ) {
+		return NULL;
+	}
+
+	entry = BG_DefIndexEntry( index, name );
+	if ( entry ) {
+		return entry->body != -1 ? index->buffer + entry->body : NULL;
+	}
+
+	if ( !index->complete ) {
+		return BG_FindDefScan( index->buffer, name, "BG_FindDef" );
+	}
+
+	return NULL;
+}
+
+/*
+=============
+BG_DefIndexBench
+
+Times building the index and finding every name in it, against scanning
+for each name from the start of the buffer, with the module's microsecond
+clock
+=============
+*/
+void BG_DefIndexBench( const char *label, const defIndex_t *index, int64_t (*microseconds)( void ) ) {
+	static defIndex_t	rebuilt;
+	int					numDiffer = 0;
+
+	if ( !index->buffer || !index->numEntries ) {
+		Com_Printf( "%s: nothing loaded\n", label );
+		return;
+	}
+
+	const int64_t buildStart = microseconds();
+	BG_BuildDefIndex( &rebuilt, index->buffer, label );
+	const int64_t scanStart = microseconds();
+
+	for ( int i = 0; i < index->numEntries; i++ ) {
+		const char *name = index->names + index->entries[i].name;
+
+		if ( BG_FindDefScan( index->buffer, name, label ) != BG_FindDef( index, name ) ) {
+			numDiffer++;
+		}
+	}
+
+	const int64_t lookupStart = microseconds();
+
+	for ( int i = 0; i < index->numEntries; i++ ) {
+		BG_FindDef( index, index->names + index->entries[i].name );
+	}
+
+	const int64_t end = microseconds();
+
+	const double buildUsec = (double)( scanStart - buildStart );
+	const double scanUsec = (double)( lookupStart - scanStart );
+	const double lookupUsec = (double)( end - lookupStart );
+
+	Com_Printf( "%s: %i definitions, %i bytes, index built in %.0f usec\n", label, index->numEntries, (int)strlen( index->buffer ), buildUsec );
+	Com_Printf( "%s: per lookup %.2f usec scanning, %.3f usec indexed, %s\n", label,
+		scanUsec / index->numEntries, lookupUsec / index->numEntries, numDiffer ? S_COLOR_RED "RESULTS DIFFER" : "results match" );
+}
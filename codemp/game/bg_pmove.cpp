@@ -8802,8 +8802,38 @@ void BG_UpdateLookAngles( int lookingDebounceTime, vec3_t lastHeadAngles, int ti
 	VectorCopy( lookAngles, lastHeadAngles );
 }
 
+static const char *bgPlayerBoneNames[BG_NUM_PLAYER_BONES] = {
+	"lower_lumbar",
+	"upper_lumbar",
+	"thoracic",
+	"cervical",
+	"cranium"
+};
+
+static const int *BG_G2PlayerBones( bgPlayerBones_t *bones, void *ghoul2 )
+{
+	int i;
+
+	if ( bones->ghoul2 != ghoul2 )
+	{
+		bones->ghoul2 = ghoul2;
+		for ( i = 0; i < BG_NUM_PLAYER_BONES; i++ )
+		{
+			bones->bones[i] = g_trap->ext.G2API_GetBoneNumber( ghoul2, 0, bgPlayerBoneNames[i] );
+		}
+	}
+
+	return bones->bones;
+}
+
+// all of the player's spine and head bones are set the same way
+static void BG_G2SetPlayerBoneAngles( void *ghoul2, const int *bones, bgPlayerBone_t bone, const vec3_t angles, int time )
+{
+	g_trap->ext.G2API_SetBoneAnglesNum( ghoul2, 0, bones[bone], angles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, time );
+}
+
 //for setting visual look (headturn) angles
-static void BG_G2ClientNeckAngles( void *ghoul2, int time, const vec3_t lookAngles, vec3_t headAngles, vec3_t neckAngles, vec3_t thoracicAngles, vec3_t headClampMinAngles, vec3_t headClampMaxAngles )
+static void BG_G2ClientNeckAngles( void *ghoul2, const int *bones, int time, const vec3_t lookAngles, vec3_t headAngles, vec3_t neckAngles, vec3_t thoracicAngles, vec3_t headClampMinAngles, vec3_t headClampMaxAngles )
 {
 	vec3_t	lA;
 	VectorCopy( lookAngles, lA );
@@ -8876,9 +8906,9 @@ static void BG_G2ClientNeckAngles( void *ghoul2, int time, const vec3_t lookAngl
 	}
 	*/
 
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "cranium", headAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "cervical", neckAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "thoracic", thoracicAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CRANIUM, headAngles, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CERVICAL, neckAngles, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_THORACIC, thoracicAngles, time);
 }
 
 //rww - Finally decided to convert all this stuff to BG form.
@@ -9095,7 +9125,7 @@ qboolean BG_InRoll2( entityState_t *es )
 
 
 extern qboolean BG_SaberLockBreakAnim( int anim ); //bg_panimate.c
-void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int time, vec3_t cent_lerpOrigin,
+void BG_G2PlayerAngles(void *ghoul2, int motionBolt, bgPlayerBones_t *boneCache, entityState_t *cent, int time, vec3_t cent_lerpOrigin,
 					   vec3_t cent_lerpAngles, matrix3_t legs, vec3_t legsAngles, qboolean *tYawing,
 					   qboolean *tPitching, qboolean *lYawing, float *tYawAngle, float *tPitchAngle,
 					   float *lYawAngle, int frametime, vec3_t turAngles, vec3_t modelScale, int ciLegs,
@@ -9122,6 +9152,7 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 	static vec3_t		velPos, velAng;
 	static vec3_t		ulAngles, llAngles, viewAngles, angles, thoracicAngles = {0,0,0};
 	static vec3_t		headClampMinAngles = {-25,-55,-10}, headClampMaxAngles = {50,50,10};
+	const int			*bones = BG_G2PlayerBones(boneCache, ghoul2);
 
 	if ( cent->m_iVehicleNum || cent->forceFrame || BG_SaberLockBreakAnim(cent->legsAnim) || BG_SaberLockBreakAnim(cent->torsoAnim) )
 	{ //a vehicle or riding a vehicle - in either case we don't need to be in here
@@ -9136,11 +9167,11 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 
 		if (cent->number < MAX_CLIENTS)
 		{
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "lower_lumbar", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "upper_lumbar", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "cranium", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "thoracic", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "cervical", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_LOWER_LUMBAR, vec3_origin, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_UPPER_LUMBAR, vec3_origin, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CRANIUM, vec3_origin, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_THORACIC, vec3_origin, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CERVICAL, vec3_origin, time);
 		}
 		return;
 	}
@@ -9401,9 +9432,9 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 				}
 
 				BG_G2ClientSpineAngles(ghoul2, motionBolt, cent_lerpOrigin, cent_lerpAngles, cent, time, viewAngles, ciLegs, ciTorso, angles, thoracicAngles, ulAngles, llAngles, modelScale, tPitchAngle, tYawAngle, corrTime);
-				g_trap->G2API_SetBoneAngles(ghoul2, 0, "lower_lumbar", llAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-				g_trap->G2API_SetBoneAngles(ghoul2, 0, "upper_lumbar", ulAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-				g_trap->G2API_SetBoneAngles(ghoul2, 0, "cranium", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+				BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_LOWER_LUMBAR, llAngles, time);
+				BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_UPPER_LUMBAR, ulAngles, time);
+				BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CRANIUM, vec3_origin, time);
 
 				VectorAdd(facingAngles, thoracicAngles, facingAngles);
 
@@ -9416,17 +9447,17 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 			{
 			//	g_trap->G2API_SetBoneAngles(ghoul2, 0, "lower_lumbar", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
 			//	g_trap->G2API_SetBoneAngles(ghoul2, 0, "upper_lumbar", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-				g_trap->G2API_SetBoneAngles(ghoul2, 0, "cranium", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+				BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CRANIUM, vec3_origin, time);
 			}
 
-			VectorScale(facingAngles, 0.6f, facingAngles);	g_trap->G2API_SetBoneAngles(ghoul2, 0, "lower_lumbar", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			VectorScale(facingAngles, 0.8f, facingAngles);	g_trap->G2API_SetBoneAngles(ghoul2, 0, "upper_lumbar", facingAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-			VectorScale(facingAngles, 0.8f, facingAngles);	g_trap->G2API_SetBoneAngles(ghoul2, 0, "thoracic", facingAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+			VectorScale(facingAngles, 0.6f, facingAngles);	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_LOWER_LUMBAR, vec3_origin, time);
+			VectorScale(facingAngles, 0.8f, facingAngles);	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_UPPER_LUMBAR, facingAngles, time);
+			VectorScale(facingAngles, 0.8f, facingAngles);	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_THORACIC, facingAngles, time);
 
 			//Now we want the head angled toward where we are facing
 			VectorSet(facingAngles, 0.0f, dif, 0.0f);
 			VectorScale(facingAngles, 0.6f, facingAngles);
-			g_trap->G2API_SetBoneAngles(ghoul2, 0, "cervical", facingAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+			BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_CERVICAL, facingAngles, time);
 
 			return; //don't have to bother with the rest then
 		}
@@ -9447,7 +9478,7 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 
 	BG_UpdateLookAngles(lookTime, lastHeadAngles, time, lookAngles, lookSpeed, -50.0f, 50.0f, -70.0f, 70.0f, -30.0f, 30.0f);
 
-	BG_G2ClientNeckAngles(ghoul2, time, lookAngles, headAngles, neckAngles, thoracicAngles, headClampMinAngles, headClampMaxAngles);
+	BG_G2ClientNeckAngles(ghoul2, bones, time, lookAngles, headAngles, neckAngles, thoracicAngles, headClampMinAngles, headClampMaxAngles);
 
 #ifdef BONE_BASED_LEG_ANGLES
 	{
@@ -9463,9 +9494,9 @@ void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int ti
 	}
 #endif
 
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "lower_lumbar", llAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "upper_lumbar", ulAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
-	g_trap->G2API_SetBoneAngles(ghoul2, 0, "thoracic", thoracicAngles, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_LOWER_LUMBAR, llAngles, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_UPPER_LUMBAR, ulAngles, time);
+	BG_G2SetPlayerBoneAngles(ghoul2, bones, BG_BONE_THORACIC, thoracicAngles, time);
 //	g_trap->G2API_SetBoneAngles(ghoul2, 0, "cervical", vec3_origin, BONE_ANGLES_POSTMULT, POSITIVE_X, NEGATIVE_Y, NEGATIVE_Z, 0, 0, time);
 }
 
@@ -1682,7 +1682,22 @@ void BG_GiveMeVectorFromMatrix(mdxaBone_t *boltMatrix, int flags, vec3_t vec);
 void BG_IK_MoveArm(void *ghoul2, int lHandBolt, int time, entityState_t *ent, int basePose, vec3_t desiredPos, qboolean *ikInProgress,
 					 vec3_t origin, vec3_t angles, vec3_t scale, int blendTime, qboolean forceHalt);
 
-void BG_G2PlayerAngles(void *ghoul2, int motionBolt, entityState_t *cent, int time, vec3_t cent_lerpOrigin,
+// the bones BG_G2PlayerAngles sets every frame, by number so their names aren't looked up each time
+typedef enum bgPlayerBone_e {
+	BG_BONE_LOWER_LUMBAR,
+	BG_BONE_UPPER_LUMBAR,
+	BG_BONE_THORACIC,
+	BG_BONE_CERVICAL,
+	BG_BONE_CRANIUM,
+	BG_NUM_PLAYER_BONES
+} bgPlayerBone_t;
+
+typedef struct bgPlayerBones_s {
+	void	*ghoul2;	// the instance the numbers were looked up on, if it doesn't match they're looked up again
+	int		bones[BG_NUM_PLAYER_BONES];
+} bgPlayerBones_t;
+
+void BG_G2PlayerAngles(void *ghoul2, int motionBolt, bgPlayerBones_t *bones, entityState_t *cent, int time, vec3_t cent_lerpOrigin,
 					   vec3_t cent_lerpAngles, matrix3_t legs, vec3_t legsAngles, qboolean *tYawing,
 					   qboolean *tPitching, qboolean *lYawing, float *tYawAngle, float *tPitchAngle,
 					   float *lYawAngle, int frametime, vec3_t turAngles, vec3_t modelScale, int ciLegs,
@@ -1808,3 +1823,32 @@ extern int forcePowerDarkLight[NUM_FORCE_POWERS];
 extern const char *gametypeStringShort[GT_MAX_GAME_TYPE];
 const char *BG_GetGametypeString( int gametype );
 int BG_GetGametypeForString( const char *gametype );
+
+// Where each top level "name { ... }" block starts in a buffer of concatenated
+// .sab or .npc files, so finding one doesn't mean parsing everything before it
+#define MAX_DEF_INDEX_ENTRIES		4096
+#define DEF_INDEX_HASH_SIZE			1024
+#define DEF_INDEX_NAMES_SIZE		(64*1024)
+
+typedef struct defIndexEntry_s {
+	int			name;						// offset into names
+	int			body;						// offset into the buffer just past the name
+	int			next;						// next entry in the hash chain, or -1
+} defIndexEntry_t;
+
+typedef struct defIndex_s {
+	const char		*buffer;
+	int				hash[DEF_INDEX_HASH_SIZE];
+	defIndexEntry_t	entries[MAX_DEF_INDEX_ENTRIES];
+	int				numEntries;
+	char			names[DEF_INDEX_NAMES_SIZE];
+	int				namesUsed;
+	qboolean		complete;				// every name in the buffer made it into the index
+} defIndex_t;
+
+void BG_BuildDefIndex( defIndex_t *index, const char *buffer, const char *sessionName );
+const char *BG_FindDef( const defIndex_t *index, const char *name );
+const char *BG_FindDefScan( const char *buffer, const char *name, const char *sessionName );
+void BG_DefIndexBench( const char *label, const defIndex_t *index, int64_t (*microseconds)( void ) );
+
+extern defIndex_t bgSaberDefs;
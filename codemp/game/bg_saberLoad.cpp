@@ -49,6 +49,7 @@ extern stringID_table_t FPTable[];
 
 #define MAX_SABER_DATA_SIZE (1024*1024) // 1mb, was 512kb
 static char saberParms[MAX_SABER_DATA_SIZE];
+defIndex_t bgSaberDefs;
 
 stringID_table_t saberTable[] = {
 	ENUM2STRING( SABER_NONE ),
@@ -2083,35 +2084,21 @@ qboolean WP_SaberParseParms( const char *saberName, saberInfo_t *saber ) {
 	else
 		Q_strncpyz( useSaber, saberName, sizeof( useSaber ) );
 
-	//try to parse it out
-	p = saberParms;
-	COM_BeginParseSession( "saberinfo" );
-
 	// look for the right saber
-	while ( p ) {
-		token = COM_ParseExt( &p, qtrue );
-		if ( !token[0] ) {
-			if ( !triedDefault ) {
-				// fall back to default and restart, should always be there
-				p = saberParms;
-				COM_BeginParseSession( "saberinfo" );
-				Q_strncpyz( useSaber, DEFAULT_SABER, sizeof( useSaber ) );
-				triedDefault = qtrue;
-			}
-			else
-				return qfalse;
-		}
-
-		if ( !Q_stricmp( token, useSaber ) )
-			break;
-
-		SkipBracedSection( &p, 0 );
+	p = BG_FindDef( &bgSaberDefs, useSaber );
+	if ( !p && !triedDefault ) {
+		// fall back to default, should always be there
+		Q_strncpyz( useSaber, DEFAULT_SABER, sizeof( useSaber ) );
+		triedDefault = qtrue;
+		p = BG_FindDef( &bgSaberDefs, useSaber );
 	}
 
 	// even the default saber isn't found?
 	if ( !p )
 		return qfalse;
 
+	COM_BeginParseSession( "saberinfo" );
+
 	// got the name we're using for sure
 	Q_strncpyz( saber->name, useSaber, sizeof( saber->name ) );
 
@@ -2157,30 +2144,13 @@ qboolean WP_SaberParseParm( const char *saberName, const char *parmname, char *s
 		return qfalse;
 	}
 
-	//try to parse it out
-	p = saberParms;
-	COM_BeginParseSession("saberinfo");
-
 	// look for the right saber
-	while ( p )
-	{
-		token = COM_ParseExt( &p, qtrue );
-		if ( token[0] == 0 )
-		{
-			return qfalse;
-		}
-
-		if ( !Q_stricmp( token, saberName ) )
-		{
-			break;
-		}
-
-		SkipBracedSection( &p, 0 );
-	}
+	p = BG_FindDef( &bgSaberDefs, saberName );
 	if ( !p )
 	{
 		return qfalse;
 	}
+	COM_BeginParseSession("saberinfo");
 
 	if ( BG_ParseLiteral( &p, "{" ) )
 	{
@@ -2367,6 +2337,8 @@ void WP_SaberLoadParms( void )
 		totallen += len;
 		marker = saberParms+totallen;
 	}
+
+	BG_BuildDefIndex( &bgSaberDefs, saberParms, "saberinfo" );
 }
 template void WP_SaberLoadParms< moduleType::game >( void );
 template void WP_SaberLoadParms< moduleType::cgame >( void );
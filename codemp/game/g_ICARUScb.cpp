@@ -923,7 +923,7 @@ void Q3_Lerp2Angles( int taskID, int entID, vec3_t angles, float duration )
 
 	//ent->e_ReachedFunc = reachedF_NULL;
 	ent->think = anglerCallback;
-	ent->nextthink = level.time + duration;
+	G_SetNextThink( ent, level.time + duration );
 
 	g_trap->LinkEntity( (sharedEntity_t *)ent );
 }
@@ -1069,7 +1069,7 @@ void Q3_RemoveEnt( gentity_t *victim )
 				}
 			}
 			victim->think = G_FreeEntity;
-			victim->nextthink = level.time + 100;
+			G_SetNextThink( victim, level.time + 100 );
 		}
 		/*
 		//ClientDisconnect(ent);
@@ -1078,6 +1078,7 @@ void Q3_RemoveEnt( gentity_t *victim )
 		victim->contents = 0;
 		victim->health = 0;
 		victim->targetname = NULL;
+		G_UpdateEntityIndex( victim );
 
 		if ( victim->NPC && victim->NPC->tempGoal != NULL )
 		{
@@ -1094,14 +1095,14 @@ void Q3_RemoveEnt( gentity_t *victim )
 		}
 		//Disappear in half a second
 		victim->e_ThinkFunc = thinkF_G_FreeEntity;
-		victim->nextthink = level.time + 500;
+		G_SetNextThink( victim, level.time + 500 );
 		return;
 		*/
 	}
 	else
 	{
 		victim->think = G_FreeEntity;
-		victim->nextthink = level.time + 100;
+		G_SetNextThink( victim, level.time + 100 );
 	}
 }
 
@@ -1859,7 +1860,7 @@ void MoveOwner( gentity_t *self )
 {
 	gentity_t *owner = &g_entities[self->r.ownerNum];
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	self->think = G_FreeEntity;
 
 	if ( !owner || !owner->inuse )
@@ -1899,7 +1900,7 @@ static qboolean Q3_SetTeleportDest( int entID, vec3_t org )
 			teleporter->r.ownerNum = teleEnt->s.number;
 
 			teleporter->think = MoveOwner;
-			teleporter->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( teleporter, level.time + FRAMETIME );
 
 			return qfalse;
 		}
@@ -3766,6 +3767,7 @@ static void Q3_SetTargetName (int entID, const char *targetname)
 	{
 		self->targetname = G_NewString( targetname );
 	}
+	G_UpdateEntityIndex( self );
 }
 
 
@@ -3796,6 +3798,7 @@ static void Q3_SetTarget (int entID, const char *target)
 	{
 		self->target = G_NewString( target );
 	}
+	G_UpdateEntityIndex( self );
 }
 
 /*
@@ -5065,7 +5068,7 @@ void SolidifyOwner( gentity_t *self )
 	int oldContents;
 	gentity_t *owner = &g_entities[self->r.ownerNum];
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	self->think = G_FreeEntity;
 
 	if ( !owner || !owner->inuse )
@@ -5115,7 +5118,7 @@ static qboolean Q3_SetSolid( int entID, qboolean solid)
 			solidifier->r.ownerNum = ent->s.number;
 
 			solidifier->think = SolidifyOwner;
-			solidifier->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( solidifier, level.time + FRAMETIME );
 
 			ent->r.contents = oldContents;
 			return qfalse;
@@ -337,6 +337,7 @@ void ThrowSaberToAttacker(gentity_t *self, gentity_t *attacker)
 	ent->s.modelGhoul2 = 1;
 	ent->s.eType = ET_MISSILE;
 	ent->enemy = NULL;
+	G_WakeEntity( ent );
 
 	if (!attacker || !attacker->client)
 	{
@@ -401,7 +402,7 @@ void JMSaberThink(gentity_t *ent)
 		g_trap->LinkEntity((sharedEntity_t *)ent);
 	}
 
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 	G_RunObject(ent);
 }
 
@@ -536,7 +537,7 @@ void SP_info_jedimaster_start(gentity_t *ent)
 	g_trap->LinkEntity((sharedEntity_t *)ent);
 
 	ent->think = JMSaberThink;
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 }
 
 /*
@@ -1037,7 +1038,7 @@ void BodySink( gentity_t *ent ) {
 //	ent->s.pos.trBase[2] -= 1;
 
 	G_AddEvent(ent, EV_BODYFADE, 0);
-	ent->nextthink = level.time + 18000;
+	G_SetNextThink( ent, level.time + 18000 );
 	ent->takedamage = qfalse;
 }
 
@@ -1101,6 +1102,7 @@ static qboolean CopyToBodyQue( gentity_t *ent ) {
 	body->timestamp = level.time;
 	body->physicsObject = qtrue;
 	body->physicsBounce = 0;		// don't bounce
+	G_WakeEntity( body );
 	if ( body->s.groundEntityNum == ENTITYNUM_NONE ) {
 		body->s.pos.trType = TR_GRAVITY;
 		body->s.pos.trTime = level.time;
@@ -1142,7 +1144,7 @@ static qboolean CopyToBodyQue( gentity_t *ent ) {
 	body->r.contents = CONTENTS_CORPSE;
 	body->r.ownerNum = ent->s.number;
 
-	body->nextthink = level.time + BODY_SINK_TIME;
+	G_SetNextThink( body, level.time + BODY_SINK_TIME );
 	body->think = BodySink;
 
 	body->die = body_die;
@@ -3367,6 +3369,7 @@ void ClientSpawn(gentity_t *ent) {
 	ent->takedamage = qtrue;
 	ent->inuse = qtrue;
 	ent->classname = "player";
+	G_UpdateEntityIndex( ent );
 	ent->r.contents = CONTENTS_BODY;
 	ent->clipmask = MASK_PLAYERSOLID;
 	ent->die = player_die;
@@ -4011,6 +4014,7 @@ void ClientDisconnect( int clientNum ) {
 	ent->s.modelindex = 0;
 	ent->inuse = qfalse;
 	ent->classname = "disconnected";
+	G_UpdateEntityIndex( ent );
 	ent->client->pers.connected = CON_DISCONNECTED;
 	ent->client->ps.persistant[PERS_TEAM] = TEAM_FREE;
 	ent->client->sess.sessionTeam = TEAM_FREE;
@@ -717,7 +717,7 @@ void body_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int d
 			  meansOfDeath == MOD_TRIGGER_HURT) )
 		{
 			self->think = G_FreeEntity;
-			self->nextthink = level.time;
+			G_SetNextThink( self, level.time );
 		}
 		return;
 	}
@@ -759,7 +759,7 @@ void body_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int d
 
 			//since it's the corpse entity, tell it to "remove" itself
 			self->think = BodyRid;
-			self->nextthink = level.time + 1000;
+			G_SetNextThink( self, level.time + 1000 );
 		}
 		return;
 	}
@@ -2244,7 +2244,7 @@ void player_die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int
 		saberReactivate(saberEnt, self);
 		saberEnt->r.contents = CONTENTS_LIGHTSABER;
 		saberEnt->think = saberBackToOwner;
-		saberEnt->nextthink = level.time;
+		G_SetNextThink( saberEnt, level.time );
 		G_RunObject(saberEnt);
 	}
 
@@ -2810,7 +2810,7 @@ extern void RunEmplacedWeapon( gentity_t *ent, usercmd_t **ucmd );
 			self->client->NPC_class != CLASS_VEHICLE)
 		{ //in this case if we're an NPC it's my guess that we want to get removed straight away.
 			self->think = G_FreeEntity;
-			self->nextthink = level.time;
+			G_SetNextThink( self, level.time );
 		}
 
 		//self->client->ps.legsAnim = anim;
@@ -3336,7 +3336,7 @@ void LimbThink( gentity_t *ent )
 	if (ent->speed < level.time)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -3346,7 +3346,7 @@ void LimbThink( gentity_t *ent )
 		ent->genericValue5 = level.time + 50;
 	}
 
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 }
 
 extern qboolean BG_GetRootSurfNameWithVariant( CGhoul2Info_v&ghoul2, const char *rootSurfName, char *returnSurfName, int returnSize );
@@ -3427,7 +3427,7 @@ void G_Dismember( gentity_t *ent, gentity_t *enemy, vec3_t point, int limbType,
 	limb->think = LimbThink;
 	limb->touch = LimbTouch;
 	limb->speed = level.time + Q_irand(8000, 16000);
-	limb->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( limb, level.time + FRAMETIME );
 
 	limb->r.svFlags = SVF_USE_CURRENT_ORIGIN;
 	limb->clipmask = MASK_SOLID;
@@ -5630,11 +5630,10 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 	float		points, dist;
 	gentity_t	*ent;
 	int			entityList[MAX_GENTITIES];
+	float		entityDists[MAX_GENTITIES];
 	int			numListedEntities;
-	vec3_t		mins, maxs;
-	vec3_t		v;
 	vec3_t		dir;
-	int			i, e;
+	int			e;
 	qboolean	hitClient = qfalse;
 	qboolean	roastPeople = qfalse;
 
@@ -5663,37 +5662,17 @@ qboolean G_RadiusDamage ( vec3_t origin, gentity_t *attacker, float damage, floa
 		radius = 1;
 	}
 
-	for ( i = 0 ; i < 3 ; i++ ) {
-		mins[i] = origin[i] - radius;
-		maxs[i] = origin[i] + radius;
-	}
-
-	numListedEntities = g_trap->EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	// distances are from the edge of each bounding box, as they were
+	// when the explosion went off
+	numListedEntities = g_trap->ext.EntitiesInRadius( origin, radius, ignore ? ignore->s.number : ENTITYNUM_NONE, 0, 0, entityList, entityDists, MAX_GENTITIES );
 
 	for ( e = 0 ; e < numListedEntities ; e++ ) {
 		ent = &g_entities[entityList[ e ]];
+		dist = entityDists[ e ];
 
-		if (ent == ignore)
-			continue;
 		if (!ent->takedamage)
 			continue;
 
-		// find the distance from the edge of the bounding box
-		for ( i = 0 ; i < 3 ; i++ ) {
-			if ( origin[i] < ent->r.absmin[i] ) {
-				v[i] = ent->r.absmin[i] - origin[i];
-			} else if ( origin[i] > ent->r.absmax[i] ) {
-				v[i] = origin[i] - ent->r.absmax[i];
-			} else {
-				v[i] = 0;
-			}
-		}
-
-		dist = VectorLength( v );
-		if ( dist >= radius ) {
-			continue;
-		}
-
 	//	if ( ent->health <= 0 )
 	//		continue;
 
@@ -0,0 +1,387 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// g_entprofile.cpp -- where G_RunFrame spends its time, for g_entityProfile
+
+#include "g_local.h"
+#include "g_entprofile.h"
+
+#include <algorithm>
+
+#define PROFILE_HASH_SIZE		(512)	// power of two
+#define PROFILE_NAME_LENGTH		(64)
+
+typedef struct entityProfileCounters_s {
+	int		calls;
+	int64_t	usec;
+	int64_t	maxUsec;
+} entityProfileCounters_t;
+
+typedef struct entityProfileStats_s {
+	entityProfileCounters_t	total;
+	entityProfileCounters_t	interval;	// since the last CSV dump
+} entityProfileStats_t;
+
+typedef struct classProfile_s {
+	char					name[PROFILE_NAME_LENGTH];	// empty if the slot is free
+	entityProfileStats_t	stats;
+} classProfile_t;
+
+typedef struct thinkProfile_s {
+	entityThink_t			think;						// NULL if the slot is free
+	char					classname[PROFILE_NAME_LENGTH];	// the first entity seen with it
+	entityProfileStats_t	stats;
+} thinkProfile_t;
+
+static const char *runNames[ENTRUN_MAX] = {
+	"G_RunThink",
+	"G_RunMissile",
+	"G_RunMover",
+	"G_RunItem",
+	"G_RunClient",
+};
+
+static entityProfileStats_t	runStats[ENTRUN_MAX];
+static classProfile_t		classStats[PROFILE_HASH_SIZE];
+static thinkProfile_t		thinkStats[PROFILE_HASH_SIZE];
+static int					numClassStats, numThinkStats;
+
+// everything that didn't fit in the tables
+static entityProfileStats_t	otherClassStats, otherThinkStats;
+
+static fileHandle_t			profileFile;
+static int					profileNextDump;
+
+static void G_ProfileAdd( entityProfileStats_t *stats, int64_t usec ) {
+	stats->total.calls++;
+	stats->total.usec += usec;
+	stats->total.maxUsec = std::max( stats->total.maxUsec, usec );
+	stats->interval.calls++;
+	stats->interval.usec += usec;
+	stats->interval.maxUsec = std::max( stats->interval.maxUsec, usec );
+}
+
+static entityProfileStats_t *G_ClassProfile( const char *classname ) {
+	uint32_t	hash;
+	int			i;
+
+	if ( !classname || !classname[0] ) {
+		classname = "(none)";
+	}
+	hash = Q_HashStringFNV( classname );
+
+	for ( i = hash & ( PROFILE_HASH_SIZE - 1 ); classStats[i].name[0]; i = ( i + 1 ) & ( PROFILE_HASH_SIZE - 1 ) ) {
+		if ( !strncmp( classStats[i].name, classname, sizeof( classStats[i].name ) - 1 ) ) {
+			return &classStats[i].stats;
+		}
+	}
+
+	// keep a free slot so the probe above always ends
+	if ( numClassStats == PROFILE_HASH_SIZE - 1 ) {
+		return &otherClassStats;
+	}
+	numClassStats++;
+	Q_strncpyz( classStats[i].name, classname, sizeof( classStats[i].name ) );
+	return &classStats[i].stats;
+}
+
+static entityProfileStats_t *G_ThinkProfile( entityThink_t think, const char *classname ) {
+	uint32_t	hash = (uint32_t)( (uintptr_t)think >> 4 ) * 2654435761u;
+	int			i;
+
+	for ( i = ( hash >> 16 ) & ( PROFILE_HASH_SIZE - 1 ); thinkStats[i].think; i = ( i + 1 ) & ( PROFILE_HASH_SIZE - 1 ) ) {
+		if ( thinkStats[i].think == think ) {
+			return &thinkStats[i].stats;
+		}
+	}
+
+	if ( numThinkStats == PROFILE_HASH_SIZE - 1 ) {
+		return &otherThinkStats;
+	}
+	numThinkStats++;
+	thinkStats[i].think = think;
+	Q_strncpyz( thinkStats[i].classname, classname ? classname : "(none)", sizeof( thinkStats[i].classname ) );
+	return &thinkStats[i].stats;
+}
+
+void G_ProfileEntityRun( entityRun_t run, const char *classname, entityThink_t think, int64_t usec ) {
+	G_ProfileAdd( &runStats[run], usec );
+	G_ProfileAdd( G_ClassProfile( classname ), usec );
+	if ( think ) {
+		G_ProfileAdd( G_ThinkProfile( think, classname ), usec );
+	}
+}
+
+static void G_ResetEntityProfile( void ) {
+	memset( runStats, 0, sizeof( runStats ) );
+	memset( classStats, 0, sizeof( classStats ) );
+	memset( thinkStats, 0, sizeof( thinkStats ) );
+	memset( &otherClassStats, 0, sizeof( otherClassStats ) );
+	memset( &otherThinkStats, 0, sizeof( otherThinkStats ) );
+	numClassStats = numThinkStats = 0;
+}
+
+/*
+=============
+G_EntityProfileDump
+
+Appends the counters gathered since the last dump to entity_profile.csv
+=============
+*/
+static void G_EntityProfileDumpRow( const char *type, const char *name, entityProfileCounters_t *counters ) {
+	const char *row;
+
+	if ( counters->calls ) {
+		row = va( "%d,%s,%s,%d,%lld,%lld\n", level.time, type, name, counters->calls, (long long)counters->usec, (long long)counters->maxUsec );
+		g_trap->FS_Write( row, strlen( row ), profileFile );
+	}
+	memset( counters, 0, sizeof( *counters ) );
+}
+
+static void G_EntityProfileDump( void ) {
+	int i;
+
+	if ( !profileFile ) {
+		const char	*header = "time,type,name,calls,usec,maxUsec\n";
+		fileHandle_t	f;
+		bool			exists = g_trap->FS_Open( "entity_profile.csv", &f, FS_READ ) >= 0;
+
+		if ( f ) {
+			g_trap->FS_Close( f );
+		}
+		g_trap->FS_Open( "entity_profile.csv", &profileFile, FS_APPEND );
+		if ( !profileFile ) {
+			g_trap->Print( S_COLOR_RED "Couldn't open entity_profile.csv for writing, disabling g_entityProfileDump\n" );
+			g_trap->Cvar_Set( "g_entityProfileDump", "0" );
+			return;
+		}
+		if ( !exists ) {
+			g_trap->FS_Write( header, strlen( header ), profileFile );
+		}
+	}
+
+	for ( i = 0; i < ENTRUN_MAX; i++ ) {
+		G_EntityProfileDumpRow( "run", runNames[i], &runStats[i].interval );
+	}
+	for ( i = 0; i < PROFILE_HASH_SIZE; i++ ) {
+		if ( classStats[i].name[0] ) {
+			G_EntityProfileDumpRow( "class", classStats[i].name, &classStats[i].stats.interval );
+		}
+	}
+	G_EntityProfileDumpRow( "class", "(other)", &otherClassStats.interval );
+	for ( i = 0; i < PROFILE_HASH_SIZE; i++ ) {
+		if ( thinkStats[i].think ) {
+			G_EntityProfileDumpRow( "think", va( "%p %s", (void *)thinkStats[i].think, thinkStats[i].classname ), &thinkStats[i].stats.interval );
+		}
+	}
+	G_EntityProfileDumpRow( "think", "(other)", &otherThinkStats.interval );
+}
+
+static void G_CloseEntityProfile( void ) {
+	if ( profileFile ) {
+		g_trap->FS_Close( profileFile );
+		profileFile = 0;
+	}
+	profileNextDump = 0;
+}
+
+/*
+=============
+G_EntityProfileFrame
+=============
+*/
+void G_EntityProfileFrame( void ) {
+	if ( !g_entityProfile.integer || g_entityProfileDump.integer <= 0 ) {
+		G_CloseEntityProfile();
+		return;
+	}
+
+	if ( profileNextDump && level.time < profileNextDump ) {
+		return;
+	}
+	if ( profileNextDump ) {
+		G_EntityProfileDump();
+	}
+	profileNextDump = level.time + g_entityProfileDump.integer * 1000;
+}
+
+/*
+=============
+G_ShutdownEntityProfile
+
+Writes out what's left of the current interval, the tables don't outlive the map
+=============
+*/
+void G_ShutdownEntityProfile( void ) {
+	if ( profileFile ) {
+		G_EntityProfileDump();
+	}
+	G_CloseEntityProfile();
+}
+
+/*
+=============
+Svcmd_EntityProfile_f
+=============
+*/
+typedef struct profileEntry_s {
+	const entityProfileCounters_t	*counters;
+	const char						*name;
+	entityThink_t					think;
+} profileEntry_t;
+
+static bool G_ProfileSortByTime( const profileEntry_t &a, const profileEntry_t &b ) {
+	return a.counters->usec > b.counters->usec;
+}
+
+static int64_t G_ProfileTotalTime( void ) {
+	int64_t	total = 0;
+	int		i;
+
+	for ( i = 0; i < ENTRUN_MAX; i++ ) {
+		total += runStats[i].total.usec;
+	}
+	return total;
+}
+
+static void G_PrintProfileEntries( const char *title, profileEntry_t *entries, int numEntries, int count ) {
+	int64_t	total = G_ProfileTotalTime();
+	int		i;
+
+	if ( !numEntries ) {
+		g_trap->Print( "no %s\n", title );
+		return;
+	}
+
+	std::sort( entries, entries + numEntries, G_ProfileSortByTime );
+
+	g_trap->Print( "%-18s %-32s %8s %10s %8s %8s %6s\n", title, "name", "calls", "total us", "avg us", "max us", "%" );
+	for ( i = 0; i < numEntries && i < count; i++ ) {
+		const entityProfileCounters_t *c = entries[i].counters;
+
+		g_trap->Print( "%-18s %-32s %8d %10lld %8lld %8lld %6.2f\n",
+			entries[i].think ? va( "%p", (void *)entries[i].think ) : "", entries[i].name,
+			c->calls, (long long)c->usec, (long long)( c->usec / c->calls ), (long long)c->maxUsec,
+			total ? c->usec * 100.0 / total : 0.0 );
+	}
+}
+
+static void G_PrintProfileRuns( void ) {
+	profileEntry_t	entries[ENTRUN_MAX];
+	int				numEntries = 0;
+	int				i;
+
+	for ( i = 0; i < ENTRUN_MAX; i++ ) {
+		if ( runStats[i].total.calls ) {
+			entries[numEntries].counters = &runStats[i].total;
+			entries[numEntries].name = runNames[i];
+			entries[numEntries].think = NULL;
+			numEntries++;
+		}
+	}
+	G_PrintProfileEntries( "runs", entries, numEntries, ENTRUN_MAX );
+}
+
+static void G_PrintProfileClasses( int count ) {
+	static profileEntry_t	entries[PROFILE_HASH_SIZE];
+	int						numEntries = 0;
+	int						i;
+
+	for ( i = 0; i < PROFILE_HASH_SIZE; i++ ) {
+		if ( classStats[i].name[0] ) {
+			entries[numEntries].counters = &classStats[i].stats.total;
+			entries[numEntries].name = classStats[i].name;
+			entries[numEntries].think = NULL;
+			numEntries++;
+		}
+	}
+	if ( otherClassStats.total.calls ) {
+		entries[numEntries].counters = &otherClassStats.total;
+		entries[numEntries].name = "(other)";
+		entries[numEntries].think = NULL;
+		numEntries++;
+	}
+	G_PrintProfileEntries( "classes", entries, numEntries, count );
+}
+
+static void G_PrintProfileThinks( int count ) {
+	static profileEntry_t	entries[PROFILE_HASH_SIZE];
+	int						numEntries = 0;
+	int						i;
+
+	for ( i = 0; i < PROFILE_HASH_SIZE; i++ ) {
+		if ( thinkStats[i].think ) {
+			entries[numEntries].counters = &thinkStats[i].stats.total;
+			entries[numEntries].name = thinkStats[i].classname;
+			entries[numEntries].think = thinkStats[i].think;
+			numEntries++;
+		}
+	}
+	if ( otherThinkStats.total.calls ) {
+		entries[numEntries].counters = &otherThinkStats.total;
+		entries[numEntries].name = "(other)";
+		entries[numEntries].think = NULL;
+		numEntries++;
+	}
+	G_PrintProfileEntries( "thinks", entries, numEntries, count );
+}
+
+void Svcmd_EntityProfile_f( void ) {
+	char	cmd[MAX_TOKEN_CHARS] = {0}, arg[MAX_TOKEN_CHARS] = {0};
+	int		count = 10;
+
+	if ( g_trap->Argc() > 1 ) {
+		g_trap->Argv( 1, cmd, sizeof( cmd ) );
+	}
+	if ( g_trap->Argc() > 2 ) {
+		g_trap->Argv( 2, arg, sizeof( arg ) );
+		count = atoi( arg );
+	}
+
+	if ( !Q_stricmp( cmd, "reset" ) ) {
+		G_ResetEntityProfile();
+		g_trap->Print( "Entity profile reset\n" );
+		return;
+	}
+
+	if ( !g_entityProfile.integer ) {
+		g_trap->Print( "Entity profiling is disabled, set g_entityProfile 1 to enable it\n" );
+	}
+
+	if ( !Q_stricmp( cmd, "runs" ) ) {
+		G_PrintProfileRuns();
+	}
+	else if ( !Q_stricmp( cmd, "classes" ) ) {
+		G_PrintProfileClasses( count );
+	}
+	else if ( !Q_stricmp( cmd, "thinks" ) ) {
+		G_PrintProfileThinks( count );
+	}
+	else if ( !cmd[0] ) {
+		G_PrintProfileRuns();
+		g_trap->Print( "\n" );
+		G_PrintProfileClasses( count );
+		g_trap->Print( "\n" );
+		G_PrintProfileThinks( count );
+	}
+	else {
+		g_trap->Print( "usage: entityprofile [runs|classes|thinks|reset] [count]\n" );
+	}
+}
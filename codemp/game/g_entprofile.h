@@ -0,0 +1,80 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// g_entprofile.h -- where G_RunFrame spends its time, for g_entityProfile
+//
+// G_RunFrame runs its entity loop as G_RunEntities< true > while profiling and
+// G_RunEntities< false > otherwise, so the unprofiled loop has no timing code
+// in it at all.
+
+#pragma once
+
+#include "g_local.h"
+
+typedef enum entityRun_e {
+	ENTRUN_THINK,
+	ENTRUN_MISSILE,
+	ENTRUN_MOVER,
+	ENTRUN_ITEM,
+	ENTRUN_CLIENT,
+	ENTRUN_MAX
+} entityRun_t;
+
+typedef void (*entityThink_t)( gentity_t *self );
+
+// classname and think are taken before the run, it can free the entity
+void G_ProfileEntityRun( entityRun_t run, const char *classname, entityThink_t think, int64_t usec );
+
+// Called once a frame, for the CSV dumps.
+void G_EntityProfileFrame( void );
+void G_ShutdownEntityProfile( void );
+
+void Svcmd_EntityProfile_f( void );
+
+/*
+=============
+G_ProfiledRun
+
+Runs func on ent, timing it if profile is set.  profile is a template argument
+so the test is resolved at compile time.
+=============
+*/
+template< bool profile >
+static inline void G_ProfiledRun( entityRun_t run, gentity_t *ent, void (*func)( gentity_t *ent ) ) {
+	const char		*classname;
+	entityThink_t	think = NULL;
+	int64_t			start;
+
+	if ( !profile ) {
+		func( ent );
+		return;
+	}
+
+	// missiles, items and movers call G_RunThink as part of their run, so
+	// theirs are counted under the think as well, clients don't think here
+	classname = ent->classname;
+	if ( run != ENTRUN_CLIENT && ent->nextthink > 0 && ent->nextthink <= level.time ) {
+		think = ent->think;
+	}
+
+	start = g_trap->ext.Microseconds();
+	func( ent );
+	G_ProfileEntityRun( run, classname, think, g_trap->ext.Microseconds() - start );
+}
@@ -200,7 +200,7 @@ void G_RunExPhys(gentity_t *ent, float gravity, float mass, float bounce, qboole
 		if (autoKill)
 		{
 			ent->think = G_FreeEntity;
-			ent->nextthink = level.time;
+			G_SetNextThink( ent, level.time );
 		}
 		return;
 	}
@@ -130,7 +130,7 @@ static qhandle_t	shieldDamageSound=0;
 void ShieldRemove(gentity_t *self)
 {
 	self->think = G_FreeEntity;
-	self->nextthink = level.time + 100;
+	G_SetNextThink( self, level.time + 100 );
 
 	// Play kill sound...
 	G_AddEvent(self, EV_GENERAL_SOUND, shieldDeactivateSound);
@@ -154,7 +154,7 @@ void ShieldThink(gentity_t *self)
 	{
 		self->health -= SHIELD_HEALTH_DEC;
 	}
-	self->nextthink = level.time + 1000;
+	G_SetNextThink( self, level.time + 1000 );
 	if (self->health <= 0)
 	{
 		ShieldRemove(self);
@@ -178,7 +178,7 @@ void ShieldPain(gentity_t *self, gentity_t *attacker, int damage)
 {
 	// Set the itemplaceholder flag to indicate the the shield drawing that the shield pain should be drawn.
 	self->think = ShieldThink;
-	self->nextthink = level.time + 400;
+	G_SetNextThink( self, level.time + 400 );
 
 	// Play damaging sound...
 	G_AddEvent(self, EV_GENERAL_SOUND, shieldDamageSound);
@@ -205,7 +205,7 @@ void ShieldGoSolid(gentity_t *self)
 	g_trap->Trace (&tr, self->r.currentOrigin, self->r.mins, self->r.maxs, self->r.currentOrigin, self->s.number, CONTENTS_BODY, qfalse, 0, 0 );
 	if(tr.startsolid)
 	{	// gah, we can't activate yet
-		self->nextthink = level.time + 200;
+		G_SetNextThink( self, level.time + 200 );
 		self->think = ShieldGoSolid;
 		g_trap->LinkEntity((sharedEntity_t *)self);
 	}
@@ -214,7 +214,7 @@ void ShieldGoSolid(gentity_t *self)
 		self->s.eFlags &= ~EF_NODRAW;
 
 		self->r.contents = CONTENTS_SOLID;
-		self->nextthink = level.time + 1000;
+		G_SetNextThink( self, level.time + 1000 );
 		self->think = ShieldThink;
 		self->takedamage = qtrue;
 		g_trap->LinkEntity((sharedEntity_t *)self);
@@ -236,7 +236,7 @@ void ShieldGoNotSolid(gentity_t *self)
 	self->r.contents = 0;
 	self->s.eFlags |= EF_NODRAW;
 	// nextthink needs to have a large enough interval to avoid excess accumulation of Activate messages
-	self->nextthink = level.time + 200;
+	G_SetNextThink( self, level.time + 200 );
 	self->think = ShieldGoSolid;
 	self->takedamage = qfalse;
 	g_trap->LinkEntity((sharedEntity_t *)self);
@@ -375,7 +375,7 @@ void CreateShield(gentity_t *ent)
 		ent->r.contents = 0;
 		ent->s.eFlags |= EF_NODRAW;
 		// nextthink needs to have a large enough interval to avoid excess accumulation of Activate messages
-		ent->nextthink = level.time + 200;
+		G_SetNextThink( ent, level.time + 200 );
 		ent->think = ShieldGoSolid;
 		ent->takedamage = qfalse;
 		g_trap->LinkEntity((sharedEntity_t *)ent);
@@ -384,7 +384,7 @@ void CreateShield(gentity_t *ent)
 	{	// Get solid.
 		ent->r.contents = CONTENTS_PLAYERCLIP|CONTENTS_SHOTCLIP;//CONTENTS_SOLID;
 
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		ent->think = ShieldThink;
 
 		ent->takedamage = qtrue;
@@ -446,7 +446,7 @@ qboolean PlaceShield(gentity_t *playerent)
 				shield->s.angles[YAW] = 90;
 			}
 			shield->think = CreateShield;
-			shield->nextthink = level.time + 500;	// power up after .5 seconds
+			G_SetNextThink( shield, level.time + 500 );	// power up after .5 seconds
 			shield->parent = playerent;
 
 			// Set team number.
@@ -781,7 +781,7 @@ void pas_think( gentity_t *ent )
 	{
 		ent->r.contents = 0;
 		ent->s.fireflag = 0;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( ent, level.time + FRAMETIME );
 		return;
 	}
 	else
@@ -793,7 +793,7 @@ void pas_think( gentity_t *ent )
 		g_entities[ent->genericValue3].client->sess.sessionTeam != ent->genericValue2)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -802,7 +802,7 @@ void pas_think( gentity_t *ent )
 	if ( !ent->damage )
 	{
 		ent->damage = 1;
-		ent->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( ent, level.time + FRAMETIME );
 		return;
 	}
 
@@ -813,11 +813,11 @@ void pas_think( gentity_t *ent )
 		ent->s.fireflag = 2;
 
 		ent->think = sentryExpire;
-		ent->nextthink = level.time + TURRET_DEATH_DELAY;
+		G_SetNextThink( ent, level.time + TURRET_DEATH_DELAY );
 		return;
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 
 	if ( ent->enemy )
 	{
@@ -951,7 +951,7 @@ void pas_think( gentity_t *ent )
 			ent->s.fireflag = 2;
 
 			ent->think = sentryExpire;
-			ent->nextthink = level.time + TURRET_DEATH_DELAY;
+			G_SetNextThink( ent, level.time + TURRET_DEATH_DELAY );
 		}
 	}
 	else
@@ -1032,7 +1032,7 @@ void SP_PAS( gentity_t *base )
 	G_RunObject(base);
 
 	base->think = pas_think;
-	base->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( base, level.time + FRAMETIME );
 
 	if ( !base->health )
 	{
@@ -1103,7 +1103,7 @@ void ItemUse_Sentry( gentity_t *ent )
 	sentry->s.pos.trType = TR_GRAVITY;//STATIONARY;
 	sentry->s.pos.trTime = level.time;
 	sentry->touch = SentryTouch;
-	sentry->nextthink = level.time;
+	G_SetNextThink( sentry, level.time );
 	sentry->genericValue4 = ENTITYNUM_NONE; //genericValue4 used as enemy index
 
 	sentry->genericValue5 = 1000;
@@ -1321,13 +1321,13 @@ void SpecialItemThink(gentity_t *ent)
 	if (ent->genericValue5 < level.time)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
 	G_RunExPhys(ent, gravity, mass, bounce, qfalse, NULL, 0);
 	VectorCopy(ent->r.currentOrigin, ent->s.origin);
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 }
 
 void G_SpecialSpawnItem(gentity_t *ent, gitem_t *item)
@@ -1338,7 +1338,7 @@ void G_SpecialSpawnItem(gentity_t *ent, gitem_t *item)
 	//go away if no one wants me
 	ent->genericValue5 = level.time + TOSSED_ITEM_STAY_PERIOD;
 	ent->think = SpecialItemThink;
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 	ent->clipmask = MASK_SOLID;
 
 	ent->physicsBounce = 0.50;		// items are bouncy
@@ -1465,7 +1465,7 @@ void EWebDisattach(gentity_t *owner, gentity_t *eweb)
 		owner->client->ps.stats[STAT_WEAPONS] = 0;
 	}
 	eweb->think = G_FreeEntity;
-	eweb->nextthink = level.time;
+	G_SetNextThink( eweb, level.time );
 }
 
 //precache misc e-web assets
@@ -1879,7 +1879,7 @@ void EWebThink(gentity_t *self)
 	//run some physics on it real quick so it falls and stuff properly
 	G_RunExPhys(self, gravity, mass, bounce, qfalse, NULL, 0);
 
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 
 #define EWEB_HEALTH			200
@@ -1961,7 +1961,7 @@ gentity_t *EWeb_Create(gentity_t *spawner)
 	ent->pain = EWebPain;
 
 	ent->think = EWebThink;
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 
 	//set up the g2 model info
 	ent->s.modelGhoul2 = 1;
@@ -2366,7 +2366,7 @@ void RespawnItem( gentity_t *ent ) {
 	// play the normal respawn sound only to nearby clients
 	G_AddEvent( ent, EV_ITEM_RESPAWN, 0 );
 
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 }
 
 qboolean CheckItemCanBePickedUpByNPC( gentity_t *item, gentity_t *pickerupper )
@@ -2663,7 +2663,7 @@ void Touch_Item (gentity_t *ent, gentity_t *other, trace_t *trace) {
 	if (ent->genericValue9)
 	{ //dropped item, should be removed when picked up
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -2672,10 +2672,10 @@ void Touch_Item (gentity_t *ent, gentity_t *other, trace_t *trace) {
 	// delete it).  This is used by items that are respawned by third party
 	// events such as ctf flags
 	if ( respawn <= 0 ) {
-		ent->nextthink = 0;
+		G_SetNextThink( ent, 0 );
 		ent->think = 0;
 	} else {
-		ent->nextthink = level.time + respawn * 1000;
+		G_SetNextThink( ent, level.time + respawn * 1000 );
 		ent->think = RespawnItem;
 	}
 	g_trap->LinkEntity( (sharedEntity_t *)ent );
@@ -2721,7 +2721,7 @@ gentity_t *LaunchItem( gitem_t *item, vec3_t origin, vec3_t velocity ) {
 	dropped->flags |= FL_BOUNCE_HALF;
 	if ((level.gametype == GT_CTF || level.gametype == GT_CTY) && item->giType == IT_TEAM) { // Special case for CTF flags
 		dropped->think = Team_DroppedFlagThink;
-		dropped->nextthink = level.time + 30000;
+		G_SetNextThink( dropped, level.time + 30000 );
 		Team_CheckDroppedItem( dropped );
 
 		//rww - so bots know
@@ -2735,7 +2735,7 @@ gentity_t *LaunchItem( gitem_t *item, vec3_t origin, vec3_t velocity ) {
 		}
 	} else { // auto-remove after 30 seconds
 		dropped->think = G_FreeEntity;
-		dropped->nextthink = level.time + 30000;
+		G_SetNextThink( dropped, level.time + 30000 );
 	}
 
 	dropped->flags = FL_DROPPED_ITEM;
@@ -2989,7 +2989,7 @@ void FinishSpawningItem( gentity_t *ent ) {
 		respawn = 45 + Q_flrand(-1.0f, 1.0f) * 15;
 		ent->s.eFlags |= EF_NODRAW;
 		ent->r.contents = 0;
-		ent->nextthink = level.time + respawn * 1000;
+		G_SetNextThink( ent, level.time + respawn * 1000 );
 		ent->think = RespawnItem;
 		return;
 	}
@@ -3145,7 +3145,7 @@ void G_SpawnItem (gentity_t *ent, gitem_t *item) {
 	ent->item = item;
 	// some movers spawn on the second frame, so delay item
 	// spawns until the third frame so they can ride trains
-	ent->nextthink = level.time + FRAMETIME * 2;
+	G_SetNextThink( ent, level.time + FRAMETIME * 2 );
 	ent->think = FinishSpawningItem;
 
 	ent->physicsBounce = 0.50;		// items are bouncy
@@ -326,7 +326,7 @@ struct gentity_s {
 	int			setTime;
 
 //Think Functions
-	int			nextthink;
+	int			nextthink;		// set with G_SetNextThink, so a sleeping entity is woken in time
 	void		(*think)(gentity_t *self);
 	void		(*reached)(gentity_t *self);	// movers call this when hitting endpoint
 	void		(*blocked)(gentity_t *self, gentity_t *other);
@@ -579,6 +579,8 @@ typedef struct renderInfo_s
 	int			footLBolt;
 	int			motionBolt;
 
+	bgPlayerBones_t	playerBones;	// spine and head bone numbers for BG_G2PlayerAngles
+
 	int			boltValidityTime;
 } renderInfo_t;
 
@@ -1074,6 +1076,7 @@ void SaveRegisteredItems( void );
 //
 // g_utils.c
 //
+void	G_ClearConfigstringIndex( void );
 int		G_ModelIndex( const char *name );
 int		G_SoundIndex( const char *name );
 int		G_SoundSetIndex(const char *name);
@@ -1086,7 +1089,20 @@ qboolean	G_PlayerHasCustomSkeleton(gentity_t *ent);
 void	G_TeamCommand( team_t team, char *cmd );
 void	G_ScaleNetHealth(gentity_t *self);
 void	G_KillBox (gentity_t *ent);
+// fields G_Find looks up through a hash index instead of a scan
+typedef enum entIndexField_e {
+	ENTINDEX_CLASSNAME,
+	ENTINDEX_TARGETNAME,
+	ENTINDEX_TARGET,
+	ENTINDEX_SCRIPT_TARGETNAME,
+	ENTINDEX_MAX
+} entIndexField_t;
+
 gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match);
+gentity_t *G_FindIndexed( gentity_t *from, entIndexField_t field, const char *match );
+void	G_UpdateEntityIndex( gentity_t *ent );
+void	G_ClearEntityIndex( void );
+void	G_EntityIndexFrame( void );
 int		G_RadiusList ( vec3_t origin, float radius,	gentity_t *ignore, qboolean takeDamage, gentity_t *ent_list[MAX_GENTITIES]);
 
 void	G_Throw( gentity_t *targ, vec3_t newDir, float push );
@@ -1198,6 +1214,8 @@ void G_RunExPhys(gentity_t *ent, float gravity, float mass, float bounce, qboole
 void G_ReflectMissile( gentity_t *ent, gentity_t *missile, vec3_t forward );
 
 void G_RunMissile( gentity_t *ent );
+void G_BeginMissileBench( int bolts, int msec );
+void G_MissileBenchFrame( int64_t usec );
 
 gentity_t *CreateMissile( vec3_t org, vec3_t dir, float vel, int life,
 							gentity_t *owner, qboolean altFire);
@@ -1301,6 +1319,7 @@ qboolean G_FilterPacket (char *from);
 void FireWeapon( gentity_t *ent, qboolean altFire );
 void BlowDetpacks(gentity_t *ent);
 void RemoveDetpacks(gentity_t *ent);
+void Svcmd_MissileBench_f( void );
 
 //
 // p_hud.c
@@ -1331,6 +1350,10 @@ void FindIntermissionPoint( void );
 void SetLeader(int team, int client);
 void CheckTeamLeader( int team );
 void G_RunThink (gentity_t *ent);
+void G_ClearThinkQueue( void );
+void G_WakeEntity( gentity_t *ent );
+void G_SetNextThink( gentity_t *ent, int time );
+void G_UnscheduleEntity( gentity_t *ent );
 void AddTournamentQueue(gclient_t *client);
 void QDECL G_LogPrintf( const char *fmt, ... );
 void QDECL G_SecurityLogPrintf( const char *fmt, ... );
@@ -28,6 +28,8 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "g_nav.h"
 #include "bg_saga.h"
 #include "b_local.h"
+#include "g_thinkqueue.h"
+#include "g_entprofile.h"
 
 level_locals_t	level;
 
@@ -114,6 +116,8 @@ void G_FindTeams( void ) {
 				if ( e2->targetname ) {
 					e->targetname = e2->targetname;
 					e2->targetname = NULL;
+					G_UpdateEntityIndex( e );
+					G_UpdateEntityIndex( e2 );
 				}
 			}
 		}
@@ -198,13 +202,16 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	g_trap->Print ("gamename: %s\n", GAMEVERSION);
 	g_trap->Print ("gamedate: %s\n", SOURCE_DATE);
 
+	// Q_irand and friends too, so a replay with the same seed plays out the same
 	srand( randomSeed );
+	Rand_Init( randomSeed );
 
 	G_RegisterCvars();
 
 	G_ProcessIPBans();
 
 	G_InitMemory();
+	G_ClearConfigstringIndex();
 
 	// set some level globals
 	memset( &level, 0, sizeof( level ) );
@@ -261,6 +268,8 @@ void G_InitGame( int levelTime, int randomSeed, int restart ) {
 	// initialize all entities for this game
 	memset( g_entities, 0, MAX_GENTITIES * sizeof(g_entities[0]) );
 	level.gentities = g_entities;
+	G_ClearEntityIndex();
+	G_ClearThinkQueue();
 
 	// initialize all clients for this game
 	level.maxclients = sv_maxclients->integer;
@@ -488,6 +497,7 @@ void G_ShutdownGame( int restart ) {
 	TAG_Init();	//Clear the reference tags
 
 	G_LogWeaponOutput();
+	G_ShutdownEntityProfile();
 
 	if ( level.logFile ) {
 		G_LogPrintf( "ShutdownGame:\n------------------------------------------------------------\n" );
@@ -2806,6 +2816,239 @@ void CheckCvars( void ) {
 	}
 }
 
+/*
+========================================================================
+
+THINK QUEUE
+
+Most entities spend most of their time waiting for their nextthink, or for
+nothing at all, so G_RunFrame only visits the ones that are awake and puts
+the rest to sleep until there is something for them to do.  Missiles, items,
+movers, clients and NPCs never sleep, and the others are still visited in
+ascending order, so everything runs in exactly the order a scan of every
+entity would run it in.
+
+Anything that gives a sleeping entity something to do has to wake it.
+G_SetNextThink and adding an event do that by themselves; the few places
+that turn an idle entity into one that has to be run every frame (a saber
+being thrown, a corpse being dropped, an ICARUS script being attached) call
+G_WakeEntity.  d_thinkQueue 1 checks every sleeping entity at the end of
+each frame and complains about any that should have been woken.
+
+========================================================================
+*/
+
+void ClearNPCGlobals( void );
+
+static_assert( THINKQUEUE_MAX_ENTITIES >= MAX_GENTITIES, "think queue is too small" );
+
+static thinkQueue_t thinkQueue;
+static qboolean entTaskManager[MAX_GENTITIES];	// ICARUS has to be maintained every frame
+
+/*
+=============
+G_SetNextThink
+
+Sets when the entity thinks next, and has the think queue wake it then.
+Write nextthink through this, never directly.
+=============
+*/
+void G_SetNextThink( gentity_t *ent, int time ) {
+	ent->nextthink = time;
+	if ( ent >= g_entities && ent < g_entities + MAX_GENTITIES ) {
+		ThinkQueue_WakeAt( &thinkQueue, ent - g_entities, time, level.time );
+	}
+}
+
+void G_ClearThinkQueue( void ) {
+	int i;
+
+	ThinkQueue_Clear( &thinkQueue );
+	memset( entTaskManager, 0, sizeof( entTaskManager ) );
+
+	// client slots are looked at every frame, in use or not
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		ThinkQueue_Wake( &thinkQueue, i );
+	}
+}
+
+void G_WakeEntity( gentity_t *ent ) {
+	ThinkQueue_Wake( &thinkQueue, ent - g_entities );
+}
+
+void G_UnscheduleEntity( gentity_t *ent ) {
+	int num = ent - g_entities;
+
+	if ( num >= MAX_CLIENTS ) {
+		ThinkQueue_Remove( &thinkQueue, num );
+	}
+	entTaskManager[num] = qfalse;
+}
+
+/*
+=============
+G_EntityWakeTime
+
+When ent next needs to be visited: -1 for every frame, 0 for only when it's
+woken, otherwise the level time it wakes at.
+=============
+*/
+static int G_EntityWakeTime( gentity_t *ent ) {
+	int wakeTime = 0;
+
+	if ( ent->freeAfterEvent || ent->unlinkAfterEvent || ent->physicsObject ) {
+		return -1;
+	}
+	if ( ent->s.eType == ET_MISSILE || ent->s.eType == ET_ITEM || ent->s.eType == ET_MOVER || ent->s.eType == ET_NPC ) {
+		return -1;
+	}
+	if ( ent->client || ent->NPC || entTaskManager[ent - g_entities] ) {
+		return -1;
+	}
+
+	if ( ent->nextthink > 0 ) {
+		if ( ent->nextthink <= level.time ) {
+			// due, but not run (unlinked and never freed)
+			return -1;
+		}
+		wakeTime = ent->nextthink;
+	}
+
+	if ( ent->s.event ) {
+		int eventExpires = ent->eventTime + EVENT_VALID_MSEC + 1;
+
+		if ( eventExpires <= level.time ) {
+			return -1;
+		}
+		if ( !wakeTime || eventExpires < wakeTime ) {
+			wakeTime = eventExpires;
+		}
+	}
+
+	return wakeTime;
+}
+
+/*
+=============
+G_SettleEntity
+
+Decides whether the entity G_RunFrame just visited can sleep.
+=============
+*/
+static void G_SettleEntity( int num ) {
+	gentity_t *ent = &g_entities[num];
+	int wakeTime;
+
+	if ( num < MAX_CLIENTS ) {
+		return;
+	}
+	if ( !ent->inuse ) {
+		ThinkQueue_Remove( &thinkQueue, num );
+		return;
+	}
+	if ( !g_thinkQueue.integer ) {
+		ThinkQueue_Wake( &thinkQueue, num );
+		return;
+	}
+
+	wakeTime = G_EntityWakeTime( ent );
+	if ( wakeTime >= 0 ) {
+		ThinkQueue_Sleep( &thinkQueue, num, wakeTime );
+	}
+}
+
+/*
+=============
+G_SkipSleepingEntities
+
+A visit to an idle entity doesn't do anything except clear the NPC globals, so
+do that if any of the skipped entities would have.
+=============
+*/
+static void G_SkipSleepingEntities( int first, int end ) {
+	int i;
+
+	if ( !NPCS.NPC && !NPCS.NPCInfo && !NPCS.client ) {
+		return;
+	}
+	if ( !ThinkQueue_AnyAsleep( &thinkQueue, first, end ) ) {
+		return;
+	}
+
+	for ( i = first; i < end; i++ ) {
+		gentity_t *ent = &g_entities[i];
+
+		if ( !ThinkQueue_IsAsleep( &thinkQueue, i ) || !ent->inuse ) {
+			continue;
+		}
+		if ( ent->freeAfterEvent || ( !ent->r.linked && ent->neverFree ) ) {
+			continue;
+		}
+		ClearNPCGlobals();
+		return;
+	}
+}
+
+/*
+=============
+G_NextEntityToRun
+
+Settles the entity that was just visited and returns the next one to visit,
+or -1 when the frame is done.  Pass -1 to start the frame.
+=============
+*/
+static int G_NextEntityToRun( int num ) {
+	int next;
+
+	if ( num < 0 ) {
+		ThinkQueue_BeginFrame( &thinkQueue, level.time );
+	} else {
+		G_SettleEntity( num );
+	}
+
+	if ( !g_thinkQueue.integer ) {
+		next = num + 1;
+		return next < level.num_entities ? next : -1;
+	}
+
+	next = ThinkQueue_Next( &thinkQueue, num, level.num_entities );
+	if ( g_allowNPC.integer ) {
+		G_SkipSleepingEntities( num + 1, next < 0 ? level.num_entities : next );
+	}
+	return next;
+}
+
+/*
+=============
+G_CheckThinkQueue
+
+Makes sure nothing is asleep that shouldn't be, for d_thinkQueue.
+=============
+*/
+static void G_CheckThinkQueue( void ) {
+	int i;
+
+	for ( i = MAX_CLIENTS; i < level.num_entities; i++ ) {
+		gentity_t *ent = &g_entities[i];
+		int wakeTime;
+
+		if ( !ThinkQueue_IsAsleep( &thinkQueue, i ) ) {
+			continue;
+		}
+		if ( !ent->inuse ) {
+			g_trap->Print( "WARNING: entity %i (%s) was freed while asleep\n", i, ent->classname );
+			ThinkQueue_Remove( &thinkQueue, i );
+			continue;
+		}
+
+		wakeTime = G_EntityWakeTime( ent );
+		if ( wakeTime < 0 || ( wakeTime > 0 && ( !thinkQueue.wakeTime[i] || thinkQueue.wakeTime[i] > wakeTime ) ) ) {
+			g_trap->Print( "WARNING: entity %i (%s) should not be asleep\n", i, ent->classname );
+			ThinkQueue_Wake( &thinkQueue, i );
+		}
+	}
+}
+
 /*
 =============
 G_RunThink
@@ -2824,7 +3067,7 @@ void G_RunThink (gentity_t *ent) {
 		goto runicarus;
 	}
 
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 	if (!ent->think) {
 		//g_trap->Error( ERR_DROP, "NULL ent->think");
 		goto runicarus;
@@ -2839,7 +3082,7 @@ runicarus:
 		{
 			SetNPCGlobals( ent );
 		}
-		g_trap->ICARUS_MaintainTaskManager(ent->s.number);
+		entTaskManager[ent->s.number] = g_trap->ICARUS_MaintainTaskManager(ent->s.number);
 		RestoreNPCGlobals();
 	}
 }
@@ -2887,13 +3130,6 @@ void NAV_CheckCalcPaths( void )
 	}
 }
 
-/*
-================
-G_RunFrame
-
-Advances the non-player objects in the world
-================
-*/
 void ClearNPCGlobals( void );
 void AI_UpdateGroups( void );
 void ClearPlayerAlertEvents( void );
@@ -2906,163 +3142,20 @@ qboolean G_PointInBounds( vec3_t point, vec3_t mins, vec3_t maxs );
 int g_siegeRespawnCheck = 0;
 void SetMoverState( gentity_t *ent, moverState_t moverState, int time );
 
-void G_RunFrame( int levelTime ) {
+/*
+================
+G_RunEntities
+
+Runs everything that's awake this frame, timing each run when profile is set
+================
+*/
+template< bool profile >
+static void G_RunEntities( void ) {
 	int			i;
 	gentity_t	*ent;
-#ifdef _G_FRAME_PERFANAL
-	int			iTimer_ItemRun = 0;
-	int			iTimer_ROFF = 0;
-	int			iTimer_ClientEndframe = 0;
-	int			iTimer_GameChecks = 0;
-	int			iTimer_Queues = 0;
-	void		*timer_ItemRun;
-	void		*timer_ROFF;
-	void		*timer_ClientEndframe;
-	void		*timer_GameChecks;
-	void		*timer_Queues;
-#endif
-
-	if (level.gametype == GT_SIEGE &&
-		g_siegeRespawn.integer &&
-		g_siegeRespawnCheck < level.time)
-	{ //check for a respawn wave
-		gentity_t *clEnt;
-		for ( i=0; i < MAX_CLIENTS; i++ )
-		{
-			clEnt = &g_entities[i];
-
-			if (clEnt->inuse && clEnt->client &&
-				clEnt->client->tempSpectate >= level.time &&
-				clEnt->client->sess.sessionTeam != TEAM_SPECTATOR)
-			{
-				ClientRespawn(clEnt);
-				clEnt->client->tempSpectate = 0;
-			}
-		}
-
-		g_siegeRespawnCheck = level.time + g_siegeRespawn.integer * 1000;
-	}
-
-	if (gDoSlowMoDuel)
-	{
-		if (level.restarted)
-		{
-			char buf[128];
-			float tFVal = 0;
-
-			g_trap->Cvar_VariableStringBuffer("timescale", buf, sizeof(buf));
-
-			tFVal = atof(buf);
-
-			g_trap->Cvar_Set("timescale", "1");
-			if (tFVal == 1.0f)
-			{
-				gDoSlowMoDuel = qfalse;
-			}
-		}
-		else
-		{
-			float timeDif = (level.time - gSlowMoDuelTime); //difference in time between when the slow motion was initiated and now
-			float useDif = 0; //the difference to use when actually setting the timescale
-
-			if (timeDif < 150)
-			{
-				g_trap->Cvar_Set("timescale", "0.1f");
-			}
-			else if (timeDif < 1150)
-			{
-				useDif = (timeDif/1000); //scale from 0.1 up to 1
-				if (useDif < 0.1f)
-				{
-					useDif = 0.1f;
-				}
-				if (useDif > 1.0f)
-				{
-					useDif = 1.0f;
-				}
-				g_trap->Cvar_Set("timescale", va("%f", useDif));
-			}
-			else
-			{
-				char buf[128];
-				float tFVal = 0;
-
-				g_trap->Cvar_VariableStringBuffer("timescale", buf, sizeof(buf));
-
-				tFVal = atof(buf);
-
-				g_trap->Cvar_Set("timescale", "1");
-				if (timeDif > 1500 && tFVal == 1.0f)
-				{
-					gDoSlowMoDuel = qfalse;
-				}
-			}
-		}
-	}
 
-	// if we are waiting for the level to restart, do nothing
-	if ( level.restarted ) {
-		return;
-	}
-
-	level.framenum++;
-	level.previousTime = level.time;
-	level.time = levelTime;
-
-	if (g_allowNPC.integer)
-	{
-		NAV_CheckCalcPaths();
-	}
-
-	AI_UpdateGroups();
-
-	if (g_allowNPC.integer)
-	{
-		if ( d_altRoutes.integer )
-		{
-			g_trap->Nav_CheckAllFailedEdges();
-		}
-		g_trap->Nav_ClearCheckedNodes();
-
-		//remember last waypoint, clear current one
-		for ( i = 0; i < level.num_entities ; i++)
-		{
-			ent = &g_entities[i];
-
-			if ( !ent->inuse )
-				continue;
-
-			if ( ent->waypoint != WAYPOINT_NONE
-				&& ent->noWaypointTime < level.time )
-			{
-				ent->lastWaypoint = ent->waypoint;
-				ent->waypoint = WAYPOINT_NONE;
-			}
-			if ( d_altRoutes.integer )
-			{
-				g_trap->Nav_CheckFailedNodes( (sharedEntity_t *)ent );
-			}
-		}
-
-		//Look to clear out old events
-		ClearPlayerAlertEvents();
-	}
-
-	g_TimeSinceLastFrame = (level.time - g_LastFrameTime);
-
-	// get any cvar changes
-	G_UpdateCvars();
-
-
-
-#ifdef _G_FRAME_PERFANAL
-	g_trap->PrecisionTimer_Start(&timer_ItemRun);
-#endif
-	//
-	// go through all allocated objects
-	//
-	ent = &g_entities[0];
-	for (i=0 ; i<level.num_entities ; i++, ent++) {
+	for ( i = G_NextEntityToRun( -1 ) ; i != -1 ; i = G_NextEntityToRun( i ) ) {
+		ent = &g_entities[i];
 		if ( !ent->inuse ) {
 			continue;
 		}
@@ -3109,7 +3202,7 @@ void G_RunFrame( int levelTime ) {
 		}
 
 		if ( ent->s.eType == ET_MISSILE ) {
-			G_RunMissile( ent );
+			G_ProfiledRun< profile >( ENTRUN_MISSILE, ent, G_RunMissile );
 			continue;
 		}
 
@@ -3128,13 +3221,13 @@ void G_RunFrame( int levelTime ) {
 				G_RunItem( ent );
 			}
 #else
-			G_RunItem( ent );
+			G_ProfiledRun< profile >( ENTRUN_ITEM, ent, G_RunItem );
 #endif
 			continue;
 		}
 
 		if ( ent->s.eType == ET_MOVER ) {
-			G_RunMover( ent );
+			G_ProfiledRun< profile >( ENTRUN_MOVER, ent, G_RunMover );
 			continue;
 		}
 
@@ -3317,7 +3410,7 @@ void G_RunFrame( int levelTime ) {
 
 			g_trap->ICARUS_MaintainTaskManager(ent->s.number);
 
-			G_RunClient( ent );
+			G_ProfiledRun< profile >( ENTRUN_CLIENT, ent, G_RunClient );
 			continue;
 		}
 		else if (ent->s.eType == ET_NPC)
@@ -3335,13 +3428,192 @@ void G_RunFrame( int levelTime ) {
 			WP_SaberStartMissileBlockCheck(ent, &ent->client->pers.cmd);
 		}
 
-		G_RunThink( ent );
+		G_ProfiledRun< profile >( ENTRUN_THINK, ent, G_RunThink );
 
 		if (g_allowNPC.integer)
 		{
 			ClearNPCGlobals();
 		}
 	}
+}
+
+/*
+================
+G_RunFrame
+
+Advances the non-player objects in the world
+================
+*/
+void G_RunFrame( int levelTime ) {
+	int			i;
+	gentity_t	*ent;
+	int64_t		frameStart;
+#ifdef _G_FRAME_PERFANAL
+	int			iTimer_ItemRun = 0;
+	int			iTimer_ROFF = 0;
+	int			iTimer_ClientEndframe = 0;
+	int			iTimer_GameChecks = 0;
+	int			iTimer_Queues = 0;
+	void		*timer_ItemRun;
+	void		*timer_ROFF;
+	void		*timer_ClientEndframe;
+	void		*timer_GameChecks;
+	void		*timer_Queues;
+#endif
+
+	// anything spawned before this frame has its names set by now
+	G_EntityIndexFrame();
+
+	if (level.gametype == GT_SIEGE &&
+		g_siegeRespawn.integer &&
+		g_siegeRespawnCheck < level.time)
+	{ //check for a respawn wave
+		gentity_t *clEnt;
+		for ( i=0; i < MAX_CLIENTS; i++ )
+		{
+			clEnt = &g_entities[i];
+
+			if (clEnt->inuse && clEnt->client &&
+				clEnt->client->tempSpectate >= level.time &&
+				clEnt->client->sess.sessionTeam != TEAM_SPECTATOR)
+			{
+				ClientRespawn(clEnt);
+				clEnt->client->tempSpectate = 0;
+			}
+		}
+
+		g_siegeRespawnCheck = level.time + g_siegeRespawn.integer * 1000;
+	}
+
+	if (gDoSlowMoDuel)
+	{
+		if (level.restarted)
+		{
+			char buf[128];
+			float tFVal = 0;
+
+			g_trap->Cvar_VariableStringBuffer("timescale", buf, sizeof(buf));
+
+			tFVal = atof(buf);
+
+			g_trap->Cvar_Set("timescale", "1");
+			if (tFVal == 1.0f)
+			{
+				gDoSlowMoDuel = qfalse;
+			}
+		}
+		else
+		{
+			float timeDif = (level.time - gSlowMoDuelTime); //difference in time between when the slow motion was initiated and now
+			float useDif = 0; //the difference to use when actually setting the timescale
+
+			if (timeDif < 150)
+			{
+				g_trap->Cvar_Set("timescale", "0.1f");
+			}
+			else if (timeDif < 1150)
+			{
+				useDif = (timeDif/1000); //scale from 0.1 up to 1
+				if (useDif < 0.1f)
+				{
+					useDif = 0.1f;
+				}
+				if (useDif > 1.0f)
+				{
+					useDif = 1.0f;
+				}
+				g_trap->Cvar_Set("timescale", va("%f", useDif));
+			}
+			else
+			{
+				char buf[128];
+				float tFVal = 0;
+
+				g_trap->Cvar_VariableStringBuffer("timescale", buf, sizeof(buf));
+
+				tFVal = atof(buf);
+
+				g_trap->Cvar_Set("timescale", "1");
+				if (timeDif > 1500 && tFVal == 1.0f)
+				{
+					gDoSlowMoDuel = qfalse;
+				}
+			}
+		}
+	}
+
+	// if we are waiting for the level to restart, do nothing
+	if ( level.restarted ) {
+		return;
+	}
+
+	level.framenum++;
+	level.previousTime = level.time;
+	level.time = levelTime;
+
+	if (g_allowNPC.integer)
+	{
+		NAV_CheckCalcPaths();
+	}
+
+	AI_UpdateGroups();
+
+	if (g_allowNPC.integer)
+	{
+		if ( d_altRoutes.integer )
+		{
+			g_trap->Nav_CheckAllFailedEdges();
+		}
+		g_trap->Nav_ClearCheckedNodes();
+
+		//remember last waypoint, clear current one
+		for ( i = 0; i < level.num_entities ; i++)
+		{
+			ent = &g_entities[i];
+
+			if ( !ent->inuse )
+				continue;
+
+			if ( ent->waypoint != WAYPOINT_NONE
+				&& ent->noWaypointTime < level.time )
+			{
+				ent->lastWaypoint = ent->waypoint;
+				ent->waypoint = WAYPOINT_NONE;
+			}
+			if ( d_altRoutes.integer )
+			{
+				g_trap->Nav_CheckFailedNodes( (sharedEntity_t *)ent );
+			}
+		}
+
+		//Look to clear out old events
+		ClearPlayerAlertEvents();
+	}
+
+	g_TimeSinceLastFrame = (level.time - g_LastFrameTime);
+
+	// get any cvar changes
+	G_UpdateCvars();
+
+
+
+#ifdef _G_FRAME_PERFANAL
+	g_trap->PrecisionTimer_Start(&timer_ItemRun);
+#endif
+	//
+	// go through all allocated objects that are awake
+	//
+	frameStart = g_trap->ext.Microseconds();
+	if ( g_entityProfile.integer ) {
+		G_RunEntities< true >();
+	} else {
+		G_RunEntities< false >();
+	}
+	G_MissileBenchFrame( g_trap->ext.Microseconds() - frameStart );
+	G_EntityProfileFrame();
+	if ( d_thinkQueue.integer ) {
+		G_CheckThinkQueue();
+	}
 #ifdef _G_FRAME_PERFANAL
 	iTimer_ItemRun = g_trap->PrecisionTimer_End(timer_ItemRun);
 #endif
@@ -559,7 +559,7 @@ void SP_misc_portal_surface(gentity_t *ent) {
 		VectorCopy( ent->s.origin, ent->s.origin2 );
 	} else {
 		ent->think = locateCamera;
-		ent->nextthink = level.time + 100;
+		G_SetNextThink( ent, level.time + 100 );
 	}
 }
 
@@ -714,7 +714,7 @@ void G_PortalifyEntities(gentity_t *ent)
 	}
 
 	ent->think = G_FreeEntity; //the portal entity is no longer needed because its information is stored in a config string.
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 }
 
 /*QUAKED misc_skyportal_orient (.6 .7 .7) (-8 -8 0) (8 8 16)
@@ -762,7 +762,7 @@ void SP_misc_skyportal (gentity_t *ent)
 	g_trap->SetConfigstring( CS_SKYBOXORG, va("%.2f %.2f %.2f %.1f %i %.2f %.2f %.2f %i %i", ent->s.origin[0], ent->s.origin[1], ent->s.origin[2], fov_x, (int)isfog, fogv[0], fogv[1], fogv[2], fogn, fogf ) );
 
 	ent->think = G_PortalifyEntities;
-	ent->nextthink = level.time + 1050; //give it some time first so that all other entities are spawned.
+	G_SetNextThink( ent, level.time + 1050 ); //give it some time first so that all other entities are spawned.
 }
 
 /*QUAKED misc_holocron (0 0 1) (-8 -8 -8) (8 8 8)
@@ -1033,7 +1033,7 @@ void HolocronThink(gentity_t *ent)
 	}
 
 justthink:
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 
 	if (ent->s.pos.trDelta[0] || ent->s.pos.trDelta[1] || ent->s.pos.trDelta[2])
 	{
@@ -1144,7 +1144,7 @@ void SP_misc_holocron(gentity_t *ent)
 	g_trap->LinkEntity((sharedEntity_t *)ent);
 
 	ent->think = HolocronThink;
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 }
 
 /*
@@ -1193,7 +1193,7 @@ void Use_Shooter( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 static void InitShooter_Finish( gentity_t *ent ) {
 	ent->enemy = G_PickTarget( ent->target );
 	ent->think = 0;
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 }
 
 void InitShooter( gentity_t *ent, int weapon ) {
@@ -1211,7 +1211,7 @@ void InitShooter( gentity_t *ent, int weapon ) {
 	// target might be a moving object, so we can't set movedir for it
 	if ( ent->target ) {
 		ent->think = InitShooter_Finish;
-		ent->nextthink = level.time + 500;
+		G_SetNextThink( ent, level.time + 500 );
 	}
 	g_trap->LinkEntity( (sharedEntity_t *)ent );
 }
@@ -1253,7 +1253,7 @@ void check_recharge(gentity_t *ent)
 		}
 	}
 	ent->s.health = ent->count; //the "health bar" is gonna be how full we are
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 }
 
 /*
@@ -1623,7 +1623,7 @@ void SP_misc_ammo_floor_unit(gentity_t *ent)
 	ent->s.teamowner = 0;
 	ent->s.owner = ENTITYNUM_NONE;
 
-	ent->nextthink = level.time + 200;// + STATION_RECHARGE_TIME;
+	G_SetNextThink( ent, level.time + 200 );// + STATION_RECHARGE_TIME;
 
 	ent->use = ammo_generic_power_converter_use;
 
@@ -1718,7 +1718,7 @@ void SP_misc_shield_floor_unit( gentity_t *ent )
 	ent->s.teamowner = 0;
 	ent->s.owner = ENTITYNUM_NONE;
 
-	ent->nextthink = level.time + 200;// + STATION_RECHARGE_TIME;
+	G_SetNextThink( ent, level.time + 200 );// + STATION_RECHARGE_TIME;
 
 	ent->use = shield_power_converter_use;
 
@@ -1772,7 +1772,7 @@ void SP_misc_model_shield_power_converter( gentity_t *ent )
 	ent->s.teamowner = 0;
 	ent->s.owner = ENTITYNUM_NONE;
 
-	ent->nextthink = level.time + 200;// + STATION_RECHARGE_TIME;
+	G_SetNextThink( ent, level.time + 200 );// + STATION_RECHARGE_TIME;
 
 	ent->use = shield_power_converter_use;
 
@@ -1942,7 +1942,7 @@ void SP_misc_model_ammo_power_converter( gentity_t *ent )
 	ent->s.teamowner = 0;
 	ent->s.owner = ENTITYNUM_NONE;
 
-	ent->nextthink = level.time + 200;// + STATION_RECHARGE_TIME;
+	G_SetNextThink( ent, level.time + 200 );// + STATION_RECHARGE_TIME;
 
 	G_SetOrigin( ent, ent->s.origin );
 	VectorCopy( ent->s.angles, ent->s.apos.trBase );
@@ -2056,7 +2056,7 @@ void SP_misc_model_health_power_converter( gentity_t *ent )
 	ent->s.teamowner = 0;
 	ent->s.owner = ENTITYNUM_NONE;
 
-	ent->nextthink = level.time + 200;// + STATION_RECHARGE_TIME;
+	G_SetNextThink( ent, level.time + 200 );// + STATION_RECHARGE_TIME;
 
 	G_SetOrigin( ent, ent->s.origin );
 	VectorCopy( ent->s.angles, ent->s.apos.trBase );
@@ -2116,12 +2116,12 @@ void DmgBoxUpdateSelf(gentity_t *self)
 
 	g_trap->LinkEntity((sharedEntity_t *)self);
 
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 	return;
 
 killMe:
 	self->think = G_FreeEntity;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 
 void DmgBoxAbsorb_Die( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int damage, int mod )
@@ -2164,7 +2164,7 @@ gentity_t *CreateNewDamageBox( gentity_t *ent )
 	dmgBox->die = DmgBoxAbsorb_Die;
 
 	dmgBox->think = DmgBoxUpdateSelf;
-	dmgBox->nextthink = level.time + 50;
+	G_SetNextThink( dmgBox, level.time + 50 );
 
 	return dmgBox;
 }
@@ -2332,7 +2332,7 @@ void fx_runner_think( gentity_t *ent )
 	VectorCopy(ent->r.currentAngles, ent->s.angles);
 	VectorCopy(ent->r.currentOrigin, ent->s.origin);
 
-	ent->nextthink = level.time + ent->delay + Q_flrand(0.0f, 1.0f) * ent->random;
+	G_SetNextThink( ent, level.time + ent->delay + Q_flrand(0.0f, 1.0f) * ent->random );
 
 	if ( ent->spawnflags & 4 ) // damage
 	{
@@ -2372,7 +2372,7 @@ void fx_runner_use( gentity_t *self, gentity_t *other, gentity_t *activator )
 		int		saveState = self->s.modelindex2 + 1;
 
 		fx_runner_think( self );
-		self->nextthink = -1;
+		G_SetNextThink( self, -1 );
 		// one shot indicator
 		self->s.modelindex2 = saveState;
 		if (self->s.modelindex2 > FX_STATE_ONE_SHOT_LIMIT)
@@ -2415,7 +2415,7 @@ void fx_runner_use( gentity_t *self, gentity_t *other, gentity_t *activator )
 		else
 		{
 			// turn off for now
-			self->nextthink = -1;
+			G_SetNextThink( self, -1 );
 
 			// turn off fx on client
 			self->s.modelindex2 = FX_STATE_OFF;
@@ -2477,7 +2477,7 @@ void fx_runner_link( gentity_t *ent )
 	if ( ent->spawnflags & 1 || ent->spawnflags & 2 ) // STARTOFF || ONESHOT
 	{
 		// We won't even consider thinking until we are used
-		ent->nextthink = -1;
+		G_SetNextThink( ent, -1 );
 	}
 	else
 	{
@@ -2490,7 +2490,7 @@ void fx_runner_link( gentity_t *ent )
 
 		// Let's get to work right now!
 		ent->think = fx_runner_think;
-		ent->nextthink = level.time + 200; // wait a small bit, then start working
+		G_SetNextThink( ent, level.time + 200 ); // wait a small bit, then start working
 	}
 
 	// make us useable if we can be targeted
@@ -2537,7 +2537,7 @@ void SP_fx_runner( gentity_t *ent )
 
 	// Give us a bit of time to spawn in the other entities, since we may have to target one of 'em
 	ent->think = fx_runner_link;
-	ent->nextthink = level.time + 400;
+	G_SetNextThink( ent, level.time + 400 );
 
 	// Save our position and link us up!
 	G_SetOrigin( ent, ent->s.origin );
@@ -2807,7 +2807,7 @@ void SP_misc_maglock ( gentity_t *self )
 
 	self->think = maglock_link;
 	//FIXME: for some reason, when you re-load a level, these fail to find their doors...?  Random?  Testing an additional 200ms after the START_TIME_FIND_LINKS
-	self->nextthink = level.time + START_TIME_FIND_LINKS+200;//START_TIME_FIND_LINKS;//because we need to let the doors link up and spawn their triggers first!
+	G_SetNextThink( self, level.time + START_TIME_FIND_LINKS+200 );//START_TIME_FIND_LINKS;//because we need to let the doors link up and spawn their triggers first!
 }
 void maglock_link( gentity_t *self )
 {
@@ -2831,7 +2831,7 @@ void maglock_link( gentity_t *self )
 	if ( trace.fraction == 1.0 )
 	{
 		self->think = maglock_link;
-		self->nextthink = level.time + 100;
+		G_SetNextThink( self, level.time + 100 );
 		/*
 		Com_Error( ERR_DROP,"misc_maglock at %s pointed at no surface\n", vtos(self->s.origin) );
 		G_FreeEntity( self );
@@ -2842,7 +2842,7 @@ void maglock_link( gentity_t *self )
 	if ( trace.entityNum >= ENTITYNUM_WORLD || !traceEnt || Q_stricmp( "func_door", traceEnt->classname ) )
 	{
 		self->think = maglock_link;
-		self->nextthink = level.time + 100;
+		G_SetNextThink( self, level.time + 100 );
 		//Com_Error( ERR_DROP,"misc_maglock at %s not pointed at a door\n", vtos(self->s.origin) );
 		//G_FreeEntity( self );
 		return;
@@ -2917,7 +2917,7 @@ void faller_think(gentity_t *ent)
 	if (ent->genericValue6 < level.time)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -2936,7 +2936,7 @@ void faller_think(gentity_t *ent)
 
 	G_RunExPhys(ent, gravity, mass, bounce, qtrue, NULL, 0);
 	VectorScale(ent->epVelocity, 10.0f, ent->s.pos.trDelta);
-	ent->nextthink = level.time + 25;
+	G_SetNextThink( ent, level.time + 25 );
 }
 
 void misc_faller_create( gentity_t *ent, gentity_t *other, gentity_t *activator )
@@ -2970,7 +2970,7 @@ void misc_faller_create( gentity_t *ent, gentity_t *other, gentity_t *activator
 	faller->s.eFlags = (EF_RAG|EF_CLIENTSMOOTH);
 
 	faller->think = faller_think;
-	faller->nextthink = level.time;
+	G_SetNextThink( faller, level.time );
 
 	faller->touch = faller_touch;
 
@@ -2983,7 +2983,7 @@ void misc_faller_create( gentity_t *ent, gentity_t *other, gentity_t *activator
 void misc_faller_think(gentity_t *ent)
 {
 	misc_faller_create(ent, ent, ent);
-	ent->nextthink = level.time + ent->genericValue1 + Q_irand(0, ent->genericValue2);
+	G_SetNextThink( ent, level.time + ent->genericValue1 + Q_irand(0, ent->genericValue2) );
 }
 
 /*QUAKED misc_faller (1 0 0) (-8 -8 -8) (8 8 8)
@@ -3009,7 +3009,7 @@ void SP_misc_faller(gentity_t *ent)
 	if (!ent->targetname || !ent->targetname[0])
 	{
 		ent->think = misc_faller_think;
-		ent->nextthink = level.time + ent->genericValue1 + Q_irand(0, ent->genericValue2);
+		G_SetNextThink( ent, level.time + ent->genericValue1 + Q_irand(0, ent->genericValue2) );
 	}
 	else
 	{
@@ -3454,7 +3454,7 @@ void SP_reference_tag ( gentity_t *ent )
 	{
 		//Init cannot occur until all entities have been spawned
 		ent->think = ref_link;
-		ent->nextthink = level.time + START_TIME_LINK_ENTS;
+		G_SetNextThink( ent, level.time + START_TIME_LINK_ENTS );
 	}
 	else
 	{
@@ -3545,7 +3545,7 @@ void misc_weapon_shooter_fire( gentity_t *self )
 	if ( (self->spawnflags&2) )
 	{//repeat
 		self->think = misc_weapon_shooter_fire;
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink( self, level.time + self->wait );
 	}
 }
 
@@ -3556,9 +3556,9 @@ void misc_weapon_shooter_use ( gentity_t *self, gentity_t *other, gentity_t *act
 		/*
 		G_FreeClientForShooter(self->client);
 		self->think = G_FreeEntity;
-		self->nextthink = level.time;
+		G_SetNextThink( self, level.time );
 		*/
-		self->nextthink = 0;
+		G_SetNextThink( self, 0 );
 		return;
 	}
 	//otherwise, fire
@@ -3579,7 +3579,7 @@ void misc_weapon_shooter_aim( gentity_t *self )
 			vectoangles( self->pos1, self->client->ps.viewangles );
 			SetClientViewAngle( self, self->client->ps.viewangles );
 			//FIXME: don't keep doing this unless target is a moving target?
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( self, level.time + FRAMETIME );
 		}
 		else
 		{
@@ -3617,7 +3617,7 @@ void SP_misc_weapon_shooter( gentity_t *self )
 	if ( self->target )
 	{
         self->think = misc_weapon_shooter_aim;
-		self->nextthink = level.time + START_TIME_LINK_ENTS;
+		G_SetNextThink( self, level.time + START_TIME_LINK_ENTS );
 	}
 	else
 	{//just set aim angles
@@ -96,7 +96,7 @@ void G_ReflectMissile( gentity_t *ent, gentity_t *missile, vec3_t forward )
 	if ( missile->s.weapon == WP_ROCKET_LAUNCHER )
 	{//stop homing
 		missile->think = 0;
-		missile->nextthink = 0;
+		G_SetNextThink( missile, 0 );
 	}
 }
 
@@ -141,7 +141,7 @@ void G_DeflectMissile( gentity_t *ent, gentity_t *missile, vec3_t forward )
 	if ( missile->s.weapon == WP_ROCKET_LAUNCHER )
 	{//stop homing
 		missile->think = 0;
-		missile->nextthink = 0;
+		G_SetNextThink( missile, 0 );
 	}
 }
 
@@ -172,7 +172,7 @@ void G_BounceMissile( gentity_t *ent, trace_t *trace ) {
 		if ( trace->plane.normal[2] > 0.7 && ent->s.pos.trDelta[2] < 40 ) //this can happen even on very slightly sloped walls, so changed it from > 0 to > 0.7
 		{
 			G_SetOrigin( ent, trace->endpos );
-			ent->nextthink = level.time + 100;
+			G_SetNextThink( ent, level.time + 100 );
 			return;
 		}
 	}
@@ -302,7 +302,7 @@ gentity_t *CreateMissile( vec3_t org, vec3_t dir, float vel, int life,
 
 	missile = G_Spawn();
 
-	missile->nextthink = level.time + life;
+	G_SetNextThink( missile, level.time + life );
 	missile->think = G_FreeEntity;
 	missile->s.eType = ET_MISSILE;
 	missile->r.svFlags = SVF_USE_CURRENT_ORIGIN;
@@ -807,6 +807,233 @@ killProj:
 	g_trap->LinkEntity( (sharedEntity_t *)ent );
 }
 
+/*
+=======================================================================
+
+MISSILE SWEEPS
+
+Most missiles fly in a straight line until they hit something, but a
+full trace every frame checks the world all over again each time.  Once
+a missile has kept the same trajectory for a frame, the next second or
+so of its flight is traced against the world in one go.  After that, a
+frame's move that ends short of the world impact only has to be checked
+against entities, and when the area tree has none near the move there
+is nothing the full trace could hit.
+
+Missiles that change course every frame (homing rockets) never get a
+sweep, they'd only pay for longer traces.  The world trace uses a box
+one unit bigger than the missile, so moves that land slightly off the
+traced line are still inside it.
+
+=======================================================================
+*/
+
+#define MISSILE_SWEEP_MSEC		(1000)
+#define MISSILE_SWEEP_MIN		(256.0f)
+#define MISSILE_SWEEP_MAX		(16384.0f)
+#define MISSILE_SWEEP_MARGIN	(2.0f)
+
+typedef struct missileSweep_s {
+	// what the sweep was traced for, the world doesn't move so nothing else matters
+	int			trType;
+	int			trTime;
+	vec3_t		trBase;
+	vec3_t		trDelta;
+	vec3_t		mins, maxs;
+	int			clipmask;
+
+	vec3_t		dir;
+	float		startDist, clearDist;	// along dir from trBase, clearDist < startDist if there's no sweep yet
+	qboolean	open;					// nothing was hit, it can be carried on from clearDist
+} missileSweep_t;
+
+static missileSweep_t missileSweeps[MAX_GENTITIES];
+
+static struct {
+	int			sweeps;			// moves that skipped the trace
+	int			traces;			// moves that needed it
+
+	// missilebench
+	int			endTime;
+	int			bolts;
+	int			frames;
+	int64_t		usec;
+	int64_t		maxUsec;
+} missileStats;
+
+static qboolean G_MissileSweepMatches( const missileSweep_t *sweep, const gentity_t *ent ) {
+	return (qboolean)( sweep->trType == ent->s.pos.trType && sweep->trTime == ent->s.pos.trTime
+		&& VectorCompare( sweep->trBase, ent->s.pos.trBase ) && VectorCompare( sweep->trDelta, ent->s.pos.trDelta )
+		&& VectorCompare( sweep->mins, ent->r.mins ) && VectorCompare( sweep->maxs, ent->r.maxs )
+		&& sweep->clipmask == ent->clipmask );
+}
+
+// Starts over for a new trajectory, the sweep waits until it's kept for a frame.
+static void G_ResetMissileSweep( missileSweep_t *sweep, const gentity_t *ent ) {
+	sweep->trType = ent->s.pos.trType;
+	sweep->trTime = ent->s.pos.trTime;
+	VectorCopy( ent->s.pos.trBase, sweep->trBase );
+	VectorCopy( ent->s.pos.trDelta, sweep->trDelta );
+	VectorCopy( ent->r.mins, sweep->mins );
+	VectorCopy( ent->r.maxs, sweep->maxs );
+	sweep->clipmask = ent->clipmask;
+
+	VectorCopy( ent->s.pos.trDelta, sweep->dir );
+	VectorNormalize( sweep->dir );
+	sweep->startDist = 0;
+	sweep->clearDist = -1;
+	sweep->open = qtrue;
+}
+
+static float G_MissileSweepDist( const missileSweep_t *sweep, const vec3_t point ) {
+	vec3_t delta;
+
+	VectorSubtract( point, sweep->trBase, delta );
+	return DotProduct( delta, sweep->dir );
+}
+
+static void G_TraceMissileSweep( missileSweep_t *sweep, float from ) {
+	vec3_t	mins, maxs, start, end;
+	trace_t	tr;
+	float	length;
+	int		i;
+
+	sweep->startDist = from;
+	sweep->clearDist = -1;
+	sweep->open = qfalse;
+
+	length = VectorLength( sweep->trDelta ) * MISSILE_SWEEP_MSEC * 0.001f;
+	if ( length <= 0 ) {
+		return;
+	}
+	length = Com_Clamp( MISSILE_SWEEP_MIN, MISSILE_SWEEP_MAX, length );
+
+	for ( i = 0; i < 3; i++ ) {
+		mins[i] = sweep->mins[i] - 1;
+		maxs[i] = sweep->maxs[i] + 1;
+	}
+	VectorMA( sweep->trBase, from, sweep->dir, start );
+	VectorMA( start, length, sweep->dir, end );
+	g_trap->ext.TraceWorld( &tr, start, mins, maxs, end, sweep->clipmask );
+	if ( tr.startsolid || tr.allsolid ) {
+		return;
+	}
+
+	sweep->clearDist = from + tr.fraction * length - MISSILE_SWEEP_MARGIN;
+	sweep->open = (qboolean)( tr.fraction == 1.0f );
+}
+
+// Whether point is on the swept line somewhere the world is known to be clear.
+static qboolean G_PointInMissileSweep( const missileSweep_t *sweep, const vec3_t point ) {
+	vec3_t	delta, off;
+	float	along;
+
+	VectorSubtract( point, sweep->trBase, delta );
+	along = DotProduct( delta, sweep->dir );
+	if ( along < sweep->startDist - 0.5f || along > sweep->clearDist ) {
+		return qfalse;
+	}
+	VectorMA( delta, -along, sweep->dir, off );
+	return (qboolean)( VectorLengthSquared( off ) < 0.25f );
+}
+
+/*
+================
+G_MissileSweepClear
+
+Whether the move from start to end can't hit anything, so G_RunMissile can
+skip the trace.  Anything that might be hit is left to the full trace.
+================
+*/
+static qboolean G_MissileSweepClear( gentity_t *ent, const vec3_t start, const vec3_t end, int passent ) {
+	static int		touch[MAX_GENTITIES];
+	missileSweep_t	*sweep = &missileSweeps[ent->s.number];
+	vec3_t			boxmins, boxmaxs;
+	int				i, num;
+
+	if ( !g_missileSweep.integer || ent->s.pos.trType != TR_LINEAR ) {
+		return qfalse;
+	}
+
+	if ( !G_MissileSweepMatches( sweep, ent ) ) {
+		G_ResetMissileSweep( sweep, ent );
+		return qfalse;
+	}
+	if ( sweep->open && !G_PointInMissileSweep( sweep, end ) ) {
+		// flown off the end without hitting anything, carry on from here
+		G_TraceMissileSweep( sweep, Q_max( G_MissileSweepDist( sweep, start ), 0.0f ) );
+	}
+	if ( !G_PointInMissileSweep( sweep, start ) || !G_PointInMissileSweep( sweep, end ) ) {
+		return qfalse;
+	}
+
+	// the same box SV_Trace looks for entities in
+	for ( i = 0; i < 3; i++ ) {
+		boxmins[i] = Q_min( start[i], end[i] ) + ent->r.mins[i] - 1;
+		boxmaxs[i] = Q_max( start[i], end[i] ) + ent->r.maxs[i] + 1;
+	}
+
+	num = g_trap->EntitiesInBox( boxmins, boxmaxs, touch, MAX_GENTITIES );
+	for ( i = 0; i < num; i++ ) {
+		gentity_t *other = &g_entities[touch[i]];
+
+		if ( touch[i] == passent || !( other->r.contents & ent->clipmask ) ) {
+			continue;
+		}
+		if ( other == ent && ent->r.ownerNum == passent && !( ent->r.svFlags & SVF_OWNERNOTSHARED ) ) {
+			continue;
+		}
+		return qfalse;
+	}
+
+	if ( d_missileSweep.integer ) {
+		trace_t tr;
+
+		g_trap->Trace( &tr, start, ent->r.mins, ent->r.maxs, end, passent, ent->clipmask, qfalse, 0, 0 );
+		if ( tr.fraction != 1.0f || tr.startsolid ) {
+			g_trap->Print( "WARNING: missile %i (%s) skipped a trace that hit entity %i\n", ent->s.number, ent->classname, tr.entityNum );
+			return qfalse;
+		}
+	}
+	return qtrue;
+}
+
+/*
+================
+G_BeginMissileBench
+
+Times the frames it takes the bolts that were just fired to clear out, for missilebench
+================
+*/
+void G_BeginMissileBench( int bolts, int msec ) {
+	missileStats.sweeps = missileStats.traces = 0;
+	missileStats.endTime = level.time + msec;
+	missileStats.bolts = bolts;
+	missileStats.frames = 0;
+	missileStats.usec = missileStats.maxUsec = 0;
+}
+
+void G_MissileBenchFrame( int64_t usec ) {
+	int total;
+
+	if ( !missileStats.endTime ) {
+		return;
+	}
+
+	missileStats.frames++;
+	missileStats.usec += usec;
+	missileStats.maxUsec = Q_max( missileStats.maxUsec, usec );
+	if ( level.time < missileStats.endTime ) {
+		return;
+	}
+
+	total = missileStats.sweeps + missileStats.traces;
+	g_trap->Print( "%i bolts, %i frames: %.3f ms average, %.3f ms worst, %i of %i moves skipped the trace (g_missileSweep %i)\n",
+		missileStats.bolts, missileStats.frames, missileStats.usec / 1000.0 / missileStats.frames, missileStats.maxUsec / 1000.0,
+		missileStats.sweeps, total, g_missileSweep.integer );
+	missileStats.endTime = 0;
+}
+
 /*
 ================
 G_RunMissile
@@ -845,8 +1072,17 @@ void G_RunMissile( gentity_t *ent ) {
 		}
 	}
 	// trace a line from the previous position to the current position
-	if (d_projectileGhoul2Collision.integer)
+	if ( G_MissileSweepClear( ent, ent->r.currentOrigin, origin, passent ) )
+	{
+		missileStats.sweeps++;
+		memset( &tr, 0, sizeof( tr ) );
+		tr.fraction = 1.0f;
+		tr.entityNum = ENTITYNUM_NONE;
+		VectorCopy( origin, tr.endpos );
+	}
+	else if (d_projectileGhoul2Collision.integer)
 	{
+		missileStats.traces++;
 		g_trap->Trace( &tr, ent->r.currentOrigin, ent->r.mins, ent->r.maxs, origin, passent, ent->clipmask, qfalse, G2TRFLAG_DOGHOULTRACE|G2TRFLAG_GETSURFINDEX|G2TRFLAG_THICK|G2TRFLAG_HITCORPSES, g_g2TraceLod.integer );
 
 		if (tr.fraction != 1.0 && tr.entityNum < ENTITYNUM_WORLD)
@@ -867,6 +1103,7 @@ void G_RunMissile( gentity_t *ent ) {
 	}
 	else
 	{
+		missileStats.traces++;
 		g_trap->Trace( &tr, ent->r.currentOrigin, ent->r.mins, ent->r.maxs, origin, passent, ent->clipmask, qfalse, 0, 0 );
 	}
 
@@ -644,7 +644,7 @@ ReturnToPos1
 */
 void ReturnToPos1( gentity_t *ent ) {
 	ent->think = 0;
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 	ent->s.time = level.time;
 
 	MatchTeam( ent, MOVER_2TO1, level.time );
@@ -682,7 +682,7 @@ void Reached_BinaryMover( gentity_t *ent )
 		if ( ent->wait < 0 )
 		{//Done for good
 			ent->think = 0;
-			ent->nextthink = 0;
+			G_SetNextThink( ent, 0 );
 			ent->use = 0;
 		}
 		else
@@ -691,11 +691,11 @@ void Reached_BinaryMover( gentity_t *ent )
 			ent->think = ReturnToPos1;
 			if(ent->spawnflags & 8)
 			{//Toggle, keep think, wait for next use?
-				ent->nextthink = -1;
+				G_SetNextThink( ent, -1 );
 			}
 			else
 			{
-				ent->nextthink = level.time + ent->wait;
+				G_SetNextThink( ent, level.time + ent->wait );
 			}
 		}
 
@@ -775,11 +775,11 @@ void Use_BinaryMover_Go( gentity_t *ent )
 		ent->think = ReturnToPos1;
 		if ( ent->spawnflags & 8 )
 		{//TOGGLE doors don't use wait!
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( ent, level.time + FRAMETIME );
 		}
 		else
 		{
-			ent->nextthink = level.time + ent->wait;
+			G_SetNextThink( ent, level.time + ent->wait );
 		}
 		G_UseTargets2( ent, ent->activator, ent->target2 );
 		return;
@@ -867,6 +867,7 @@ void UnLockDoors(gentity_t *const ent)
 		if( !(slave->spawnflags & MOVER_TOGGLE) )
 		{
 			slave->targetname = NULL;//not usable ever again
+			G_UpdateEntityIndex( slave );
 		}
 		slave->spawnflags &= ~MOVER_LOCKED;
 		slave->s.frame = 1;//second stage of anim
@@ -922,7 +923,7 @@ void Use_BinaryMover( gentity_t *ent, gentity_t *other, gentity_t *activator )
 	if(ent->delay)
 	{
 		ent->think = Use_BinaryMover_Go;
-		ent->nextthink = level.time + ent->delay;
+		G_SetNextThink( ent, level.time + ent->delay );
 	}
 	else
 	{
@@ -1475,7 +1476,7 @@ void SP_func_door (gentity_t *ent)
 	}
 	InitMover( ent );
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 
 	if ( !(ent->flags&FL_TEAMSLAVE) )
 	{
@@ -1527,7 +1528,7 @@ void Touch_Plat( gentity_t *ent, gentity_t *other, trace_t *trace ) {
 
 	// delay return-to-pos1 by one second
 	if ( ent->moverState == MOVER_POS2 ) {
-		ent->nextthink = level.time + 1000;
+		G_SetNextThink( ent, level.time + 1000 );
 	}
 }
 
@@ -1816,7 +1817,7 @@ void Reached_Train( gentity_t *ent ) {
 	if ( next->wait ) {
 		ent->s.loopSound = 0;
 		ent->s.loopIsSoundset = qfalse;
-		ent->nextthink = level.time + next->wait * 1000;
+		G_SetNextThink( ent, level.time + next->wait * 1000 );
 		ent->think = Think_BeginMoving;
 		ent->s.pos.trType = TR_STATIONARY;
 	}
@@ -1956,7 +1957,7 @@ void SP_func_train (gentity_t *self) {
 
 	// start trains on the second frame, to make sure their targets have had
 	// a chance to spawn
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	self->think = Think_SetupTrainTargets;
 }
 
@@ -2513,7 +2514,7 @@ void funcBBrushDieGo (gentity_t *self)
 
 	g_trap->AdjustAreaPortalState( (sharedEntity_t *)self, qtrue );
 	self->think = G_FreeEntity;
-	self->nextthink = level.time + 50;
+	G_SetNextThink( self, level.time + 50 );
 	//G_FreeEntity( self );
 }
 
@@ -2526,7 +2527,7 @@ void funcBBrushDie (gentity_t *self, gentity_t *inflictor, gentity_t *attacker,
 	if(self->delay)
 	{
 		self->think = funcBBrushDieGo;
-		self->nextthink = level.time + floor(self->delay * 1000.0f);
+		G_SetNextThink( self, level.time + floor(self->delay * 1000.0f) );
 		return;
 	}
 
@@ -3040,7 +3041,7 @@ void func_wait_return_solid( gentity_t *self )
 	{
 		self->clipmask = 0;
 		self->think = func_wait_return_solid;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 	}
 }
 
@@ -3097,7 +3098,7 @@ void func_usable_use (gentity_t *self, gentity_t *other, gentity_t *activator)
 		if ( self->wait )
 		{
 			self->think = func_usable_think;
-			self->nextthink = level.time + ( self->wait * 1000 );
+			G_SetNextThink( self, level.time + ( self->wait * 1000 ) );
 		}
 
 		return;
@@ -3121,7 +3122,7 @@ void func_usable_use (gentity_t *self, gentity_t *other, gentity_t *activator)
 			G_UseTargets(self, activator);
 		}
 		self->think = 0;
-		self->nextthink = -1;
+		G_SetNextThink( self, -1 );
 	}
 }
 
@@ -109,7 +109,7 @@ void G_RunObject( gentity_t *ent )
 		}
 	}
 
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 
 	VectorCopy( ent->r.currentOrigin, oldOrg );
 	// get current position
@@ -299,7 +299,7 @@ void G_StartObjectMoving( gentity_t *object, vec3_t dir, float speed, trType_t t
 	//FIXME: make these objects go through G_RunObject automatically, like missiles do
 	if ( object->think == NULL )
 	{
-		object->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( object, level.time + FRAMETIME );
 		object->think = G_RunObject;
 	}
 	else
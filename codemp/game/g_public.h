@@ -62,6 +62,9 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #define SVF_NO_COMBAT_SOUNDS	0x20000000	// No combat sounds
 #define SVF_NO_EXTRA_SOUNDS		0x40000000	// No extra or jedi sounds
 
+// EntitiesInRadius flags
+#define RADIUS_PLAYERS			0x00000001	// only entities below MAX_CLIENTS
+
 //rww - ghoul2 trace flags
 #define G2TRFLAG_DOGHOULTRACE	0x00000001 //do the ghoul2 trace
 #define G2TRFLAG_HITCORPSES		0x00000002 //will try g2 collision on the ent even if it's EF_DEAD
@@ -709,6 +712,25 @@ typedef struct gameImport_s {
 	void		(*G2API_CleanEntAttachments)			( void );
 	qboolean	(*G2API_OverrideServer)					( void *serverInstance );
 	void		(*G2API_GetSurfaceName)					( void *ghoul2, int surfNumber, int modelIndex, char *fillBuf );
+
+	struct {
+		int			(*G2API_GetBoneNumber)					( void *ghoul2, int modelIndex, const char *boneName );
+		qboolean	(*G2API_SetBoneAnglesNum)				( void *ghoul2, int modelIndex, int boneNum, const vec3_t angles, const int flags, const int up, const int right, const int forward, int blendTime, int currentTime );
+		qboolean	(*G2API_SetBoneAnimNum)					( void *ghoul2, const int modelIndex, int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime );
+
+		// per client slot data that survives map changes, GetSessionData returns the stored size
+		void		(*SetSessionData)						( int clientNum, const void *data, int size );
+		int			(*GetSessionData)						( int clientNum, void *data, int size );
+
+		// trace against the world only, ignoring every entity
+		void		(*TraceWorld)							( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int contentmask );
+
+		// entities whose boxes come within radius of origin, with the distance to each box if dists isn't NULL
+		int			(*EntitiesInRadius)						( const vec3_t origin, float radius, int ignore, int contentmask, int flags, int *list, float *dists, int maxcount );
+
+		// a steady clock for profiling, never for anything that affects the game
+		int64_t		(*Microseconds)							( void );
+	} ext;
 } gameImport_t;
 
 typedef struct gameExport_s {
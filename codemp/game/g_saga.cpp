@@ -1526,7 +1526,7 @@ void SiegeItemThink(gentity_t *ent)
 		ent->s.time2 = 0;
 	}
 
-	ent->nextthink = level.time + FRAMETIME/2;
+	G_SetNextThink( ent, level.time + FRAMETIME/2 );
 }
 
 void SiegeItemTouch( gentity_t *self, gentity_t *other, trace_t *trace )
@@ -1619,7 +1619,7 @@ void SiegeItemDie( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, i
 
 	self->neverFree = qfalse;
 	self->think = G_FreeEntity;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 
 	//Fire off the death target if we've got one.
 	if (self->target4 && self->target4[0])
@@ -1660,7 +1660,7 @@ void SiegeItemUse(gentity_t *ent, gentity_t *other, gentity_t *activator)
 	}
 
 	ent->think = SiegeItemThink;
-	ent->nextthink = level.time + FRAMETIME/2;
+	G_SetNextThink( ent, level.time + FRAMETIME/2 );
 
 	//take off nodraw
 	ent->s.eFlags &= ~EF_NODRAW;
@@ -1914,7 +1914,7 @@ void SP_misc_siege_item (gentity_t *ent)
 		}
 
 		ent->think = SiegeItemThink;
-		ent->nextthink = level.time + FRAMETIME/2;
+		G_SetNextThink( ent, level.time + FRAMETIME/2 );
 	}
 
 	ent->genericValue8 = ENTITYNUM_NONE; //initialize the carrier to none
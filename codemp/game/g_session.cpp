@@ -34,7 +34,31 @@ and tournament restarts.
 =======================================================================
 */
 
-//TODO: Replace with reading/writing to file(s)
+// The engine keeps a block of bytes per client slot for us.  Bump the
+// version whenever sessionData_t changes; a block from another version is
+// ignored, as if the client were connecting for the first time.
+#define SESSION_DATA_VERSION	(1)
+
+typedef struct sessionData_s {
+	int32_t		version;
+	int32_t		sessionTeam;
+	int32_t		spectatorNum;
+	int32_t		spectatorState;
+	int32_t		spectatorClient;
+	int32_t		wins;
+	int32_t		losses;
+	int32_t		teamLeader;
+	int32_t		setForce;
+	int32_t		saberLevel;
+	int32_t		selectedFP;
+	int32_t		duelTeam;
+	int32_t		siegeDesiredTeam;
+	char		siegeClass[64];
+	char		IP[NET_ADDRSTRMAXLEN];
+} sessionData_t;
+
+static_assert( sizeof( ((clientSession_t *)0)->siegeClass ) == sizeof( ((sessionData_t *)0)->siegeClass ), "siegeClass size mismatch" );
+static_assert( sizeof( ((clientSession_t *)0)->IP ) == sizeof( ((sessionData_t *)0)->IP ), "IP size mismatch" );
 
 /*
 ================
@@ -45,46 +69,26 @@ Called on game shutdown
 */
 void G_WriteClientSessionData( gclient_t *client )
 {
-	char		s[MAX_CVAR_VALUE_STRING] = {0},
-				siegeClass[64] = {0}, IP[NET_ADDRSTRMAXLEN] = {0};
-	const char	*var;
-	int			i = 0;
-
-	// for the strings, replace ' ' with 1
-
-	Q_strncpyz( siegeClass, client->sess.siegeClass, sizeof( siegeClass ) );
-	for ( i=0; siegeClass[i]; i++ ) {
-		if (siegeClass[i] == ' ')
-			siegeClass[i] = 1;
-	}
-	if ( !siegeClass[0] )
-		Q_strncpyz( siegeClass, "none", sizeof( siegeClass ) );
-
-	Q_strncpyz( IP, client->sess.IP, sizeof( IP ) );
-	for ( i=0; IP[i]; i++ ) {
-		if (IP[i] == ' ')
-			IP[i] = 1;
-	}
-
-	// Make sure there is no space on the last entry
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.sessionTeam ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.spectatorNum ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.spectatorState ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.spectatorClient ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.wins ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.losses ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.teamLeader ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.setForce ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.saberLevel ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.selectedFP ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.duelTeam ) );
-	Q_strcat( s, sizeof( s ), va( "%i ", client->sess.siegeDesiredTeam ) );
-	Q_strcat( s, sizeof( s ), va( "%s ", siegeClass ) );
-	Q_strcat( s, sizeof( s ), va( "%s", IP ) );
-
-	var = va( "session%i", client - level.clients );
-
-	g_trap->Cvar_Set( var, s );
+	sessionData_t	data;
+
+	memset( &data, 0, sizeof( data ) );
+	data.version			= SESSION_DATA_VERSION;
+	data.sessionTeam		= client->sess.sessionTeam;
+	data.spectatorNum		= client->sess.spectatorNum;
+	data.spectatorState		= client->sess.spectatorState;
+	data.spectatorClient	= client->sess.spectatorClient;
+	data.wins				= client->sess.wins;
+	data.losses				= client->sess.losses;
+	data.teamLeader			= client->sess.teamLeader;
+	data.setForce			= client->sess.setForce;
+	data.saberLevel			= client->sess.saberLevel;
+	data.selectedFP			= client->sess.selectedFP;
+	data.duelTeam			= client->sess.duelTeam;
+	data.siegeDesiredTeam	= client->sess.siegeDesiredTeam;
+	Q_strncpyz( data.siegeClass, client->sess.siegeClass, sizeof( data.siegeClass ) );
+	Q_strncpyz( data.IP, client->sess.IP, sizeof( data.IP ) );
+
+	g_trap->ext.SetSessionData( client - level.clients, &data, sizeof( data ) );
 }
 
 /*
@@ -96,45 +100,30 @@ Called on a reconnect
 */
 void G_ReadSessionData( gclient_t *client )
 {
-	char			s[MAX_CVAR_VALUE_STRING] = {0};
-	const char		*var;
-	int			i=0, tempSessionTeam=0, tempSpectatorState, tempTeamLeader;
-
-	var = va( "session%i", client - level.clients );
-	g_trap->Cvar_VariableStringBuffer( var, s, sizeof(s) );
-
-	sscanf( s, "%i %i %i %i %i %i %i %i %i %i %i %i %s %s",
-		&tempSessionTeam, //&client->sess.sessionTeam,
-		&client->sess.spectatorNum,
-		&tempSpectatorState, //&client->sess.spectatorState,
-		&client->sess.spectatorClient,
-		&client->sess.wins,
-		&client->sess.losses,
-		&tempTeamLeader, //&client->sess.teamLeader,
-		&client->sess.setForce,
-		&client->sess.saberLevel,
-		&client->sess.selectedFP,
-		&client->sess.duelTeam,
-		&client->sess.siegeDesiredTeam,
-		client->sess.siegeClass,
-		client->sess.IP
-		);
-
-	client->sess.sessionTeam	= (team_t)tempSessionTeam;
-	client->sess.spectatorState	= (spectatorState_t)tempSpectatorState;
-	client->sess.teamLeader		= (qboolean)tempTeamLeader;
-
-	// convert back to spaces from unused chars, as session data is written that way.
-	for ( i=0; client->sess.siegeClass[i]; i++ )
-	{
-		if (client->sess.siegeClass[i] == 1)
-			client->sess.siegeClass[i] = ' ';
+	sessionData_t	data;
+	int				size;
+
+	memset( &data, 0, sizeof( data ) );
+	size = g_trap->ext.GetSessionData( client - level.clients, &data, sizeof( data ) );
+
+	if ( size == sizeof( data ) && data.version == SESSION_DATA_VERSION ) {
+		client->sess.sessionTeam		= (team_t)data.sessionTeam;
+		client->sess.spectatorNum		= data.spectatorNum;
+		client->sess.spectatorState		= (spectatorState_t)data.spectatorState;
+		client->sess.spectatorClient	= data.spectatorClient;
+		client->sess.wins				= data.wins;
+		client->sess.losses				= data.losses;
+		client->sess.teamLeader			= (qboolean)data.teamLeader;
+		client->sess.setForce			= data.setForce;
+		client->sess.saberLevel			= data.saberLevel;
+		client->sess.selectedFP			= data.selectedFP;
+		client->sess.duelTeam			= data.duelTeam;
+		client->sess.siegeDesiredTeam	= data.siegeDesiredTeam;
+		Q_strncpyz( client->sess.siegeClass, data.siegeClass, sizeof( client->sess.siegeClass ) );
+		Q_strncpyz( client->sess.IP, data.IP, sizeof( client->sess.IP ) );
 	}
-
-	for ( i=0; client->sess.IP[i]; i++ )
-	{
-		if (client->sess.IP[i] == 1)
-			client->sess.IP[i] = ' ';
+	else if ( size != 0 ) {
+		g_trap->Print( "Ignoring session data for client %i (%i bytes, version %i)\n", (int)( client - level.clients ), size, data.version );
 	}
 
 	client->ps.fd.saberAnimLevel = client->sess.saberLevel;
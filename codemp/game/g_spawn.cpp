@@ -688,6 +688,184 @@ spawn_t	spawns[] = {
 	{ "waypoint_small",						SP_waypoint_small },
 };
 
+/*
+=============================================================================
+
+SPAWN LOOKUPS
+
+Every entity in the map used to look its classname up in bg_itemlist and
+spawns[], and each of its keys up in fields[], one string compare at a time.
+These hash tables are built the first time anything is spawned.  Each chain
+is in table order, so items still win over spawn functions, the first of
+two items with the same classname still wins, and items still have to match
+case and all.
+
+=============================================================================
+*/
+
+#define SPAWN_HASH_SIZE		512
+#define SPAWN_MAX_NAMES		512
+
+typedef struct spawnLookup_s {
+	int			first[SPAWN_HASH_SIZE];		// first table index, or -1
+	int			next[SPAWN_MAX_NAMES];		// next table index, or -1
+} spawnLookup_t;
+
+static spawnLookup_t	itemLookup, spawnFuncLookup, fieldLookup;
+static qboolean			spawnLookupsBuilt;
+
+static int G_SpawnLookupHash( const char *s ) {
+	return (int)( Q_HashStringFNVNoCase( s ) & ( SPAWN_HASH_SIZE - 1 ) );
+}
+
+static void G_ClearSpawnLookup( spawnLookup_t *lookup ) {
+	memset( lookup->first, -1, sizeof( lookup->first ) );
+	memset( lookup->next, -1, sizeof( lookup->next ) );
+}
+
+// names have to be added last to first to keep the chains in table order
+static void G_AddSpawnLookup( spawnLookup_t *lookup, int index, const char *name ) {
+	const int hash = G_SpawnLookupHash( name );
+
+	if ( index >= SPAWN_MAX_NAMES ) {
+		g_trap->Error( ERR_DROP, "G_AddSpawnLookup: SPAWN_MAX_NAMES" );
+	}
+
+	lookup->next[index] = lookup->first[hash];
+	lookup->first[hash] = index;
+}
+
+static void G_BuildSpawnLookups( void ) {
+	int i, numItems;
+
+	G_ClearSpawnLookup( &itemLookup );
+	G_ClearSpawnLookup( &spawnFuncLookup );
+	G_ClearSpawnLookup( &fieldLookup );
+
+	for ( numItems = 1; bg_itemlist[numItems].classname; numItems++ ) {
+	}
+	for ( i = numItems - 1; i >= 1; i-- ) {
+		G_AddSpawnLookup( &itemLookup, i, bg_itemlist[i].classname );
+	}
+	for ( i = ARRAY_LEN( spawns ) - 1; i >= 0; i-- ) {
+		G_AddSpawnLookup( &spawnFuncLookup, i, spawns[i].name );
+	}
+	for ( i = ARRAY_LEN( fields ) - 1; i >= 0; i-- ) {
+		G_AddSpawnLookup( &fieldLookup, i, fields[i].name );
+	}
+
+	spawnLookupsBuilt = qtrue;
+}
+
+static gitem_t *G_FindSpawnItem( const char *classname ) {
+	int i;
+
+	for ( i = itemLookup.first[G_SpawnLookupHash( classname )]; i != -1; i = itemLookup.next[i] ) {
+		if ( !strcmp( bg_itemlist[i].classname, classname ) ) {
+			return &bg_itemlist[i];
+		}
+	}
+
+	return NULL;
+}
+
+static spawn_t *G_FindSpawnFunc( const char *classname ) {
+	int i;
+
+	for ( i = spawnFuncLookup.first[G_SpawnLookupHash( classname )]; i != -1; i = spawnFuncLookup.next[i] ) {
+		if ( !Q_stricmp( spawns[i].name, classname ) ) {
+			return &spawns[i];
+		}
+	}
+
+	return NULL;
+}
+
+static game::field_t *G_FindSpawnField( const char *key ) {
+	int i;
+
+	if ( !spawnLookupsBuilt ) {
+		G_BuildSpawnLookups();
+	}
+
+	for ( i = fieldLookup.first[G_SpawnLookupHash( key )]; i != -1; i = fieldLookup.next[i] ) {
+		if ( !Q_stricmp( fields[i].name, key ) ) {
+			return &fields[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*
+=============================================================================
+
+SPAWN TIMING
+
+Where the time goes when a map loads, printed with developer 1.  Times are
+in microseconds and include any sub-BSP instances.
+
+=============================================================================
+*/
+
+#define SPAWN_TIMING_ITEMS		ARRAY_LEN( spawns )		// every item counts as one class
+#define SPAWN_TIMING_SHOW		8
+
+static struct {
+	int			numTokens;
+	int			numEntities;
+	int64_t		tokens;				// reading the entity string
+	int64_t		fields;				// setting entity fields from spawn vars
+	int64_t		spawnFuncs;			// item and SP_* functions
+	int64_t		scripts;			// ICARUS setup and spawn scripts
+	int64_t		total;
+	int64_t		subBSPs;			// misc_bsps spawning their instances, which is counted above
+
+	int64_t		classTime[ARRAY_LEN( spawns ) + 1];
+	int			classCount[ARRAY_LEN( spawns ) + 1];
+} spawnTiming;
+
+static void G_PrintSpawnTiming( void ) {
+	int i, j, num;
+	int shown[SPAWN_TIMING_SHOW];
+	int64_t other;
+
+	if ( !developer.integer ) {
+		return;
+	}
+
+	other = spawnTiming.total - spawnTiming.tokens - spawnTiming.fields - spawnTiming.spawnFuncs - spawnTiming.scripts;
+	g_trap->Print( "%i entities (%i tokens) spawned in %.1f msec:\n", spawnTiming.numEntities, spawnTiming.numTokens, spawnTiming.total / 1000.0f );
+	g_trap->Print( "%8.1f msec reading the entity string\n", spawnTiming.tokens / 1000.0f );
+	g_trap->Print( "%8.1f msec setting fields\n", spawnTiming.fields / 1000.0f );
+	g_trap->Print( "%8.1f msec in spawn functions\n", spawnTiming.spawnFuncs / 1000.0f );
+	g_trap->Print( "%8.1f msec starting scripts\n", spawnTiming.scripts / 1000.0f );
+	g_trap->Print( "%8.1f msec everything else\n", other / 1000.0f );
+
+	// the slowest classes, by total time
+	for ( num = 0; num < SPAWN_TIMING_SHOW; num++ ) {
+		int best = -1;
+
+		for ( i = 0; i <= (int)SPAWN_TIMING_ITEMS; i++ ) {
+			if ( !spawnTiming.classCount[i] ) {
+				continue;
+			}
+			for ( j = 0; j < num && shown[j] != i; j++ ) {
+			}
+			if ( j == num && ( best == -1 || spawnTiming.classTime[i] > spawnTiming.classTime[best] ) ) {
+				best = i;
+			}
+		}
+		if ( best == -1 ) {
+			break;
+		}
+
+		shown[num] = best;
+		g_trap->Print( "%8.1f msec %4i %s\n", spawnTiming.classTime[best] / 1000.0f, spawnTiming.classCount[best],
+			best == (int)SPAWN_TIMING_ITEMS ? "items" : spawns[best].name );
+	}
+}
+
 /*
 ===============
 G_CallSpawn
@@ -696,36 +874,45 @@ Finds the spawn function for the entity and calls it,
 returning qfalse if not found
 ===============
 */
-static int spawncmp( const void *a, const void *b ) {
-	return Q_stricmp( (const char *)a, ((spawn_t*)b)->name );
-}
-
 qboolean G_CallSpawn( gentity_t *ent ) {
 	spawn_t	*s;
 	gitem_t	*item;
+	int64_t	start, subBSPs;
 
 	if ( !ent->classname ) {
 		g_trap->Print( "G_CallSpawn: NULL classname\n" );
 		return qfalse;
 	}
 
+	if ( !spawnLookupsBuilt ) {
+		G_BuildSpawnLookups();
+	}
+
 	// check item spawn functions
 	//TODO: cant reorder items because compat so....?
-	for ( item=bg_itemlist+1 ; item->classname ; item++ ) {
-		if ( !strcmp(item->classname, ent->classname) ) {
-			G_SpawnItem( ent, item );
-			return qtrue;
-		}
+	item = G_FindSpawnItem( ent->classname );
+	if ( item ) {
+		start = g_trap->ext.Microseconds();
+		G_SpawnItem( ent, item );
+		spawnTiming.classTime[SPAWN_TIMING_ITEMS] += g_trap->ext.Microseconds() - start;
+		spawnTiming.classCount[SPAWN_TIMING_ITEMS]++;
+		return qtrue;
 	}
 
 	// check normal spawn functions
-	s = (spawn_t *)Q_LinearSearch( ent->classname, spawns, ARRAY_LEN( spawns ), sizeof( spawn_t ), spawncmp );
+	s = G_FindSpawnFunc( ent->classname );
 	if ( s )
 	{// found it
+		start = g_trap->ext.Microseconds();
+		subBSPs = spawnTiming.subBSPs;
+
 		if ( VALIDSTRING( ent->healingsound ) )
 			G_SoundIndex( ent->healingsound );
 
 		s->spawn( ent );
+
+		spawnTiming.classTime[s - spawns] += g_trap->ext.Microseconds() - start - ( spawnTiming.subBSPs - subBSPs );
+		spawnTiming.classCount[s - spawns]++;
 		return qtrue;
 	}
 
@@ -807,10 +994,6 @@ in a gentity
 ===============
 */
 
-static int fieldcmp( const void *a, const void *b ) {
-	return Q_stricmp( (const char *)a, ((game::field_t*)b)->name );
-}
-
 void Q3_SetParm ( int entID, int parmNum, const char *parmValue );
 void G_ParseField( const char *key, const char *value, gentity_t *ent )
 {
@@ -819,7 +1002,7 @@ void G_ParseField( const char *key, const char *value, gentity_t *ent )
 	float	v;
 	vec3_t	vec;
 
-	f = (game::field_t *)Q_LinearSearch( key, fields, ARRAY_LEN( fields ), sizeof( game::field_t ), fieldcmp );
+	f = G_FindSpawnField( key );
 	if ( f )
 	{// found it
 		b = (byte *)ent;
@@ -894,13 +1077,17 @@ void G_SpawnGEntityFromSpawnVars( qboolean inSubBSP ) {
 	gentity_t	*ent;
 	char		*s, *value, *gametypeName;
 	static char *gametypeNames[] = {"ffa", "holocron", "jedimaster", "duel", "powerduel", "single", "team", "siege", "ctf", "cty"};
+	int64_t		start, subBSPs;
 
 	// get the next free entity
 	ent = G_Spawn();
+	spawnTiming.numEntities++;
 
+	start = g_trap->ext.Microseconds();
 	for ( i = 0 ; i < level.numSpawnVars ; i++ ) {
 		G_ParseField( level.spawnVars[i][0], level.spawnVars[i][1], ent );
 	}
+	spawnTiming.fields += g_trap->ext.Microseconds() - start;
 
 	// check for "notsingle" flag
 	if ( level.gametype == GT_SINGLE_PLAYER ) {
@@ -946,14 +1133,19 @@ void G_SpawnGEntityFromSpawnVars( qboolean inSubBSP ) {
 	VectorCopy( ent->s.origin, ent->r.currentOrigin );
 
 	// if we didn't get a classname, don't bother spawning anything
+	start = g_trap->ext.Microseconds();
+	subBSPs = spawnTiming.subBSPs;
 	if ( !G_CallSpawn( ent ) ) {
 		G_FreeEntity( ent );
 	}
+	spawnTiming.spawnFuncs += g_trap->ext.Microseconds() - start - ( spawnTiming.subBSPs - subBSPs );
 
 	//Tag on the ICARUS scripting information only to valid recipients
+	start = g_trap->ext.Microseconds();
 	if ( g_trap->ICARUS_ValidEnt( (sharedEntity_t *)ent ) )
 	{
 		g_trap->ICARUS_InitEnt( (sharedEntity_t *)ent );
+		G_WakeEntity( ent );
 
 		if ( ent->classname && ent->classname[0] )
 		{
@@ -963,6 +1155,7 @@ void G_SpawnGEntityFromSpawnVars( qboolean inSubBSP ) {
 			}
 		}
 	}
+	spawnTiming.scripts += g_trap->ext.Microseconds() - start;
 }
 
 /*
@@ -1136,6 +1329,83 @@ static void HandleEntityAdjustment(void)
 	}
 }
 
+/*
+=============================================================================
+
+ENTITY TOKENS
+
+The entity string used to be pulled out of the engine one token at a time,
+in between spawning entities.  G_SpawnEntitiesFromString now reads all of it
+into one block up front and G_ParseSpawnVars takes its tokens from there.
+Anything else that parses spawn vars (the random map generator) still reads
+straight from the engine.
+
+=============================================================================
+*/
+
+typedef struct spawnTokens_s {
+	char		*chars;
+	int			numChars;
+	int			maxChars;
+
+	int			*tokens;			// offsets into chars
+	int			numTokens;
+	int			maxTokens;
+
+	int			next;				// next token G_GetSpawnToken returns
+} spawnTokens_t;
+
+static spawnTokens_t *spawnTokens;	// NULL to read from the engine
+
+static void G_ReadSpawnTokens( spawnTokens_t *st ) {
+	char	token[MAX_TOKEN_CHARS];
+	int64_t	start = g_trap->ext.Microseconds();
+
+	memset( st, 0, sizeof( *st ) );
+
+	while ( g_trap->GetEntityToken( token, sizeof( token ) ) ) {
+		const int len = strlen( token ) + 1;
+
+		if ( st->numChars + len > st->maxChars ) {
+			st->maxChars = Q_max( st->maxChars * 2, st->numChars + len + 0x10000 );
+			st->chars = (char *)realloc( st->chars, st->maxChars );
+		}
+		if ( st->numTokens == st->maxTokens ) {
+			st->maxTokens = Q_max( st->maxTokens * 2, 4096 );
+			st->tokens = (int *)realloc( st->tokens, st->maxTokens * sizeof( st->tokens[0] ) );
+		}
+		if ( !st->chars || !st->tokens ) {
+			g_trap->Error( ERR_DROP, "G_ReadSpawnTokens: out of memory" );
+		}
+
+		memcpy( st->chars + st->numChars, token, len );
+		st->tokens[st->numTokens++] = st->numChars;
+		st->numChars += len;
+	}
+
+	spawnTiming.numTokens += st->numTokens;
+	spawnTiming.tokens += g_trap->ext.Microseconds() - start;
+}
+
+static void G_FreeSpawnTokens( spawnTokens_t *st ) {
+	free( st->chars );
+	free( st->tokens );
+	memset( st, 0, sizeof( *st ) );
+}
+
+static qboolean G_GetSpawnToken( char *buffer, int bufferSize ) {
+	if ( !spawnTokens ) {
+		return g_trap->GetEntityToken( buffer, bufferSize );
+	}
+
+	if ( spawnTokens->next == spawnTokens->numTokens ) {
+		buffer[0] = '\0';
+		return qfalse;
+	}
+	Q_strncpyz( buffer, spawnTokens->chars + spawnTokens->tokens[spawnTokens->next++], bufferSize );
+	return qtrue;
+}
+
 /*
 ====================
 G_ParseSpawnVars
@@ -1154,7 +1424,7 @@ qboolean G_ParseSpawnVars( qboolean inSubBSP ) {
 	level.numSpawnVarChars = 0;
 
 	// parse the opening brace
-	if ( !g_trap->GetEntityToken( com_token, sizeof( com_token ) ) ) {
+	if ( !G_GetSpawnToken( com_token, sizeof( com_token ) ) ) {
 		// end of spawn string
 		return qfalse;
 	}
@@ -1165,7 +1435,7 @@ qboolean G_ParseSpawnVars( qboolean inSubBSP ) {
 	// go through all the key / value pairs
 	while ( 1 ) {
 		// parse key
-		if ( !g_trap->GetEntityToken( keyname, sizeof( keyname ) ) ) {
+		if ( !G_GetSpawnToken( keyname, sizeof( keyname ) ) ) {
 			g_trap->Error( ERR_DROP, "G_ParseSpawnVars: EOF without closing brace" );
 		}
 
@@ -1174,7 +1444,7 @@ qboolean G_ParseSpawnVars( qboolean inSubBSP ) {
 		}
 
 		// parse value
-		if ( !g_trap->GetEntityToken( com_token, sizeof( com_token ) ) ) {
+		if ( !G_GetSpawnToken( com_token, sizeof( com_token ) ) ) {
 			g_trap->Error( ERR_DROP, "G_ParseSpawnVars: EOF without closing brace" );
 		}
 
@@ -1575,10 +1845,25 @@ Parses textual entity definitions out of an entstring and spawns gentities.
 ==============
 */
 void G_SpawnEntitiesFromString( qboolean inSubBSP ) {
+	spawnTokens_t	tokens;
+	spawnTokens_t	*oldTokens = spawnTokens;
+	int64_t			start = g_trap->ext.Microseconds();
+	int64_t			subBSPs;
+
+	if ( !inSubBSP ) {
+		memset( &spawnTiming, 0, sizeof( spawnTiming ) );
+	}
+	subBSPs = spawnTiming.subBSPs;
+
 	// allow calls to G_Spawn*()
 	level.spawning = qtrue;
 	level.numSpawnVars = 0;
 
+	// sub-BSP instances are spawned in the middle of this, from their own
+	// entity string
+	G_ReadSpawnTokens( &tokens );
+	spawnTokens = &tokens;
+
 	// the worldspawn is not an actual entity, but it still
 	// has a "spawn" function to perform any global setup
 	// needed by a level (setting configstrings or cvars, etc)
@@ -1595,6 +1880,9 @@ void G_SpawnEntitiesFromString( qboolean inSubBSP ) {
 		// Skip this guy if its worldspawn fails
 		if ( !SP_bsp_worldspawn() )
 		{
+			spawnTokens = oldTokens;
+			G_FreeSpawnTokens( &tokens );
+			spawnTiming.subBSPs = subBSPs + g_trap->ext.Microseconds() - start;
 			return;
 		}
 	}
@@ -1604,6 +1892,9 @@ void G_SpawnEntitiesFromString( qboolean inSubBSP ) {
 		G_SpawnGEntityFromSpawnVars(inSubBSP);
 	}
 
+	spawnTokens = oldTokens;
+	G_FreeSpawnTokens( &tokens );
+
 	if( g_entities[ENTITYNUM_WORLD].behaviorSet[BSET_SPAWN] && g_entities[ENTITYNUM_WORLD].behaviorSet[BSET_SPAWN][0] )
 	{//World has a spawn script, but we don't want the world in ICARUS and running scripts,
 		//so make a scriptrunner and start it going.
@@ -1613,11 +1904,12 @@ void G_SpawnEntitiesFromString( qboolean inSubBSP ) {
 			script_runner->behaviorSet[BSET_USE] = g_entities[ENTITYNUM_WORLD].behaviorSet[BSET_SPAWN];
 			script_runner->count = 1;
 			script_runner->think = scriptrunner_run;
-			script_runner->nextthink = level.time + 100;
+			G_SetNextThink( script_runner, level.time + 100 );
 
 			if ( script_runner->inuse )
 			{
 				g_trap->ICARUS_InitEnt( (sharedEntity_t *)script_runner );
+				G_WakeEntity( script_runner );
 			}
 		}
 	}
@@ -1630,5 +1922,13 @@ void G_SpawnEntitiesFromString( qboolean inSubBSP ) {
 	G_LinkLocations();
 
 	G_PrecacheSoundsets();
+
+	if ( !inSubBSP ) {
+		spawnTiming.total = g_trap->ext.Microseconds() - start;
+		G_PrintSpawnTiming();
+	} else {
+		// replaces any instances nested in this one, which it includes
+		spawnTiming.subBSPs = subBSPs + g_trap->ext.Microseconds() - start;
+	}
 }
 
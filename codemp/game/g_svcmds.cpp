@@ -25,6 +25,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 // this file holds commands that can be executed by the server console, but not remote clients
 
 #include "g_local.h"
+#include "g_entprofile.h"
 
 /*
 ==============================================================================
@@ -299,6 +300,20 @@ void Svcmd_ListIP_f (void)
 	g_trap->Print ("%i bans.\n", count);
 }
 
+/*
+===================
+Svcmd_DefBench_f
+
+Times finding saber and NPC definitions through their indexes against
+scanning the definition text for them
+===================
+*/
+extern defIndex_t npcDefs;
+void Svcmd_DefBench_f( void ) {
+	BG_DefIndexBench( "sabers", &bgSaberDefs, g_trap->ext.Microseconds );
+	BG_DefIndexBench( "NPCs", &npcDefs, g_trap->ext.Microseconds );
+}
+
 /*
 ===================
 Svcmd_EntityList_f
@@ -482,10 +497,13 @@ svcmd_t svcmds[] = {
 	{ "addbot",						Svcmd_AddBot_f,						qfalse },
 	{ "addip",						Svcmd_AddIP_f,						qfalse },
 	{ "botlist",					Svcmd_BotList_f,					qfalse },
+	{ "defbench",					Svcmd_DefBench_f,					qfalse },
 	{ "entitylist",					Svcmd_EntityList_f,					qfalse },
+	{ "entityprofile",				Svcmd_EntityProfile_f,				qfalse },
 	{ "forceteam",					Svcmd_ForceTeam_f,					qfalse },
 	{ "game_memory",				Svcmd_GameMem_f,					qfalse },
 	{ "listip",						Svcmd_ListIP_f,						qfalse },
+	{ "missilebench",				Svcmd_MissileBench_f,				qfalse },
 	{ "removeip",					Svcmd_RemoveIP_f,					qfalse },
 	{ "say",						Svcmd_Say_f,						qtrue },
 	{ "toggleallowvote",			Svcmd_ToggleAllowVote_f,			qfalse },
@@ -49,7 +49,7 @@ void Use_Target_Give( gentity_t *ent, gentity_t *other, gentity_t *activator ) {
 		Touch_Item( t, activator, &trace );
 
 		// make sure it isn't going to respawn or show any events
-		t->nextthink = 0;
+		G_SetNextThink( t, 0 );
 		g_trap->UnlinkEntity( (sharedEntity_t *)t );
 	}
 }
@@ -106,7 +106,7 @@ void Use_Target_Delay( gentity_t *ent, gentity_t *other, gentity_t *activator )
 		return;
 	}
 	G_ActivateBehavior(ent,BSET_USE);
-	ent->nextthink = level.time + ( ent->wait + ent->random * Q_flrand(-1.0f, 1.0f) ) * 1000;
+	G_SetNextThink( ent, level.time + ( ent->wait + ent->random * Q_flrand(-1.0f, 1.0f) ) * 1000 );
 	ent->think = Think_Target_Delay;
 	ent->activator = activator;
 }
@@ -396,7 +396,7 @@ void target_laser_think (gentity_t *self) {
 	VectorCopy (tr.endpos, self->s.origin2);
 
 	g_trap->LinkEntity( (sharedEntity_t *)self );
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 void target_laser_on (gentity_t *self)
@@ -409,7 +409,7 @@ void target_laser_on (gentity_t *self)
 void target_laser_off (gentity_t *self)
 {
 	g_trap->UnlinkEntity( (sharedEntity_t *)self );
-	self->nextthink = 0;
+	G_SetNextThink( self, 0 );
 }
 
 void target_laser_use (gentity_t *self, gentity_t *other, gentity_t *activator)
@@ -454,7 +454,7 @@ void SP_target_laser (gentity_t *self)
 {
 	// let everything else get spawned before we start firing
 	self->think = target_laser_start;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 }
 
 
@@ -525,7 +525,7 @@ void target_relay_use (gentity_t *self, gentity_t *other, gentity_t *activator)
 		else
 		{//remove
 			self->think = G_FreeEntity;
-			self->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( self, level.time + FRAMETIME );
 		}
 	}
 	if ( self->spawnflags & 4 ) {
@@ -815,12 +815,14 @@ void scriptrunner_run (gentity_t *self)
 				if ( !self->activator->script_targetname || !self->activator->script_targetname[0] )
 				{
 					//We don't have a script_targetname, so create a new one
-					self->activator->script_targetname = va( "newICARUSEnt%d", numNewICARUSEnts++ );
+					self->activator->script_targetname = G_NewString( va( "newICARUSEnt%d", numNewICARUSEnts++ ) );
+					G_UpdateEntityIndex( self->activator );
 				}
 
 				if ( g_trap->ICARUS_ValidEnt( (sharedEntity_t *)self->activator ) )
 				{
 					g_trap->ICARUS_InitEnt( (sharedEntity_t *)self->activator );
+					G_WakeEntity( self->activator );
 				}
 				else
 				{
@@ -850,7 +852,7 @@ void scriptrunner_run (gentity_t *self)
 
 	if ( self->wait )
 	{
-		self->nextthink = level.time + self->wait;
+		G_SetNextThink( self, level.time + self->wait );
 	}
 }
 
@@ -866,7 +868,7 @@ void target_scriptrunner_use(gentity_t *self, gentity_t *other, gentity_t *activ
 	if ( self->delay )
 	{//delay before firing scriptrunner
 		self->think = scriptrunner_run;
-		self->nextthink = level.time + self->delay;
+		G_SetNextThink( self, level.time + self->delay );
 	}
 	else
 	{
@@ -0,0 +1,221 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// g_thinkqueue.cpp -- which entities G_RunFrame has to visit
+
+#include "g_thinkqueue.h"
+
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static inline int LowestBit( uint32_t bits ) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward( &index, bits );
+	return (int)index;
+#else
+	return __builtin_ctz( bits );
+#endif
+}
+
+static inline bool TestBit( const uint32_t *set, int num ) {
+	return ( set[num >> 5] & ( 1u << ( num & 31 ) ) ) != 0;
+}
+
+static inline void SetBit( uint32_t *set, int num ) {
+	set[num >> 5] |= 1u << ( num & 31 );
+}
+
+static inline void ClearBit( uint32_t *set, int num ) {
+	set[num >> 5] &= ~( 1u << ( num & 31 ) );
+}
+
+// Bits from first up to but not including end of the word holding first.
+static inline uint32_t WordMask( int first, int end ) {
+	uint32_t mask = ~0u << ( first & 31 );
+	if ( end - ( first & ~31 ) < 32 ) {
+		mask &= ( 1u << ( end & 31 ) ) - 1;
+	}
+	return mask;
+}
+
+static inline bool WakeBefore( const thinkQueueWake_t *a, const thinkQueueWake_t *b ) {
+	return a->time < b->time || ( a->time == b->time && a->num < b->num );
+}
+
+static void SiftUp( thinkQueue_t *tq, int pos ) {
+	thinkQueueWake_t wake = tq->wakes[pos];
+
+	while ( pos > 0 ) {
+		int parent = ( pos - 1 ) / 2;
+		if ( !WakeBefore( &wake, &tq->wakes[parent] ) ) {
+			break;
+		}
+		tq->wakes[pos] = tq->wakes[parent];
+		pos = parent;
+	}
+	tq->wakes[pos] = wake;
+}
+
+static void SiftDown( thinkQueue_t *tq, int pos ) {
+	thinkQueueWake_t wake = tq->wakes[pos];
+
+	for ( ;; ) {
+		int child = pos * 2 + 1;
+		if ( child >= tq->numWakes ) {
+			break;
+		}
+		if ( child + 1 < tq->numWakes && WakeBefore( &tq->wakes[child + 1], &tq->wakes[child] ) ) {
+			child++;
+		}
+		if ( !WakeBefore( &tq->wakes[child], &wake ) ) {
+			break;
+		}
+		tq->wakes[pos] = tq->wakes[child];
+		pos = child;
+	}
+	tq->wakes[pos] = wake;
+}
+
+/*
+=============
+ThinkQueue_Compact
+
+Rebuilds the heap from the live wake times, throwing away the stale entries.
+There is at most one live entry per entity, so this always makes room.
+=============
+*/
+static void ThinkQueue_Compact( thinkQueue_t *tq ) {
+	int i;
+
+	tq->numWakes = 0;
+	for ( i = 0; i < THINKQUEUE_MAX_ENTITIES; i++ ) {
+		if ( TestBit( tq->asleep, i ) && tq->wakeTime[i] > 0 ) {
+			tq->wakes[tq->numWakes].time = tq->wakeTime[i];
+			tq->wakes[tq->numWakes].num = i;
+			tq->numWakes++;
+		}
+	}
+	for ( i = tq->numWakes / 2 - 1; i >= 0; i-- ) {
+		SiftDown( tq, i );
+	}
+}
+
+static void ThinkQueue_Push( thinkQueue_t *tq, int num, int time ) {
+	if ( tq->numWakes == THINKQUEUE_MAX_WAKES ) {
+		ThinkQueue_Compact( tq );
+	}
+	tq->wakes[tq->numWakes].time = time;
+	tq->wakes[tq->numWakes].num = num;
+	SiftUp( tq, tq->numWakes++ );
+}
+
+void ThinkQueue_Clear( thinkQueue_t *tq ) {
+	memset( tq, 0, sizeof( *tq ) );
+}
+
+void ThinkQueue_Wake( thinkQueue_t *tq, int num ) {
+	ClearBit( tq->asleep, num );
+	SetBit( tq->awake, num );
+	tq->wakeTime[num] = 0;
+}
+
+void ThinkQueue_Sleep( thinkQueue_t *tq, int num, int wakeTime ) {
+	ClearBit( tq->awake, num );
+	SetBit( tq->asleep, num );
+	tq->wakeTime[num] = wakeTime;
+	if ( wakeTime > 0 ) {
+		ThinkQueue_Push( tq, num, wakeTime );
+	}
+}
+
+void ThinkQueue_Remove( thinkQueue_t *tq, int num ) {
+	ClearBit( tq->awake, num );
+	ClearBit( tq->asleep, num );
+	tq->wakeTime[num] = 0;
+}
+
+void ThinkQueue_WakeAt( thinkQueue_t *tq, int num, int time, int now ) {
+	if ( !TestBit( tq->asleep, num ) || time <= 0 ) {
+		return;
+	}
+	if ( time <= now ) {
+		ThinkQueue_Wake( tq, num );
+		return;
+	}
+
+	// a later wake than the one already pending can wait; the entity works
+	// out its next one again when it does wake
+	if ( tq->wakeTime[num] == 0 || time < tq->wakeTime[num] ) {
+		tq->wakeTime[num] = time;
+		ThinkQueue_Push( tq, num, time );
+	}
+}
+
+void ThinkQueue_BeginFrame( thinkQueue_t *tq, int now ) {
+	while ( tq->numWakes > 0 && tq->wakes[0].time <= now ) {
+		thinkQueueWake_t wake = tq->wakes[0];
+
+		tq->wakes[0] = tq->wakes[--tq->numWakes];
+		if ( tq->numWakes > 0 ) {
+			SiftDown( tq, 0 );
+		}
+
+		if ( TestBit( tq->asleep, wake.num ) && tq->wakeTime[wake.num] == wake.time ) {
+			ThinkQueue_Wake( tq, wake.num );
+		}
+	}
+}
+
+int ThinkQueue_Next( const thinkQueue_t *tq, int after, int end ) {
+	int first = after + 1;
+
+	if ( end > THINKQUEUE_MAX_ENTITIES ) {
+		end = THINKQUEUE_MAX_ENTITIES;
+	}
+	while ( first < end ) {
+		uint32_t bits = tq->awake[first >> 5] & WordMask( first, end );
+		if ( bits ) {
+			return ( first & ~31 ) + LowestBit( bits );
+		}
+		first = ( first & ~31 ) + 32;
+	}
+	return -1;
+}
+
+bool ThinkQueue_AnyAsleep( const thinkQueue_t *tq, int first, int end ) {
+	if ( end > THINKQUEUE_MAX_ENTITIES ) {
+		end = THINKQUEUE_MAX_ENTITIES;
+	}
+	while ( first < end ) {
+		if ( tq->asleep[first >> 5] & WordMask( first, end ) ) {
+			return true;
+		}
+		first = ( first & ~31 ) + 32;
+	}
+	return false;
+}
+
+bool ThinkQueue_IsAsleep( const thinkQueue_t *tq, int num ) {
+	return TestBit( tq->asleep, num );
+}
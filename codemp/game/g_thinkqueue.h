@@ -0,0 +1,79 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// g_thinkqueue.h -- which entities G_RunFrame has to visit
+//
+// Every entity slot is absent, awake or asleep.  Awake entities are visited
+// every frame, in ascending order.  Asleep ones are in use but have nothing
+// to do until their wake time comes around (or forever, if it's 0), or until
+// something wakes them early.  Waking early is always safe: a visit to an
+// idle entity does nothing.
+//
+// This doesn't depend on the rest of the game module, so the unit tests can
+// check it against a plain scan of every entity.
+
+#pragma once
+
+#include <stdint.h>
+
+#define THINKQUEUE_MAX_ENTITIES		(1024)
+#define THINKQUEUE_MAX_WAKES		(THINKQUEUE_MAX_ENTITIES * 4)
+
+typedef struct thinkQueueWake_s {
+	int		time;
+	int		num;
+} thinkQueueWake_t;
+
+typedef struct thinkQueue_s {
+	uint32_t			awake[THINKQUEUE_MAX_ENTITIES / 32];
+	uint32_t			asleep[THINKQUEUE_MAX_ENTITIES / 32];
+	int					wakeTime[THINKQUEUE_MAX_ENTITIES];	// 0 if it only wakes when told to
+
+	// min heap on time, stale entries are dropped when they reach the top
+	thinkQueueWake_t	wakes[THINKQUEUE_MAX_WAKES];
+	int					numWakes;
+} thinkQueue_t;
+
+void ThinkQueue_Clear( thinkQueue_t *tq );
+
+// Visit num every frame from now on, starting with this one if the frame
+// hasn't got past it yet.
+void ThinkQueue_Wake( thinkQueue_t *tq, int num );
+
+// Stop visiting num until wakeTime, or until it's woken if that's 0.
+void ThinkQueue_Sleep( thinkQueue_t *tq, int num, int wakeTime );
+
+// num is no longer in use.
+void ThinkQueue_Remove( thinkQueue_t *tq, int num );
+
+// Something will need doing for num at time; wakes it now if that's due.
+// Does nothing for entities that are awake or absent.
+void ThinkQueue_WakeAt( thinkQueue_t *tq, int num, int time, int now );
+
+// Wakes everything that's due at now.
+void ThinkQueue_BeginFrame( thinkQueue_t *tq, int now );
+
+// The first awake entity after after and before end, or -1.
+int ThinkQueue_Next( const thinkQueue_t *tq, int after, int end );
+
+// Whether any entity from first up to but not including end is asleep.
+bool ThinkQueue_AnyAsleep( const thinkQueue_t *tq, int first, int end );
+
+bool ThinkQueue_IsAsleep( const thinkQueue_t *tq, int num );
@@ -42,7 +42,7 @@ void InitTrigger( gentity_t *self ) {
 
 // the wait time has passed, so set back up for another activation
 void multi_wait( gentity_t *ent ) {
-	ent->nextthink = 0;
+	G_SetNextThink( ent, 0 );
 }
 
 void trigger_cleared_fire (gentity_t *self);
@@ -86,14 +86,14 @@ void multi_trigger_run( gentity_t *ent )
 	if ( ent->target2 && ent->target2[0] && ent->wait >= 0 )
 	{
 		ent->think = trigger_cleared_fire;
-		ent->nextthink = level.time + ent->speed;
+		G_SetNextThink( ent, level.time + ent->speed );
 	}
 	else if ( ent->wait > 0 )
 	{
 		if ( ent->painDebounceTime != level.time )
 		{//first ent to touch it this frame
 			//ent->e_ThinkFunc = thinkF_multi_wait;
-			ent->nextthink = level.time + ( ent->wait + ent->random * Q_flrand(-1.0f, 1.0f) ) * 1000;
+			G_SetNextThink( ent, level.time + ( ent->wait + ent->random * Q_flrand(-1.0f, 1.0f) ) * 1000 );
 			ent->painDebounceTime = level.time;
 		}
 	}
@@ -221,7 +221,7 @@ void multi_trigger( gentity_t *ent, gentity_t *activator )
 
 						//now that the item has been delivered, it can go away.
 						SiegeItemRemoveOwner(objItem, activator);
-						objItem->nextthink = 0;
+						G_SetNextThink( objItem, 0 );
 						objItem->neverFree = qfalse;
 						G_FreeEntity(objItem);
 					}
@@ -351,7 +351,7 @@ void multi_trigger( gentity_t *ent, gentity_t *activator )
 	if(ent->delay && ent->painDebounceTime < (level.time + ent->delay) )
 	{//delay before firing trigger
 		ent->think = multi_trigger_run;
-		ent->nextthink = level.time + ent->delay;
+		G_SetNextThink( ent, level.time + ent->delay );
 		ent->painDebounceTime = level.time;
 
 	}
@@ -560,7 +560,7 @@ void Touch_Multi( gentity_t *self, gentity_t *other, trace_t *trace )
 
 	if ( self->think == trigger_cleared_fire )
 	{//We're waiting to fire our target2 first
-		self->nextthink = level.time + self->speed;
+		G_SetNextThink( self, level.time + self->speed );
 		return;
 	}
 
@@ -574,7 +574,7 @@ void trigger_cleared_fire (gentity_t *self)
 	// should start the wait timer now, because the trigger's just been cleared, so we must "wait" from this point
 	if ( self->wait > 0 )
 	{
-		self->nextthink = level.time + ( self->wait + self->random * Q_flrand(-1.0f, 1.0f) ) * 1000;
+		G_SetNextThink( self, level.time + ( self->wait + self->random * Q_flrand(-1.0f, 1.0f) ) * 1000 );
 	}
 }
 
@@ -785,7 +785,7 @@ void Do_Strike(gentity_t *ent)
 
 	if (localTrace.startsolid || localTrace.allsolid)
 	{ //got a bad spot, think again next frame to try another strike
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -814,7 +814,7 @@ void Think_Strike(gentity_t *ent)
 		return;
 	}
 
-	ent->nextthink = level.time + ent->wait + Q_irand(0, ent->random);
+	G_SetNextThink( ent, level.time + ent->wait + Q_irand(0, ent->random) );
 	Do_Strike(ent);
 }
 
@@ -825,7 +825,7 @@ void Use_Strike( gentity_t *ent, gentity_t *other, gentity_t *activator )
 
 	if (!ent->genericValue1)
 	{ //turn it back on
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 	}
 }
 
@@ -848,7 +848,7 @@ void SP_trigger_lightningstrike( gentity_t *ent )
 
 	ent->use = Use_Strike;
 	ent->think = Think_Strike;
-	ent->nextthink = level.time + 500;
+	G_SetNextThink( ent, level.time + 500 );
 
 	G_SpawnString("lightningfx", "", &s);
 	if (!s || !s[0])
@@ -900,7 +900,7 @@ This trigger will always fire.  It is activated by the world.
 */
 void SP_trigger_always (gentity_t *ent) {
 	// we must have some delay to make sure our use targets are present
-	ent->nextthink = level.time + 300;
+	G_SetNextThink( ent, level.time + 300 );
 	ent->think = trigger_always_think;
 }
 
@@ -1152,7 +1152,7 @@ void SP_trigger_push( gentity_t *self ) {
 	}
 
 	self->think = AimAtTarget;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	g_trap->LinkEntity ((sharedEntity_t *)self);
 }
 
@@ -1202,7 +1202,7 @@ void SP_target_push( gentity_t *self ) {
 		VectorCopy( self->s.origin, self->r.absmin );
 		VectorCopy( self->s.origin, self->r.absmax );
 		self->think = AimAtTarget;
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 	}
 	self->use = Use_target_push;
 }
@@ -1555,7 +1555,7 @@ void shipboundary_think(gentity_t *ent)
 	int			i = 0;
 	gentity_t	*listedEnt;
 
-	ent->nextthink = level.time + 100;
+	G_SetNextThink( ent, level.time + 100 );
 
 	if (ent->genericValue7 < level.time)
 	{ //don't need to be doing this check, no one has touched recently
@@ -1606,7 +1606,7 @@ void SP_trigger_shipboundary(gentity_t *self)
 	}
 
 	self->think = shipboundary_think;
-	self->nextthink = level.time + 500;
+	G_SetNextThink( self, level.time + 500 );
 	self->touch = shipboundary_touch;
 
     g_trap->LinkEntity((sharedEntity_t *)self);
@@ -1771,7 +1771,7 @@ so, the basic time between firing is a random time between
 void func_timer_think( gentity_t *self ) {
 	G_UseTargets (self, self->activator);
 	// set time before next firing
-	self->nextthink = level.time + 1000 * ( self->wait + Q_flrand(-1.0f, 1.0f) * self->random );
+	G_SetNextThink( self, level.time + 1000 * ( self->wait + Q_flrand(-1.0f, 1.0f) * self->random ) );
 }
 
 void func_timer_use( gentity_t *self, gentity_t *other, gentity_t *activator ) {
@@ -1781,7 +1781,7 @@ void func_timer_use( gentity_t *self, gentity_t *other, gentity_t *activator ) {
 
 	// if on, turn it off
 	if ( self->nextthink ) {
-		self->nextthink = 0;
+		G_SetNextThink( self, 0 );
 		return;
 	}
 
@@ -1802,7 +1802,7 @@ void SP_func_timer( gentity_t *self ) {
 	}
 
 	if ( self->spawnflags & 1 ) {
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 		self->activator = self;
 	}
 
@@ -1878,7 +1878,7 @@ void asteroid_field_think(gentity_t *self)
 {
 	int numAsteroids = asteroid_count_num_asteroids( self );
 
-	self->nextthink = level.time + 500;
+	G_SetNextThink( self, level.time + 500 );
 
 	if ( numAsteroids < self->count )
 	{
@@ -1960,13 +1960,13 @@ void asteroid_field_think(gentity_t *self)
 
 				//remove itself when done
 				newAsteroid->think = G_FreeEntity;
-				newAsteroid->nextthink = level.time+time;
+				G_SetNextThink( newAsteroid, level.time+time );
 
 				//think again sooner if need even more
 				if ( numAsteroids+1 < self->count )
 				{//still need at least one more
 					//spawn it in 100ms
-					self->nextthink = level.time + 100;
+					G_SetNextThink( self, level.time + 100 );
 				}
 			}
 		}
@@ -1994,7 +1994,7 @@ void SP_trigger_asteroid_field(gentity_t *self)
 	}
 
 	self->think = asteroid_field_think;
-	self->nextthink = level.time + 100;
+	G_SetNextThink( self, level.time + 100 );
 
     g_trap->LinkEntity((sharedEntity_t *)self);
 }
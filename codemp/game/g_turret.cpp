@@ -169,7 +169,7 @@ static void turret_fire ( gentity_t *ent, vec3_t start, vec3_t dir )
 	bolt->s.emplacedOwner = ent->genericValue15;
 
 	bolt->classname = "turret_proj";
-	bolt->nextthink = level.time + 10000;
+	G_SetNextThink( bolt, level.time + 10000 );
 	bolt->think = G_FreeEntity;
 	bolt->s.eType = ET_MISSILE;
 	bolt->s.weapon = WP_EMPLACED_GUN;
@@ -542,7 +542,7 @@ void turret_base_think( gentity_t *self )
 
 		// No target
 		self->flags |= FL_NOTARGET;
-		self->nextthink = -1;//never think again
+		G_SetNextThink( self, -1 );//never think again
 		return;
 	}
 	else
@@ -550,7 +550,7 @@ void turret_base_think( gentity_t *self )
 		// I'm all hot and bothered
 		self->flags &= ~FL_NOTARGET;
 		//remember to keep thinking!
-		self->nextthink = level.time + FRAMETIME;
+		G_SetNextThink( self, level.time + FRAMETIME );
 	}
 
 	if ( !self->enemy )
@@ -722,7 +722,7 @@ void SP_misc_turret( gentity_t *base )
 	base->use = turret_base_use;
 	base->think = turret_base_think;
 	// don't start working right away
-	base->nextthink = level.time + FRAMETIME * 5;
+	G_SetNextThink( base, level.time + FRAMETIME * 5 );
 
 	g_trap->LinkEntity( (sharedEntity_t *)base );
 
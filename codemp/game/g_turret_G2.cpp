@@ -394,7 +394,7 @@ static void turretG2_fire ( gentity_t *ent, vec3_t start, vec3_t dir )
 		bolt = G_Spawn();
 
 		bolt->classname = "turret_proj";
-		bolt->nextthink = level.time + 10000;
+		G_SetNextThink( bolt, level.time + 10000 );
 		bolt->think = G_FreeEntity;
 		bolt->s.eType = ET_MISSILE;
 		bolt->s.weapon = WP_BLASTER;
@@ -847,7 +847,7 @@ void turretG2_base_think( gentity_t *self )
 	float		enemyDist;
 	vec3_t		enemyDir, org, org2;
 
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 
 	if ( self->health <= 0 )
 	{//dead
@@ -1133,7 +1133,7 @@ void finish_spawning_turretG2( gentity_t *base )
 
 	// don't start working right away
 	base->think = turretG2_base_think;
-	base->nextthink = level.time + FRAMETIME * 5;
+	G_SetNextThink( base, level.time + FRAMETIME * 5 );
 
 	// this is really the pitch angle.....
 	base->speed = 0;
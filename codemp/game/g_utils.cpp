@@ -76,30 +76,90 @@ const char *BuildShaderStateConfig(void) {
 
 model / sound configstring indexes
 
+Finding an index used to mean fetching every configstring in the range
+from the engine until the name turned up.  The game is the only thing that
+fills these ranges, and only ever appends to them, so it keeps its own hash
+of what it has put in each one.  A range is read back from the engine the
+first time it's used after G_InitGame, since a map_restart keeps the
+configstrings the last game set.
+
 =========================================================================
 */
 
+#define CSINDEX_HASH_SIZE	1024
+
+static struct {
+	int			hash[CSINDEX_HASH_SIZE];		// first configstring, or -1
+	int			next[MAX_CONFIGSTRINGS];		// next configstring in the bucket, or -1
+	const char	*names[MAX_CONFIGSTRINGS];		// in the level's memory pool
+	int			free[MAX_CONFIGSTRINGS];		// first free index of the range starting here, 0 until read
+} csIndex;
+
+static int G_ConfigstringIndexHash( const char *name, int start ) {
+	return (int)( Q_HashStringFNV( name, Q_FNV_BASIS ^ (uint32_t)start ) & ( CSINDEX_HASH_SIZE - 1 ) );
+}
+
+static void G_AddConfigstringIndex( const char *name, int start, int index ) {
+	const int num = start + index;
+	const int hash = G_ConfigstringIndexHash( name, start );
+	const int len = strlen( name ) + 1;
+	char *copy = (char *)G_Alloc( len );
+
+	memcpy( copy, name, len );
+	csIndex.names[num] = copy;
+	csIndex.next[num] = csIndex.hash[hash];
+	csIndex.hash[hash] = num;
+}
+
 /*
 ================
-G_FindConfigstringIndex
+G_ClearConfigstringIndex
 
+Forgets every range, along with the memory pool holding the names.
 ================
 */
-static int G_FindConfigstringIndex( const char *name, int start, int max, qboolean create ) {
+void G_ClearConfigstringIndex( void ) {
+	memset( csIndex.hash, -1, sizeof( csIndex.hash ) );
+	memset( csIndex.next, -1, sizeof( csIndex.next ) );
+	memset( csIndex.names, 0, sizeof( csIndex.names ) );
+	memset( csIndex.free, 0, sizeof( csIndex.free ) );
+}
+
+static void G_ReadConfigstringRange( int start, int max ) {
 	int		i;
 	char	s[MAX_STRING_CHARS];
 
-	if ( !VALIDSTRING( name ) ) {
-		return 0;
-	}
-
 	for ( i=1 ; i<max ; i++ ) {
 		g_trap->GetConfigstring( start + i, s, sizeof( s ) );
 		if ( !s[0] ) {
 			break;
 		}
-		if ( !strcmp( s, name ) ) {
-			return i;
+		G_AddConfigstringIndex( s, start, i );
+	}
+
+	csIndex.free[start] = i;
+}
+
+/*
+================
+G_FindConfigstringIndex
+
+================
+*/
+static int G_FindConfigstringIndex( const char *name, int start, int max, qboolean create ) {
+	int		i, num;
+
+	if ( !VALIDSTRING( name ) ) {
+		return 0;
+	}
+
+	if ( !csIndex.free[start] ) {
+		G_ReadConfigstringRange( start, max );
+	}
+
+	for ( num = csIndex.hash[G_ConfigstringIndexHash( name, start )]; num != -1; num = csIndex.next[num] ) {
+		if ( num > start && num < start + max && !strcmp( csIndex.names[num], name ) ) {
+			return num - start;
 		}
 	}
 
@@ -107,11 +167,14 @@ static int G_FindConfigstringIndex( const char *name, int start, int max, qboole
 		return 0;
 	}
 
+	i = csIndex.free[start];
 	if ( i == max ) {
 		g_trap->Error( ERR_DROP, "G_FindConfigstringIndex: overflow" );
 	}
 
 	g_trap->SetConfigstring( start + i, name );
+	G_AddConfigstringIndex( name, start, i );
+	csIndex.free[start] = i + 1;
 
 	return i;
 }
@@ -229,6 +292,200 @@ void G_TeamCommand( team_t team, char *cmd ) {
 }
 
 
+/*
+=============================================================================
+
+ENTITY NAME INDEX
+
+G_Find used to test every entity, and trigger chains on big maps call it
+over and over.  classname, targetname, target and script_targetname are
+indexed instead: each hash bucket is a list of entity numbers in ascending
+order, so walking a bucket visits entities in the same order the old scan
+did and a search can carry on from any entity.
+
+Most code assigns these fields directly, so the index remembers the string
+pointer each entity was indexed with and re-reads the fields when they may
+have changed.  Entities are re-read on every search until the frame after
+they were spawned, which catches the fields set right after G_Spawn.  Code
+that renames an older entity calls G_UpdateEntityIndex.  Entities are
+still compared against the string, so a stale entry can only be skipped,
+never returned wrongly.
+
+=============================================================================
+*/
+
+#define ENTINDEX_HASH_SIZE	1024
+
+static const int entIndexOffsets[ENTINDEX_MAX] = {
+	FOFS( classname ),
+	FOFS( targetname ),
+	FOFS( target ),
+	FOFS( script_targetname ),
+};
+
+static struct {
+	int			buckets[ENTINDEX_MAX][ENTINDEX_HASH_SIZE];	// first entity, or -1
+	int			next[ENTINDEX_MAX][MAX_GENTITIES];			// next entity in the bucket, or -1
+	int			hash[ENTINDEX_MAX][MAX_GENTITIES];			// bucket holding the entity, or -1
+	const char	*indexed[ENTINDEX_MAX][MAX_GENTITIES];		// the string it was indexed with
+
+	int			recent[MAX_GENTITIES];						// spawned since the start of the frame
+	qboolean	isRecent[MAX_GENTITIES];
+	int			numRecent;
+} entIndex;
+
+static int G_EntityIndexHash( const char *s ) {
+	return (int)( Q_HashStringFNVNoCase( s ) & ( ENTINDEX_HASH_SIZE - 1 ) );
+}
+
+static void G_EntityIndexUnlink( entIndexField_t field, int num ) {
+	int *link = &entIndex.buckets[field][entIndex.hash[field][num]];
+
+	while ( *link != num ) {
+		link = &entIndex.next[field][*link];
+	}
+	*link = entIndex.next[field][num];
+
+	entIndex.hash[field][num] = -1;
+	entIndex.next[field][num] = -1;
+}
+
+static void G_EntityIndexLink( entIndexField_t field, int num, const char *s ) {
+	const int hash = G_EntityIndexHash( s );
+	int *link = &entIndex.buckets[field][hash];
+
+	// keep the bucket in entity order
+	while ( *link != -1 && *link < num ) {
+		link = &entIndex.next[field][*link];
+	}
+	entIndex.next[field][num] = *link;
+	*link = num;
+
+	entIndex.hash[field][num] = hash;
+}
+
+/*
+=============
+G_ClearEntityIndex
+=============
+*/
+void G_ClearEntityIndex( void ) {
+	memset( entIndex.buckets, -1, sizeof( entIndex.buckets ) );
+	memset( entIndex.next, -1, sizeof( entIndex.next ) );
+	memset( entIndex.hash, -1, sizeof( entIndex.hash ) );
+	memset( entIndex.indexed, 0, sizeof( entIndex.indexed ) );
+	memset( entIndex.isRecent, 0, sizeof( entIndex.isRecent ) );
+	entIndex.numRecent = 0;
+}
+
+/*
+=============
+G_UpdateEntityIndex
+
+Re-reads the indexed fields of an entity, call it after renaming one that
+wasn't spawned this frame
+=============
+*/
+void G_UpdateEntityIndex( gentity_t *ent ) {
+	const int num = ent - g_entities;
+
+	for ( int field = 0; field < ENTINDEX_MAX; field++ ) {
+		const char *s = ent->inuse ? *(const char **)( (const byte *)ent + entIndexOffsets[field] ) : NULL;
+
+		if ( s == entIndex.indexed[field][num] ) {
+			continue;
+		}
+
+		if ( entIndex.hash[field][num] != -1 ) {
+			G_EntityIndexUnlink( (entIndexField_t)field, num );
+		}
+		if ( s ) {
+			G_EntityIndexLink( (entIndexField_t)field, num, s );
+		}
+		entIndex.indexed[field][num] = s;
+	}
+}
+
+/*
+=============
+G_EntityIndexSpawned
+
+Keeps re-reading a new entity's fields until the next frame
+=============
+*/
+static void G_EntityIndexSpawned( gentity_t *ent ) {
+	const int num = ent - g_entities;
+
+	if ( !entIndex.isRecent[num] ) {
+		entIndex.isRecent[num] = qtrue;
+		entIndex.recent[entIndex.numRecent++] = num;
+	}
+}
+
+static void G_SyncRecentEntities( void ) {
+	for ( int i = 0; i < entIndex.numRecent; i++ ) {
+		G_UpdateEntityIndex( &g_entities[entIndex.recent[i]] );
+	}
+}
+
+/*
+=============
+G_EntityIndexFrame
+
+Called at the start of each frame, whatever was spawned before it has had
+its fields set by now
+=============
+*/
+void G_EntityIndexFrame( void ) {
+	G_SyncRecentEntities();
+
+	for ( int i = 0; i < entIndex.numRecent; i++ ) {
+		entIndex.isRecent[entIndex.recent[i]] = qfalse;
+	}
+	entIndex.numRecent = 0;
+}
+
+/*
+=============
+G_FindIndexed
+
+G_Find for one of the indexed fields
+=============
+*/
+gentity_t *G_FindIndexed( gentity_t *from, entIndexField_t field, const char *match ) {
+	const int	hash = G_EntityIndexHash( match );
+	int			num;
+
+	G_SyncRecentEntities();
+
+	if ( !from ) {
+		num = entIndex.buckets[field][hash];
+	} else if ( entIndex.hash[field][from - g_entities] == hash ) {
+		// carry on from where the last search left off
+		num = entIndex.next[field][from - g_entities];
+	} else {
+		num = entIndex.buckets[field][hash];
+		while ( num != -1 && num <= from - g_entities ) {
+			num = entIndex.next[field][num];
+		}
+	}
+
+	for ( ; num != -1 && num < level.num_entities; num = entIndex.next[field][num] ) {
+		gentity_t	*ent = &g_entities[num];
+		const char	*s;
+
+		if ( !ent->inuse ) {
+			continue;
+		}
+		s = *(const char **)( (const byte *)ent + entIndexOffsets[field] );
+		if ( s && !Q_stricmp( s, match ) ) {
+			return ent;
+		}
+	}
+
+	return NULL;
+}
+
 /*
 =============
 G_Find
@@ -245,6 +502,14 @@ gentity_t *G_Find (gentity_t *from, int fieldofs, const char *match)
 {
 	char	*s;
 
+	if ( match ) {
+		for ( int field = 0; field < ENTINDEX_MAX; field++ ) {
+			if ( fieldofs == entIndexOffsets[field] ) {
+				return G_FindIndexed( from, (entIndexField_t)field, match );
+			}
+		}
+	}
+
 	if (!from)
 		from = g_entities;
 	else
@@ -273,13 +538,10 @@ G_RadiusList - given an origin and a radius, return all entities that are in use
 */
 int G_RadiusList ( vec3_t origin, float radius,	gentity_t *ignore, qboolean takeDamage, gentity_t *ent_list[MAX_GENTITIES])
 {
-	float		dist;
 	gentity_t	*ent;
 	int			entityList[MAX_GENTITIES];
 	int			numListedEntities;
-	vec3_t		mins, maxs;
-	vec3_t		v;
-	int			i, e;
+	int			e;
 	int			ent_count = 0;
 
 	if ( radius < 1 )
@@ -287,42 +549,16 @@ int G_RadiusList ( vec3_t origin, float radius,	gentity_t *ignore, qboolean take
 		radius = 1;
 	}
 
-	for ( i = 0 ; i < 3 ; i++ )
-	{
-		mins[i] = origin[i] - radius;
-		maxs[i] = origin[i] + radius;
-	}
-
-	numListedEntities = g_trap->EntitiesInBox( mins, maxs, entityList, MAX_GENTITIES );
+	// the engine only hands back what's within the radius of the edge of each bounding box
+	numListedEntities = g_trap->ext.EntitiesInRadius( origin, radius, ignore ? ignore->s.number : ENTITYNUM_NONE, 0, 0, entityList, NULL, MAX_GENTITIES );
 
 	for ( e = 0 ; e < numListedEntities ; e++ )
 	{
 		ent = &g_entities[entityList[ e ]];
 
-		if ((ent == ignore) || !(ent->inuse) || ent->takedamage != takeDamage)
+		if (!(ent->inuse) || ent->takedamage != takeDamage)
 			continue;
 
-		// find the distance from the edge of the bounding box
-		for ( i = 0 ; i < 3 ; i++ )
-		{
-			if ( origin[i] < ent->r.absmin[i] )
-			{
-				v[i] = ent->r.absmin[i] - origin[i];
-			} else if ( origin[i] > ent->r.absmax[i] )
-			{
-				v[i] = origin[i] - ent->r.absmax[i];
-			} else
-			{
-				v[i] = 0;
-			}
-		}
-
-		dist = VectorLength( v );
-		if ( dist >= radius )
-		{
-			continue;
-		}
-
 		// ok, we are within the radius, add us to the incoming list
 		ent_list[ent_count] = ent;
 		ent_count++;
@@ -709,6 +945,9 @@ void G_InitGentity( gentity_t *e ) {
 	e->r.ownerNum = ENTITYNUM_NONE;
 	e->s.modelGhoul2 = 0; //assume not
 
+	G_EntityIndexSpawned( e );
+	G_WakeEntity( e );
+
 	g_trap->ICARUS_FreeEnt( (sharedEntity_t *)e );	//ICARUS information must be added after this point
 }
 
@@ -1049,6 +1288,9 @@ void G_FreeEntity( gentity_t *ed ) {
 	ed->classname = "freed";
 	ed->freetime = level.time;
 	ed->inuse = qfalse;
+
+	G_UpdateEntityIndex( ed );
+	G_UnscheduleEntity( ed );
 }
 
 /*
@@ -1249,6 +1491,7 @@ void G_AddEvent( gentity_t *ent, int event, int eventParm ) {
 		ent->s.eventParm = eventParm;
 	}
 	ent->eventTime = level.time;
+	G_WakeEntity( ent );
 }
 
 /*
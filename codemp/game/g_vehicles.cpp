@@ -1037,7 +1037,7 @@ static void DeathUpdate( Vehicle_t *pVeh )
 			}
 
 			parent->think = G_FreeEntity;
-			parent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( parent, level.time + FRAMETIME );
 		}
 	}
 }
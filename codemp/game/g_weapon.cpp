@@ -392,7 +392,7 @@ void WP_Explode( gentity_t *self )
 
 	G_SetOrigin( self, self->r.currentOrigin );
 
-	self->nextthink = level.time + 50;
+	G_SetNextThink( self, level.time + 50 );
 	self->think = G_FreeEntity;
 }
 
@@ -486,7 +486,7 @@ void WP_FireTurboLaserMissile( gentity_t *ent, vec3_t start, vec3_t dir )
 
 	//don't let them last forever
 	missile->think = G_FreeEntity;
-	missile->nextthink = level.time + 5000;//at 20000 speed, that should be more than enough
+	G_SetNextThink( missile, level.time + 5000 );//at 20000 speed, that should be more than enough
 }
 
 //---------------------------------------------------------
@@ -1265,7 +1265,7 @@ void DEMP2_AltRadiusDamage( gentity_t *ent )
 	if (!myOwner || !myOwner->inuse || !myOwner->client)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -1380,12 +1380,12 @@ void DEMP2_AltRadiusDamage( gentity_t *ent )
 	if ( frac < 1.0f )
 	{
 		// shock is still happening so continue letting it expand
-		ent->nextthink = level.time + 50;
+		G_SetNextThink( ent, level.time + 50 );
 	}
 	else
 	{ //don't just leave the entity around
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 	}
 }
 
@@ -1410,7 +1410,7 @@ void DEMP2_AltDetonate( gentity_t *ent )
 
 	ent->genericValue5 = level.time;
 	ent->genericValue6 = 0;
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 	ent->think = DEMP2_AltRadiusDamage;
 	ent->s.eType = ET_GENERAL; // make us a missile no longer
 }
@@ -1470,7 +1470,7 @@ static void WP_DEMP2_AltFire( gentity_t *ent )
 	missile->s.weapon = WP_DEMP2;
 
 	missile->think = DEMP2_AltDetonate;
-	missile->nextthink = level.time;
+	G_SetNextThink( missile, level.time );
 
 	missile->splashDamage = missile->damage = damage;
 	missile->splashMethodOfDeath = missile->methodOfDeath = MOD_DEMP2;
@@ -1579,12 +1579,12 @@ void prox_mine_think( gentity_t *ent )
 	if ( blow )
 	{
 		ent->think = laserTrapExplode;
-		ent->nextthink = level.time + 200;
+		G_SetNextThink( ent, level.time + 200 );
 	}
 	else
 	{
 		// we probably don't need to do this thinking logic very often...maybe this is fast enough?
-		ent->nextthink = level.time + 500;
+		G_SetNextThink( ent, level.time + 500 );
 	}
 }
 
@@ -1760,7 +1760,7 @@ void rocketThink( gentity_t *ent )
 	{//no enemy or enemy not a client or enemy dead or enemy cloaked
 		if ( !ent->genericValue1  )
 		{//doesn't have its own self-kill time
-			ent->nextthink = level.time + 10000;
+			G_SetNextThink( ent, level.time + 10000 );
 			ent->think = G_FreeEntity;
 		}
 		return;
@@ -1801,7 +1801,7 @@ void rocketThink( gentity_t *ent )
 					//OR: should it stop trying to lock altogether?
 					if ( ent->genericValue1 )
 					{//have a timelimit, set next think to that
-						ent->nextthink = ent->genericValue1;
+						G_SetNextThink( ent, ent->genericValue1 );
 						if ( ent->genericValue2 )
 						{//explode when die
 							ent->think = G_ExplodeMissile;
@@ -1814,7 +1814,7 @@ void rocketThink( gentity_t *ent )
 					else
 					{
 						ent->think = NULL;
-						ent->nextthink = -1;
+						G_SetNextThink( ent, -1 );
 					}
 					*/
 					return;
@@ -1889,7 +1889,7 @@ void rocketThink( gentity_t *ent )
 		ent->s.pos.trTime = level.time;
 	}
 
-	ent->nextthink = level.time + ROCKET_ALT_THINK_TIME;	// Nothing at all spectacular happened, continue.
+	G_SetNextThink( ent, level.time + ROCKET_ALT_THINK_TIME );	// Nothing at all spectacular happened, continue.
 	return;
 }
 
@@ -1902,7 +1902,7 @@ void RocketDie(gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int d
 	G_ExplodeMissile( self );
 
 	self->think = G_FreeEntity;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 
 //---------------------------------------------------------
@@ -1947,7 +1947,7 @@ static void WP_FireRocket( gentity_t *ent, qboolean altFire )
 			{ //if enemy became invalid, died, or is on the same team, then don't seek it
 				missile->angle = 0.5f;
 				missile->think = rocketThink;
-				missile->nextthink = level.time + ROCKET_ALT_THINK_TIME;
+				G_SetNextThink( missile, level.time + ROCKET_ALT_THINK_TIME );
 			}
 		}
 
@@ -2025,7 +2025,7 @@ void thermalDetonatorExplode( gentity_t *ent )
 		ent->count = 1;
 		ent->genericValue5 = level.time + 500;
 		ent->think = thermalThinkStandard;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		ent->r.svFlags |= SVF_BROADCAST;//so everyone hears/sees the explosion?
 	}
 	else
@@ -2057,12 +2057,12 @@ void thermalThinkStandard(gentity_t *ent)
 	if (ent->genericValue5 < level.time)
 	{
 		ent->think = thermalDetonatorExplode;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
 	G_RunObject(ent);
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 }
 
 //---------------------------------------------------------
@@ -2082,7 +2082,7 @@ gentity_t *WP_FireThermalDetonator( gentity_t *ent, qboolean altFire )
 
 	bolt->classname = "thermal_detonator";
 	bolt->think = thermalThinkStandard;
-	bolt->nextthink = level.time;
+	G_SetNextThink( bolt, level.time );
 	bolt->touch = touch_NULL;
 
 	// How 'bout we give this thing a size...
@@ -2359,14 +2359,14 @@ void laserTrapExplode( gentity_t *self )
 	}
 
 	self->think = G_FreeEntity;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 
 void laserTrapDelayedExplode( gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int damage, int meansOfDeath )
 {
 	self->enemy = attacker;
 	self->think = laserTrapExplode;
-	self->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( self, level.time + FRAMETIME );
 	self->takedamage = qfalse;
 	if ( attacker && attacker->s.number < MAX_CLIENTS )
 	{
@@ -2384,7 +2384,7 @@ void touchLaserTrap( gentity_t *ent, gentity_t *other, trace_t *trace )
 		if ( ent->activator != other )
 		{
 			ent->touch = 0;
-			ent->nextthink = level.time + FRAMETIME;
+			G_SetNextThink( ent, level.time + FRAMETIME );
 			ent->think = laserTrapExplode;
 			VectorCopy(trace->plane.normal, ent->s.pos.trDelta);
 		}
@@ -2411,7 +2411,7 @@ void proxMineThink(gentity_t *ent)
 		owner = &g_entities[ent->r.ownerNum];
 	}
 
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 
 	if (ent->genericValue15 < level.time ||
 		!owner ||
@@ -2463,7 +2463,7 @@ void laserTrapThink ( gentity_t *ent )
 		ent->s.eFlags |= EF_FIRING;
 	}
 	ent->think = laserTrapThink;
-	ent->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( ent, level.time + FRAMETIME );
 
 	// Find the main impact point
 	VectorMA ( ent->s.pos.trBase, 1024, ent->movedir, end );
@@ -2477,7 +2477,7 @@ void laserTrapThink ( gentity_t *ent )
 	{
 		//go boom
 		ent->touch = 0;
-		ent->nextthink = level.time + LT_DELAY_TIME;
+		G_SetNextThink( ent, level.time + LT_DELAY_TIME );
 		ent->think = laserTrapExplode;
 	}
 }
@@ -2508,7 +2508,7 @@ void laserTrapStick( gentity_t *ent, vec3_t endpos, vec3_t normal )
 		//add draw line flag
 		VectorCopy( normal, ent->movedir );
 		ent->think = laserTrapThink;
-		ent->nextthink = level.time + LT_ACTIVATION_DELAY;//delay the activation
+		G_SetNextThink( ent, level.time + LT_ACTIVATION_DELAY );//delay the activation
 		ent->touch = touch_NULL;
 		//make it shootable
 		ent->takedamage = qtrue;
@@ -2527,7 +2527,7 @@ void laserTrapStick( gentity_t *ent, vec3_t endpos, vec3_t normal )
 		ent->touch = touchLaserTrap;
 		ent->think = proxMineThink;//laserTrapExplode;
 		ent->genericValue15 = level.time + 30000; //auto-explode after 30 seconds.
-		ent->nextthink = level.time + LT_ALT_TIME; // How long 'til she blows
+		G_SetNextThink( ent, level.time + LT_ALT_TIME ); // How long 'til she blows
 
 		//make it shootable
 		ent->takedamage = qtrue;
@@ -2553,7 +2553,7 @@ void laserTrapStick( gentity_t *ent, vec3_t endpos, vec3_t normal )
 
 void TrapThink(gentity_t *ent)
 { //laser g_trap think
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 	G_RunObject(ent);
 }
 
@@ -2610,7 +2610,7 @@ void CreateLaserTrap( gentity_t *laserTrap, vec3_t start, gentity_t *owner )
 	VectorCopy( start, laserTrap->pos2 );
 	laserTrap->touch = touchLaserTrap;
 	laserTrap->think = TrapThink;
-	laserTrap->nextthink = level.time + 50;
+	G_SetNextThink( laserTrap, level.time + 50 );
 }
 
 void WP_PlaceLaserTrap( gentity_t *ent, qboolean alt_fire )
@@ -2766,7 +2766,7 @@ void charge_stick (gentity_t *self, gentity_t *other, trace_t *trace)
 
 		self->touch = 0;
 		self->think = 0;
-		self->nextthink = 0;
+		G_SetNextThink( self, 0 );
 
 		self->takedamage = qfalse;
 
@@ -2780,7 +2780,7 @@ void charge_stick (gentity_t *self, gentity_t *other, trace_t *trace)
 		G_PlayEffect(EFFECT_EXPLOSION_DETPACK, self->r.currentOrigin, v);
 
 		self->think = G_FreeEntity;
-		self->nextthink = level.time;
+		G_SetNextThink( self, level.time );
 		return;
 	}
 
@@ -2799,7 +2799,7 @@ void charge_stick (gentity_t *self, gentity_t *other, trace_t *trace)
 	if ( self->think == G_RunObject ) {
 		self->touch = 0;
 		self->think = DetPackBlow;
-		self->nextthink = level.time + 30000;
+		G_SetNextThink( self, level.time + 30000 );
 	}
 
 	VectorClear(self->s.apos.trDelta);
@@ -2857,20 +2857,20 @@ void DetPackBlow(gentity_t *self)
 	G_PlayEffect(EFFECT_EXPLOSION_DETPACK, self->r.currentOrigin, v);
 
 	self->think = G_FreeEntity;
-	self->nextthink = level.time;
+	G_SetNextThink( self, level.time );
 }
 
 void DetPackPain(gentity_t *self, gentity_t *attacker, int damage)
 {
 	self->think = DetPackBlow;
-	self->nextthink = level.time + Q_irand(50, 100);
+	G_SetNextThink( self, level.time + Q_irand(50, 100) );
 	self->takedamage = qfalse;
 }
 
 void DetPackDie(gentity_t *self, gentity_t *inflictor, gentity_t *attacker, int damage, int mod)
 {
 	self->think = DetPackBlow;
-	self->nextthink = level.time + Q_irand(50, 100);
+	G_SetNextThink( self, level.time + Q_irand(50, 100) );
 	self->takedamage = qfalse;
 }
 
@@ -2882,7 +2882,7 @@ void drop_charge (gentity_t *self, vec3_t start, vec3_t dir)
 
 	bolt = G_Spawn();
 	bolt->classname = "detpack";
-	bolt->nextthink = level.time + FRAMETIME;
+	G_SetNextThink( bolt, level.time + FRAMETIME );
 	bolt->think = G_RunObject;
 	bolt->s.eType = ET_GENERAL;
 	bolt->s.g2radius = 100;
@@ -2955,7 +2955,7 @@ void BlowDetpacks(gentity_t *ent)
 			{
 				VectorCopy( found->r.currentOrigin, found->s.origin );
 				found->think = DetPackBlow;
-				found->nextthink = level.time + 100 + Q_flrand(0.0f, 1.0f) * 200;
+				G_SetNextThink( found, level.time + 100 + Q_flrand(0.0f, 1.0f) * 200 );
 				G_Sound( found, CHAN_BODY, G_SoundIndex("sound/weapons/detpack/warning.wav") );
 			}
 		}
@@ -2974,7 +2974,7 @@ void RemoveDetpacks(gentity_t *ent)
 			{
 				VectorCopy( found->r.currentOrigin, found->s.origin );
 				found->think = G_FreeEntity;
-				found->nextthink = level.time;
+				G_SetNextThink( found, level.time );
 			//	G_Sound( found, CHAN_BODY, G_SoundIndex("sound/weapons/detpack/warning.wav") );
 			}
 		}
@@ -3714,7 +3714,7 @@ void WP_VehWeapSetSolidToOwner( gentity_t *self )
 		{//just remove yourself
 			self->think = G_FreeEntity;//FIXME: custom func?
 		}
-		self->nextthink = level.time + self->genericValue1;
+		G_SetNextThink( self, level.time + self->genericValue1 );
 	}
 }
 
@@ -3840,7 +3840,7 @@ gentity_t *WP_FireVehicleWeapon( gentity_t *ent, vec3_t start, vec3_t dir, vehWe
 			{//just remove yourself
 				missile->think = G_FreeEntity;//FIXME: custom func?
 			}
-			missile->nextthink = level.time + vehWeapon->iLifeTime;
+			G_SetNextThink( missile, level.time + vehWeapon->iLifeTime );
 		}
 		missile->s.otherEntityNum2 = (vehWeapon-&g_vehWeaponInfo[0]);
 		missile->s.eFlags |= EF_JETPACK_ACTIVE;
@@ -3892,7 +3892,7 @@ gentity_t *WP_FireVehicleWeapon( gentity_t *ent, vec3_t start, vec3_t dir, vehWe
 						}
 						//now go ahead and use the rocketThink func
 						missile->think = rocketThink;//FIXME: custom func?
-						missile->nextthink = level.time + VEH_HOMING_MISSILE_THINK_TIME;
+						G_SetNextThink( missile, level.time + VEH_HOMING_MISSILE_THINK_TIME );
 						missile->s.eFlags |= EF_RADAROBJECT;//FIXME: externalize
 						if ( missile->enemy->s.NPC_class == CLASS_VEHICLE )
 						{//let vehicle know we've locked on to them
@@ -3920,7 +3920,7 @@ gentity_t *WP_FireVehicleWeapon( gentity_t *ent, vec3_t start, vec3_t dir, vehWe
 			}
 			//now go ahead and use the setsolidtoowner func
 			missile->think = WP_VehWeapSetSolidToOwner;
-			missile->nextthink = level.time + 3000;
+			G_SetNextThink( missile, level.time + 3000 );
 		}
 	}
 	else
@@ -4948,7 +4948,7 @@ void emplaced_gun_update(gentity_t *self)
 		{
 			self->activator->client->ps.emplacedIndex = 0;
 			self->activator->client->ps.saberHolstered = 0;
-			self->nextthink = level.time + 50;
+			G_SetNextThink( self, level.time + 50 );
 			return;
 		}
 	}
@@ -4974,7 +4974,7 @@ void emplaced_gun_update(gentity_t *self)
 		self->activator->client->ps.weapon = WP_EMPLACED_GUN;
 		self->activator->client->ps.weaponstate = WEAPON_READY;
 	}
-	self->nextthink = level.time + 50;
+	G_SetNextThink( self, level.time + 50 );
 }
 
 //----------------------------------------------------------
@@ -5062,7 +5062,7 @@ void SP_emplaced_gun( gentity_t *ent )
 	VectorCopy( ent->s.angles, ent->s.apos.trBase );
 
 	ent->think = emplaced_gun_update;
-	ent->nextthink = level.time + 50;
+	G_SetNextThink( ent, level.time + 50 );
 
 	ent->use = emplaced_gun_realuse;
 
@@ -5076,3 +5076,67 @@ void SP_emplaced_gun( gentity_t *ent )
 
 	g_trap->LinkEntity((sharedEntity_t *)ent);
 }
+
+/*
+===================
+Svcmd_MissileBench_f
+
+missilebench [bolts] [seconds]
+
+Fires repeater bolts in random directions from the spawn points and reports
+how long the frames take while they're in flight.  They're real bolts, they
+hurt whoever they hit.
+===================
+*/
+#define MAX_BENCH_SPOTS		(64)
+
+void Svcmd_MissileBench_f( void ) {
+	gentity_t	*spots[MAX_BENCH_SPOTS], *spot = NULL, *owner = &g_entities[ENTITYNUM_WORLD];
+	char		arg[MAX_TOKEN_CHARS] = {0};
+	int			numSpots = 0, numFree = 0, bolts = 500, seconds = 2;
+	int			i;
+
+	if ( g_trap->Argc() > 1 ) {
+		g_trap->Argv( 1, arg, sizeof( arg ) );
+		bolts = Com_Clampi( 1, MAX_GENTITIES, atoi( arg ) );
+	}
+	if ( g_trap->Argc() > 2 ) {
+		g_trap->Argv( 2, arg, sizeof( arg ) );
+		seconds = Com_Clampi( 1, 60, atoi( arg ) );
+	}
+
+	while ( numSpots < MAX_BENCH_SPOTS && ( spot = G_Find( spot, FOFS( classname ), "info_player_deathmatch" ) ) != NULL ) {
+		spots[numSpots++] = spot;
+	}
+	if ( !numSpots ) {
+		g_trap->Print( "missilebench: no info_player_deathmatch to fire from\n" );
+		return;
+	}
+
+	// leave room for everything else
+	for ( i = MAX_CLIENTS; i < ENTITYNUM_MAX_NORMAL; i++ ) {
+		if ( !g_entities[i].inuse ) {
+			numFree++;
+		}
+	}
+	bolts = Q_min( bolts, numFree - 64 );
+	if ( bolts <= 0 ) {
+		g_trap->Print( "missilebench: no free entities\n" );
+		return;
+	}
+
+	for ( i = 0; i < bolts; i++ ) {
+		vec3_t angles, dir;
+
+		spot = spots[i % numSpots];
+		VectorSet( angles, flrand( -30.0f, 30.0f ), flrand( 0.0f, 360.0f ), 0 );
+		AngleVectors( angles, dir, NULL, NULL );
+		VectorCopy( spot->s.origin, muzzle );
+		muzzle[2] += 16;
+
+		WP_RepeaterMainFire( owner, dir );
+	}
+
+	G_BeginMissileBench( bolts, seconds * 1000 );
+	g_trap->Print( "missilebench: fired %i bolts from %i spots\n", bolts, numSpots );
+}
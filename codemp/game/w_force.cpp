@@ -1769,31 +1769,18 @@ void ForceShootLightning( gentity_t *self )
 
 	if ( self->client->ps.fd.forcePowerLevel[FP_LIGHTNING] > FORCE_LEVEL_2 )
 	{//arc
-		vec3_t	center, mins, maxs, dir, ent_org, size, v;
-		float	radius = FORCE_LIGHTNING_RADIUS, dot, dist;
-		gentity_t	*entityList[MAX_GENTITIES];
+		vec3_t	center, dir, ent_org, size;
+		float	radius = FORCE_LIGHTNING_RADIUS, dot;
 		int			iEntityList[MAX_GENTITIES];
-		int		e, numListedEntities, i;
+		int		e, numListedEntities;
 
 		VectorCopy( self->client->ps.origin, center );
-		for ( i = 0 ; i < 3 ; i++ )
-		{
-			mins[i] = center[i] - radius;
-			maxs[i] = center[i] + radius;
-		}
-		numListedEntities = g_trap->EntitiesInBox( mins, maxs, iEntityList, MAX_GENTITIES );
-
-		i = 0;
-		while (i < numListedEntities)
-		{
-			entityList[i] = &g_entities[iEntityList[i]];
-
-			i++;
-		}
+		// only what's within radius of the edge of its bounding box
+		numListedEntities = g_trap->ext.EntitiesInRadius( center, radius, self->s.number, 0, 0, iEntityList, NULL, MAX_GENTITIES );
 
 		for ( e = 0 ; e < numListedEntities ; e++ )
 		{
-			traceEnt = entityList[e];
+			traceEnt = &g_entities[iEntityList[e]];
 
 			if ( !traceEnt )
 				continue;
@@ -1809,22 +1796,6 @@ void ForceShootLightning( gentity_t *self )
 				continue;
 			if ( !g_friendlyFire.integer && OnSameTeam(self, traceEnt))
 				continue;
-			//this is all to see if we need to start a saber attack, if it's in flight, this doesn't matter
-			// find the distance from the edge of the bounding box
-			for ( i = 0 ; i < 3 ; i++ )
-			{
-				if ( center[i] < traceEnt->r.absmin[i] )
-				{
-					v[i] = traceEnt->r.absmin[i] - center[i];
-				} else if ( center[i] > traceEnt->r.absmax[i] )
-				{
-					v[i] = center[i] - traceEnt->r.absmax[i];
-				} else
-				{
-					v[i] = 0;
-				}
-			}
-
 			VectorSubtract( traceEnt->r.absmax, traceEnt->r.absmin, size );
 			VectorMA( traceEnt->r.absmin, 0.5, size, ent_org );
 
@@ -1835,13 +1806,6 @@ void ForceShootLightning( gentity_t *self )
 			if ( (dot = DotProduct( dir, forward )) < 0.5 )
 				continue;
 
-			//must be close enough
-			dist = VectorLength( v );
-			if ( dist >= radius )
-			{
-				continue;
-			}
-
 			//in PVS?
 			if ( !traceEnt->r.bmodel && !g_trap->InPVS( ent_org, self->client->ps.origin ) )
 			{//must be in PVS
@@ -2052,31 +2016,18 @@ int ForceShootDrain( gentity_t *self )
 
 	if ( self->client->ps.fd.forcePowerLevel[FP_DRAIN] > FORCE_LEVEL_2 )
 	{//arc
-		vec3_t	center, mins, maxs, dir, ent_org, size, v;
-		float	radius = MAX_DRAIN_DISTANCE, dot, dist;
-		gentity_t	*entityList[MAX_GENTITIES];
+		vec3_t	center, dir, ent_org, size;
+		float	radius = MAX_DRAIN_DISTANCE, dot;
 		int			iEntityList[MAX_GENTITIES];
-		int		e, numListedEntities, i;
+		int		e, numListedEntities;
 
 		VectorCopy( self->client->ps.origin, center );
-		for ( i = 0 ; i < 3 ; i++ )
-		{
-			mins[i] = center[i] - radius;
-			maxs[i] = center[i] + radius;
-		}
-		numListedEntities = g_trap->EntitiesInBox( mins, maxs, iEntityList, MAX_GENTITIES );
-
-		i = 0;
-		while (i < numListedEntities)
-		{
-			entityList[i] = &g_entities[iEntityList[i]];
-
-			i++;
-		}
+		// only what's within radius of the edge of its bounding box
+		numListedEntities = g_trap->ext.EntitiesInRadius( center, radius, self->s.number, 0, 0, iEntityList, NULL, MAX_GENTITIES );
 
 		for ( e = 0 ; e < numListedEntities ; e++ )
 		{
-			traceEnt = entityList[e];
+			traceEnt = &g_entities[iEntityList[e]];
 
 			if ( !traceEnt )
 				continue;
@@ -2094,22 +2045,6 @@ int ForceShootDrain( gentity_t *self )
 				continue;
 			if (OnSameTeam(self, traceEnt) && !g_friendlyFire.integer)
 				continue;
-			//this is all to see if we need to start a saber attack, if it's in flight, this doesn't matter
-			// find the distance from the edge of the bounding box
-			for ( i = 0 ; i < 3 ; i++ )
-			{
-				if ( center[i] < traceEnt->r.absmin[i] )
-				{
-					v[i] = traceEnt->r.absmin[i] - center[i];
-				} else if ( center[i] > traceEnt->r.absmax[i] )
-				{
-					v[i] = center[i] - traceEnt->r.absmax[i];
-				} else
-				{
-					v[i] = 0;
-				}
-			}
-
 			VectorSubtract( traceEnt->r.absmax, traceEnt->r.absmin, size );
 			VectorMA( traceEnt->r.absmin, 0.5, size, ent_org );
 
@@ -2120,13 +2055,6 @@ int ForceShootDrain( gentity_t *self )
 			if ( (dot = DotProduct( dir, forward )) < 0.5 )
 				continue;
 
-			//must be close enough
-			dist = VectorLength( v );
-			if ( dist >= radius )
-			{
-				continue;
-			}
-
 			//in PVS?
 			if ( !traceEnt->r.bmodel && !g_trap->InPVS( ent_org, self->client->ps.origin ) )
 			{//must be in PVS
@@ -296,7 +296,7 @@ void SaberUpdateSelf(gentity_t *ent)
 	if (ent->r.ownerNum == ENTITYNUM_NONE)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
@@ -305,13 +305,13 @@ void SaberUpdateSelf(gentity_t *ent)
 		g_entities[ent->r.ownerNum].client->sess.sessionTeam == TEAM_SPECTATOR*/)
 	{
 		ent->think = G_FreeEntity;
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		return;
 	}
 
 	if (g_entities[ent->r.ownerNum].client->ps.saberInFlight && g_entities[ent->r.ownerNum].health > 0)
 	{ //let The Master take care of us now (we'll get treated like a missile until we return)
-		ent->nextthink = level.time;
+		G_SetNextThink( ent, level.time );
 		ent->genericValue5 = PROPER_THROWN_VALUE;
 		return;
 	}
@@ -362,7 +362,7 @@ void SaberUpdateSelf(gentity_t *ent)
 
 	g_trap->LinkEntity((sharedEntity_t *)ent);
 
-	ent->nextthink = level.time;
+	G_SetNextThink( ent, level.time );
 }
 
 void SaberGotHit( gentity_t *self, gentity_t *other, trace_t *trace )
@@ -587,7 +587,7 @@ void WP_SaberInitBladeData( gentity_t *ent )
 			{ //already have one
 				checkEnt->neverFree = qfalse;
 				checkEnt->think = G_FreeEntity;
-				checkEnt->nextthink = level.time;
+				G_SetNextThink( checkEnt, level.time );
 			}
 			else
 			{ //hmm.. well then, take it as my own.
@@ -636,7 +636,7 @@ void WP_SaberInitBladeData( gentity_t *ent )
 
 	saberent->think = SaberUpdateSelf;
 	saberent->genericValue5 = 0;
-	saberent->nextthink = level.time + 50;
+	G_SetNextThink( saberent, level.time + 50 );
 
 	saberSpinSound = G_SoundIndex("sound/weapons/saber/saberspin.wav");
 }
@@ -948,7 +948,7 @@ static QINLINE void G_G2PlayerAngles( gentity_t *ent, matrix3_t legs, vec3_t leg
 			emplaced = &g_entities[ent->client->ps.emplacedIndex].s;
 		}
 
-		BG_G2PlayerAngles(ent->ghoul2, ent->client->renderInfo.motionBolt, &ent->s, level.time, lerpOrg, lerpAng, legs,
+		BG_G2PlayerAngles(ent->ghoul2, ent->client->renderInfo.motionBolt, &ent->client->renderInfo.playerBones, &ent->s, level.time, lerpOrg, lerpAng, legs,
 			legsAngles, &tYawing, &tPitching, &lYawing, &tYawAngle, &tPitchAngle, &lYawAngle, FRAMETIME, turAngles,
 			ent->modelScale, ciLegs, ciTorso, &ent->client->corrTime, lookAngles, ent->client->lastHeadAngles,
 			ent->client->lookTime, emplaced, NULL);
@@ -5698,7 +5698,7 @@ void WP_SaberStartMissileBlockCheck( gentity_t *self, usercmd_t *ucmd  )
 							ent->splashDamage /= 3;
 							ent->splashRadius /= 3;
 							//ent->think = WP_Explode;
-							ent->nextthink = level.time + Q_irand( 500, 3000 );
+							G_SetNextThink( ent, level.time + Q_irand( 500, 3000 ) );
 						}
 					}
 				}
@@ -6197,7 +6197,7 @@ void DeadSaberThink(gentity_t *saberent)
 	if (saberent->speed < level.time)
 	{
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -6239,7 +6239,7 @@ void MakeDeadSaber(gentity_t *ent)
 	saberent->touch = SaberBounceSound;
 
 	saberent->think = DeadSaberThink;
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 
 	//perform a trace before attempting to spawn at currently location.
 	//unfortunately, it's a fairly regular occurance that current saber location
@@ -6328,14 +6328,14 @@ void DownedSaberThink(gentity_t *saberent)
 	qboolean notDisowned = qfalse;
 	qboolean pullBack = qfalse;
 
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 
 	if (saberent->r.ownerNum == ENTITYNUM_NONE)
 	{
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -6350,7 +6350,7 @@ void DownedSaberThink(gentity_t *saberent)
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -6366,7 +6366,7 @@ void DownedSaberThink(gentity_t *saberent)
 			MakeDeadSaber(saberent);
 
 			saberent->think = G_FreeEntity;
-			saberent->nextthink = level.time;
+			G_SetNextThink( saberent, level.time );
 			return;
 		}
 	}
@@ -6396,7 +6396,7 @@ void DownedSaberThink(gentity_t *saberent)
 		saberent->touch = SaberGotHit;
 		saberent->think = SaberUpdateSelf;
 		saberent->genericValue5 = 0;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 
 		saberent->r.svFlags |= (SVF_NOCLIENT);
 		//saberent->r.contents = CONTENTS_LIGHTSABER;
@@ -6441,7 +6441,7 @@ void DownedSaberThink(gentity_t *saberent)
 		saberent->think = saberBackToOwner;
 		saberent->speed = 0;
 		saberent->genericValue5 = 0;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 
 		saberent->r.contents = CONTENTS_LIGHTSABER;
 
@@ -6459,7 +6459,7 @@ void DownedSaberThink(gentity_t *saberent)
 	}
 
 	G_RunObject(saberent);
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 }
 
 void saberReactivate(gentity_t *saberent, gentity_t *saberOwner)
@@ -6540,6 +6540,7 @@ void saberKnockDown(gentity_t *saberent, gentity_t *saberOwner, gentity_t *other
 
 	saberent->s.eType = ET_MISSILE;
 	saberent->s.weapon = WP_SABER;
+	G_WakeEntity( saberent );
 
 	saberent->speed = level.time + 4000;
 
@@ -6555,7 +6556,7 @@ void saberKnockDown(gentity_t *saberent, gentity_t *saberOwner, gentity_t *other
 
 	saberent->touch = SaberBounceSound;
 	saberent->think = DownedSaberThink;
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 
 	if (saberOwner != other)
 	{ //if someone knocked it out of the air and it wasn't turned off, go in the direction they were facing.
@@ -6924,7 +6925,7 @@ void saberBackToOwner(gentity_t *saberent)
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -6935,7 +6936,7 @@ void saberBackToOwner(gentity_t *saberent)
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -6944,7 +6945,7 @@ void saberBackToOwner(gentity_t *saberent)
 		saberent->touch = SaberGotHit;
 		saberent->think = SaberUpdateSelf;
 		saberent->genericValue5 = 0;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 
 		if (saberOwner->client &&
 			saberOwner->client->saber[0].soundOff)
@@ -7053,7 +7054,7 @@ void saberBackToOwner(gentity_t *saberent)
 
 			saberent->think = SaberUpdateSelf;
 			saberent->genericValue5 = 0;
-			saberent->nextthink = level.time + 50;
+			G_SetNextThink( saberent, level.time + 50 );
 			WP_SaberRemoveG2Model( saberent );
 
 			return;
@@ -7071,7 +7072,7 @@ void saberBackToOwner(gentity_t *saberent)
 		saberMoveBack(saberent, qtrue);
 	}
 
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 }
 
 void saberFirstThrown(gentity_t *saberent);
@@ -7095,7 +7096,7 @@ void thrownSaberTouch (gentity_t *saberent, gentity_t *other, trace_t *trace)
 	VectorCopy(saberent->r.currentOrigin, saberent->s.pos.trBase);
 
 	saberent->think = saberBackToOwner;
-	saberent->nextthink = level.time;
+	G_SetNextThink( saberent, level.time );
 
 	if (other && other->r.ownerNum < MAX_CLIENTS &&
 		(other->r.contents & CONTENTS_LIGHTSABER) &&
@@ -7124,7 +7125,7 @@ void saberFirstThrown(gentity_t *saberent)
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -7136,7 +7137,7 @@ void saberFirstThrown(gentity_t *saberent)
 		MakeDeadSaber(saberent);
 
 		saberent->think = G_FreeEntity;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 		return;
 	}
 
@@ -7145,7 +7146,7 @@ void saberFirstThrown(gentity_t *saberent)
 		saberent->touch = SaberGotHit;
 		saberent->think = SaberUpdateSelf;
 		saberent->genericValue5 = 0;
-		saberent->nextthink = level.time;
+		G_SetNextThink( saberent, level.time );
 
 		if (saberOwn->client &&
 			saberOwn->client->saber[0].soundOff)
@@ -8651,7 +8652,7 @@ nextStep:
 				//Projectile stuff:
 				AngleVectors(self->client->ps.viewangles, dir, NULL, NULL);
 
-				saberent->nextthink = level.time + FRAMETIME;
+				G_SetNextThink( saberent, level.time + FRAMETIME );
 				saberent->think = saberFirstThrown;
 
 				saberent->damage = SABER_THROWN_HIT_DAMAGE;
@@ -8701,7 +8702,7 @@ nextStep:
 				{ //return to the owner now, this is a bad state to be in for here..
 					saberent->genericValue5 = 0;
 					saberent->think = SaberUpdateSelf;
-					saberent->nextthink = level.time;
+					G_SetNextThink( saberent, level.time );
 					WP_SaberRemoveG2Model( saberent );
 
 					self->client->ps.saberInFlight = qfalse;
@@ -199,8 +199,10 @@ int			G2_IsSurfaceRendered(CGhoul2Info *ghlInfo, const char *surfaceName, surfac
 
 // internal bone calls - G2_Bones.cpp
 qboolean	G2_Set_Bone_Angles(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, const float *angles, const int flags, const Eorientations up, const Eorientations left, const Eorientations forward, qhandle_t *modelList, const int modelIndex, const int blendTime, const int currentTime);
+qboolean	G2_Set_Bone_Angles_Num(CGhoul2Info *ghlInfo, boneInfo_v &blist, const int boneNum, const float *angles, const int flags, const Eorientations up, const Eorientations left, const Eorientations forward, const int blendTime, const int currentTime);
 qboolean	G2_Remove_Bone (CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName);
 qboolean	G2_Set_Bone_Anim(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime);
+qboolean	G2_Set_Bone_Anim_Num(CGhoul2Info *ghlInfo, boneInfo_v &blist, const int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime);
 qboolean	G2_Get_Bone_Anim(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, const int currentTime, float *currentFrame, int *startFrame, int *endFrame, int *flags, float *retAnimSpeed, qhandle_t *modelList, int modelIndex);
 qboolean	G2_Get_Bone_Anim_Range(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, int *startFrame, int *endFrame);
 qboolean	G2_Pause_Bone_Anim(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, const int currentTime );
@@ -212,6 +214,7 @@ void		G2_Animate_Bone_List(CGhoul2Info_v &ghoul2, const int currentTime, const i
 //rww - RAGDOLL_END
 void		G2_Init_Bone_List(boneInfo_v &blist, int numBones);
 int			G2_Find_Bone_In_List(boneInfo_v &blist, const int boneNum);
+int			G2_Add_Bone_Num(boneInfo_v &blist, const int boneNum);
 void		G2_RemoveRedundantBoneOverrides(boneInfo_v &blist, int *activeBones);
 qboolean	G2_Set_Bone_Angles_Matrix(const char *fileName, boneInfo_v &blist, const char *boneName, const mdxaBone_t &matrix, const int flags, qhandle_t *modelList, const int modelIndex, const int blendTime, const int currentTime);
 int			G2_Get_Bone_Index(CGhoul2Info *ghoul2, const char *boneName);
@@ -233,9 +236,9 @@ void		G2_TraceModels(CGhoul2Info_v &ghoul2, vec3_t rayStart, vec3_t rayEnd, Coll
 #endif
 void		TransformAndTranslatePoint (const vec3_t in, vec3_t out, mdxaBone_t *mat);
 #ifdef _G2_GORE
-void		G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, bool ApplyGore);
+void		G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, bool ApplyGore, const vec3_t traceStart = NULL, const vec3_t traceEnd = NULL, float traceRadius = 0.0f, bool keepVerts = false);
 #else
-void		G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod);
+void		G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, const vec3_t traceStart = NULL, const vec3_t traceEnd = NULL, float traceRadius = 0.0f, bool keepVerts = false);
 #endif
 void		G2_GenerateWorldMatrix(const vec3_t angles, const vec3_t origin);
 void		TransformPoint (const vec3_t in, vec3_t out, mdxaBone_t *mat);
@@ -310,6 +313,8 @@ int			G2API_GetGhoul2ModelFlags(CGhoul2Info *ghlInfo);
 qboolean	G2API_GetAnimFileName(CGhoul2Info *ghlInfo, char **filename);
 void		G2API_CollisionDetect(CollisionRecord_t *collRecMap, CGhoul2Info_v &ghoul2, const vec3_t angles, const vec3_t position, int frameNumber, int entNum, vec3_t rayStart, vec3_t rayEnd, vec3_t scale, IHeapAllocator *G2VertSpace, int traceFlags, int useLod, float fRadius);
 void		G2API_CollisionDetectCache(CollisionRecord_t *collRecMap, CGhoul2Info_v &ghoul2, const vec3_t angles, const vec3_t position, int frameNumber, int entNum, vec3_t rayStart, vec3_t rayEnd, vec3_t scale, IHeapAllocator *G2VertSpace, int traceFlags, int useLod, float fRadius);
+void		G2API_GetTraceCacheStats(g2TraceCacheStats_t *stats, qboolean reset);
+void		G2API_ResetVertSpace(IHeapAllocator *G2VertSpace);
 
 void		G2API_GiveMeVectorFromMatrix(mdxaBone_t *boltMatrix, Eorientations flags, vec3_t vec);
 int			G2API_CopyGhoul2Instance(CGhoul2Info_v &g2From, CGhoul2Info_v &g2To, int modelIndex);
@@ -321,6 +326,9 @@ char		*G2API_GetGLAName(CGhoul2Info_v &ghoul2, int modelIndex);
 qboolean	G2API_SetBoneAnglesMatrix(CGhoul2Info *ghlInfo, const char *boneName, const mdxaBone_t &matrix, const int flags, qhandle_t *modelList, int blendTime = 0, int currentTime = 0);
 qboolean	G2API_SetNewOrigin(CGhoul2Info_v &ghoul2, const int boltIndex);
 int			G2API_GetBoneIndex(CGhoul2Info *ghlInfo, const char *boneName);
+int			G2API_GetBoneNumber(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName);
+qboolean	G2API_SetBoneAnglesNum(CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const vec3_t angles, const int flags, const Eorientations up, const Eorientations left, const Eorientations forward, int blendTime, int currentTime);
+qboolean	G2API_SetBoneAnimNum(CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime);
 qboolean	G2API_StopBoneAnglesIndex(CGhoul2Info *ghlInfo, const int index);
 qboolean	G2API_StopBoneAnimIndex(CGhoul2Info *ghlInfo, const int index);
 qboolean	G2API_SetBoneAnglesIndex( CGhoul2Info *ghlInfo, const int index, const vec3_t angles, const int flags, const Eorientations yaw, const Eorientations pitch, const Eorientations roll, qhandle_t *modelList, int blendTime, int currentTime );
@@ -376,5 +384,6 @@ void		G2API_ClearSkinGore ( CGhoul2Info_v &ghoul2 );
 
 int			G2API_Ghoul2Size ( CGhoul2Info_v &ghoul2 );
 void		RemoveBoneCache( CBoneCache *boneCache );
+int			BoneCacheTouch( const CBoneCache *boneCache );
 
 const char	*G2API_GetModelName ( CGhoul2Info_v& ghoul2, int modelIndex );
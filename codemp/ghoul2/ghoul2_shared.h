@@ -336,5 +336,12 @@ enum EG2_Collision
 	G2_RETURNONHIT
 };
 
+// how often G2API_CollisionDetect could reuse the work of an earlier trace in the same frame
+typedef struct g2TraceCacheStats_s {
+	int		traces;
+	int		skeletonHits;	// skeleton was still valid
+	int		vertHits;		// transformed verts were too, only surfaces new to this trace were skinned
+} g2TraceCacheStats_t;
+
 
 //====================================================================
@@ -43,6 +43,18 @@ CBlockMember::CBlockMember( void )
 	m_id = -1;
 	m_size = -1;
 	m_data = NULL;
+	m_ownsData = false;
+}
+
+CBlockMember::CBlockMember( CBlockMember &&other )
+{
+	m_id = other.m_id;
+	m_size = other.m_size;
+	m_data = other.m_data;
+	m_ownsData = other.m_ownsData;
+
+	other.m_data = NULL;
+	other.m_ownsData = false;
 }
 
 CBlockMember::~CBlockMember( void )
@@ -50,6 +62,24 @@ CBlockMember::~CBlockMember( void )
 	Free();
 }
 
+CBlockMember &CBlockMember::operator=( CBlockMember &&other )
+{
+	if ( this != &other )
+	{
+		FreeData();
+
+		m_id = other.m_id;
+		m_size = other.m_size;
+		m_data = other.m_data;
+		m_ownsData = other.m_ownsData;
+
+		other.m_data = NULL;
+		other.m_ownsData = false;
+	}
+
+	return *this;
+}
+
 /*
 -------------------------
 Free
@@ -60,13 +90,31 @@ void CBlockMember::Free( void )
 {
 	if ( m_data != NULL )
 	{
-		ICARUS_Free ( m_data );
-		m_data = NULL;
+		FreeData();
 
 		m_id = m_size = -1;
 	}
 }
 
+/*
+-------------------------
+FreeData
+
+Releases the member's data, leaving data owned by a compiled script alone
+-------------------------
+*/
+
+void CBlockMember::FreeData( void )
+{
+	if ( m_data && m_ownsData )
+	{
+		ICARUS_Free( m_data );
+	}
+
+	m_data = NULL;
+	m_ownsData = false;
+}
+
 /*
 -------------------------
 GetInfo
@@ -98,12 +146,29 @@ void CBlockMember::SetData( vector_t data )
 
 void CBlockMember::SetData( void *data, int size )
 {
-	if ( m_data )
-		ICARUS_Free( m_data );
+	FreeData();
 
 	m_data = ICARUS_Malloc( size );
 	memcpy( m_data, data, size );
 	m_size = size;
+	m_ownsData = true;
+}
+
+/*
+-------------------------
+SetSharedData
+
+The data is not copied and must outlive the member; any later SetData replaces it with an owned copy
+-------------------------
+*/
+
+void CBlockMember::SetSharedData( int id, int size, const void *data )
+{
+	FreeData();
+
+	m_id = id;
+	m_size = size;
+	m_data = (void *) data;
 }
 
 //	Member I/O functions
@@ -116,8 +181,11 @@ ReadMember
 
 int CBlockMember::ReadMember( char **stream, int *streamPos )
 {
+	FreeData();
+
 	m_id = LittleLong(*(int *) (*stream + *((int *)streamPos)));
 	*streamPos += sizeof( int );
+	m_ownsData = true;
 
 	if ( m_id == ID_RANDOM )
 	{//special case, need to initialize this member's data to Q3_INFINITE so we can randomize the number only the first time random is checked when inside a wait
@@ -165,18 +233,18 @@ Duplicate
 -------------------------
 */
 
-CBlockMember *CBlockMember::Duplicate( void )
+void CBlockMember::Duplicate( CBlockMember &dest ) const
 {
-	CBlockMember	*newblock = new CBlockMember;
-
-	if ( newblock == NULL )
-		return NULL;
-
-	newblock->SetData( m_data, m_size );
-	newblock->SetSize( m_size );
-	newblock->SetID( m_id );
+	//Compiled script data is immutable, so the copy can keep pointing at it
+	if ( !m_ownsData )
+	{
+		dest.SetSharedData( m_id, m_size, m_data );
+		return;
+	}
 
-	return newblock;
+	dest.SetData( m_data, m_size );
+	dest.SetSize( m_size );
+	dest.SetID( m_id );
 }
 
 /*
@@ -191,6 +259,7 @@ CBlock::CBlock( void )
 {
 	m_flags			= 0;
 	m_id			= 0;
+	m_nameID		= -1;
 }
 
 CBlock::~CBlock( void )
@@ -208,6 +277,7 @@ int CBlock::Init( void )
 {
 	m_flags			= 0;
 	m_id			= 0;
+	m_nameID		= -1;
 
 	return true;
 }
@@ -235,20 +305,7 @@ Free
 
 int CBlock::Free( void )
 {
-	int	numMembers = GetNumMembers();
-	CBlockMember	*bMember;
-
-	while ( numMembers-- )
-	{
-		bMember = GetMember( numMembers );
-
-		if (!bMember)
-			return false;
-
-		delete bMember;
-	}
-
-	m_members.clear();			//List of all CBlockMembers owned by this list
+	m_members.clear();
 
 	return true;
 }
@@ -263,81 +320,77 @@ Write
 
 int CBlock::Write( int member_id, const char *member_data )
 {
-	CBlockMember *bMember = new CBlockMember;
-
-	bMember->SetID( member_id );
+	CBlockMember &bMember = AddMember();
 
-	bMember->SetData( member_data );
-	bMember->SetSize( strlen(member_data) + 1 );
+	bMember.SetID( member_id );
 
-	AddMember( bMember );
+	bMember.SetData( member_data );
+	bMember.SetSize( strlen(member_data) + 1 );
 
 	return true;
 }
 
 int CBlock::Write( int member_id, vector_t member_data )
 {
-	CBlockMember *bMember;
+	CBlockMember &bMember = AddMember();
 
-	bMember = new CBlockMember;
-
-	bMember->SetID( member_id );
-	bMember->SetData( member_data );
-	bMember->SetSize( sizeof(vector_t) );
-
-	AddMember( bMember );
+	bMember.SetID( member_id );
+	bMember.SetData( member_data );
+	bMember.SetSize( sizeof(vector_t) );
 
 	return true;
 }
 
 int CBlock::Write( int member_id, float member_data )
 {
-	CBlockMember *bMember = new CBlockMember;
-
-	bMember->SetID( member_id );
-	bMember->WriteData( member_data );
-	bMember->SetSize( sizeof(member_data) );
+	CBlockMember &bMember = AddMember();
 
-	AddMember( bMember );
+	bMember.SetID( member_id );
+	bMember.WriteData( member_data );
+	bMember.SetSize( sizeof(member_data) );
 
 	return true;
 }
 
 int CBlock::Write( int member_id, int member_data )
 {
-	CBlockMember *bMember = new CBlockMember;
+	CBlockMember &bMember = AddMember();
 
-	bMember->SetID( member_id );
-	bMember->WriteData( member_data );
-	bMember->SetSize( sizeof(member_data) );
-
-	AddMember( bMember );
+	bMember.SetID( member_id );
+	bMember.WriteData( member_data );
+	bMember.SetSize( sizeof(member_data) );
 
 	return true;
 }
 
+// Member list functions
 
-int CBlock::Write( CBlockMember *bMember )
-{
-// findme: this is wrong:	bMember->SetSize( sizeof(bMember->GetData()) );
+/*
+-------------------------
+AddMember
 
-	AddMember( bMember );
+The reference is only good until the next member is added
+-------------------------
+*/
 
-	return true;
+CBlockMember &CBlock::AddMember( void )
+{
+	m_members.emplace_back();
+	return m_members.back();
 }
 
-// Member list functions
-
 /*
 -------------------------
-AddMember
+AddMembers
 -------------------------
 */
 
-int	CBlock::AddMember( CBlockMember *member )
+CBlockMember *CBlock::AddMembers( int count )
 {
-	m_members.insert( m_members.end(), member );
-	return true;
+	const size_t first = m_members.size();
+
+	m_members.resize( first + count );
+	return m_members.data() + first;
 }
 
 /*
@@ -352,7 +405,7 @@ CBlockMember *CBlock::GetMember( int memberNum )
 	{
 		return NULL;
 	}
-	return m_members[ memberNum ];
+	return &m_members[ memberNum ];
 }
 
 /*
@@ -387,16 +440,185 @@ CBlock *CBlock::Duplicate( void )
 		return NULL;
 
 	newblock->Create( m_id );
+	newblock->SetNameID( m_nameID );
 
 	//Duplicate entire block and return the cc
+	CBlockMember *members = newblock->AddMembers( GetNumMembers() );
+
 	for ( mi = m_members.begin(); mi != m_members.end(); ++mi )
 	{
-		newblock->AddMember( (*mi)->Duplicate() );
+		mi->Duplicate( *members++ );
 	}
 
 	return newblock;
 }
 
+/*
+-------------------------
+GetNameID
+-------------------------
+*/
+
+int CBlock::GetNameID( void )
+{
+	if ( m_nameID == -1 )
+	{
+		const char *name = (const char *) GetMemberData( 0 );
+
+		if ( name )
+		{
+			m_nameID = ICARUS_GetTaskNameID( name, true );
+		}
+	}
+
+	return m_nameID;
+}
+
+/*
+===================================================================================================
+
+  CCompiledScript
+
+===================================================================================================
+*/
+
+CCompiledScript::CCompiledScript( void )
+{
+}
+
+CCompiledScript::~CCompiledScript( void )
+{
+	Free();
+}
+
+/*
+-------------------------
+Free
+-------------------------
+*/
+
+void CCompiledScript::Free( void )
+{
+	m_blocks.clear();
+	m_members.clear();
+	m_data.clear();
+}
+
+/*
+-------------------------
+Compile
+
+Decodes an IBI stream into the flat block and member tables
+-------------------------
+*/
+
+int CCompiledScript::Compile( const char *buffer, long size )
+{
+	long	pos = IBI_HEADER_ID_LENGTH + sizeof( float );
+	float	version;
+
+	Free();
+
+	if ( size < pos )
+		return false;
+
+	//Check for valid header
+	if ( strncmp( buffer, IBI_HEADER_ID, IBI_HEADER_ID_LENGTH ) )
+		return false;
+
+	memcpy( &version, buffer + IBI_HEADER_ID_LENGTH, sizeof( version ) );
+
+	//Check for valid version
+	if ( LittleFloat( version ) != IBI_VERSION )
+		return false;
+
+	//Block data is at most the size of the stream, so reserve it up front
+	m_data.reserve( size );
+
+	while ( pos < size )
+	{
+		block_t	block;
+
+		if ( pos + (long) ( sizeof( int ) * 2 + 1 ) > size )
+			return false;
+
+		block.id			= LittleLong( *(int *) ( buffer + pos ) );
+		block.numMembers	= LittleLong( *(int *) ( buffer + pos + sizeof( int ) ) );
+		block.flags			= (unsigned char) buffer[ pos + sizeof( int ) * 2 ];
+		block.firstMember	= (int) m_members.size();
+		block.nameID		= -1;
+		pos += sizeof( int ) * 2 + 1;
+
+		if ( block.numMembers < 0 )
+			return false;
+
+		for ( int i = 0; i < block.numMembers; i++ )
+		{
+			member_t	member;
+
+			if ( pos + (long) ( sizeof( int ) * 2 ) > size )
+				return false;
+
+			member.id	= LittleLong( *(int *) ( buffer + pos ) );
+			member.size	= LittleLong( *(int *) ( buffer + pos + sizeof( int ) ) );
+			pos += sizeof( int ) * 2;
+
+			//Keep member data aligned for float and vector reads
+			member.offset = ( (int) m_data.size() + 3 ) & ~3;
+
+			if ( member.id == ID_RANDOM )
+			{//special case, initialize to Q3_INFINITE so the number is only randomized the first time it's checked inside a wait
+				float infinite = Q3_INFINITE;
+
+				member.size = sizeof( float );
+				if ( pos + member.size > size )
+					return false;
+
+				pos += member.size;
+				m_data.resize( member.offset + member.size );
+				memcpy( m_data.data() + member.offset, &infinite, member.size );
+			}
+			else
+			{
+				if ( member.size < 0 || pos + member.size > size )
+					return false;
+
+				m_data.resize( member.offset + member.size );
+				if ( member.size )
+					memcpy( m_data.data() + member.offset, buffer + pos, member.size );
+				pos += member.size;
+#ifdef Q3_BIG_ENDIAN
+				// only TK_INT, TK_VECTOR and TK_FLOAT has to be swapped, but just in case
+				if (member.size == 4 && member.id != TK_STRING && member.id != TK_IDENTIFIER && member.id != TK_CHAR)
+					*(int *) ( m_data.data() + member.offset ) = LittleLong( *(int *) ( m_data.data() + member.offset ) );
+#endif
+			}
+
+			m_members.push_back( member );
+		}
+
+		m_blocks.push_back( block );
+	}
+
+	//Intern task names now so task and do blocks never have to look them up by string
+	for ( size_t i = 0; i < m_blocks.size(); i++ )
+	{
+		block_t &block = m_blocks[ i ];
+
+		if ( ( block.id != ID_TASK && block.id != ID_DO ) || block.numMembers == 0 )
+			continue;
+
+		const member_t &name = m_members[ block.firstMember ];
+
+		if ( name.id == TK_STRING || name.id == TK_IDENTIFIER || name.id == TK_CHAR )
+		{
+			block.nameID = ICARUS_GetTaskNameID( (const char *) GetMemberData( name ), true );
+		}
+	}
+
+	return true;
+}
+
 /*
 ===================================================================================================
 
@@ -409,6 +631,9 @@ CBlockStream::CBlockStream( void )
 {
 	m_stream = NULL;
 	m_streamPos = 0;
+
+	m_script = NULL;
+	m_blockNum = 0;
 }
 
 CBlockStream::~CBlockStream( void )
@@ -509,6 +734,9 @@ int CBlockStream::Free( void )
 	m_stream = NULL;
 	m_streamPos = 0;
 
+	m_script = NULL;
+	m_blockNum = 0;
+
 	return true;
 }
 
@@ -552,6 +780,9 @@ int CBlockStream::Init( void )
 	m_stream = NULL;
 	m_streamPos = 0;
 
+	m_script = NULL;
+	m_blockNum = 0;
+
 	return true;
 }
 
@@ -593,6 +824,9 @@ BlockAvailable
 
 int CBlockStream::BlockAvailable( void )
 {
+	if ( m_script )
+		return ( m_blockNum < m_script->GetNumBlocks() );
+
 	if ( m_streamPos >= m_fileSize )
 		return false;
 
@@ -614,6 +848,27 @@ int CBlockStream::ReadBlock( CBlock *get )
 	if (!BlockAvailable())
 		return false;
 
+	if ( m_script )
+	{
+		const CCompiledScript::block_t &block = m_script->GetBlock( m_blockNum++ );
+
+		get->Create( block.id );
+		get->SetFlags( block.flags );
+		get->SetNameID( block.nameID );
+
+		//The members are views of the script's data, laid out in one allocation with the block
+		bMember = get->AddMembers( block.numMembers );
+
+		for ( int i = 0; i < block.numMembers; i++ )
+		{
+			const CCompiledScript::member_t &member = m_script->GetMember( block.firstMember + i );
+
+			bMember[i].SetSharedData( member.id, member.size, m_script->GetMemberData( member ) );
+		}
+
+		return true;
+	}
+
 	b_id		= LittleLong(GetInteger());
 	numMembers	= LittleLong(GetInteger());
 	flags		= (unsigned char) GetChar();
@@ -626,11 +881,11 @@ int CBlockStream::ReadBlock( CBlock *get )
 
 	// Stream blocks are generally temporary as they
 	// are just used in an initial parsing phase...
-	while ( numMembers-- > 0)
+	bMember = get->AddMembers( numMembers );
+
+	for ( int i = 0; i < numMembers; i++ )
 	{
-		bMember = new CBlockMember;
-		bMember->ReadMember( &m_stream, &m_streamPos );
-		get->AddMember( bMember );
+		bMember[i].ReadMember( &m_stream, &m_streamPos );
 	}
 
 	return true;
@@ -677,3 +932,24 @@ int CBlockStream::Open( char *buffer, long size )
 
 	return true;
 }
+
+/*
+-------------------------
+Open
+
+Reads blocks from an already compiled script instead of a raw stream
+-------------------------
+*/
+
+int CBlockStream::Open( const CCompiledScript *script )
+{
+	Init();
+
+	if ( script == NULL )
+		return false;
+
+	m_script = script;
+	m_fileSize = 0;
+
+	return true;
+}
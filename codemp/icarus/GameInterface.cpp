@@ -30,6 +30,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "qcommon/RoffSystem.h"
 #include "Q3_Interface.h"
 #include "server/sv_gameapi.h"
+#include "Q3_Profile.h"
 
 ICARUS_Instance		*iICARUS;
 bufferlist_t		ICARUS_BufferList;
@@ -48,7 +49,7 @@ gets the named script from the cache or disk if not already loaded
 =============
 */
 
-int ICARUS_GetScript( const char *name, char **buf )
+const CCompiledScript *ICARUS_GetScript( const char *name )
 {
 	bufferlist_t::iterator		ei;
 	//Make sure the caller is valid
@@ -60,7 +61,7 @@ int ICARUS_GetScript( const char *name, char **buf )
 	if ( ei == ICARUS_BufferList.end() )
 	{
 		if ( ICARUS_RegisterScript( name ) == false )
-			return 0;
+			return NULL;
 
 		//Script is now inserted, retrieve it and pass through
 		ei = ICARUS_BufferList.find( (char *) name );
@@ -69,12 +70,11 @@ int ICARUS_GetScript( const char *name, char **buf )
 		{
 			//NOTENOTE: This is an internal error in STL if this happens...
 			assert(0);
-			return 0;
+			return NULL;
 		}
 	}
 
-	*buf = (*ei).second->buffer;
-	return (*ei).second->length;
+	return (*ei).second->script;
 }
 
 /*
@@ -86,8 +86,7 @@ Runs the script by the given name
 */
 int ICARUS_RunScript( sharedEntity_t *ent, const char *name )
 {
-	char *buf;
-	int len;
+	const CCompiledScript *script;
 
 	//Make sure the caller is valid
 	if ( gSequencers[ent->s.number] == NULL )
@@ -129,17 +128,19 @@ int ICARUS_RunScript( sharedEntity_t *ent, const char *name )
 		strcpy(namex, name);
 	}
 
-	len = ICARUS_GetScript (namex,  &buf);
+	script = ICARUS_GetScript (namex);
 #else
-	len = ICARUS_GetScript (name,  &buf);
+	script = ICARUS_GetScript (name);
 #endif
-	if (len == 0)
+	if (script == NULL)
 	{
 		return false;
 	}
 
+	ICARUS_ProfileRunScript( ent->s.number, name );
+
 	//Attempt to run the script
-	if S_FAILED(gSequencers[ent->s.number]->Run( buf, len ))
+	if S_FAILED(gSequencers[ent->s.number]->Run( script ))
 		return false;
 
 	if ( ( ICARUS_entFilter == -1 ) || ( ICARUS_entFilter == ent->s.number ) )
@@ -206,13 +207,17 @@ void ICARUS_Shutdown( void )
 	//Clear out all precached scripts
 	for ( ei = ICARUS_BufferList.begin(); ei != ICARUS_BufferList.end(); ++ei )
 	{
-		//gi.Free( (*ei).second->buffer );
-		ICARUS_Free((*ei).second->buffer);
+		delete (*ei).second->script;
 		delete (*ei).second;
 	}
 
 	ICARUS_BufferList.clear();
 
+	//Forget the task names interned by the scripts
+	ICARUS_FreeTaskNames();
+
+	ICARUS_ProfileClearEntities();
+
 	//Clear the name map
 	ICARUS_EntList.clear();
 
@@ -339,7 +344,7 @@ void ICARUS_AssociateEnt( sharedEntity_t *ent )
 ==============
 ICARUS_RegisterScript
 
-Loads and caches a script
+Loads, compiles and caches a script
 ==============
 */
 
@@ -404,9 +409,18 @@ bool ICARUS_RegisterScript( const char *name, qboolean bCalledDuringInterrogate
 
 	pscript = new pscript_t;
 
-	pscript->buffer = (char *) ICARUS_Malloc(length);//gi.Malloc(length, TAG_ICARUS, qfalse);
-	memcpy (pscript->buffer, buffer, length);
-	pscript->length = length;
+	//Decode the stream once here, every sequencer running this script shares the result
+	pscript->script = new CCompiledScript;
+
+	if ( !pscript->script->Compile( buffer, length ) )
+	{
+		Com_Printf(S_COLOR_RED"Invalid script file '%s'\n", newname );
+
+		delete pscript->script;
+		delete pscript;
+		FS_FreeFile( buffer );
+		return false;
+	}
 
 	FS_FreeFile( buffer );
 
@@ -472,15 +486,14 @@ void ICARUS_InterrogateScript( const char *filename )
 	if ( ICARUS_RegisterScript( sFilename, qtrue ) == false )	// true = bCalledDuringInterrogate
 		return;
 
-	char	*buf;
-	long	len;
+	const CCompiledScript	*script;
 
 	//Attempt to retrieve the new script data
-	if ( ( len = ICARUS_GetScript ( sFilename,  &buf ) ) == 0 )
+	if ( ( script = ICARUS_GetScript ( sFilename ) ) == NULL )
 		return;
 
 	//Open the stream
-	if ( stream.Open( buf, len ) == qfalse )
+	if ( stream.Open( script ) == qfalse )
 		return;
 
 	const char	*sVal1, *sVal2;
@@ -25,10 +25,11 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include <map>
 #include <string>
 
+class CCompiledScript;
+
 typedef struct pscript_s
 {
-	char	*buffer;
-	long	length;
+	CCompiledScript	*script;
 } pscript_t;
 
 typedef	std::map < std::string, int >		entlist_t;
@@ -39,6 +40,7 @@ extern	interface_export_t	interface_export;
 
 extern	void Interface_Init( interface_export_t *pe );
 extern	int ICARUS_RunScript( sharedEntity_t *ent, const char *name );
+extern	const CCompiledScript *ICARUS_GetScript( const char *name );
 extern	bool ICARUS_RegisterScript( const char *name, qboolean bCalledDuringInterrogate = qfalse);
 extern ICARUS_Instance	*iICARUS;
 extern bufferlist_t		ICARUS_BufferList;
@@ -54,17 +54,16 @@ interface_export_t	interface_export;
 
 /*
 ============
-Q3_ReadScript
-  Description	: Reads in a file and attaches the script directory properly
-  Return type	: static int
+Q3_LoadScript
+  Description	: Gets the compiled form of a script, attaching the script directory properly
+  Return type	: static const CCompiledScript *
   Argument		: const char *name
-  Argument		: void **buf
 ============
 */
-extern int ICARUS_GetScript( const char *name, char **buf );	//g_icarus.cpp
-static int Q3_ReadScript( const char *name, void **buf )
+extern const CCompiledScript *ICARUS_GetScript( const char *name );	//g_icarus.cpp
+static const CCompiledScript *Q3_LoadScript( const char *name )
 {
-	return ICARUS_GetScript( va( "%s/%s", Q3_SCRIPT_DIR, name ), (char**)buf );	//get a (hopefully) cached file
+	return ICARUS_GetScript( va( "%s/%s", Q3_SCRIPT_DIR, name ) );	//get a (hopefully) cached script
 }
 
 /*
@@ -972,7 +971,7 @@ void Interface_Init( interface_export_t *pe )
 	//TODO: This is where you link up all your functions to the engine
 
 	//General
-	pe->I_LoadFile				=	Q3_ReadScript;
+	pe->I_LoadScript			=	Q3_LoadScript;
 	pe->I_CenterPrint			=	Q3_CenterPrint;
 	pe->I_DPrintf				=	Q3_DebugPrint;
 	pe->I_GetEntityByName		=	Q3_GetEntityByName;
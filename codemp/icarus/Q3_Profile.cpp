@@ -0,0 +1,453 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// ICARUS script execution profiler
+
+// this include must remain at the top of every Icarus CPP file
+#include "icarus.h"
+
+#include "server/server.h"
+#include "Q3_Profile.h"
+
+#include <algorithm>
+
+cvar_t	*sv_icarusProfile;
+cvar_t	*sv_icarusProfileDump;
+
+typedef struct icarusProfileCounters_s
+{
+	int		updates;
+	int		tasks;
+	int		waits;
+	int		callbacks;
+	int64_t	callbackTime;
+	int64_t	updateTime;
+	int64_t	maxUpdateTime;
+} icarusProfileCounters_t;
+
+typedef struct icarusProfileStats_s
+{
+	icarusProfileCounters_t	total;
+	icarusProfileCounters_t	interval;	//since the last CSV dump
+} icarusProfileStats_t;
+
+typedef std::map < std::string, icarusProfileStats_t >	scriptStats_m;
+
+static scriptStats_m			scriptStats;
+static icarusProfileStats_t		entStats[MAX_GENTITIES];
+static const char				*entScripts[MAX_GENTITIES];			//Script each entity's cost is charged to
+static icarusProfileStats_t		*entScriptStats[MAX_GENTITIES];
+static icarusProfileStats_t		callbackStats[ID_EOF - ID_AFFECT];
+
+static fileHandle_t				profileFile;
+static int						profileNextDump;
+
+/*
+-------------------------
+ICARUS_ProfileCallbackName
+
+Names the game callback a task ends up in, NULL for tasks handled inside ICARUS
+-------------------------
+*/
+
+static const char *ICARUS_ProfileCallbackName( int taskID )
+{
+	switch ( taskID )
+	{
+	case ID_SET:		return "Q3_Set";
+	case ID_MOVE:		return "Q3_Lerp2Pos";
+	case ID_ROTATE:		return "Q3_Lerp2Angles";
+	case ID_SOUND:		return "Q3_PlaySound";
+	case ID_USE:		return "Q3_Use";
+	case ID_KILL:		return "Q3_Kill";
+	case ID_REMOVE:		return "Q3_Remove";
+	case ID_PLAY:		return "Q3_Play";
+	case ID_PRINT:		return "Q3_CenterPrint";
+	case ID_CAMERA:		return "CGCam";
+	case ID_DECLARE:	return "Q3_DeclareVariable";
+	case ID_FREE:		return "Q3_FreeVariable";
+	default:			return NULL;
+	}
+}
+
+static void ICARUS_ProfileAddUpdate( icarusProfileCounters_t *counters, int64_t usec )
+{
+	counters->updates++;
+	counters->updateTime += usec;
+	counters->maxUpdateTime = Q_max( counters->maxUpdateTime, usec );
+}
+
+static void ICARUS_ProfileAddTask( icarusProfileCounters_t *counters, bool callback, int64_t usec )
+{
+	counters->tasks++;
+
+	if ( callback )
+	{
+		counters->callbacks++;
+		counters->callbackTime += usec;
+	}
+}
+
+/*
+-------------------------
+ICARUS_ProfileRunScript
+
+Charges everything the entity does from now on to the named script
+-------------------------
+*/
+
+void ICARUS_ProfileRunScript( int entID, const char *name )
+{
+	if ( !ICARUS_Profiling() )
+		return;
+
+	scriptStats_m::iterator	si = scriptStats.find( name );
+
+	if ( si == scriptStats.end() )
+	{
+		icarusProfileStats_t	stats = {};
+
+		si = scriptStats.insert( std::make_pair( std::string( name ), stats ) ).first;
+	}
+
+	entScripts[ entID ] = (*si).first.c_str();
+	entScriptStats[ entID ] = &(*si).second;
+}
+
+/*
+-------------------------
+ICARUS_ProfileUpdate
+-------------------------
+*/
+
+void ICARUS_ProfileUpdate( int entID, int64_t usec )
+{
+	ICARUS_ProfileAddUpdate( &entStats[ entID ].total, usec );
+	ICARUS_ProfileAddUpdate( &entStats[ entID ].interval, usec );
+
+	if ( entScriptStats[ entID ] )
+	{
+		ICARUS_ProfileAddUpdate( &entScriptStats[ entID ]->total, usec );
+		ICARUS_ProfileAddUpdate( &entScriptStats[ entID ]->interval, usec );
+	}
+}
+
+/*
+-------------------------
+ICARUS_ProfileTask
+-------------------------
+*/
+
+void ICARUS_ProfileTask( int entID, int taskID, int64_t usec )
+{
+	bool	callback = ( ICARUS_ProfileCallbackName( taskID ) != NULL );
+
+	ICARUS_ProfileAddTask( &entStats[ entID ].total, callback, usec );
+	ICARUS_ProfileAddTask( &entStats[ entID ].interval, callback, usec );
+
+	if ( entScriptStats[ entID ] )
+	{
+		ICARUS_ProfileAddTask( &entScriptStats[ entID ]->total, callback, usec );
+		ICARUS_ProfileAddTask( &entScriptStats[ entID ]->interval, callback, usec );
+	}
+
+	if ( callback )
+	{
+		ICARUS_ProfileAddTask( &callbackStats[ taskID - ID_AFFECT ].total, callback, usec );
+		ICARUS_ProfileAddTask( &callbackStats[ taskID - ID_AFFECT ].interval, callback, usec );
+	}
+}
+
+/*
+-------------------------
+ICARUS_ProfileWait
+
+A wait or waitsignal task that has to be reconsidered next frame
+-------------------------
+*/
+
+void ICARUS_ProfileWait( int entID )
+{
+	entStats[ entID ].total.waits++;
+	entStats[ entID ].interval.waits++;
+
+	if ( entScriptStats[ entID ] )
+	{
+		entScriptStats[ entID ]->total.waits++;
+		entScriptStats[ entID ]->interval.waits++;
+	}
+}
+
+/*
+-------------------------
+ICARUS_ProfileReset
+-------------------------
+*/
+
+void ICARUS_ProfileReset( void )
+{
+	ICARUS_ProfileClearEntities();
+
+	scriptStats.clear();
+	memset( callbackStats, 0, sizeof( callbackStats ) );
+}
+
+/*
+-------------------------
+ICARUS_ProfileClearEntities
+
+Entity numbers are meaningless once the ICARUS instance goes away
+-------------------------
+*/
+
+void ICARUS_ProfileClearEntities( void )
+{
+	memset( entStats, 0, sizeof( entStats ) );
+	memset( entScripts, 0, sizeof( entScripts ) );
+	memset( entScriptStats, 0, sizeof( entScriptStats ) );
+}
+
+/*
+-------------------------
+ICARUS_ProfileDump
+
+Appends the counters gathered since the last dump to the CSV file
+-------------------------
+*/
+
+static void ICARUS_ProfileDumpRow( const char *type, const char *name, int entID, icarusProfileCounters_t *counters )
+{
+	if ( counters->updates || counters->tasks )
+	{
+		FS_Printf( profileFile, "%d,%s,%s,%d,%d,%d,%d,%d,%lld,%lld,%lld\n", svs.time, type, name, entID,
+			counters->updates, counters->tasks, counters->waits, counters->callbacks,
+			(long long)counters->callbackTime, (long long)counters->updateTime, (long long)counters->maxUpdateTime );
+	}
+
+	memset( counters, 0, sizeof( *counters ) );
+}
+
+static void ICARUS_ProfileDump( void )
+{
+	if ( !profileFile )
+	{
+		profileFile = FS_FOpenFileWrite( "icarus_profile.csv" );
+
+		if ( !profileFile )
+		{
+			Com_Printf( S_COLOR_RED "Couldn't open icarus_profile.csv for writing, disabling sv_icarusProfileDump\n" );
+			Cvar_Set( "sv_icarusProfileDump", "0" );
+			return;
+		}
+
+		FS_Printf( profileFile, "time,type,name,entity,updates,tasks,waits,callbacks,callbackUsec,updateUsec,maxUpdateUsec\n" );
+	}
+
+	for ( scriptStats_m::iterator si = scriptStats.begin(); si != scriptStats.end(); ++si )
+	{
+		ICARUS_ProfileDumpRow( "script", (*si).first.c_str(), -1, &(*si).second.interval );
+	}
+
+	for ( int i = 0; i < MAX_GENTITIES; i++ )
+	{
+		ICARUS_ProfileDumpRow( "entity", entScripts[ i ] ? entScripts[ i ] : "", i, &entStats[ i ].interval );
+	}
+
+	for ( int i = 0; i < ID_EOF - ID_AFFECT; i++ )
+	{
+		const char *name = ICARUS_ProfileCallbackName( i + ID_AFFECT );
+
+		if ( name )
+		{
+			ICARUS_ProfileDumpRow( "callback", name, -1, &callbackStats[ i ].interval );
+		}
+	}
+
+	FS_Flush( profileFile );
+}
+
+/*
+-------------------------
+ICARUS_ProfileFrame
+
+Called once per server frame to handle the periodic CSV dump
+-------------------------
+*/
+
+void ICARUS_ProfileFrame( void )
+{
+	if ( !ICARUS_Profiling() || sv_icarusProfileDump->integer <= 0 )
+	{
+		if ( profileFile )
+		{
+			FS_FCloseFile( profileFile );
+			profileFile = 0;
+		}
+
+		profileNextDump = 0;
+		return;
+	}
+
+	if ( profileNextDump && svs.time < profileNextDump )
+		return;
+
+	if ( profileNextDump )
+	{
+		ICARUS_ProfileDump();
+	}
+
+	profileNextDump = svs.time + sv_icarusProfileDump->integer * 1000;
+}
+
+/*
+-------------------------
+Svcmd_ICARUSProfile_f
+-------------------------
+*/
+
+typedef std::pair < const icarusProfileCounters_t *, const char * >	scriptEntry_t;
+typedef std::pair < const icarusProfileCounters_t *, int >			entityEntry_t;
+
+template < class T > static bool ICARUS_ProfileSortByTime( const T &a, const T &b )
+{
+	return a.first->updateTime > b.first->updateTime;
+}
+
+static void ICARUS_ProfilePrintScripts( int count )
+{
+	std::vector < scriptEntry_t >	entries;
+
+	for ( scriptStats_m::iterator si = scriptStats.begin(); si != scriptStats.end(); ++si )
+	{
+		entries.push_back( std::make_pair( &(*si).second.total, (*si).first.c_str() ) );
+	}
+
+	std::sort( entries.begin(), entries.end(), ICARUS_ProfileSortByTime < scriptEntry_t > );
+
+	Com_Printf( "%-32s %8s %8s %8s %8s %10s %10s %8s\n", "script", "updates", "tasks", "waits", "calls", "call us", "total us", "max us" );
+
+	for ( int i = 0; i < (int)entries.size() && i < count; i++ )
+	{
+		const icarusProfileCounters_t *c = entries[ i ].first;
+
+		Com_Printf( "%-32s %8d %8d %8d %8d %10lld %10lld %8lld\n", entries[ i ].second, c->updates, c->tasks, c->waits, c->callbacks,
+			(long long)c->callbackTime, (long long)c->updateTime, (long long)c->maxUpdateTime );
+	}
+}
+
+static void ICARUS_ProfilePrintEntities( int count )
+{
+	std::vector < entityEntry_t >	entries;
+
+	for ( int i = 0; i < MAX_GENTITIES; i++ )
+	{
+		if ( entStats[ i ].total.updates )
+		{
+			entries.push_back( std::make_pair( &entStats[ i ].total, i ) );
+		}
+	}
+
+	std::sort( entries.begin(), entries.end(), ICARUS_ProfileSortByTime < entityEntry_t > );
+
+	Com_Printf( "%4s %-20s %-20s %-24s %8s %8s %8s %10s %8s\n", "num", "classname", "targetname", "script", "tasks", "waits", "calls", "total us", "max us" );
+
+	for ( int i = 0; i < (int)entries.size() && i < count; i++ )
+	{
+		const icarusProfileCounters_t	*c = entries[ i ].first;
+		int								entID = entries[ i ].second;
+		sharedEntity_t					*ent = SV_GentityNum( entID );
+
+		Com_Printf( "%4d %-20s %-20s %-24s %8d %8d %8d %10lld %8lld\n", entID,
+			ent->classname ? ent->classname : "", ent->targetname ? ent->targetname : "", entScripts[ entID ] ? entScripts[ entID ] : "",
+			c->tasks, c->waits, c->callbacks, (long long)c->updateTime, (long long)c->maxUpdateTime );
+	}
+}
+
+static void ICARUS_ProfilePrintCallbacks( void )
+{
+	Com_Printf( "%-20s %8s %10s\n", "callback", "calls", "total us" );
+
+	for ( int i = 0; i < ID_EOF - ID_AFFECT; i++ )
+	{
+		const char *name = ICARUS_ProfileCallbackName( i + ID_AFFECT );
+
+		if ( name && callbackStats[ i ].total.callbacks )
+		{
+			Com_Printf( "%-20s %8d %10lld\n", name, callbackStats[ i ].total.callbacks, (long long)callbackStats[ i ].total.callbackTime );
+		}
+	}
+}
+
+static void Svcmd_ICARUSProfile_f( void )
+{
+	const char	*cmd = Cmd_Argv( 1 );
+	int			count = ( Cmd_Argc() > 2 ) ? atoi( Cmd_Argv( 2 ) ) : 10;
+
+	if ( !Q_stricmp( cmd, "reset" ) )
+	{
+		ICARUS_ProfileReset();
+		Com_Printf( "ICARUS profile reset\n" );
+		return;
+	}
+
+	if ( !ICARUS_Profiling() )
+	{
+		Com_Printf( "ICARUS profiling is disabled, set sv_icarusProfile 1 to enable it\n" );
+	}
+
+	if ( !Q_stricmp( cmd, "scripts" ) )
+	{
+		ICARUS_ProfilePrintScripts( count );
+	}
+	else if ( !Q_stricmp( cmd, "entities" ) )
+	{
+		ICARUS_ProfilePrintEntities( count );
+	}
+	else if ( !Q_stricmp( cmd, "callbacks" ) )
+	{
+		ICARUS_ProfilePrintCallbacks();
+	}
+	else if ( !cmd[0] )
+	{
+		ICARUS_ProfilePrintScripts( count );
+		Com_Printf( "\n" );
+		ICARUS_ProfilePrintEntities( count );
+		Com_Printf( "\n" );
+		ICARUS_ProfilePrintCallbacks();
+	}
+	else
+	{
+		Com_Printf( "usage: icarusprofile [scripts|entities|callbacks|reset] [count]\n" );
+	}
+}
+
+/*
+-------------------------
+ICARUS_ProfileInit
+-------------------------
+*/
+
+void ICARUS_ProfileInit( void )
+{
+	sv_icarusProfile = Cvar_Get( "sv_icarusProfile", "0", 0, "Gather per script and per entity ICARUS execution statistics" );
+	sv_icarusProfileDump = Cvar_Get( "sv_icarusProfileDump", "0", 0, "Seconds between ICARUS profile dumps to icarus_profile.csv, 0 to disable" );
+
+	Cmd_AddCommand( "icarusprofile", Svcmd_ICARUSProfile_f, "Print the ICARUS script execution profile" );
+}
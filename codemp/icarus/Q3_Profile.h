@@ -0,0 +1,45 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+#pragma once
+
+// ICARUS script execution profiler
+//
+// Counts tasks, waits and game callbacks per script file and per entity, and
+// the wall time spent in CTaskManager::Update. Enabled with sv_icarusProfile,
+// reported with the icarusprofile command and optionally dumped to a CSV file
+// every sv_icarusProfileDump seconds.
+
+extern cvar_t	*sv_icarusProfile;
+
+void ICARUS_ProfileInit( void );
+void ICARUS_ProfileReset( void );
+void ICARUS_ProfileClearEntities( void );
+void ICARUS_ProfileFrame( void );
+
+void ICARUS_ProfileRunScript( int entID, const char *name );
+void ICARUS_ProfileUpdate( int entID, int64_t usec );
+void ICARUS_ProfileTask( int entID, int taskID, int64_t usec );
+void ICARUS_ProfileWait( int entID );
+
+inline bool ICARUS_Profiling( void )
+{
+	return ( sv_icarusProfile && sv_icarusProfile->integer );
+}
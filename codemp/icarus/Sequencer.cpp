@@ -324,7 +324,7 @@ Run
 Runs a script
 ========================
 */
-int CSequencer::Run( char *buffer, long size )
+int CSequencer::Run( const CCompiledScript *script )
 {
 	bstream_t		*blockStream;
 
@@ -333,8 +333,8 @@ int CSequencer::Run( char *buffer, long size )
 	//Create a new stream
 	blockStream = AddStream();
 
-	//Open the stream as an IBI stream
-	if (!blockStream->stream->Open( buffer, size ))
+	//Open the stream on the shared compiled script
+	if (!blockStream->stream->Open( script ))
 	{
 		m_ie->I_DPrintf( WL_ERROR, "invalid stream" );
 		return SEQ_FAILED;
@@ -364,17 +364,16 @@ int CSequencer::ParseRun( CBlock *block )
 {
 	CSequence	*new_sequence;
 	bstream_t	*new_stream;
-	char		*buffer;
+	const CCompiledScript	*script;
 	char		newname[ MAX_STRING_SIZE ];
-	int			buffer_size;
 
 	//Get the name and format it
 	COM_StripExtension( (char*) block->GetMemberData( 0 ), (char *) newname, sizeof(newname) );
 
-	//Get the file from the game engine
-  	buffer_size = m_ie->I_LoadFile( newname, (void **) &buffer );
+	//Get the compiled script from the game engine
+	script = m_ie->I_LoadScript( newname );
 
-	if ( buffer_size <= 0 )
+	if ( script == NULL )
 	{
 		m_ie->I_DPrintf( WL_ERROR, "'%s' : could not open file\n", (char*) block->GetMemberData( 0 ));
 		delete block;
@@ -386,7 +385,7 @@ int CSequencer::ParseRun( CBlock *block )
 	new_stream = AddStream();
 
 	//Begin streaming the file
-	if (!new_stream->stream->Open( buffer, buffer_size ))
+	if (!new_stream->stream->Open( script ))
 	{
 		m_ie->I_DPrintf( WL_ERROR, "invalid stream" );
 		delete block;
@@ -754,17 +753,13 @@ int CSequencer::ParseTask( CBlock *block, bstream_t *bstream )
 {
 	CSequence	*sequence;
 	CTaskGroup	*group;
-	const char	*taskName;
 
 	//Setup the container sequence
 	sequence = AddSequence( m_curSequence, m_curSequence, SQ_TASK | SQ_RETAIN );
 	m_curSequence->AddChild( sequence );
 
-	//Get the name of this task for reference later
-	taskName = (const char *) block->GetMemberData( 0 );
-
-	//Get a new task group from the task manager
-	group = m_taskManager->AddTaskGroup( taskName );
+	//Get a new task group from the task manager, keyed on this task's interned name
+	group = m_taskManager->AddTaskGroup( block );
 
 	if ( group == NULL )
 	{
@@ -1911,7 +1906,7 @@ void CSequencer::CheckDo( CBlock **command )
 	{
 		//Get the sequence
 		const char	*groupName = (const char *) block->GetMemberData( 0 );
-		CTaskGroup	*group = m_taskManager->GetTaskGroup( groupName );
+		CTaskGroup	*group = m_taskManager->GetTaskGroup( block );
 		CSequence	*sequence = GetTaskSequence( group );
 
 		//TODO: Emit warning
@@ -28,12 +28,80 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include <assert.h>
 #include "server/server.h"
+#include "Q3_Profile.h"
 
 #define ICARUS_VALIDATE(a) if ( a == false ) return TASK_FAILED;
 
 /*
 =================================================
 
+Task names
+
+=================================================
+*/
+
+typedef std::map < std::string, int >	taskNameID_m;
+
+static taskNameID_m					taskNameIDs;
+static std::vector < std::string >	taskNames;
+
+/*
+-------------------------
+ICARUS_GetTaskNameID
+
+Returns the interned id for a task name, or -1 if it is unknown and create is false
+-------------------------
+*/
+
+int ICARUS_GetTaskNameID( const char *name, bool create )
+{
+	taskNameID_m::iterator	tni;
+
+	tni = taskNameIDs.find( name );
+
+	if ( tni != taskNameIDs.end() )
+		return (*tni).second;
+
+	if ( !create )
+		return -1;
+
+	int id = (int)taskNames.size();
+
+	taskNames.push_back( name );
+	taskNameIDs[ name ] = id;
+
+	return id;
+}
+
+/*
+-------------------------
+ICARUS_GetTaskName
+-------------------------
+*/
+
+const char *ICARUS_GetTaskName( int id )
+{
+	if ( id < 0 || id >= (int)taskNames.size() )
+		return "";
+
+	return taskNames[ id ].c_str();
+}
+
+/*
+-------------------------
+ICARUS_FreeTaskNames
+-------------------------
+*/
+
+void ICARUS_FreeTaskNames( void )
+{
+	taskNameIDs.clear();
+	taskNames.clear();
+}
+
+/*
+=================================================
+
 CTask
 
 =================================================
@@ -253,12 +321,22 @@ AddTaskGroup
 */
 
 CTaskGroup *CTaskManager::AddTaskGroup( const char *name )
+{
+	return AddTaskGroup( ICARUS_GetTaskNameID( name, true ) );
+}
+
+CTaskGroup *CTaskManager::AddTaskGroup( CBlock *block )
+{
+	return AddTaskGroup( block->GetNameID() );
+}
+
+CTaskGroup *CTaskManager::AddTaskGroup( int nameID )
 {
 	CTaskGroup *group;
 
 	//Collect any garbage
 	taskGroupName_m::iterator	tgni;
-	tgni = m_taskGroupNameMap.find( name );
+	tgni = m_taskGroupNameMap.find( nameID );
 
 	if ( tgni != m_taskGroupNameMap.end() )
 	{
@@ -277,7 +355,7 @@ CTaskGroup *CTaskManager::AddTaskGroup( const char *name )
 	assert( group );
 	if ( group == NULL )
 	{
-		(m_owner->GetInterface())->I_DPrintf( WL_ERROR, "Unable to allocate task group \"%s\"\n", name );
+		(m_owner->GetInterface())->I_DPrintf( WL_ERROR, "Unable to allocate task group \"%s\"\n", ICARUS_GetTaskName( nameID ) );
 		return NULL;
 	}
 
@@ -286,7 +364,7 @@ CTaskGroup *CTaskManager::AddTaskGroup( const char *name )
 
 	//Add it to the list and associate it for retrieval later
 	m_taskGroups.insert( m_taskGroups.end(), group );
-	m_taskGroupNameMap[ name ] = group;
+	m_taskGroupNameMap[ nameID ] = group;
 	m_taskGroupIDMap[ group->GetGUID() ] = group;
 
 	return group;
@@ -299,14 +377,32 @@ GetTaskGroup
 */
 
 CTaskGroup *CTaskManager::GetTaskGroup( const char *name )
+{
+	int nameID = ICARUS_GetTaskNameID( name, false );
+
+	if ( nameID == -1 )
+	{
+		(m_owner->GetInterface())->I_DPrintf( WL_WARNING, "Could not find task group \"%s\"\n", name );
+		return NULL;
+	}
+
+	return GetTaskGroupByName( nameID );
+}
+
+CTaskGroup *CTaskManager::GetTaskGroup( CBlock *block )
+{
+	return GetTaskGroupByName( block->GetNameID() );
+}
+
+CTaskGroup *CTaskManager::GetTaskGroupByName( int nameID )
 {
 	taskGroupName_m::iterator	tgi;
 
-	tgi = m_taskGroupNameMap.find( name );
+	tgi = m_taskGroupNameMap.find( nameID );
 
 	if ( tgi == m_taskGroupNameMap.end() )
 	{
-		(m_owner->GetInterface())->I_DPrintf( WL_WARNING, "Could not find task group \"%s\"\n", name );
+		(m_owner->GetInterface())->I_DPrintf( WL_WARNING, "Could not find task group \"%s\"\n", ICARUS_GetTaskName( nameID ) );
 		return NULL;
 	}
 
@@ -345,7 +441,20 @@ int CTaskManager::Update( void )
 	m_count = 0;	//Needed for runaway init
 	m_resident = true;
 
-	int returnVal = Go();
+	int returnVal;
+
+	if ( ICARUS_Profiling() )
+	{
+		int64_t startTime = Sys_Microseconds();
+
+		returnVal = Go();
+
+		ICARUS_ProfileUpdate( m_ownerID, Sys_Microseconds() - startTime );
+	}
+	else
+	{
+		returnVal = Go();
+	}
 
 	m_resident = false;
 
@@ -716,6 +825,8 @@ int	CTaskManager::Go( void )
 {
 	CTask	*task = NULL;
 	bool	completed = false;
+	bool	profiling = ICARUS_Profiling();
+	int64_t	startTime = 0;
 
 	//Check for run away scripts
 	if ( m_count++ > RUNAWAY_LIMIT )
@@ -742,6 +853,9 @@ int	CTaskManager::Go( void )
 		if ( task->GetTimeStamp() == 0 )
 			task->SetTimeStamp( ( m_owner->GetInterface())->I_GetTime() );
 
+		if ( profiling )
+			startTime = Sys_Microseconds();
+
 		//Switch and call the proper function
 		switch( task->GetID() )
 		{
@@ -752,6 +866,9 @@ int	CTaskManager::Go( void )
 			//Push it to consider it again on the next frame if not complete
 			if ( completed == false )
 			{
+				if ( profiling )
+					ICARUS_ProfileWait( m_ownerID );
+
 				PushTask( task, PUSH_BACK );
 				return TASK_OK;
 			}
@@ -767,6 +884,9 @@ int	CTaskManager::Go( void )
 			//Push it to consider it again on the next frame if not complete
 			if ( completed == false )
 			{
+				if ( profiling )
+					ICARUS_ProfileWait( m_ownerID );
+
 				PushTask( task, PUSH_BACK );
 				return TASK_OK;
 			}
@@ -835,6 +955,10 @@ int	CTaskManager::Go( void )
 			break;
 		}
 
+		//Only the task itself is timed, the sequencer pump below can run further tasks
+		if ( profiling )
+			ICARUS_ProfileTask( m_ownerID, task->GetID(), Sys_Microseconds() - startTime );
+
 		//Pump the sequencer for another task
 		CallbackCommand( task, TASK_RETURN_COMPLETE );
 
@@ -1771,7 +1895,7 @@ void CTaskManager::Save( void )
 	numWritten = 0;
 	STL_ITERATE( tmi, m_taskGroupNameMap )
 	{
-		name = ((*tmi).first).c_str();
+		name = ICARUS_GetTaskName( (*tmi).first );
 
 		//Make sure this is a valid string
 		assert( ( name != NULL ) && ( name[0] != NULL ) );
@@ -1998,7 +2122,7 @@ void CTaskManager::Load( void )
 		taskGroup = GetTaskGroup( id );
 		assert( taskGroup );
 
-		m_taskGroupNameMap[ name ] = taskGroup;
+		m_taskGroupNameMap[ ICARUS_GetTaskNameID( name, true ) ] = taskGroup;
 		m_taskGroupIDMap[ taskGroup->GetGUID() ] = taskGroup;
 	}
 
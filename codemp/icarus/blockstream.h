@@ -50,13 +50,22 @@ enum
 
 // CBlockMember
 
+// Blocks hold their members by value, so a member is moved rather than copied;
+// Duplicate makes a real copy.
+
 class CBlockMember
 {
 public:
 
 	CBlockMember();
+	CBlockMember( CBlockMember &&other );
 	~CBlockMember();
 
+	CBlockMember &operator=( CBlockMember &&other );
+
+	CBlockMember( const CBlockMember & ) = delete;
+	CBlockMember &operator=( const CBlockMember & ) = delete;
+
 	void Free( void );
 
 	int WriteMember ( FILE * );				//Writes the member's data, in block format, to FILE *
@@ -72,6 +81,8 @@ public:
 	void SetData( vector_t );
 	void SetData( void *data, int size );
 
+	void SetSharedData( int id, int size, const void *data );	//Points the member at data owned by a compiled script
+
 	int	GetID( void )		const	{	return m_id;	}	//Get ID member variables
 	void *GetData( void )	const	{	return m_data;	}	//Get data member variable
 	int	GetSize( void )		const	{	return m_size;	}	//Get size member variable
@@ -86,44 +97,43 @@ public:
 		Z_Free( pRawData );
 	}
 
-	CBlockMember *Duplicate( void );
+	void Duplicate( CBlockMember &dest ) const;
 
 	template <class T> void WriteData(T &data)
 	{
-		if ( m_data )
-		{
-			ICARUS_Free( m_data );
-		}
+		FreeData();
 
 		m_data = ICARUS_Malloc( sizeof(T) );
 		*((T *) m_data) = data;
 		m_size = sizeof(T);
+		m_ownsData = true;
 	}
 
 	template <class T> void WriteDataPointer(const T *data, int num)
 	{
-		if ( m_data )
-		{
-			ICARUS_Free( m_data );
-		}
+		FreeData();
 
 		m_data = ICARUS_Malloc( num*sizeof(T) );
 		memcpy( m_data, data, num*sizeof(T) );
 		m_size = num*sizeof(T);
+		m_ownsData = true;
 	}
 
 protected:
 
+	void FreeData( void );
+
 	int		m_id;		//ID of the value contained in data
 	int		m_size;		//Size of the data member variable
 	void	*m_data;	//Data for this member
+	bool	m_ownsData;	//False if m_data lives in a shared compiled script
 };
 
 //CBlock
 
 class CBlock
 {
-	typedef std::vector< CBlockMember * >	blockMember_v;
+	typedef std::vector< CBlockMember >	blockMember_v;
 
 public:
 
@@ -141,17 +151,20 @@ public:
 	int Write( int, float );
 	int Write( int, const char * );
 	int Write( int, int );
-	int Write( CBlockMember * );
 
 	//Member push / pop functions
 
-	int AddMember( CBlockMember * );
+	CBlockMember &AddMember( void );
+	CBlockMember *AddMembers( int count );	//Appends count empty members in one go, returns the first
 	CBlockMember *GetMember( int memberNum );
 
 	void	*GetMemberData( int memberNum );
 
 	CBlock *Duplicate( void );
 
+	int GetNameID( void );	//Interned id of the task name held in the first member (task / do blocks)
+	void SetNameID( int id )	{	m_nameID = id;	}
+
 	int	GetBlockID( void )		const	{	return m_id;			}	//Get the ID for the block
 	int	GetNumMembers( void )	const	{	return (int)m_members.size();}	//Get the number of member in the block's list
 
@@ -163,11 +176,66 @@ public:
 
 protected:
 
-	blockMember_v				m_members;			//List of all CBlockMembers owned by this list
+	blockMember_v				m_members;			//All of the block's members, in order
 	int							m_id;				//ID of the block
+	int							m_nameID;			//Interned task name, -1 until resolved
 	unsigned char				m_flags;
 };
 
+// CCompiledScript
+
+// Flat, immutable form of an IBI stream. A script is compiled once when it is
+// registered and shared by every sequencer that runs it; blocks read from it
+// reference its data instead of copying it.
+
+class CCompiledScript
+{
+public:
+
+	typedef struct member_s
+	{
+		int		id;
+		int		size;
+		int		offset;			//Offset of the member's data in m_data
+	} member_t;
+
+	typedef struct block_s
+	{
+		int				id;
+		int				firstMember;	//Index of the block's first member in m_members
+		int				numMembers;
+		int				nameID;			//Interned task name for task / do blocks, -1 otherwise
+		unsigned char	flags;
+	} block_t;
+
+	CCompiledScript();
+	~CCompiledScript();
+
+	int Compile( const char *buffer, long size );
+	void Free( void );
+
+	int GetNumBlocks( void )					const	{	return (int)m_blocks.size();	}
+	const block_t &GetBlock( int blockNum )		const	{	return m_blocks[ blockNum ];	}
+	const member_t &GetMember( int memberNum )	const	{	return m_members[ memberNum ];	}
+	const void *GetMemberData( const member_t &member )	const	{	return m_data.data() + member.offset;	}
+
+	inline void *operator new( size_t size )
+	{	// Allocate the memory.
+		return Z_Malloc( size, TAG_ICARUS, qtrue );
+	}
+	// Overloaded delete operator.
+	inline void operator delete( void *pRawData )
+	{	// Free the Memory.
+		Z_Free( pRawData );
+	}
+
+protected:
+
+	std::vector< block_t >		m_blocks;
+	std::vector< member_t >		m_members;
+	std::vector< char >			m_data;
+};
+
 // CBlockStream
 
 class CBlockStream
@@ -190,6 +258,7 @@ public:
 	int ReadBlock( CBlock * );	//Read the block in
 
 	int Open( char *, long );	//Open a stream for reading / writing
+	int Open( const CCompiledScript * );	//Open a compiled script for reading
 
 protected:
 
@@ -206,4 +275,7 @@ protected:
 
 	char	*m_stream;							//Stream of data to be parsed
 	int		m_streamPos;
+
+	const CCompiledScript	*m_script;			//Compiled script being read, if any
+	int						m_blockNum;			//Next block to read from m_script
 };
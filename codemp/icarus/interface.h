@@ -28,11 +28,12 @@ typedef	float vec3_t[3];
 
 class CSequencer;
 class CTaskManager;
+class CCompiledScript;
 
 typedef struct interface_export_s
 {
 	//General
-	int				(*I_LoadFile)( const char *name, void **buf );
+	const CCompiledScript *(*I_LoadScript)( const char *name );		//Gets the cached, compiled form of a script
 	void			(*I_CenterPrint)( const char *format, ... );
 	void			(*I_DPrintf)( int, const char *, ... );
 	sharedEntity_t *(*I_GetEntityByName)( const char *name );		//Polls the engine for the sequencer of the entity matching the name passed
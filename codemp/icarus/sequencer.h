@@ -91,7 +91,7 @@ public:
 	static CSequencer *Create ( void );
 	int Free( void );
 
-	int Run( char *buffer, long size );
+	int Run( const CCompiledScript *script );
 	int Callback( CTaskManager *taskManager, CBlock *block, int returnCode );
 
 	ICARUS_Instance	*GetOwner( void )	{	return m_owner;	}
@@ -36,6 +36,11 @@ class CSequencer;
 
 const int RUNAWAY_LIMIT	= 256;
 
+// Task names are interned once per session so task groups can be found by integer id
+int ICARUS_GetTaskNameID( const char *name, bool create );
+const char *ICARUS_GetTaskName( int id );
+void ICARUS_FreeTaskNames( void );
+
 enum
 {
 	TASK_RETURN_COMPLETE,
@@ -120,7 +125,7 @@ class CTaskManager
 {
 
 	typedef	std::map < int, CTask * >			taskID_m;
-	typedef std::map < std::string, CTaskGroup * >	taskGroupName_m;
+	typedef std::map < int, CTaskGroup * >			taskGroupName_m;
 	typedef std::map < int, CTaskGroup * >		taskGroupID_m;
 	typedef std::vector < CTaskGroup * >			taskGroup_v;
 	typedef std::list < CTask *>					tasks_l;
@@ -146,7 +151,9 @@ public:
 	qboolean IsRunning( void );
 
 	CTaskGroup *AddTaskGroup( const char *name );
+	CTaskGroup *AddTaskGroup( CBlock *block );
 	CTaskGroup *GetTaskGroup( const char *name );
+	CTaskGroup *GetTaskGroup( CBlock *block );
 	CTaskGroup *GetTaskGroup( int id );
 
 	int MarkTask( int id, int operation );
@@ -166,6 +173,9 @@ protected:
 	int GetFloat( int entID, CBlock *block, int &memberNum, float &value );
 	int Get( int entID, CBlock *block, int &memberNum, char **value );
 
+	CTaskGroup *AddTaskGroup( int nameID );
+	CTaskGroup *GetTaskGroupByName( int nameID );
+
 	int	PushTask( CTask *task, int flag );
 	CTask *PopTask( int flag );
 
@@ -1044,6 +1044,35 @@ fileHandle_t FS_FOpenFileWrite( const char *filename, qboolean safe ) {
 	return f;
 }
 
+/*
+===========
+FS_FOpenStdioWrite
+
+Opens a file in the home path like FS_FOpenFileWrite, but hands back the stdio
+file instead of a handle, for writing from another thread.  The caller closes
+it with fclose.
+===========
+*/
+FILE *FS_FOpenStdioWrite( const char *filename ) {
+	char *ospath;
+
+	FS_AssertInitialised();
+
+	ospath = FS_BuildOSPath( fs_homepath->string, fs_gamedir, filename );
+
+	if ( fs_debug->integer ) {
+		Com_Printf( "FS_FOpenStdioWrite: %s\n", ospath );
+	}
+
+	FS_CheckFilenameIsMutable( ospath, __func__ );
+
+	if ( FS_CreatePath( ospath ) ) {
+		return NULL;
+	}
+
+	return fopen( ospath, "wb" );
+}
+
 /*
 ===========
 FS_FOpenFileAppend
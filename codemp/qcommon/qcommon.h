@@ -578,6 +578,8 @@ int		FS_GetModList(  char *listbuf, int bufsize );
 
 fileHandle_t	FS_FOpenFileWrite( const char *qpath, qboolean safe=qtrue );
 // will properly create any needed paths and deal with seperater character issues
+FILE			*FS_FOpenStdioWrite( const char *qpath );
+// a plain stdio file in the home path, for other threads to write without the handle table
 
 int		FS_filelength( fileHandle_t f );
 fileHandle_t FS_SV_FOpenFileWrite( const char *filename );
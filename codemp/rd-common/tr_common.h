@@ -51,7 +51,23 @@ float GetNoiseTime( int t );
 // Initialize the image loader.
 void R_ImageLoader_Init();
 
-typedef void (*ImageLoaderFn)( const char *filename, byte **pic, int *width, int *height );
+// An image file that has been read in, and what decoding it produced.  The
+// decoders don't touch the file system, the zone or the console, so they can
+// be run off the main thread.
+typedef struct imageFile_s {
+	char		name[MAX_QPATH];
+	byte		*buffer;		// file contents, the decoder may modify them
+	int			len;
+
+	byte		*pic;			// RGBA, free with R_FreeImage
+	int			width;
+	int			height;
+
+	qboolean	fatal;			// the error should drop the game
+	char		error[256];
+} imageFile_t;
+
+typedef void (*ImageLoaderFn)( imageFile_t *image );
 
 // Adds a new image loader to handle a new image type. The extension should not
 // begin with a period (a full stop).
@@ -60,14 +76,27 @@ qboolean R_ImageLoader_Add( const char *extension, ImageLoaderFn imageLoader );
 // Load an image from file.
 void R_LoadImage( const char *shortname, byte **pic, int *width, int *height );
 
-// Load raw image data from TGA image.
-void LoadTGA( const char *name, byte **pic, int *width, int *height );
+// Read the file R_LoadImage would decode without decoding it, returns the
+// decoder to use or NULL if there's no such image.
+ImageLoaderFn R_ReadImage( const char *shortname, imageFile_t *image );
+
+// Print the decoder's error, if it had one.
+void R_ReportImageError( const imageFile_t *image );
+
+// Record a decoding error, safe to call off the main thread.
+void QDECL R_ImageError( imageFile_t *image, const char *fmt, ... );
+
+// Free image data returned by R_LoadImage or a decoder.
+void R_FreeImage( byte *pic );
+
+// Decode raw image data from TGA image.
+void LoadTGA( imageFile_t *image );
 
-// Load raw image data from JPEG image.
-void LoadJPG( const char *filename, byte **pic, int *width, int *height );
+// Decode raw image data from JPEG image.
+void LoadJPG( imageFile_t *image );
 
-// Load raw image data from PNG image.
-void LoadPNG( const char *filename, byte **data, int *width, int *height );
+// Decode raw image data from PNG image.
+void LoadPNG( imageFile_t *image );
 
 
 /*
@@ -33,6 +33,15 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
  */
 
 #include <jpeglib.h>
+#include <setjmp.h>
+
+/* libjpeg must not carry on after an error, so error_exit jumps back to
+ * whoever started the decode or encode, which then destroys the object.
+ */
+typedef struct jpegError_s {
+	struct jpeg_error_mgr	pub;
+	jmp_buf					jump;
+} jpegError_t;
 
 static void R_JPGErrorExit(j_common_ptr cinfo)
 {
@@ -40,10 +49,12 @@ static void R_JPGErrorExit(j_common_ptr cinfo)
 
 	(*cinfo->err->format_message) (cinfo, buffer);
 
-	/* Let the memory manager delete any temp files before we die */
-	jpeg_destroy(cinfo);
+	if (cinfo->client_data)
+		R_ImageError((imageFile_t *)cinfo->client_data, "%s", buffer);
+	else
+		Com_Printf("%s", buffer);
 
-	Com_Printf("%s", buffer);
+	longjmp(((jpegError_t *)cinfo->err)->jump, 1);
 }
 
 static void R_JPGOutputMessage(j_common_ptr cinfo)
@@ -53,11 +64,14 @@ static void R_JPGOutputMessage(j_common_ptr cinfo)
 	/* Create the message */
 	(*cinfo->err->format_message) (cinfo, buffer);
 
-	/* Send it to stderr, adding a newline */
-	Com_Printf("%s\n", buffer);
+	/* Keep it for the main thread when decoding, adding a newline */
+	if (cinfo->client_data)
+		R_ImageError((imageFile_t *)cinfo->client_data, "%s\n", buffer);
+	else
+		Com_Printf("%s\n", buffer);
 }
 
-void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height ) {
+void LoadJPG( imageFile_t *image ) {
 	/* This struct contains the JPEG decompression parameters and pointers to
 	* working space (which is allocated as needed by the JPEG library).
 	*/
@@ -74,25 +88,16 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 	* Note that this struct must live as long as the main JPEG parameter
 	* struct, to avoid dangling-pointer problems.
 	*/
-	struct jpeg_error_mgr jerr;
+	jpegError_t jerr;
 	/* More stuff */
 	JSAMPARRAY buffer;		/* Output row buffer */
 	unsigned int row_stride;  /* physical row width in output buffer */
 	unsigned int pixelcount, memcount;
 	unsigned int sindex, dindex;
 	byte *out;
-	fileBuffer_t fbuffer;
 	byte  *buf;
-	/* In this example we want to open the input file before doing anything else,
-	* so that the setjmp() error recovery below can assume the file is open.
-	* VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-	* requires it in order to read binary files.
-	*/
 
-	int len = ri->FS_ReadFile ( ( char * ) filename, &fbuffer.v);
-	if (!fbuffer.b || len < 0) {
-		return;
-	}
+	image->pic = NULL;
 
 	/* Step 1: allocate and initialize JPEG decompression object */
 
@@ -101,16 +106,27 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 	* This routine fills in the contents of struct jerr, and returns jerr's
 	* address which we place into the link field in cinfo.
 	*/
-	cinfo.err = jpeg_std_error(&jerr);
+	cinfo.err = jpeg_std_error(&jerr.pub);
 	cinfo.err->error_exit = R_JPGErrorExit;
 	cinfo.err->output_message = R_JPGOutputMessage;
+	cinfo.client_data = image;
+
+	/* A broken file ends up here, pic is set as soon as it's allocated so it
+	* can be freed
+	*/
+	if (setjmp(jerr.jump)) {
+		jpeg_destroy_decompress(&cinfo);
+		free(image->pic);
+		image->pic = NULL;
+		return;
+	}
 
 	/* Now we can initialize the JPEG decompression object. */
 	jpeg_create_decompress(&cinfo);
 
 	/* Step 2: specify data source (eg, a file) */
 
-	jpeg_mem_src(&cinfo, fbuffer.b, len);
+	jpeg_mem_src(&cinfo, image->buffer, image->len);
 
 	/* Step 3: read file parameters with jpeg_read_header() */
 
@@ -150,10 +166,9 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 		)
 	{
 		// Free the memory to make sure we don't leak memory
-		ri->FS_FreeFile (fbuffer.v);
 		jpeg_destroy_decompress(&cinfo);
 
-		Com_Printf("LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d", filename,
+		R_ImageError(image, "LoadJPG: %s has an invalid image format: %dx%d*4=%d, components: %d\n", image->name,
 			cinfo.output_width, cinfo.output_height, pixelcount * 4, cinfo.output_components);
 		return;
 	}
@@ -161,10 +176,11 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 	memcount = pixelcount * 4;
 	row_stride = cinfo.output_width * cinfo.output_components;
 
-	out = (byte *)Z_Malloc(memcount, TAG_TEMP_WORKSPACE, qfalse);
+	out = (byte *)malloc(memcount);
+	image->pic = out;
 
-	*width = cinfo.output_width;
-	*height = cinfo.output_height;
+	image->width = cinfo.output_width;
+	image->height = cinfo.output_height;
 
 	/* Step 6: while (scan lines remain to be read) */
 	/*           jpeg_read_scanlines(...); */
@@ -194,8 +210,6 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 		buf[--dindex] = buf[--sindex];
 	} while(sindex);
 
-	*pic = out;
-
 	/* Step 7: Finish decompression */
 
 	(void) jpeg_finish_decompress(&cinfo);
@@ -208,12 +222,7 @@ void LoadJPG( const char *filename, unsigned char **pic, int *width, int *height
 	/* This is an important step since it will release a good deal of memory. */
 	jpeg_destroy_decompress(&cinfo);
 
-	/* After finish_decompress, we can close the input file.
-	* Here we postpone it until after no more JPEG errors are possible,
-	* so as to simplify the setjmp error logic above.  (Actually, I don't
-	* think that jpeg_destroy can do an error exit, but why assume anything...)
-	*/
-	ri->FS_FreeFile (fbuffer.v);
+	/* The caller frees the file once we're done with it. */
 	/* At this point you may want to check to see whether any corrupt-data
 	* warnings occurred (test whether jerr.pub.num_warnings is nonzero).
 	*/
@@ -339,7 +348,7 @@ size_t RE_SaveJPGToBuffer(byte *buffer, size_t bufSize, int quality,
 	int image_width, int image_height, byte *image_buffer, int padding)
 {
 	struct jpeg_compress_struct cinfo;
-	struct jpeg_error_mgr jerr;
+	jpegError_t jerr;
 	JSAMPROW row_pointer[1];	/* pointer to JSAMPLE row[s] */
 	my_dest_ptr dest;
 	int row_stride;		/* physical row width in image buffer */
@@ -347,9 +356,15 @@ size_t RE_SaveJPGToBuffer(byte *buffer, size_t bufSize, int quality,
 
 	/* Step 1: allocate and initialize JPEG compression object */
 
-	cinfo.err = jpeg_std_error(&jerr);
+	cinfo.err = jpeg_std_error(&jerr.pub);
 	cinfo.err->error_exit = R_JPGErrorExit;
 	cinfo.err->output_message = R_JPGOutputMessage;
+	cinfo.client_data = NULL;
+
+	if (setjmp(jerr.jump)) {
+		jpeg_destroy_compress(&cinfo);
+		return 0;
+	}
 
 	/* Now we can initialize the JPEG compression object. */
 	jpeg_create_compress(&cinfo);
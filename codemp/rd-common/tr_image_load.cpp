@@ -95,6 +95,34 @@ void R_ImageLoader_Init()
 	R_ImageLoader_Add ("tga", LoadTGA);
 }
 
+/*
+=================
+Reads the given file and decodes it with the given loader.
+=================
+*/
+static void R_DecodeImageFile( const char *name, ImageLoaderFn loader, byte **pic, int *width, int *height )
+{
+	imageFile_t image;
+
+	memset (&image, 0, sizeof (image));
+	Q_strncpyz (image.name, name, sizeof (image.name));
+
+	image.len = ri->FS_ReadFile (name, (void **)&image.buffer);
+	if ( !image.buffer || image.len < 0 )
+	{
+		return;
+	}
+
+	loader (&image);
+	ri->FS_FreeFile (image.buffer);
+
+	R_ReportImageError (&image);
+
+	*pic = image.pic;
+	*width = image.width;
+	*height = image.height;
+}
+
 /*
 =================
 Loads any of the supported image types into a cannonical
@@ -111,7 +139,7 @@ void R_LoadImage( const char *shortname, byte **pic, int *width, int *height ) {
 	const ImageLoaderMap *imageLoader = FindImageLoader (extension);
 	if ( imageLoader != NULL )
 	{
-		imageLoader->loader (shortname, pic, width, height);
+		R_DecodeImageFile (shortname, imageLoader->loader, pic, width, height);
 		if ( *pic )
 		{
 			return;
@@ -131,10 +159,102 @@ void R_LoadImage( const char *shortname, byte **pic, int *width, int *height ) {
 		}
 
 		const char *name = va ("%s.%s", extensionlessName, tryLoader->extension);
-		tryLoader->loader (name, pic, width, height);
+		R_DecodeImageFile (name, tryLoader->loader, pic, width, height);
 		if ( *pic )
 		{
 			return;
 		}
 	}
 }
+
+/*
+=================
+Reads the first file R_LoadImage would try, leaving the decoding to
+the caller.  Unlike R_LoadImage, a file that fails to decode doesn't
+fall back to the next extension.
+=================
+*/
+ImageLoaderFn R_ReadImage( const char *shortname, imageFile_t *image )
+{
+	memset (image, 0, sizeof (*image));
+
+	const char *extension = COM_GetExtension (shortname);
+	const ImageLoaderMap *imageLoader = FindImageLoader (extension);
+	if ( imageLoader != NULL )
+	{
+		image->len = ri->FS_ReadFile (shortname, (void **)&image->buffer);
+		if ( image->buffer && image->len >= 0 )
+		{
+			Q_strncpyz (image->name, shortname, sizeof (image->name));
+			return imageLoader->loader;
+		}
+	}
+
+	char extensionlessName[MAX_QPATH];
+	COM_StripExtension(shortname, extensionlessName, sizeof( extensionlessName ));
+	for ( int i = 0; i < numImageLoaders; i++ )
+	{
+		const ImageLoaderMap *tryLoader = &imageLoaders[i];
+		if ( tryLoader == imageLoader )
+		{
+			continue;
+		}
+
+		Com_sprintf (image->name, sizeof (image->name), "%s.%s", extensionlessName, tryLoader->extension);
+		image->len = ri->FS_ReadFile (image->name, (void **)&image->buffer);
+		if ( image->buffer && image->len >= 0 )
+		{
+			return tryLoader->loader;
+		}
+	}
+
+	image->buffer = NULL;
+	return NULL;
+}
+
+/*
+=================
+Records a decoding error.  Decoders may run on the image threads,
+so this mustn't print anything.
+=================
+*/
+void QDECL R_ImageError( imageFile_t *image, const char *fmt, ... )
+{
+	va_list argptr;
+	size_t len = strlen (image->error);
+
+	va_start (argptr, fmt);
+	Q_vsnprintf (image->error + len, sizeof (image->error) - len, fmt, argptr);
+	va_end (argptr);
+}
+
+/*
+=================
+Prints what went wrong decoding an image, call on the main thread.
+=================
+*/
+void R_ReportImageError( const imageFile_t *image )
+{
+	if ( !image->error[0] )
+	{
+		return;
+	}
+
+	if ( image->fatal )
+	{
+		Com_Error (ERR_DROP, "%s( File: \"%s\" )\n", image->error, image->name);
+	}
+
+	ri->Printf (PRINT_WARNING, "%s", image->error);
+}
+
+/*
+=================
+Image data comes from malloc rather than the zone, since the
+decoders can run off the main thread.
+=================
+*/
+void R_FreeImage( byte *pic )
+{
+	free (pic);
+}
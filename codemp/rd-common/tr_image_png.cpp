@@ -125,22 +125,21 @@ fopen_failed:
 void user_read_data( png_structp png_ptr, png_bytep data, png_size_t length );
 void png_print_error ( png_structp png_ptr, png_const_charp err )
 {
-	ri->Printf (PRINT_ERROR, "%s\n", err);
+	R_ImageError ((imageFile_t *)png_get_error_ptr (png_ptr), "%s\n", err);
 }
 
 void png_print_warning ( png_structp png_ptr, png_const_charp warning )
 {
-	ri->Printf (PRINT_WARNING, "%s\n", warning);
+	R_ImageError ((imageFile_t *)png_get_error_ptr (png_ptr), "%s\n", warning);
 }
 
 bool IsPowerOfTwo ( int i ) { return (i & (i - 1)) == 0; }
 
 struct PNGFileReader
 {
-	PNGFileReader ( char *buf ) : buf(buf), offset(0), png_ptr(NULL), info_ptr(NULL) {}
+	PNGFileReader ( imageFile_t *image ) : image(image), buf((char *)image->buffer), offset(0), png_ptr(NULL), info_ptr(NULL) {}
 	~PNGFileReader()
 	{
-		ri->FS_FreeFile (buf);
 		png_destroy_read_struct (&png_ptr, &info_ptr, NULL);
 	}
 
@@ -151,6 +150,12 @@ struct PNGFileReader
 		*width = 0;
 		*height = 0;
 
+		if ( image->len < 8 )
+		{
+			R_ImageError (image, "PNG signature not found in given image.\n");
+			return 0;
+		}
+
 		// Make sure we're actually reading PNG data.
 		const int SIGNATURE_LEN = 8;
 
@@ -159,14 +164,14 @@ struct PNGFileReader
 
 		if ( !png_check_sig (ident, SIGNATURE_LEN) )
 		{
-			ri->Printf (PRINT_ERROR, "PNG signature not found in given image.");
+			R_ImageError (image, "PNG signature not found in given image.\n");
 			return 0;
 		}
 
-		png_ptr = png_create_read_struct (PNG_LIBPNG_VER_STRING, NULL, png_print_error, png_print_warning);
+		png_ptr = png_create_read_struct (PNG_LIBPNG_VER_STRING, image, png_print_error, png_print_warning);
 		if ( png_ptr == NULL )
 		{
-			ri->Printf (PRINT_ERROR, "Could not allocate enough memory to load the image.");
+			R_ImageError (image, "Could not allocate enough memory to load the image.\n");
 			return 0;
 		}
 
@@ -199,7 +204,7 @@ struct PNGFileReader
 		// so that the graphics driver doesn't have to fiddle about with the texture when uploading.
 		if ( !IsPowerOfTwo (width_) || !IsPowerOfTwo (height_) )
 		{
-			ri->Printf (PRINT_ERROR, "Width or height is not a power-of-two.\n");
+			R_ImageError (image, "Width or height is not a power-of-two.\n");
 			return 0;
 		}
 
@@ -209,7 +214,7 @@ struct PNGFileReader
 		// PNG_COLOR_TYPE_GRAY.
 		if ( colortype != PNG_COLOR_TYPE_RGB && colortype != PNG_COLOR_TYPE_RGBA )
 		{
-			ri->Printf (PRINT_ERROR, "Image is not 24-bit or 32-bit.");
+			R_ImageError (image, "Image is not 24-bit or 32-bit.\n");
 			return 0;
 		}
 
@@ -223,20 +228,20 @@ struct PNGFileReader
 		png_read_update_info (png_ptr, info_ptr);
 
 		// We always assume there are 4 channels. RGB channels are expanded to RGBA when read.
-		byte *tempData = (byte *)ri->Z_Malloc (width_ * height_ * 4, TAG_TEMP_PNG, qfalse, 4);
+		byte *tempData = (byte *)malloc (width_ * height_ * 4);
 		if ( !tempData )
 		{
-			ri->Printf (PRINT_ERROR, "Could not allocate enough memory to load the image.");
+			R_ImageError (image, "Could not allocate enough memory to load the image.\n");
 			return 0;
 		}
 
 		// Dynamic array of row pointers, with 'height' elements, initialized to NULL.
-		byte **row_pointers = (byte **)ri->Hunk_AllocateTempMemory (sizeof (byte *) * height_);
+		byte **row_pointers = (byte **)malloc (sizeof (byte *) * height_);
 		if ( !row_pointers )
 		{
-			ri->Printf (PRINT_ERROR, "Could not allocate enough memory to load the image.");
+			R_ImageError (image, "Could not allocate enough memory to load the image.\n");
 
-			ri->Z_Free (tempData);
+			R_FreeImage (tempData);
 
 			return 0;
 		}
@@ -244,8 +249,8 @@ struct PNGFileReader
 		// Re-set the jmp so that these new memory allocations can be reclaimed
 		if ( setjmp (png_jmpbuf (png_ptr)) )
 		{
-			ri->Hunk_FreeTempMemory (row_pointers);
-			ri->Z_Free (tempData);
+			free (row_pointers);
+			R_FreeImage (tempData);
 			return 0;
 		}
 
@@ -259,7 +264,7 @@ struct PNGFileReader
 		// Finish reading
 		png_read_end (png_ptr, NULL);
 
-		ri->Hunk_FreeTempMemory (row_pointers);
+		free (row_pointers);
 
 		// Finally assign all the parameters
 		*data = tempData;
@@ -271,11 +276,17 @@ struct PNGFileReader
 
 	void ReadBytes ( void *dest, size_t len )
 	{
+		if ( offset + len > (size_t)image->len )
+		{
+			png_error (png_ptr, "Unexpected end of PNG file.");
+		}
+
 		memcpy (dest, buf + offset, len);
 		offset += len;
 	}
 
 private:
+	imageFile_t *image;
 	char *buf;
 	size_t offset;
 	png_structp png_ptr;
@@ -288,17 +299,10 @@ void user_read_data( png_structp png_ptr, png_bytep data, png_size_t length ) {
 	reader->ReadBytes (data, length);
 }
 
-// Loads a PNG image from file.
-void LoadPNG ( const char *filename, byte **data, int *width, int *height )
+// Decodes a PNG image that has been read in.
+void LoadPNG ( imageFile_t *image )
 {
-	char *buf = NULL;
-	int len = ri->FS_ReadFile (filename, (void **)&buf);
-	if ( len < 0 || buf == NULL )
-	{
-		return;
-	}
-
-	PNGFileReader reader (buf);
-	reader.Read (data, width, height);
+	PNGFileReader reader (image);
+	reader.Read (&image->pic, &image->width, &image->height);
 }
 
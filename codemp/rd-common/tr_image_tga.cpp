@@ -48,12 +48,12 @@ typedef struct TGAHeader_s {
 #pragma pack(pop)
 
 
-// *pic == pic, else NULL for failed.
+// image->pic == pic, else NULL for failed.
 //
-//  returns false if found but had a format error, else true for either OK or not-found (there's a reason for this)
+//  format errors are fatal, as they always have been
 //
 
-void LoadTGA ( const char *name, byte **pic, int *width, int *height)
+void LoadTGA ( imageFile_t *image )
 {
 	char sErrorString[1024];
 	bool bFormatErrors = false;
@@ -65,19 +65,12 @@ void LoadTGA ( const char *name, byte **pic, int *width, int *height)
 	byte *pIn	= NULL;
 
 
-	*pic = NULL;
+	image->pic = NULL;
 
 #define TGA_FORMAT_ERROR(blah) {sprintf(sErrorString,blah); bFormatErrors = true; goto TGADone;}
 //#define TGA_FORMAT_ERROR(blah) Com_Error( ERR_DROP, blah );
 
-	//
-	// load the file
-	//
-	byte *pTempLoadedBuffer = 0;
-	ri->FS_ReadFile ( ( char * ) name, (void **)&pTempLoadedBuffer);
-	if (!pTempLoadedBuffer) {
-		return;
-	}
+	byte *pTempLoadedBuffer = image->buffer;
 
 	TGAHeader_t *pHeader = (TGAHeader_t *) pTempLoadedBuffer;
 
@@ -195,13 +188,11 @@ void LoadTGA ( const char *name, byte **pic, int *width, int *height)
 
 	// feed back the results...
 	//
-	if (width)
-		*width = pHeader->wImageWidth;
-	if (height)
-		*height = pHeader->wImageHeight;
+	image->width = pHeader->wImageWidth;
+	image->height = pHeader->wImageHeight;
 
-	pRGBA	= (byte *) Z_Malloc (pHeader->wImageWidth * pHeader->wImageHeight * 4, TAG_TEMP_WORKSPACE, qfalse);
-	*pic	= pRGBA;
+	pRGBA	= (byte *) malloc (pHeader->wImageWidth * pHeader->wImageHeight * 4);
+	image->pic	= pRGBA;
 	pOut	= pRGBA;
 	pIn		= pTempLoadedBuffer + sizeof(*pHeader);
 
@@ -373,11 +364,13 @@ void LoadTGA ( const char *name, byte **pic, int *width, int *height)
 
 TGADone:
 
-	ri->FS_FreeFile (pTempLoadedBuffer);
-
 	if (bFormatErrors)
 	{
-		Com_Error( ERR_DROP, "%s( File: \"%s\" )\n",sErrorString,name);
+		R_FreeImage (image->pic);
+		image->pic = NULL;
+
+		R_ImageError (image, "%s", sErrorString);
+		image->fatal = qtrue;
 	}
 }
 
@@ -243,6 +243,11 @@ typedef struct refexport_s {
 
 	struct {
 		float				(*Font_StrLenPixels)					( const char *text, const int iFontIndex, const float scale );
+		void				(*G2API_GetTraceCacheStats)				( g2TraceCacheStats_t *stats, qboolean reset );
+		int					(*G2API_GetBoneNumber)					( CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName );
+		qboolean			(*G2API_SetBoneAnglesNum)				( CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const vec3_t angles, const int flags, const Eorientations up, const Eorientations left, const Eorientations forward, int blendTime, int currentTime );
+		qboolean			(*G2API_SetBoneAnimNum)					( CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime );
+		void				(*G2API_ResetVertSpace)					( IHeapAllocator *G2VertSpace );
 	} ext;
 
 } refexport_t;
@@ -346,6 +351,9 @@ typedef struct refimport_s {
 	// Persistent data store
 	bool			(*PD_Store)							( const char *name, const void *data, size_t size );
 	const void *	(*PD_Load)							( const char *name, size_t *size );
+
+	// like Milliseconds, for profiling only
+	int64_t			(*Microseconds)						( void );
 } refimport_t;
 
 // this is the only function actually exported at the linker level
@@ -323,6 +323,9 @@ Ghoul2 Insert Start
 */
 	mdxmHeader_t *mdxm;				// only if type == MOD_GL2M which is a GHOUL II Mesh file NOT a GHOUL II animation file
 	mdxaHeader_t *mdxa;				// only if type == MOD_GL2A which is a GHOUL II Animation file
+	struct mdxmTraceBounds_s *mdxmTraceBounds;	// only if type == MOD_MDXM, bone space surface bounds for traces
+	struct mdxmSkinStreams_s *mdxmSkinStreams;	// only if type == MOD_MDXM, decoded vert weights for skinning
+	struct mdxaBoneHash_s *mdxaBoneHash;	// only if type == MOD_MDXA, bone numbers by name
 /*
 Ghoul2 Insert End
 */
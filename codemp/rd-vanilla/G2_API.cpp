@@ -1265,7 +1265,8 @@ qboolean G2API_SetBoneAnimIndex(CGhoul2Info *ghlInfo, const int index, const int
 
 #define _PLEASE_SHUT_THE_HELL_UP
 
-qboolean G2API_SetBoneAnim(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const int AstartFrame, const int AendFrame, const int flags, const float animSpeed, const int currentTime, const float AsetFrame, const int blendTime)
+// boneName, or boneNum if it's NULL
+static qboolean G2API_SetBoneAnimLow(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const int boneNum, const int AstartFrame, const int AendFrame, const int flags, const float animSpeed, const int currentTime, const float AsetFrame, const int blendTime)
 {
 	int endFrame=AendFrame;
 	int startFrame=AstartFrame;
@@ -1333,12 +1334,27 @@ qboolean G2API_SetBoneAnim(CGhoul2Info_v &ghoul2, const int modelIndex, const ch
 		{
 			// ensure we flush the cache
 			ghlInfo->mSkelFrameNum = 0;
+			if (!boneName)
+			{
+				return G2_Set_Bone_Anim_Num(ghlInfo, ghlInfo->mBlist, boneNum, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime);
+			}
  			return G2_Set_Bone_Anim(ghlInfo, ghlInfo->mBlist, boneName, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime);
 		}
 	}
 	return qfalse;
 }
 
+qboolean G2API_SetBoneAnim(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime)
+{
+	return G2API_SetBoneAnimLow(ghoul2, modelIndex, boneName, -1, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime);
+}
+
+// boneNum comes from G2API_GetBoneNumber, so callers can skip the name lookup every frame
+qboolean G2API_SetBoneAnimNum(CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime)
+{
+	return G2API_SetBoneAnimLow(ghoul2, modelIndex, NULL, boneNum, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime);
+}
+
 qboolean G2API_GetBoneAnim(CGhoul2Info_v& ghoul2, int modelIndex, const char *boneName, const int currentTime, float *currentFrame,
 						   int *startFrame, int *endFrame, int *flags, float *animSpeed, int *modelList)
 {
@@ -1500,7 +1516,8 @@ qboolean G2API_SetBoneAnglesIndex(CGhoul2Info *ghlInfo, const int index, const v
 	return qfalse;
 }
 
-qboolean G2API_SetBoneAngles(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const vec3_t angles, const int flags,
+// boneName, or boneNum if it's NULL
+static qboolean G2API_SetBoneAnglesLow(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const int boneNum, const vec3_t angles, const int flags,
 							 const Eorientations up, const Eorientations left, const Eorientations forward,
 							 qhandle_t *modelList, int blendTime, int currentTime )
 {
@@ -1535,12 +1552,31 @@ qboolean G2API_SetBoneAngles(CGhoul2Info_v &ghoul2, const int modelIndex, const
 		{
 				// ensure we flush the cache
 			ghlInfo->mSkelFrameNum = 0;
+			if (!boneName)
+			{
+				return G2_Set_Bone_Angles_Num(ghlInfo, ghlInfo->mBlist, boneNum, angles, flags, up, left, forward, blendTime, currentTime);
+			}
 			return G2_Set_Bone_Angles(ghlInfo, ghlInfo->mBlist, boneName, angles, flags, up, left, forward, modelList, ghlInfo->mModelindex, blendTime, currentTime);
 		}
 	}
 	return qfalse;
 }
 
+qboolean G2API_SetBoneAngles(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName, const vec3_t angles, const int flags,
+							 const Eorientations up, const Eorientations left, const Eorientations forward,
+							 qhandle_t *modelList, int blendTime, int currentTime )
+{
+	return G2API_SetBoneAnglesLow(ghoul2, modelIndex, boneName, -1, angles, flags, up, left, forward, modelList, blendTime, currentTime);
+}
+
+// boneNum comes from G2API_GetBoneNumber, so callers can skip the name lookup every frame
+qboolean G2API_SetBoneAnglesNum(CGhoul2Info_v &ghoul2, const int modelIndex, const int boneNum, const vec3_t angles, const int flags,
+							 const Eorientations up, const Eorientations left, const Eorientations forward,
+							 int blendTime, int currentTime )
+{
+	return G2API_SetBoneAnglesLow(ghoul2, modelIndex, NULL, boneNum, angles, flags, up, left, forward, NULL, blendTime, currentTime);
+}
+
 qboolean G2API_SetBoneAnglesMatrixIndex(CGhoul2Info *ghlInfo, const int index, const mdxaBone_t &matrix,
 								   const int flags, qhandle_t *modelList, int blendTime, int currentTime)
 {
@@ -2189,6 +2225,210 @@ qboolean G2API_GetAnimFileName(CGhoul2Info *ghlInfo, char **filename)
 	return qfalse;
 }
 
+// Collision skeleton cache.  Several traces against the same model in one frame
+// (saber blade segments, shotgun pellets) would otherwise each rebuild the
+// skeleton and skin the model again.  An entry remembers everything the skeleton
+// and transformed verts depend on, and is only reused when all of it, and the
+// bone cache itself, is unchanged.  Transformed verts live in the vert space heap
+// so they can only be reused until that heap is next reset.
+#define G2_TRACE_CACHE_SIZE		32
+
+typedef struct g2TraceModelState_s {
+	bool				valid;
+	const model_s		*currentModel;
+	int					modelBoltLink;
+	int					surfaceRoot;
+	int					lodBias;
+	int					newOrigin;
+	int					flags;
+	CBoneCache			*boneCache;
+	int					boneCacheTouch;
+	size_t				*transformedVerts;
+	boneInfo_v			blist;
+	boltInfo_v			bltlist;
+	surfaceInfo_v		slist;
+} g2TraceModelState_t;
+
+typedef struct g2TraceCacheEntry_s {
+	CGhoul2Info_v		*ghoul2;
+	int					frameNum;
+	vec3_t				scale;
+	int					useLod;
+	IHeapAllocator		*vertSpace;
+	int					vertSpaceResets;
+	std::vector<g2TraceModelState_t>	models;
+} g2TraceCacheEntry_t;
+
+typedef struct g2VertSpaceResets_s {
+	IHeapAllocator		*vertSpace;
+	int					resets;
+} g2VertSpaceResets_t;
+
+static g2TraceCacheEntry_t	g2TraceCache[G2_TRACE_CACHE_SIZE];
+static int					g2TraceCacheNext;
+static g2VertSpaceResets_t	g2VertSpaceResets[4];	// server and client
+static g2TraceCacheStats_t	g2TraceCacheStats;
+static cvar_t				*r_Ghoul2TraceCache=NULL;
+
+// all resets of a collision vert space go through here, so cached verts know when they're gone
+static void G2_ResetVertSpace(IHeapAllocator *G2VertSpace)
+{
+	int i;
+
+	G2VertSpace->ResetHeap();
+
+	for (i = 0; i < (int)ARRAY_LEN(g2VertSpaceResets); i++)
+	{
+		if (g2VertSpaceResets[i].vertSpace == G2VertSpace || !g2VertSpaceResets[i].vertSpace)
+		{
+			g2VertSpaceResets[i].vertSpace = G2VertSpace;
+			g2VertSpaceResets[i].resets++;
+			return;
+		}
+	}
+}
+
+static int G2_VertSpaceResets(IHeapAllocator *G2VertSpace)
+{
+	int i;
+
+	for (i = 0; i < (int)ARRAY_LEN(g2VertSpaceResets); i++)
+	{
+		if (g2VertSpaceResets[i].vertSpace == G2VertSpace)
+		{
+			return g2VertSpaceResets[i].resets;
+		}
+	}
+	// more heaps than expected, never reuse verts from them
+	return -1;
+}
+
+template<typename T>
+static inline bool G2_SameVector(const std::vector<T> &a, const std::vector<T> &b)
+{
+	return a.size() == b.size() && (a.empty() || !memcmp(&a[0], &b[0], a.size() * sizeof(T)));
+}
+
+static bool G2_SameTraceModelState(const g2TraceModelState_t &state, const CGhoul2Info &g)
+{
+	return state.valid == g.mValid &&
+		state.currentModel == g.currentModel &&
+		state.modelBoltLink == g.mModelBoltLink &&
+		state.surfaceRoot == g.mSurfaceRoot &&
+		state.lodBias == g.mLodBias &&
+		state.newOrigin == g.mNewOrigin &&
+		state.flags == g.mFlags &&
+		state.boneCache == g.mBoneCache &&
+		state.boneCacheTouch == BoneCacheTouch(g.mBoneCache) &&
+		G2_SameVector(state.blist, g.mBlist) &&
+		G2_SameVector(state.bltlist, g.mBltlist) &&
+		G2_SameVector(state.slist, g.mSlist);
+}
+
+static g2TraceCacheEntry_t *G2_FindTraceCache(CGhoul2Info_v &ghoul2, int frameNum, const vec3_t scale, int useLod, IHeapAllocator *G2VertSpace)
+{
+	int i, j;
+
+	for (i = 0; i < G2_TRACE_CACHE_SIZE; i++)
+	{
+		g2TraceCacheEntry_t &entry = g2TraceCache[i];
+
+		if (entry.ghoul2 != &ghoul2 || entry.frameNum != frameNum || entry.useLod != useLod ||
+			entry.vertSpace != G2VertSpace || !VectorCompare(entry.scale, scale) ||
+			(int)entry.models.size() != ghoul2.size())
+		{
+			continue;
+		}
+
+		for (j = 0; j < ghoul2.size(); j++)
+		{
+			if (!G2_SameTraceModelState(entry.models[j], ghoul2[j]))
+			{
+				break;
+			}
+		}
+		if (j == ghoul2.size())
+		{
+			return &entry;
+		}
+	}
+
+	return NULL;
+}
+
+static bool G2_TraceCacheHasVerts(const g2TraceCacheEntry_t &entry, CGhoul2Info_v &ghoul2)
+{
+	int i;
+
+	if (entry.vertSpaceResets < 0 || entry.vertSpaceResets != G2_VertSpaceResets(entry.vertSpace))
+	{
+		return false;
+	}
+
+	for (i = 0; i < ghoul2.size(); i++)
+	{
+		if (entry.models[i].transformedVerts != ghoul2[i].mTransformedVertsArray)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static void G2_StoreTraceCache(g2TraceCacheEntry_t *entry, CGhoul2Info_v &ghoul2, int frameNum, const vec3_t scale, int useLod, IHeapAllocator *G2VertSpace)
+{
+	int i;
+
+	if (!entry)
+	{
+		entry = &g2TraceCache[g2TraceCacheNext];
+		g2TraceCacheNext = (g2TraceCacheNext + 1) % G2_TRACE_CACHE_SIZE;
+	}
+
+	entry->ghoul2 = &ghoul2;
+	entry->frameNum = frameNum;
+	VectorCopy(scale, entry->scale);
+	entry->useLod = useLod;
+	entry->vertSpace = G2VertSpace;
+	entry->vertSpaceResets = G2_VertSpaceResets(G2VertSpace);
+	entry->models.resize(ghoul2.size());
+
+	for (i = 0; i < ghoul2.size(); i++)
+	{
+		const CGhoul2Info &g = ghoul2[i];
+		g2TraceModelState_t &state = entry->models[i];
+
+		state.valid = g.mValid;
+		state.currentModel = g.currentModel;
+		state.modelBoltLink = g.mModelBoltLink;
+		state.surfaceRoot = g.mSurfaceRoot;
+		state.lodBias = g.mLodBias;
+		state.newOrigin = g.mNewOrigin;
+		state.flags = g.mFlags;
+		state.boneCache = g.mBoneCache;
+		state.boneCacheTouch = BoneCacheTouch(g.mBoneCache);
+		state.transformedVerts = g.mTransformedVertsArray;
+		state.blist = g.mBlist;
+		state.bltlist = g.mBltlist;
+		state.slist = g.mSlist;
+	}
+}
+
+// for the engine's once a frame reset of the server vert space
+void G2API_ResetVertSpace(IHeapAllocator *G2VertSpace)
+{
+	G2_ResetVertSpace(G2VertSpace);
+}
+
+void G2API_GetTraceCacheStats(g2TraceCacheStats_t *stats, qboolean reset)
+{
+	*stats = g2TraceCacheStats;
+	if (reset)
+	{
+		memset(&g2TraceCacheStats, 0, sizeof(g2TraceCacheStats));
+	}
+}
+
 /*
 =======================
 SV_QsortEntityNumbers
@@ -2277,7 +2517,7 @@ void G2API_CollisionDetectCache(CollisionRecord_t *collRecMap, CGhoul2Info_v &gh
 				i++;
 			}
 			G2_ConstructGhoulSkeleton(ghoul2, frameNumber, true, scale);
-			G2VertSpace->ResetHeap();
+			G2_ResetVertSpace(G2VertSpace);
 
 			// now having done that, time to build the model
 #ifdef _G2_GORE
@@ -2343,25 +2583,61 @@ void G2API_CollisionDetect(CollisionRecord_t *collRecMap, CGhoul2Info_v &ghoul2,
 	{
 		vec3_t	transRayStart, transRayEnd;
 
-		// make sure we have transformed the whole skeletons for each model
-		G2_ConstructGhoulSkeleton(ghoul2, frameNumber, true, scale);
+		if ( r_Ghoul2TraceCache == NULL )
+		{
+			r_Ghoul2TraceCache = ri->Cvar_Get( "r_ghoul2tracecache", "1", CVAR_NONE, "Reuse Ghoul2 skeletons and verts between traces in the same frame" );
+		}
+
+		// the skeleton and verts are in model space, so the trace itself isn't part of the key
+		g2TraceCacheEntry_t *cached = NULL;
+		bool keepVerts = false;
+
+		g2TraceCacheStats.traces++;
+		if (r_Ghoul2TraceCache->integer)
+		{
+			cached = G2_FindTraceCache(ghoul2, frameNumber, scale, useLod, G2VertSpace);
+		}
+
+		if (cached)
+		{
+			g2TraceCacheStats.skeletonHits++;
+			keepVerts = G2_TraceCacheHasVerts(*cached, ghoul2);
+			if (keepVerts)
+			{
+				g2TraceCacheStats.vertHits++;
+			}
+		}
+		else
+		{
+			// make sure we have transformed the whole skeletons for each model
+			G2_ConstructGhoulSkeleton(ghoul2, frameNumber, true, scale);
+		}
 
 		// pre generate the world matrix - used to transform the incoming ray
 		G2_GenerateWorldMatrix(angles, position);
 
-		G2VertSpace->ResetHeap();
+		if (!keepVerts)
+		{
+			G2_ResetVertSpace(G2VertSpace);
+		}
+
+		// translate the ray to model space, so only the surfaces it can reach get built
+		TransformAndTranslatePoint(rayStart, transRayStart, &worldMatrixInv);
+		TransformAndTranslatePoint(rayEnd, transRayEnd, &worldMatrixInv);
 
 		// now having done that, time to build the model
 #ifdef _G2_GORE
-		G2_TransformModel(ghoul2, frameNumber, scale, G2VertSpace, useLod, false);
+		G2_TransformModel(ghoul2, frameNumber, scale, G2VertSpace, useLod, false, transRayStart, transRayEnd, fRadius, keepVerts);
 #else
-		G2_TransformModel(ghoul2, frameNumber, scale, G2VertSpace, useLod);
+		G2_TransformModel(ghoul2, frameNumber, scale, G2VertSpace, useLod, transRayStart, transRayEnd, fRadius, keepVerts);
 #endif
 
+		if (r_Ghoul2TraceCache->integer)
+		{
+			G2_StoreTraceCache(cached, ghoul2, frameNumber, scale, useLod, G2VertSpace);
+		}
+
 		// model is built. Lets check to see if any triangles are actually hit.
-		// first up, translate the ray to model space
-		TransformAndTranslatePoint(rayStart, transRayStart, &worldMatrixInv);
-		TransformAndTranslatePoint(rayEnd, transRayEnd, &worldMatrixInv);
 
 		// now walk each model and check the ray against each poly - sigh, this is SO expensive. I wish there was a better way to do this.
 #ifdef _G2_GORE
@@ -2672,6 +2948,17 @@ int G2API_GetBoneIndex(CGhoul2Info *ghlInfo, const char *boneName)
 	return -1;
 }
 
+// the bone's number in the model's gla, which unlike its bone list index doesn't change
+// as bones are added and removed, -1 if there's no such bone
+int G2API_GetBoneNumber(CGhoul2Info_v &ghoul2, const int modelIndex, const char *boneName)
+{
+	if (ghoul2.size()>modelIndex && G2_SetupModelPointers(&ghoul2[modelIndex]))
+	{
+		return G2_Find_Bone_Number(ghoul2[modelIndex].animModel, boneName);
+	}
+	return -1;
+}
+
 qboolean G2API_SaveGhoul2Models(CGhoul2Info_v &ghoul2, char **buffer, int *size)
 {
 	return G2_SaveGhoul2Models(ghoul2, buffer, size);
@@ -2800,7 +3087,7 @@ void G2API_AddSkinGore(CGhoul2Info_v &ghoul2,SSkinGoreData &gore)
 	for(lod=lodbias;lod<maxLod;lod++)
 	{
 		// now having done that, time to build the model
-		ri->GetG2VertSpaceServer()->ResetHeap();
+		G2_ResetVertSpace(ri->GetG2VertSpaceServer());
 
 		G2_TransformModel(ghoul2, gore.currentTime, gore.scale,ri->GetG2VertSpaceServer(),lod,true);
 
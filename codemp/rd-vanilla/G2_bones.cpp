@@ -42,77 +42,114 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 //=====================================================================================================================
 // Bone List handling routines - so entities can override bone info on a bone by bone level, and also interrogate this info
 
-// Given a bone name, see if that bone is already in our bone list - note the model_t pointer that gets passed in here MUST point at the
-// gla file, not the glm file type.
-int G2_Find_Bone(const model_t *mod, boneInfo_v &blist, const char *boneName)
+// bone names of a gla, hashed so finding a bone by name is one compare
+typedef struct mdxaBoneHash_s {
+	int			mask;
+	short		*slots;					// bone number + 1, 0 is an empty slot
+} mdxaBoneHash_t;
+
+static unsigned int G2_BoneNameHash(const char *boneName)
 {
-	mdxaSkel_t			*skel;
-	mdxaSkelOffsets_t	*offsets;
-   	offsets = (mdxaSkelOffsets_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t));
-	skel = (mdxaSkel_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t) + offsets->offsets[0]);
+	unsigned int hash = 0;
 
-	// look through entire list
-	for(size_t i=0; i<blist.size(); i++)
+	for (int i = 0; boneName[i]; i++)
 	{
-		// if this bone entry has no info in it, bounce over it
-		if (blist[i].boneNumber == -1)
-		{
-			continue;
-		}
+		hash = hash * 31 + tolower((unsigned char)boneName[i]);
+	}
+	return hash;
+}
 
-		// figure out what skeletal info structure this bone entry is looking at
-		skel = (mdxaSkel_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t) + offsets->offsets[blist[i].boneNumber]);
+static const char *G2_BoneName(const model_t *mod, int boneNum)
+{
+	const mdxaSkelOffsets_t	*offsets = (mdxaSkelOffsets_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t));
 
-		// if name is the same, we found it
-		if (!Q_stricmp(skel->name, boneName))
+	return ((mdxaSkel_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t) + offsets->offsets[boneNum]))->name;
+}
+
+// called once a gla is loaded, the hash lives on the hunk with the model
+void G2_BuildBoneHash(model_t *mod)
+{
+	const int	numBones = mod->mdxa->numBones;
+	int			size = 16;
+
+	while (size < numBones * 2)
+	{
+		size <<= 1;
+	}
+
+	mdxaBoneHash_t *bh = (mdxaBoneHash_t *)Hunk_Alloc(sizeof(mdxaBoneHash_t) + size * sizeof(short), h_low);
+	bh->mask = size - 1;
+	bh->slots = (short *)(bh + 1);
+
+	for (int x = 0; x < numBones; x++)
+	{
+		const char	*boneName = G2_BoneName(mod, x);
+		int			slot = G2_BoneNameHash(boneName) & bh->mask;
+
+		// the first bone of a name wins, as it did for the linear search
+		while (bh->slots[slot] && Q_stricmp(G2_BoneName(mod, bh->slots[slot] - 1), boneName))
 		{
-			return i;
+			slot = (slot + 1) & bh->mask;
+		}
+		if (!bh->slots[slot])
+		{
+			bh->slots[slot] = x + 1;
 		}
 	}
 
-	// didn't find it
-	return -1;
+	mod->mdxaBoneHash = bh;
 }
 
-// we need to add a bone to the list - find a free one and see if we can find a corresponding bone in the gla file
-int G2_Add_Bone (const model_t *mod, boneInfo_v &blist, const char *boneName)
+// Given a bone name, find its number in the gla file - note the model_t pointer that gets passed in here MUST point at the
+// gla file, not the glm file type.
+int G2_Find_Bone_Number(const model_t *mod, const char *boneName)
 {
-	int x;
-	mdxaSkel_t			*skel;
-	mdxaSkelOffsets_t	*offsets;
-	boneInfo_t			tempBone;
+	const mdxaBoneHash_t *bh = mod->mdxaBoneHash;
 
-	//rww - RAGDOLL_BEGIN
-	memset(&tempBone, 0, sizeof(tempBone));
-	//rww - RAGDOLL_END
-
-   	offsets = (mdxaSkelOffsets_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t));
-
- 	// walk the entire list of bones in the gla file for this model and see if any match the name of the bone we want to find
- 	for (x=0; x< mod->mdxa->numBones; x++)
- 	{
- 		skel = (mdxaSkel_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t) + offsets->offsets[x]);
- 		// if name is the same, we found it
- 		if (!Q_stricmp(skel->name, boneName))
+	if (!bh)
+	{
+		for (int x = 0; x < mod->mdxa->numBones; x++)
 		{
-			break;
+			if (!Q_stricmp(G2_BoneName(mod, x), boneName))
+			{
+				return x;
+			}
 		}
+		return -1;
 	}
 
-	// check to see we did actually make a match with a bone in the model
-	if (x == mod->mdxa->numBones)
+	for (int slot = G2_BoneNameHash(boneName) & bh->mask; bh->slots[slot]; slot = (slot + 1) & bh->mask)
 	{
-		// didn't find it? Error
-		//assert(0);
-#ifdef _DEBUG
-		ri->Printf( PRINT_ALL, "WARNING: Failed to add bone %s\n", boneName);
-#endif
+		if (!Q_stricmp(G2_BoneName(mod, bh->slots[slot] - 1), boneName))
+		{
+			return bh->slots[slot] - 1;
+		}
+	}
+	return -1;
+}
 
-#ifdef _RAG_PRINT_TEST
-		ri->Printf( PRINT_ALL, "WARNING: Failed to add bone %s\n", boneName);
-#endif
+// Given a bone name, see if that bone is already in our bone list - note the model_t pointer that gets passed in here MUST point at the
+// gla file, not the glm file type.
+int G2_Find_Bone(const model_t *mod, boneInfo_v &blist, const char *boneName)
+{
+	const int boneNum = G2_Find_Bone_Number(mod, boneName);
+
+	if (boneNum == -1)
+	{
+		// didn't find it
 		return -1;
 	}
+	return G2_Find_Bone_In_List(blist, boneNum);
+}
+
+// we need to add a bone to the list - find a free one, the bone number comes from G2_Find_Bone_Number
+int G2_Add_Bone_Num (boneInfo_v &blist, const int boneNum)
+{
+	boneInfo_t			tempBone;
+
+	//rww - RAGDOLL_BEGIN
+	memset(&tempBone, 0, sizeof(tempBone));
+	//rww - RAGDOLL_END
 
 	// look through entire list - see if it's already there first
 	for(size_t i=0; i<blist.size(); i++)
@@ -120,9 +157,8 @@ int G2_Add_Bone (const model_t *mod, boneInfo_v &blist, const char *boneName)
 		// if this bone entry has info in it, bounce over it
 		if (blist[i].boneNumber != -1)
 		{
-			skel = (mdxaSkel_t *)((byte *)mod->mdxa + sizeof(mdxaHeader_t) + offsets->offsets[blist[i].boneNumber]);
-			// if name is the same, we found it
-			if (!Q_stricmp(skel->name, boneName))
+			// if it's the same bone, we found it
+			if (blist[i].boneNumber == boneNum)
 			{
 				return i;
 			}
@@ -130,22 +166,48 @@ int G2_Add_Bone (const model_t *mod, boneInfo_v &blist, const char *boneName)
 		else
 		{
 			// if we found an entry that had a -1 for the bonenumber, then we hit a bone slot that was empty
-			blist[i].boneNumber = x;
+			blist[i].boneNumber = boneNum;
 			blist[i].flags = 0;
 	 		return i;
 		}
 	}
 
-#ifdef _RAG_PRINT_TEST
-	ri->Printf( PRINT_ALL, "New bone added for %s\n", boneName);
-#endif
 	// ok, we didn't find an existing bone of that name, or an empty slot. Lets add an entry
-	tempBone.boneNumber = x;
+	tempBone.boneNumber = boneNum;
 	tempBone.flags = 0;
 	blist.push_back(tempBone);
 	return blist.size()-1;
 }
 
+// we need to add a bone to the list - find a free one and see if we can find a corresponding bone in the gla file
+int G2_Add_Bone (const model_t *mod, boneInfo_v &blist, const char *boneName)
+{
+	const int boneNum = G2_Find_Bone_Number(mod, boneName);
+
+	// check to see we did actually make a match with a bone in the model
+	if (boneNum == -1)
+	{
+		// didn't find it? Error
+		//assert(0);
+#ifdef _DEBUG
+		ri->Printf( PRINT_ALL, "WARNING: Failed to add bone %s\n", boneName);
+#endif
+
+#ifdef _RAG_PRINT_TEST
+		ri->Printf( PRINT_ALL, "WARNING: Failed to add bone %s\n", boneName);
+#endif
+		return -1;
+	}
+
+#ifdef _RAG_PRINT_TEST
+	if (G2_Find_Bone_In_List(blist, boneNum) == -1)
+	{
+		ri->Printf( PRINT_ALL, "New bone added for %s\n", boneName);
+	}
+#endif
+	return G2_Add_Bone_Num(blist, boneNum);
+}
+
 
 // Given a model handle, and a bone name, we want to remove this bone from the bone override list
 qboolean G2_Remove_Bone_Index ( boneInfo_v &blist, int index)
@@ -489,6 +551,28 @@ qboolean G2_Set_Bone_Angles_Index( boneInfo_v &blist, const int index,
 
 }
 
+static qboolean G2_Set_Bone_Angles_Low(model_t *mod_a, boneInfo_v &blist, const int index, const float *angles,
+							const int flags, const Eorientations up, const Eorientations left, const Eorientations forward,
+							const int blendTime, const int currentTime)
+{
+	if (blist[index].flags & BONE_ANGLES_RAGDOLL)
+	{
+		return qtrue; // don't accept any calls on ragdoll bones
+	}
+
+	// set the angles and flags correctly
+	blist[index].flags &= ~(BONE_ANGLES_TOTAL);
+	blist[index].flags |= flags;
+	blist[index].boneBlendStart = currentTime;
+	blist[index].boneBlendTime = blendTime;
+#if DEBUG_PCJ
+	Com_OPrintf("%2d %6d   (%6.2f,%6.2f,%6.2f) %d %d %d %d\n",index,currentTime,angles[0],angles[1],angles[2],up,left,forward,flags);
+#endif
+
+	G2_Generate_Matrix(mod_a, blist, index, angles, flags, up, left, forward);
+	return qtrue;
+}
+
 // Given a model handle, and a bone name, we want to set angles specifically for overriding
 qboolean G2_Set_Bone_Angles(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, const float *angles,
 							const int flags, const Eorientations up, const Eorientations left, const Eorientations forward,
@@ -501,43 +585,16 @@ qboolean G2_Set_Bone_Angles(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char
 	int			index = G2_Find_Bone(mod_a, blist, boneName);
 
 	// did we find it?
-	if (index != -1)
+	if (index == -1)
 	{
-		if (blist[index].flags & BONE_ANGLES_RAGDOLL)
-		{
-			return qtrue; // don't accept any calls on ragdoll bones
-		}
-
-		// yes, so set the angles and flags correctly
-		blist[index].flags &= ~(BONE_ANGLES_TOTAL);
-		blist[index].flags |= flags;
-		blist[index].boneBlendStart = currentTime;
-		blist[index].boneBlendTime = blendTime;
-#if DEBUG_PCJ
-		Com_OPrintf("%2d %6d   (%6.2f,%6.2f,%6.2f) %d %d %d %d\n",index,currentTime,angles[0],angles[1],angles[2],up,left,forward,flags);
-#endif
-
-		G2_Generate_Matrix(mod_a, blist, index, angles, flags, up, left, forward);
-		return qtrue;
+		// no - lets try and add this bone in
+		index = G2_Add_Bone(mod_a, blist, boneName);
 	}
 
-	// no - lets try and add this bone in
-	index = G2_Add_Bone(mod_a, blist, boneName);
-
 	// did we find a free one?
 	if (index != -1)
 	{
-		// yes, so set the angles and flags correctly
-		blist[index].flags &= ~(BONE_ANGLES_TOTAL);
-		blist[index].flags |= flags;
-		blist[index].boneBlendStart = currentTime;
-		blist[index].boneBlendTime = blendTime;
-#if DEBUG_PCJ
-		Com_OPrintf("%2d %6d   (%6.2f,%6.2f,%6.2f) %d %d %d %d\n",index,currentTime,angles[0],angles[1],angles[2],up,left,forward,flags);
-#endif
-
-		G2_Generate_Matrix(mod_a, blist, index, angles, flags, up, left, forward);
-		return qtrue;
+		return G2_Set_Bone_Angles_Low(mod_a, blist, index, angles, flags, up, left, forward, blendTime, currentTime);
 	}
 //	assert(0);
 	//Jeese, we don't need an assert here too. There's already a warning in G2_Add_Bone if it fails.
@@ -546,6 +603,27 @@ qboolean G2_Set_Bone_Angles(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char
 	return qfalse;
 }
 
+// Same as G2_Set_Bone_Angles, for a bone number the caller got from G2_Find_Bone_Number
+qboolean G2_Set_Bone_Angles_Num(CGhoul2Info *ghlInfo, boneInfo_v &blist, const int boneNum, const float *angles,
+							const int flags, const Eorientations up, const Eorientations left, const Eorientations forward,
+							const int blendTime, const int currentTime)
+{
+	model_t		*mod_a = (model_t *)ghlInfo->animModel;
+
+	if (boneNum < 0 || boneNum >= mod_a->mdxa->numBones)
+	{
+		return qfalse;
+	}
+
+	int			index = G2_Find_Bone_In_List(blist, boneNum);
+	if (index == -1)
+	{
+		index = G2_Add_Bone_Num(blist, boneNum);
+	}
+
+	return G2_Set_Bone_Angles_Low(mod_a, blist, index, angles, flags, up, left, forward, blendTime, currentTime);
+}
+
 // Given a model handle, and a bone name, we want to set angles specifically for overriding - using a matrix directly
 qboolean G2_Set_Bone_Angles_Matrix_Index(boneInfo_v &blist, const int index,
 								   const mdxaBone_t &matrix, const int flags, qhandle_t *modelList,
@@ -860,6 +938,39 @@ qboolean G2_Set_Bone_Anim(CGhoul2Info *ghlInfo,
 	return qfalse;
 }
 
+// Same as G2_Set_Bone_Anim, for a bone number the caller got from G2_Find_Bone_Number
+qboolean G2_Set_Bone_Anim_Num(CGhoul2Info *ghlInfo,
+						  boneInfo_v &blist,
+						  const int boneNum,
+						  const int startFrame,
+						  const int endFrame,
+						  const int flags,
+						  const float animSpeed,
+						  const int currentTime,
+						  const float setFrame,
+						  const int blendTime)
+{
+	model_t		*mod_a = (model_t *)ghlInfo->animModel;
+
+	if (boneNum < 0 || boneNum >= mod_a->mdxa->numBones)
+	{
+		return qfalse;
+	}
+
+	int			index = G2_Find_Bone_In_List(blist, boneNum);
+	if (index == -1)
+	{
+		index = G2_Add_Bone_Num(blist, boneNum);
+	}
+
+	if (blist[index].flags & BONE_ANGLES_RAGDOLL)
+	{
+		return qtrue; // don't accept any calls on ragdoll bones
+	}
+
+	return G2_Set_Bone_Anim_Index(blist,index,startFrame,endFrame,flags,animSpeed,currentTime,setFrame,blendTime,ghlInfo->aHeader->numFrames);
+}
+
 qboolean G2_Get_Bone_Anim_Range(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName, int *startFrame, int *endFrame)
 {
 	model_t		*mod_a = (model_t *)ghlInfo->animModel;
@@ -1281,6 +1392,11 @@ static void G2_Generate_MatrixRag(
 
 int G2_Find_Bone_Rag(CGhoul2Info *ghlInfo, boneInfo_v &blist, const char *boneName)
 {
+	if (ghlInfo->animModel && ghlInfo->animModel->mdxa == ghlInfo->aHeader)
+	{
+		return G2_Find_Bone(ghlInfo->animModel, blist, boneName);
+	}
+
 	mdxaSkel_t			*skel;
 	mdxaSkelOffsets_t	*offsets;
 
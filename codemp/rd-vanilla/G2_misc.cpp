@@ -386,7 +386,316 @@ int G2_DecideTraceLod(CGhoul2Info &ghoul2, int useLod)
 	return returnLod;
 }
 
-void R_TransformEachSurface( const mdxmSurface_t *surface, vec3_t scale, IHeapAllocator *G2VertSpace, size_t *TransformedVertsArray,CBoneCache *boneCache)
+// Trace bounds.  For every surface of every LOD we keep the bind pose bounds of
+// the verts weighted to each of its bones.  Skinned verts are a convex blend of
+// their bones' transforms, so the box of those bounds transformed by the current
+// bone matrices contains the whole skinned surface, and a trace that misses the
+// box can't touch any of its triangles.  Those surfaces are neither skinned nor
+// tested, which leaves the collision records exactly as before.
+#define G2_TRACE_BOUNDS_EPSILON		1.0f	// padding for the float error of skinning
+
+typedef struct g2BoneBounds_s {
+	int			boneRef;				// bone cache index
+	vec3_t		center;
+	vec3_t		extents;
+} g2BoneBounds_t;
+
+typedef struct g2SurfBounds_s {
+	int			firstBone;
+	int			numBones;				// -1 if the weights can't be bounded, the surface is always traced
+} g2SurfBounds_t;
+
+typedef struct mdxmTraceBounds_s {
+	int				numSurfaces;
+	g2SurfBounds_t	*surfs;				// [lod * numSurfaces + thisSurfaceIndex]
+	g2BoneBounds_t	*bones;
+} mdxmTraceBounds_t;
+
+static cvar_t *r_Ghoul2TraceBounds=NULL;
+
+static int G2_BuildSurfaceBounds(const mdxmSurface_t *surface, g2BoneBounds_t *bones)
+{
+	vec3_t	mins[iMAX_G2_BONEREFS_PER_SURFACE], maxs[iMAX_G2_BONEREFS_PER_SURFACE];
+	int		i, j, k;
+
+	if (surface->numBoneReferences > iMAX_G2_BONEREFS_PER_SURFACE)
+	{
+		return -1;
+	}
+
+	for (i = 0; i < surface->numBoneReferences; i++)
+	{
+		ClearBounds(mins[i], maxs[i]);
+	}
+
+	const mdxmVertex_t *v = (mdxmVertex_t *) ((byte *)surface + surface->ofsVerts);
+	for (j = 0; j < surface->numVerts; j++, v++)
+	{
+		const int iNumWeights = G2_GetVertWeights( v );
+
+		float fTotalWeight = 0.0f;
+		for (k = 0; k < iNumWeights; k++)
+		{
+			const int	iBoneIndex	= G2_GetVertBoneIndex( v, k );
+			const float	fBoneWeight	= G2_GetVertBoneWeight( v, k, fTotalWeight, iNumWeights );
+
+			// anything but a convex blend can leave the bone boxes
+			if (iBoneIndex >= surface->numBoneReferences || fBoneWeight < 0.0f)
+			{
+				return -1;
+			}
+			AddPointToBounds(v->vertCoords, mins[iBoneIndex], maxs[iBoneIndex]);
+		}
+	}
+
+	const int *piBoneReferences = (int*) ((byte*)surface + surface->ofsBoneReferences);
+	int numBones = 0;
+	for (i = 0; i < surface->numBoneReferences; i++)
+	{
+		if (mins[i][0] > maxs[i][0])
+		{	// no verts on this bone
+			continue;
+		}
+
+		g2BoneBounds_t &b = bones[numBones++];
+		b.boneRef = piBoneReferences[i];
+		for (k = 0; k < 3; k++)
+		{
+			b.center[k] = (mins[i][k] + maxs[i][k]) * 0.5f;
+			b.extents[k] = (maxs[i][k] - mins[i][k]) * 0.5f;
+		}
+	}
+
+	return numBones;
+}
+
+// called once a mesh is loaded, the bounds live on the hunk with the model
+void G2_BuildTraceBounds(model_t *mod)
+{
+	const mdxmHeader_t	*mdxm = mod->mdxm;
+	const mdxmLOD_t		*lod;
+	const mdxmSurface_t	*surface;
+	int					l, i, totalBones = 0;
+
+	lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	for (l = 0; l < mdxm->numLODs; l++)
+	{
+		surface = (mdxmSurface_t *) ((byte *)lod + sizeof(mdxmLOD_t) + (mdxm->numSurfaces * sizeof(mdxmLODSurfOffset_t)));
+		for (i = 0; i < mdxm->numSurfaces; i++)
+		{
+			totalBones += surface->numBoneReferences;
+			surface = (mdxmSurface_t *) ((byte *)surface + surface->ofsEnd);
+		}
+		lod = (mdxmLOD_t *) ((byte *)lod + lod->ofsEnd);
+	}
+
+	const int numSurfs = mdxm->numLODs * mdxm->numSurfaces;
+	mdxmTraceBounds_t *tb = (mdxmTraceBounds_t *)Hunk_Alloc(sizeof(mdxmTraceBounds_t) + numSurfs * sizeof(g2SurfBounds_t) + totalBones * sizeof(g2BoneBounds_t), h_low);
+	tb->numSurfaces = mdxm->numSurfaces;
+	tb->surfs = (g2SurfBounds_t *)(tb + 1);
+	tb->bones = (g2BoneBounds_t *)(tb->surfs + numSurfs);
+
+	int firstBone = 0;
+	lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	for (l = 0; l < mdxm->numLODs; l++)
+	{
+		surface = (mdxmSurface_t *) ((byte *)lod + sizeof(mdxmLOD_t) + (mdxm->numSurfaces * sizeof(mdxmLODSurfOffset_t)));
+		for (i = 0; i < mdxm->numSurfaces; i++)
+		{
+			g2SurfBounds_t &sb = tb->surfs[l * mdxm->numSurfaces + surface->thisSurfaceIndex];
+
+			sb.firstBone = firstBone;
+			sb.numBones = G2_BuildSurfaceBounds(surface, &tb->bones[firstBone]);
+			if (sb.numBones > 0)
+			{
+				firstBone += sb.numBones;
+			}
+			surface = (mdxmSurface_t *) ((byte *)surface + surface->ofsEnd);
+		}
+		lod = (mdxmLOD_t *) ((byte *)lod + lod->ofsEnd);
+	}
+
+	mod->mdxmTraceBounds = tb;
+}
+
+// the s, t and u axes G2_RadiusTracePolys classifies verts against, a vert is
+// inside the trace box when all three are in 0..1
+static void G2_RadiusTraceAxes(const vec3_t rayStart, const vec3_t rayEnd, float fRadius, vec3_t saxis, vec3_t taxis, vec3_t v3RayDir)
+{
+	vec3_t basis1;
+	vec3_t basis2;
+
+	basis2[0]=0.0f;
+	basis2[1]=0.0f;
+	basis2[2]=1.0f;
+
+	VectorSubtract(rayEnd, rayStart, v3RayDir);
+
+	CrossProduct(v3RayDir,basis2,basis1);
+
+	if (DotProduct(basis1,basis1)<.1f)
+	{
+		basis2[0]=0.0f;
+		basis2[1]=1.0f;
+		basis2[2]=0.0f;
+		CrossProduct(v3RayDir,basis2,basis1);
+	}
+
+	CrossProduct(v3RayDir,basis1,basis2);
+	// Give me a shot direction not a bunch of zeros :) -Gil
+//	assert(DotProduct(basis1,basis1)>.0001f);
+//	assert(DotProduct(basis2,basis2)>.0001f);
+
+	VectorNormalize(basis1);
+	VectorNormalize(basis2);
+
+	const float c=cos(0.0f);//theta
+	const float s=sin(0.0f);//theta
+
+	VectorScale(basis1, 0.5f * c / fRadius,taxis);
+	VectorMA(taxis,     0.5f * s / fRadius,basis2,taxis);
+
+	VectorScale(basis1,-0.5f * s /fRadius,saxis);
+	VectorMA(    saxis, 0.5f * c /fRadius,basis2,saxis);
+
+	//rayDir/=lengthSquared(raydir);
+	const float f = VectorLengthSquared(v3RayDir);
+	v3RayDir[0]/=f;
+	v3RayDir[1]/=f;
+	v3RayDir[2]/=f;
+}
+
+class CTraceBounds
+{
+public:
+	vec3_t		rayStart;
+	vec3_t		rayEnd;
+	bool		radiusTrace;
+	vec3_t		saxis;
+	vec3_t		taxis;
+	vec3_t		rayDir;
+
+	void	Init(const vec3_t initRayStart, const vec3_t initRayEnd, float fRadius)
+	{
+		VectorCopy(initRayStart, rayStart);
+		VectorCopy(initRayEnd, rayEnd);
+		// same choice as G2_TraceSurfaces
+		radiusTrace = !(fabs(fRadius) < 0.1);
+		if (radiusTrace)
+		{
+			G2_RadiusTraceAxes(rayStart, rayEnd, fRadius, saxis, taxis, rayDir);
+		}
+	}
+
+	bool	Misses(const model_t *currentModel, const mdxmSurface_t *surface, int lod, CBoneCache *boneCache, const vec3_t scale) const;
+
+private:
+	bool	SegmentMisses(const vec3_t center, const vec3_t extents) const;
+	bool	RadiusMisses(const vec3_t center, const vec3_t extents) const;
+};
+
+// separating axis test of the segment against the box
+bool CTraceBounds::SegmentMisses(const vec3_t center, const vec3_t extents) const
+{
+	vec3_t	half, mid, absHalf;
+	int		i;
+
+	for (i = 0; i < 3; i++)
+	{
+		half[i] = (rayEnd[i] - rayStart[i]) * 0.5f;
+		mid[i] = rayStart[i] + half[i] - center[i];
+		absHalf[i] = fabs(half[i]);
+		if (fabs(mid[i]) > extents[i] + absHalf[i])
+		{
+			return true;
+		}
+	}
+
+	if (fabs(mid[1] * half[2] - mid[2] * half[1]) > extents[1] * absHalf[2] + extents[2] * absHalf[1] ||
+		fabs(mid[2] * half[0] - mid[0] * half[2]) > extents[0] * absHalf[2] + extents[2] * absHalf[0] ||
+		fabs(mid[0] * half[1] - mid[1] * half[0]) > extents[0] * absHalf[1] + extents[1] * absHalf[0])
+	{
+		return true;
+	}
+
+	return false;
+}
+
+// true when every point of the box is outside the same side of the radius trace
+// box, which is exactly when G2_RadiusTracePolys would reject all of the verts
+bool CTraceBounds::RadiusMisses(const vec3_t center, const vec3_t extents) const
+{
+	const float	*axes[3] = { saxis, taxis, rayDir };
+	const float	offsets[3] = { 0.5f, 0.5f, 0.0f };
+	vec3_t		delta;
+	int			i;
+
+	VectorSubtract(center, rayStart, delta);
+	for (i = 0; i < 3; i++)
+	{
+		const float d = DotProduct(delta, axes[i]) + offsets[i];
+		const float r = fabs(axes[i][0]) * extents[0] + fabs(axes[i][1]) * extents[1] + fabs(axes[i][2]) * extents[2];
+
+		if (d + r < 0.0f || d - r > 1.0f)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CTraceBounds::Misses(const model_t *currentModel, const mdxmSurface_t *surface, int lod, CBoneCache *boneCache, const vec3_t scale) const
+{
+	const mdxmTraceBounds_t *tb = currentModel->mdxmTraceBounds;
+
+	if (!tb)
+	{
+		return false;
+	}
+
+	const g2SurfBounds_t &sb = tb->surfs[lod * tb->numSurfaces + surface->thisSurfaceIndex];
+	if (sb.numBones <= 0)
+	{
+		return false;
+	}
+
+	vec3_t	mins, maxs, center, extents;
+	int		i, k;
+
+	ClearBounds(mins, maxs);
+	for (i = 0; i < sb.numBones; i++)
+	{
+		const g2BoneBounds_t &b = tb->bones[sb.firstBone + i];
+		const mdxaBone_t &bone = EvalBoneCache(b.boneRef, boneCache);
+
+		for (k = 0; k < 3; k++)
+		{
+			const float c = DotProduct(bone.matrix[k], b.center) + bone.matrix[k][3];
+			const float e = fabs(bone.matrix[k][0]) * b.extents[0] + fabs(bone.matrix[k][1]) * b.extents[1] + fabs(bone.matrix[k][2]) * b.extents[2];
+
+			if (c - e < mins[k])
+			{
+				mins[k] = c - e;
+			}
+			if (c + e > maxs[k])
+			{
+				maxs[k] = c + e;
+			}
+		}
+	}
+
+	// skinning scales after blending
+	for (k = 0; k < 3; k++)
+	{
+		center[k] = (mins[k] + maxs[k]) * 0.5f * scale[k];
+		extents[k] = (maxs[k] - mins[k]) * 0.5f * fabs(scale[k]) + G2_TRACE_BOUNDS_EPSILON;
+	}
+
+	return radiusTrace ? RadiusMisses(center, extents) : SegmentMisses(center, extents);
+}
+
+void R_TransformEachSurface( const mdxmSurface_t *surface, vec3_t scale, IHeapAllocator *G2VertSpace, size_t *TransformedVertsArray,CBoneCache *boneCache, const model_t *currentModel)
 {
 	int				 j, k;
 	mdxmVertex_t 	*v;
@@ -411,7 +720,31 @@ void R_TransformEachSurface( const mdxmSurface_t *surface, vec3_t scale, IHeapAl
 	mdxmVertexTexCoord_t *pTexCoords = (mdxmVertexTexCoord_t *) &v[numVerts];
 
 	// optimisation issue
-	if ((scale[0] != 1.0) || (scale[1] != 1.0) || (scale[2] != 1.0))
+	const bool scaled = (scale[0] != 1.0) || (scale[1] != 1.0) || (scale[2] != 1.0);
+
+	const g2SkinSurf_t *skin = G2_GetSkinSurf(currentModel, surface);
+	if (skin)
+	{
+		const mdxaBone_t *bones[iMAX_G2_BONEREFS_PER_SURFACE];
+
+		for (k = 0; k < surface->numBoneReferences; k++)
+		{
+			if (skin->usedBoneRefs & (1u << k))
+			{
+				bones[k] = &EvalBoneCache(piBoneReferences[k],boneCache);
+			}
+		}
+
+		G2_SkinSurface(surface, skin, bones, scaled ? scale : NULL, TransformedVerts, 5, NULL, 0);
+
+		// we will need the S & T coors too for hitlocation and hitmaterial stuff
+		for ( j = 0; j < numVerts; j++ )
+		{
+			TransformedVerts[j * 5 + 3] = pTexCoords[j].texCoords[0];
+			TransformedVerts[j * 5 + 4] = pTexCoords[j].texCoords[1];
+		}
+	}
+	else if (scaled)
 	{
 		for ( j = 0; j < numVerts; j++ )
 		{
@@ -498,7 +831,7 @@ void R_TransformEachSurface( const mdxmSurface_t *surface, vec3_t scale, IHeapAl
 }
 
 void G2_TransformSurfaces(int surfaceNum, surfaceInfo_v &rootSList,
-					CBoneCache *boneCache, const model_t *currentModel, int lod, vec3_t scale, IHeapAllocator *G2VertSpace, size_t *TransformedVertArray, bool secondTimeAround)
+					CBoneCache *boneCache, const model_t *currentModel, int lod, vec3_t scale, IHeapAllocator *G2VertSpace, size_t *TransformedVertArray, bool secondTimeAround, const CTraceBounds *traceBounds = NULL)
 {
 	int	i;
 	assert(currentModel);
@@ -519,10 +852,12 @@ void G2_TransformSurfaces(int surfaceNum, surfaceInfo_v &rootSList,
 		offFlags = surfOverride->offFlags;
 	}
 	// if this surface is not off, add it to the shader render list
-	if (!offFlags)
+	// surfaces the trace can't reach are left untransformed, G2_TraceSurfaces skips them
+	if (!offFlags && !TransformedVertArray[surface->thisSurfaceIndex] &&
+		!(traceBounds && traceBounds->Misses(currentModel, surface, lod, boneCache, scale)))
 	{
 
-		R_TransformEachSurface(surface, scale, G2VertSpace, TransformedVertArray, boneCache);
+		R_TransformEachSurface(surface, scale, G2VertSpace, TransformedVertArray, boneCache, currentModel);
 	}
 
 	// if we are turning off all descendants, then stop this recursion now
@@ -534,15 +869,17 @@ void G2_TransformSurfaces(int surfaceNum, surfaceInfo_v &rootSList,
 	// now recursively call for the children
 	for (i=0; i< surfInfo->numChildren; i++)
 	{
-		G2_TransformSurfaces(surfInfo->childIndexes[i], rootSList, boneCache, currentModel, lod, scale, G2VertSpace, TransformedVertArray, secondTimeAround);
+		G2_TransformSurfaces(surfInfo->childIndexes[i], rootSList, boneCache, currentModel, lod, scale, G2VertSpace, TransformedVertArray, secondTimeAround, traceBounds);
 	}
 }
 
 // main calling point for the model transform for collision detection. At this point all of the skeleton has been transformed.
+// if a model space trace is passed in, only the surfaces it can hit are transformed.
+// keepVerts adds to the surfaces transformed by the last call instead of starting over.
 #ifdef _G2_GORE
-void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, bool ApplyGore)
+void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, bool ApplyGore, const vec3_t traceStart, const vec3_t traceEnd, float traceRadius, bool keepVerts)
 #else
-void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod)
+void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale, IHeapAllocator *G2VertSpace, int useLod, const vec3_t traceStart, const vec3_t traceEnd, float traceRadius, bool keepVerts)
 #endif
 {
 	int				i, lod;
@@ -560,6 +897,18 @@ void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale,
 		firstModelOnly = qtrue;
 	}
 
+	if ( r_Ghoul2TraceBounds == NULL )
+	{
+		r_Ghoul2TraceBounds = ri->Cvar_Get( "r_ghoul2tracebounds", "1", CVAR_NONE, "Skip skinning Ghoul2 surfaces a trace can't hit" );
+	}
+
+	CTraceBounds		bounds;
+	const CTraceBounds	*traceBounds = NULL;
+	if (traceStart && traceEnd && r_Ghoul2TraceBounds->integer)
+	{
+		bounds.Init(traceStart, traceEnd, traceRadius);
+		traceBounds = &bounds;
+	}
 
 	VectorCopy(scale, correctScale);
 	// check for scales of 0 - that's the default I believe
@@ -616,6 +965,13 @@ void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale,
 		}
 #endif
 
+		if (keepVerts && g.mTransformedVertsArray)
+		{
+			G2_FindOverrideSurface(-1,g.mSlist); //reset the quick surface override lookup;
+			G2_TransformSurfaces(g.mSurfaceRoot, g.mSlist, g.mBoneCache,  g.currentModel, lod, correctScale, G2VertSpace, g.mTransformedVertsArray, false, traceBounds);
+			continue;
+		}
+
 		// give us space for the transformed vertex array to be put in
 		if (!(g.mFlags & GHOUL2_ZONETRANSALLOC))
 		{ //do not stomp if we're using zone space
@@ -631,7 +987,7 @@ void G2_TransformModel(CGhoul2Info_v &ghoul2, const int frameNum, vec3_t scale,
 		G2_FindOverrideSurface(-1,g.mSlist); //reset the quick surface override lookup;
 		// recursively call the model surface transform
 
-		G2_TransformSurfaces(g.mSurfaceRoot, g.mSlist, g.mBoneCache,  g.currentModel, lod, correctScale, G2VertSpace, g.mTransformedVertsArray, false);
+		G2_TransformSurfaces(g.mSurfaceRoot, g.mSlist, g.mBoneCache,  g.currentModel, lod, correctScale, G2VertSpace, g.mTransformedVertsArray, false, traceBounds);
 
 #ifdef _G2_GORE
 		if (ApplyGore && firstModelOnly)
@@ -1202,54 +1558,16 @@ static bool G2_RadiusTracePolys(
 								)
 {
 	int		j;
-	vec3_t basis1;
-	vec3_t basis2;
 	vec3_t taxis;
 	vec3_t saxis;
-
-	basis2[0]=0.0f;
-	basis2[1]=0.0f;
-	basis2[2]=1.0f;
-
 	vec3_t v3RayDir;
-	VectorSubtract(TS.rayEnd, TS.rayStart, v3RayDir);
 
-	CrossProduct(v3RayDir,basis2,basis1);
-
-	if (DotProduct(basis1,basis1)<.1f)
-	{
-		basis2[0]=0.0f;
-		basis2[1]=1.0f;
-		basis2[2]=0.0f;
-		CrossProduct(v3RayDir,basis2,basis1);
-	}
-
-	CrossProduct(v3RayDir,basis1,basis2);
-	// Give me a shot direction not a bunch of zeros :) -Gil
-//	assert(DotProduct(basis1,basis1)>.0001f);
-//	assert(DotProduct(basis2,basis2)>.0001f);
-
-	VectorNormalize(basis1);
-	VectorNormalize(basis2);
-
-	const float c=cos(0.0f);//theta
-	const float s=sin(0.0f);//theta
-
-	VectorScale(basis1, 0.5f * c / TS.m_fRadius,taxis);
-	VectorMA(taxis,     0.5f * s / TS.m_fRadius,basis2,taxis);
-
-	VectorScale(basis1,-0.5f * s /TS.m_fRadius,saxis);
-	VectorMA(    saxis, 0.5f * c /TS.m_fRadius,basis2,saxis);
+	G2_RadiusTraceAxes(TS.rayStart, TS.rayEnd, TS.m_fRadius, saxis, taxis, v3RayDir);
 
 	const float * const verts = (float *)TS.TransformedVertsArray[surface->thisSurfaceIndex];
 	const int numVerts = surface->numVerts;
 
 	int flags=63;
-	//rayDir/=lengthSquared(raydir);
-	const float f = VectorLengthSquared(v3RayDir);
-	v3RayDir[0]/=f;
-	v3RayDir[1]/=f;
-	v3RayDir[2]/=f;
 
 	for ( j = 0; j < numVerts; j++ )
 	{
@@ -1431,7 +1749,8 @@ static void G2_TraceSurfaces(CTraceSurface &TS)
 	}
 
 	// if this surface is not off, try to hit it
-	if (!offFlags)
+	// (G2_TransformModel leaves the ones out of the trace's reach untransformed)
+	if (!offFlags && TS.TransformedVertsArray[surface->thisSurfaceIndex])
 	{
 #ifdef _G2_GORE
 		if (TS.collRecMap)
@@ -0,0 +1,413 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// G2_skinning.cpp -- linear blend skinning of Ghoul2 mesh verts
+//
+// Shared by the back end (RB_SurfaceGhoul) and the collision code
+// (R_TransformEachSurface).  The packed weights and bone indexes of every
+// vert are decoded into a stream when the mesh loads, so skinning a vert is
+// only the matrix blend.  The SSE path keeps a bone matrix column per
+// register and blends the matrices of a vert before transforming it, each
+// vert uses its own bones so there's nothing to gain from a vert per lane.
+
+#include "ghoul2/G2.h"
+#include "ghoul2/g2_local.h"
+#include "tr_local.h"
+
+#if defined(__SSE__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 1 )
+	#define G2_SKIN_SSE
+	#include <xmmintrin.h>
+#endif
+
+typedef struct mdxmSkinStreams_s {
+	int				numSurfaces;
+	g2SkinSurf_t	*surfs;				// [lod * numSurfaces + thisSurfaceIndex]
+} mdxmSkinStreams_t;
+
+static cvar_t *r_Ghoul2SkinStreams=NULL;
+
+// returns false if the surface has to be skinned the old way
+static bool G2_DecodeSkinVerts(const mdxmSurface_t *surface, g2SkinVert_t *out, unsigned int *usedBoneRefs)
+{
+	const mdxmVertex_t *v = (mdxmVertex_t *) ((byte *)surface + surface->ofsVerts);
+	int j, k;
+
+	*usedBoneRefs = 0;
+	for (j = 0; j < surface->numVerts; j++, v++, out++)
+	{
+		const int iNumWeights = G2_GetVertWeights( v );
+
+		float fTotalWeight = 0.0f;
+		memset(out, 0, sizeof(*out));
+		out->numWeights = iNumWeights;
+		for (k = 0; k < iNumWeights; k++)
+		{
+			const int iBoneIndex = G2_GetVertBoneIndex( v, k );
+
+			if (iBoneIndex >= surface->numBoneReferences)
+			{
+				return false;
+			}
+			out->bones[k] = (byte)iBoneIndex;
+			out->weights[k] = G2_GetVertBoneWeight( v, k, fTotalWeight, iNumWeights );
+			*usedBoneRefs |= 1u << iBoneIndex;
+		}
+	}
+
+	return true;
+}
+
+// called once a mesh is loaded, the streams live on the hunk with the model
+void G2_BuildSkinStreams(model_t *mod)
+{
+	const mdxmHeader_t	*mdxm = mod->mdxm;
+	const mdxmLOD_t		*lod;
+	const mdxmSurface_t	*surface;
+	int					l, i, totalVerts = 0;
+
+	lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	for (l = 0; l < mdxm->numLODs; l++)
+	{
+		surface = (mdxmSurface_t *) ((byte *)lod + sizeof(mdxmLOD_t) + (mdxm->numSurfaces * sizeof(mdxmLODSurfOffset_t)));
+		for (i = 0; i < mdxm->numSurfaces; i++)
+		{
+			totalVerts += surface->numVerts;
+			surface = (mdxmSurface_t *) ((byte *)surface + surface->ofsEnd);
+		}
+		lod = (mdxmLOD_t *) ((byte *)lod + lod->ofsEnd);
+	}
+
+	const int numSurfs = mdxm->numLODs * mdxm->numSurfaces;
+	mdxmSkinStreams_t *ss = (mdxmSkinStreams_t *)Hunk_Alloc(sizeof(mdxmSkinStreams_t) + numSurfs * sizeof(g2SkinSurf_t) + totalVerts * sizeof(g2SkinVert_t), h_low);
+	ss->numSurfaces = mdxm->numSurfaces;
+	ss->surfs = (g2SkinSurf_t *)(ss + 1);
+
+	g2SkinVert_t *verts = (g2SkinVert_t *)(ss->surfs + numSurfs);
+	lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	for (l = 0; l < mdxm->numLODs; l++)
+	{
+		surface = (mdxmSurface_t *) ((byte *)lod + sizeof(mdxmLOD_t) + (mdxm->numSurfaces * sizeof(mdxmLODSurfOffset_t)));
+		for (i = 0; i < mdxm->numSurfaces; i++)
+		{
+			g2SkinSurf_t &skin = ss->surfs[l * mdxm->numSurfaces + surface->thisSurfaceIndex];
+
+			if (G2_DecodeSkinVerts(surface, verts, &skin.usedBoneRefs))
+			{
+				skin.verts = verts;
+			}
+			verts += surface->numVerts;
+			surface = (mdxmSurface_t *) ((byte *)surface + surface->ofsEnd);
+		}
+		lod = (mdxmLOD_t *) ((byte *)lod + lod->ofsEnd);
+	}
+
+	mod->mdxmSkinStreams = ss;
+}
+
+/*
+===============
+G2_GetSkinSurf
+
+Finds the decoded stream of a surface of the mesh, NULL if the surface has
+to be skinned the old way
+===============
+*/
+const g2SkinSurf_t *G2_GetSkinSurf(const model_t *mod, const mdxmSurface_t *surface)
+{
+	if ( r_Ghoul2SkinStreams == NULL )
+	{
+		r_Ghoul2SkinStreams = ri->Cvar_Get( "r_ghoul2skinstreams", "1", CVAR_NONE, "Skin Ghoul2 verts from the streams decoded at load time" );
+	}
+
+	if (!mod || !mod->mdxm || !mod->mdxmSkinStreams || !r_Ghoul2SkinStreams->integer)
+	{
+		return NULL;
+	}
+
+	// the render surface doesn't know its lod, but every lod is one block of the file
+	const mdxmHeader_t	*mdxm = mod->mdxm;
+	const mdxmLOD_t		*lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	for (int l = 0; l < mdxm->numLODs; l++)
+	{
+		const mdxmLOD_t *next = (mdxmLOD_t *) ((byte *)lod + lod->ofsEnd);
+		if ((const byte *)surface > (const byte *)lod && (const byte *)surface < (const byte *)next)
+		{
+			const g2SkinSurf_t *skin = &mod->mdxmSkinStreams->surfs[l * mdxm->numSurfaces + surface->thisSurfaceIndex];
+			return skin->verts ? skin : NULL;
+		}
+		lod = next;
+	}
+
+	return NULL;
+}
+
+/*
+===============
+G2_SkinSurface
+
+Skins every vert of the surface into xyz, one vert every xyzStride floats.
+bones holds the matrix of every bone reference in skin->usedBoneRefs.  If
+scale is set the verts are scaled after skinning.  If normal is set it gets
+the normals rotated by the first bone of each vert, the renderer has never
+blended them.
+===============
+*/
+void G2_SkinSurface(const mdxmSurface_t *surface, const g2SkinSurf_t *skin, const mdxaBone_t * const *bones, const float *scale, float *xyz, int xyzStride, float *normal, int normalStride)
+{
+	const mdxmVertex_t	*v = (mdxmVertex_t *) ((byte *)surface + surface->ofsVerts);
+	const g2SkinVert_t	*sv = skin->verts;
+	const int			numVerts = surface->numVerts;
+	int					i, j, k;
+
+#ifdef G2_SKIN_SSE
+	__m128 cols[iMAX_G2_BONEREFS_PER_SURFACE][4];
+
+	for (i = 0; i < surface->numBoneReferences; i++)
+	{
+		if (skin->usedBoneRefs & (1u << i))
+		{
+			cols[i][0] = _mm_loadu_ps(bones[i]->matrix[0]);
+			cols[i][1] = _mm_loadu_ps(bones[i]->matrix[1]);
+			cols[i][2] = _mm_loadu_ps(bones[i]->matrix[2]);
+			cols[i][3] = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(cols[i][0], cols[i][1], cols[i][2], cols[i][3]);
+		}
+	}
+
+	const __m128 vScale = scale ? _mm_setr_ps(scale[0], scale[1], scale[2], 1.0f) : _mm_set1_ps(1.0f);
+
+	for (j = 0; j < numVerts; j++, v++, sv++, xyz += xyzStride)
+	{
+		const __m128 *m = cols[sv->bones[0]];
+		__m128 w = _mm_set1_ps(sv->weights[0]);
+		__m128 c0 = _mm_mul_ps(m[0], w);
+		__m128 c1 = _mm_mul_ps(m[1], w);
+		__m128 c2 = _mm_mul_ps(m[2], w);
+		__m128 c3 = _mm_mul_ps(m[3], w);
+
+		for (k = 1; k < sv->numWeights; k++)
+		{
+			m = cols[sv->bones[k]];
+			w = _mm_set1_ps(sv->weights[k]);
+			c0 = _mm_add_ps(c0, _mm_mul_ps(m[0], w));
+			c1 = _mm_add_ps(c1, _mm_mul_ps(m[1], w));
+			c2 = _mm_add_ps(c2, _mm_mul_ps(m[2], w));
+			c3 = _mm_add_ps(c3, _mm_mul_ps(m[3], w));
+		}
+
+		__m128 r = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v->vertCoords[0])), _mm_mul_ps(c1, _mm_set1_ps(v->vertCoords[1]))),
+			_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(v->vertCoords[2])), c3));
+		r = _mm_mul_ps(r, vScale);
+
+		// only three floats, the fourth is somebody else's
+		_mm_storel_pi((__m64 *)xyz, r);
+		_mm_store_ss(xyz + 2, _mm_movehl_ps(r, r));
+
+		if (normal)
+		{
+			m = cols[sv->bones[0]];
+			const __m128 n = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(m[0], _mm_set1_ps(v->normal[0])), _mm_mul_ps(m[1], _mm_set1_ps(v->normal[1]))),
+				_mm_mul_ps(m[2], _mm_set1_ps(v->normal[2])));
+
+			_mm_storel_pi((__m64 *)normal, n);
+			_mm_store_ss(normal + 2, _mm_movehl_ps(n, n));
+			normal += normalStride;
+		}
+	}
+#else
+	for (j = 0; j < numVerts; j++, v++, sv++, xyz += xyzStride)
+	{
+		vec3_t tempVert;
+
+		VectorClear(tempVert);
+		for (k = 0; k < sv->numWeights; k++)
+		{
+			const mdxaBone_t *bone = bones[sv->bones[k]];
+			const float fBoneWeight = sv->weights[k];
+
+			tempVert[0] += fBoneWeight * ( DotProduct( bone->matrix[0], v->vertCoords ) + bone->matrix[0][3] );
+			tempVert[1] += fBoneWeight * ( DotProduct( bone->matrix[1], v->vertCoords ) + bone->matrix[1][3] );
+			tempVert[2] += fBoneWeight * ( DotProduct( bone->matrix[2], v->vertCoords ) + bone->matrix[2][3] );
+		}
+
+		for (i = 0; i < 3; i++)
+		{
+			xyz[i] = scale ? tempVert[i] * scale[i] : tempVert[i];
+		}
+
+		if (normal)
+		{
+			const mdxaBone_t *bone = bones[sv->bones[0]];
+
+			normal[0] = DotProduct( bone->matrix[0], v->normal );
+			normal[1] = DotProduct( bone->matrix[1], v->normal );
+			normal[2] = DotProduct( bone->matrix[2], v->normal );
+			normal += normalStride;
+		}
+	}
+#endif
+}
+
+/*
+===============
+R_G2SkinBench_f
+
+g2skinbench [model] [iterations]
+
+Skins every surface of the top lod of a mesh with the streams and with the
+per vert decode the collision code used before them, and prints both times
+and the largest difference between the two.
+===============
+*/
+void R_G2SkinBench_f(void)
+{
+	const char	*name = ri->Cmd_Argc() > 1 ? ri->Cmd_Argv(1) : "models/players/kyle/model.glm";
+	const int	iterations = ri->Cmd_Argc() > 2 ? Q_max(1, atoi(ri->Cmd_Argv(2))) : 1000;
+	int			i, j, k, n;
+
+	const model_t *mod = R_GetModelByHandle(RE_RegisterModel(name));
+	if (mod->type != MOD_MDXM || !mod->mdxmSkinStreams)
+	{
+		ri->Printf(PRINT_ALL, "%s isn't a Ghoul2 mesh\n", name);
+		return;
+	}
+
+	// the cost doesn't depend on the pose, so give every bone a different rigid one
+	mdxaBone_t			boneMats[iMAX_G2_BONEREFS_PER_SURFACE];
+	const mdxaBone_t	*bones[iMAX_G2_BONEREFS_PER_SURFACE];
+	for (i = 0; i < iMAX_G2_BONEREFS_PER_SURFACE; i++)
+	{
+		vec3_t angles, axis[3];
+
+		VectorSet(angles, i * 7.0f, i * 13.0f, i * 3.0f);
+		AnglesToAxis(angles, axis);
+		for (j = 0; j < 3; j++)
+		{
+			VectorCopy(axis[j], boneMats[i].matrix[j]);
+			boneMats[i].matrix[j][3] = i * 0.5f - j;
+		}
+		bones[i] = &boneMats[i];
+	}
+
+	const mdxmHeader_t	*mdxm = mod->mdxm;
+	const mdxmLOD_t		*lod = (mdxmLOD_t *) ((byte *)mdxm + mdxm->ofsLODs);
+	const mdxmSurface_t	*surfaces[256];
+	int					numSurfaces = 0, numVerts = 0, maxVerts = 0;
+
+	const mdxmSurface_t *surface = (mdxmSurface_t *) ((byte *)lod + sizeof(mdxmLOD_t) + (mdxm->numSurfaces * sizeof(mdxmLODSurfOffset_t)));
+	for (i = 0; i < mdxm->numSurfaces; i++)
+	{
+		if (surface->numVerts && G2_GetSkinSurf(mod, surface) && numSurfaces < (int)ARRAY_LEN(surfaces))
+		{
+			surfaces[numSurfaces++] = surface;
+			numVerts += surface->numVerts;
+			maxVerts = Q_max(maxVerts, surface->numVerts);
+		}
+		surface = (mdxmSurface_t *) ((byte *)surface + surface->ofsEnd);
+	}
+
+	if (!numVerts)
+	{
+		ri->Printf(PRINT_ALL, "%s has nothing to skin\n", name);
+		return;
+	}
+
+	float *oldVerts = (float *)Z_Malloc(maxVerts * 3 * sizeof(float), TAG_TEMP_WORKSPACE, qfalse);
+	float *newVerts = (float *)Z_Malloc(maxVerts * 3 * sizeof(float), TAG_TEMP_WORKSPACE, qfalse);
+	float maxError = 0.0f;
+
+	int start = ri->Milliseconds();
+	for (n = 0; n < iterations; n++)
+	{
+		for (i = 0; i < numSurfaces; i++)
+		{
+			const mdxmVertex_t *v = (mdxmVertex_t *) ((byte *)surfaces[i] + surfaces[i]->ofsVerts);
+			for (j = 0; j < surfaces[i]->numVerts; j++, v++)
+			{
+				const int iNumWeights = G2_GetVertWeights( v );
+				float *out = &oldVerts[j * 3];
+
+				float fTotalWeight = 0.0f;
+				VectorClear(out);
+				for (k = 0; k < iNumWeights; k++)
+				{
+					const mdxaBone_t &bone = *bones[G2_GetVertBoneIndex( v, k )];
+					const float fBoneWeight = G2_GetVertBoneWeight( v, k, fTotalWeight, iNumWeights );
+
+					out[0] += fBoneWeight * ( DotProduct( bone.matrix[0], v->vertCoords ) + bone.matrix[0][3] );
+					out[1] += fBoneWeight * ( DotProduct( bone.matrix[1], v->vertCoords ) + bone.matrix[1][3] );
+					out[2] += fBoneWeight * ( DotProduct( bone.matrix[2], v->vertCoords ) + bone.matrix[2][3] );
+				}
+			}
+		}
+	}
+	const int oldTime = ri->Milliseconds() - start;
+
+	start = ri->Milliseconds();
+	for (n = 0; n < iterations; n++)
+	{
+		for (i = 0; i < numSurfaces; i++)
+		{
+			G2_SkinSurface(surfaces[i], G2_GetSkinSurf(mod, surfaces[i]), bones, NULL, newVerts, 3, NULL, 0);
+		}
+	}
+	const int newTime = ri->Milliseconds() - start;
+
+	for (i = 0; i < numSurfaces; i++)
+	{
+		const mdxmVertex_t *v = (mdxmVertex_t *) ((byte *)surfaces[i] + surfaces[i]->ofsVerts);
+		G2_SkinSurface(surfaces[i], G2_GetSkinSurf(mod, surfaces[i]), bones, NULL, newVerts, 3, NULL, 0);
+		for (j = 0; j < surfaces[i]->numVerts; j++, v++)
+		{
+			const int iNumWeights = G2_GetVertWeights( v );
+			vec3_t out;
+
+			float fTotalWeight = 0.0f;
+			VectorClear(out);
+			for (k = 0; k < iNumWeights; k++)
+			{
+				const mdxaBone_t &bone = *bones[G2_GetVertBoneIndex( v, k )];
+				const float fBoneWeight = G2_GetVertBoneWeight( v, k, fTotalWeight, iNumWeights );
+
+				out[0] += fBoneWeight * ( DotProduct( bone.matrix[0], v->vertCoords ) + bone.matrix[0][3] );
+				out[1] += fBoneWeight * ( DotProduct( bone.matrix[1], v->vertCoords ) + bone.matrix[1][3] );
+				out[2] += fBoneWeight * ( DotProduct( bone.matrix[2], v->vertCoords ) + bone.matrix[2][3] );
+			}
+			for (k = 0; k < 3; k++)
+			{
+				maxError = Q_max(maxError, (float)fabs(out[k] - newVerts[j * 3 + k]));
+			}
+		}
+	}
+
+	Z_Free(oldVerts);
+	Z_Free(newVerts);
+
+	ri->Printf(PRINT_ALL, "%s: %i surfaces, %i verts, %i iterations\n", name, numSurfaces, numVerts, iterations);
+	ri->Printf(PRINT_ALL, "  per vert decode %i msec, %.1f Mverts/sec\n", oldTime, oldTime ? (float)numVerts * iterations / oldTime / 1000.0f : 0.0f);
+#ifdef G2_SKIN_SSE
+	ri->Printf(PRINT_ALL, "  SSE streams     %i msec, %.1f Mverts/sec\n", newTime, newTime ? (float)numVerts * iterations / newTime / 1000.0f : 0.0f);
+#else
+	ri->Printf(PRINT_ALL, "  streams         %i msec, %.1f Mverts/sec\n", newTime, newTime ? (float)numVerts * iterations / newTime / 1000.0f : 0.0f);
+#endif
+	ri->Printf(PRINT_ALL, "  largest difference %g\n", maxError);
+}
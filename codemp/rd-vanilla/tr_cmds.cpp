@@ -104,6 +104,9 @@ void R_IssueRenderCommands( qboolean runPerformanceCounters ) {
 		R_PerformanceCounters();
 	}
 
+	// the back end may draw with any image registered so far
+	R_ImageQueue_Finish();
+
 	// actually start the commands going
 	if ( !r_skipBackEnd->integer ) {
 		// let it start on the new batch
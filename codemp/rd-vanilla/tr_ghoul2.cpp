@@ -500,6 +500,12 @@ void RemoveBoneCache(CBoneCache *boneCache)
 	delete boneCache;
 }
 
+// changes every time the skeleton is rebuilt
+int BoneCacheTouch(const CBoneCache *boneCache)
+{
+	return boneCache ? boneCache->mCurrentTouch : 0;
+}
+
 #ifdef _G2_LISTEN_SERVER_OPT
 void CopyBoneCache(CBoneCache *to, CBoneCache *from)
 {
@@ -3476,15 +3482,15 @@ void RB_SurfaceGhoul( CRenderableSurface *surf )
 	G2PerformanceTimer_RB_SurfaceGhoul.Start();
 #endif
 
-	static int				j, k;
-	static int				baseIndex, baseVertex;
-	static int				numVerts;
-	static mdxmVertex_t 	*v;
-	static int				*triangles;
-	static int				indexes;
-	static glIndex_t		*tessIndexes;
-	static mdxmVertexTexCoord_t *pTexCoords;
-	static int				*piBoneReferences;
+	int						j, k;
+	int						baseIndex, baseVertex;
+	int						numVerts;
+	mdxmVertex_t 			*v;
+	int						*triangles;
+	int						indexes;
+	glIndex_t				*tessIndexes;
+	mdxmVertexTexCoord_t	*pTexCoords;
+	int						*piBoneReferences;
 
 #ifdef _G2_GORE
 	if (surf->alternateTex)
@@ -3555,8 +3561,7 @@ void RB_SurfaceGhoul( CRenderableSurface *surf )
 		//now check for fade overrides -rww
 		if (surf->fade)
 		{
-			static int lFade;
-			static int j;
+			int lFade;
 
 			if (surf->fade<1.0)
 			{
@@ -3642,6 +3647,29 @@ void RB_SurfaceGhoul( CRenderableSurface *surf )
 	v = (mdxmVertex_t *) ((byte *)surface + surface->ofsVerts);
 	pTexCoords = (mdxmVertexTexCoord_t *) &v[numVerts];
 
+	const g2SkinSurf_t *skin = G2_GetSkinSurf(bones->mod, surface);
+	if (skin)
+	{
+		const mdxaBone_t *boneMats[iMAX_G2_BONEREFS_PER_SURFACE];
+
+		for (k = 0; k < surface->numBoneReferences; k++)
+		{
+			if (skin->usedBoneRefs & (1u << k))
+			{
+				boneMats[k] = &bones->EvalRender(piBoneReferences[k]);
+			}
+		}
+
+		G2_SkinSurface(surface, skin, boneMats, NULL, tess.xyz[baseVertex], 4, tess.normal[baseVertex], 4);
+
+		for ( j = 0; j < numVerts; j++, baseVertex++ )
+		{
+			tess.texCoords[baseVertex][0][0] = pTexCoords[j].texCoords[0];
+			tess.texCoords[baseVertex][0][1] = pTexCoords[j].texCoords[1];
+		}
+	}
+	else
+	{
 //	if (r_ghoul2fastnormals&&r_ghoul2fastnormals->integer==0)
 #if 0
 	if (0)
@@ -3766,6 +3794,7 @@ void RB_SurfaceGhoul( CRenderableSurface *surf )
 #if 0
 	}
 #endif
+	}
 
 #ifdef _G2_GORE
 	CRenderableSurface *storeSurf = surf;
@@ -4275,6 +4304,8 @@ qboolean R_LoadMDXM( model_t *mod, void *buffer, const char *mod_name, qboolean
 
 	if (bAlreadyFound)
 	{
+		G2_BuildTraceBounds(mod);
+		G2_BuildSkinStreams(mod);
 		return qtrue;	// All done. Stop, go no further, do not LittleLong(), do not pass Go...
 	}
 
@@ -4432,6 +4463,8 @@ qboolean R_LoadMDXM( model_t *mod, void *buffer, const char *mod_name, qboolean
 		// find the next LOD
 		lod = (mdxmLOD_t *)( (byte *)lod + lod->ofsEnd );
 	}
+	G2_BuildTraceBounds(mod);
+	G2_BuildSkinStreams(mod);
 	return qtrue;
 }
 
@@ -4847,6 +4880,7 @@ qboolean R_LoadMDXA( model_t *mod, void *buffer, const char *mod_name, qboolean
 
 	if (bAlreadyFound)
 	{
+		G2_BuildBoneHash(mod);
 		return qtrue;	// All done, stop here, do not LittleLong() etc. Do not pass go...
 	}
 
@@ -4902,6 +4936,7 @@ qboolean R_LoadMDXA( model_t *mod, void *buffer, const char *mod_name, qboolean
 			LS(pwIn[k]);
 	}
 #endif
+	G2_BuildBoneHash(mod);
 	return qtrue;
 }
 
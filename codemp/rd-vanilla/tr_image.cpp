@@ -25,10 +25,12 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "tr_local.h"
 #include "../rd-common/tr_common.h"
 #include "glext.h"
+#include "tr_mipmap.h"
 
 #include <map>
 
 static byte			 s_intensitytable[256];
+static float		 s_intensityScale = 1.0f;	// what s_intensitytable was built from
 static unsigned char s_gammatable[256];
 
 int		gl_filter_min = GL_LINEAR_MIPMAP_NEAREST;
@@ -311,160 +313,32 @@ void R_ImageList_f( void ) {
 R_LightScaleTexture
 
 Scale up the pixel values in a texture to increase the
-lighting range
+lighting range, with the table R_GetImageBuildParms made
 ================
 */
-void R_LightScaleTexture (unsigned *in, int inwidth, int inheight, qboolean only_gamma )
+static void R_LightScaleTexture( byte *p, int pixelCount, const byte *table )
 {
-	if ( only_gamma )
+	for ( int i = 0; i < pixelCount; i++, p += 4 )
 	{
-		if ( !glConfig.deviceSupportsGamma && !glConfigExt.doGammaCorrectionWithShaders )
-		{
-			int		i, c;
-			byte	*p;
-
-			p = (byte *)in;
-
-			c = inwidth*inheight;
-			for (i=0 ; i<c ; i++, p+=4)
-			{
-				p[0] = s_gammatable[p[0]];
-				p[1] = s_gammatable[p[1]];
-				p[2] = s_gammatable[p[2]];
-			}
-		}
-	}
-	else
-	{
-		int		i, c;
-		byte	*p;
-
-		p = (byte *)in;
-
-		c = inwidth*inheight;
-
-		if ( glConfig.deviceSupportsGamma || glConfigExt.doGammaCorrectionWithShaders )
-		{
-			for (i=0 ; i<c ; i++, p+=4)
-			{
-				p[0] = s_intensitytable[p[0]];
-				p[1] = s_intensitytable[p[1]];
-				p[2] = s_intensitytable[p[2]];
-			}
-		}
-		else
-		{
-			for (i=0 ; i<c ; i++, p+=4)
-			{
-				p[0] = s_gammatable[s_intensitytable[p[0]]];
-				p[1] = s_gammatable[s_intensitytable[p[1]]];
-				p[2] = s_gammatable[s_intensitytable[p[2]]];
-			}
-		}
+		p[0] = table[p[0]];
+		p[1] = table[p[1]];
+		p[2] = table[p[2]];
 	}
 }
 
 
-/*
-================
-R_MipMap2
-
-Operates in place, quartering the size of the texture
-Proper linear filter
-================
-*/
-static void R_MipMap2( unsigned *in, int inWidth, int inHeight ) {
-	int			i, j, k;
-	byte		*outpix;
-	int			inWidthMask, inHeightMask;
-	int			total;
-	int			outWidth, outHeight;
-	unsigned	*temp;
-
-	outWidth = inWidth >> 1;
-	outHeight = inHeight >> 1;
-	temp = (unsigned int *)Hunk_AllocateTempMemory( outWidth * outHeight * 4 );
-
-	inWidthMask = inWidth - 1;
-	inHeightMask = inHeight - 1;
-
-	for ( i = 0 ; i < outHeight ; i++ ) {
-		for ( j = 0 ; j < outWidth ; j++ ) {
-			outpix = (byte *) ( temp + i * outWidth + j );
-			for ( k = 0 ; k < 4 ; k++ ) {
-				total =
-					1 * ((byte *)&in[ ((i*2-1)&inHeightMask)*inWidth + ((j*2-1)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2-1)&inHeightMask)*inWidth + ((j*2)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2-1)&inHeightMask)*inWidth + ((j*2+1)&inWidthMask) ])[k] +
-					1 * ((byte *)&in[ ((i*2-1)&inHeightMask)*inWidth + ((j*2+2)&inWidthMask) ])[k] +
-
-					2 * ((byte *)&in[ ((i*2)&inHeightMask)*inWidth + ((j*2-1)&inWidthMask) ])[k] +
-					4 * ((byte *)&in[ ((i*2)&inHeightMask)*inWidth + ((j*2)&inWidthMask) ])[k] +
-					4 * ((byte *)&in[ ((i*2)&inHeightMask)*inWidth + ((j*2+1)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2)&inHeightMask)*inWidth + ((j*2+2)&inWidthMask) ])[k] +
-
-					2 * ((byte *)&in[ ((i*2+1)&inHeightMask)*inWidth + ((j*2-1)&inWidthMask) ])[k] +
-					4 * ((byte *)&in[ ((i*2+1)&inHeightMask)*inWidth + ((j*2)&inWidthMask) ])[k] +
-					4 * ((byte *)&in[ ((i*2+1)&inHeightMask)*inWidth + ((j*2+1)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2+1)&inHeightMask)*inWidth + ((j*2+2)&inWidthMask) ])[k] +
-
-					1 * ((byte *)&in[ ((i*2+2)&inHeightMask)*inWidth + ((j*2-1)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2+2)&inHeightMask)*inWidth + ((j*2)&inWidthMask) ])[k] +
-					2 * ((byte *)&in[ ((i*2+2)&inHeightMask)*inWidth + ((j*2+1)&inWidthMask) ])[k] +
-					1 * ((byte *)&in[ ((i*2+2)&inHeightMask)*inWidth + ((j*2+2)&inWidthMask) ])[k];
-				outpix[k] = total / 36;
-			}
-		}
-	}
-
-	memcpy( in, temp, outWidth * outHeight * 4 );
-	Hunk_FreeTempMemory( temp );
-}
-
 /*
 ================
 R_MipMap
 
-Operates in place, quartering the size of the texture
+Quarters the size of the texture into out, which must not be in
 ================
 */
-static void R_MipMap (byte *in, int width, int height) {
-	int		i, j;
-	byte	*out;
-	int		row;
-
-	if ( !r_simpleMipMaps->integer ) {
-		R_MipMap2( (unsigned *)in, width, height );
-		return;
-	}
-
-	if ( width == 1 && height == 1 ) {
-		return;
-	}
-
-	row = width * 4;
-	out = in;
-	width >>= 1;
-	height >>= 1;
-
-	if ( width == 0 || height == 0 ) {
-		width += height;	// get largest
-		for (i=0 ; i<width ; i++, out+=4, in+=8 ) {
-			out[0] = ( in[0] + in[4] )>>1;
-			out[1] = ( in[1] + in[5] )>>1;
-			out[2] = ( in[2] + in[6] )>>1;
-			out[3] = ( in[3] + in[7] )>>1;
-		}
-		return;
-	}
-
-	for (i=0 ; i<height ; i++, in+=row) {
-		for (j=0 ; j<width ; j++, out+=4, in+=8) {
-			out[0] = (in[0] + in[4] + in[row+0] + in[row+4])>>2;
-			out[1] = (in[1] + in[5] + in[row+1] + in[row+5])>>2;
-			out[2] = (in[2] + in[6] + in[row+2] + in[row+6])>>2;
-			out[3] = (in[3] + in[7] + in[row+3] + in[row+7])>>2;
-		}
+static void R_MipMap (const byte *in, byte *out, int width, int height, qboolean simple, qboolean simd) {
+	if ( simple ) {
+		R_MipMapBox( in, out, width, height, simd ? true : false );
+	} else {
+		R_MipMapFilter( in, out, width, height, simd ? true : false );
 	}
 }
 
@@ -564,16 +438,146 @@ static void R_Images_DeleteImageContents( image_t *pImage )
 
 
 
+/*
+===============
+R_GetImageBuildParms
+
+Everything R_BuildImageLevels needs to know from the cvars, the GL config and
+the gamma tables, copied on the main thread so a gamma change or vid_restart
+can't pull them out from under an image thread
+===============
+*/
+void R_GetImageBuildParms( imageBuildParms_t *parms, qboolean mipmap, qboolean picmip ) {
+	parms->mipmap = mipmap;
+	parms->picmip = picmip ? r_picmip->integer : 0;
+	parms->maxTextureSize = glConfig.maxTextureSize;
+	parms->simpleMipMaps = (qboolean)!!r_simpleMipMaps->integer;
+	parms->colorMipLevels = (qboolean)!!r_colorMipLevels->integer;
+	parms->simd = (qboolean)!!r_imageSIMD->integer;
+	parms->hardwareGamma = (qboolean)( glConfig.deviceSupportsGamma || glConfigExt.doGammaCorrectionWithShaders );
+	parms->intensityScale = s_intensityScale;
+
+	for ( int i = 0; i < 256; i++ ) {
+		parms->lightScale[i] = parms->hardwareGamma ? s_intensitytable[i] : s_gammatable[s_intensitytable[i]];
+	}
+}
+
+/*
+===============
+R_BuildImageLevels
+
+The CPU side of a texture upload: picmip, the clamp to the largest texture
+size, light scaling and the mip chain.  pic is used as scratch space.
+Doesn't use GL or the zone, so it can run on the image threads.
+===============
+*/
+void R_BuildImageLevels( imageLevels_t *levels, byte *pic, int width, int height, const imageBuildParms_t *parms ) {
+	int		i, c, size;
+	byte	*scan, *temp;
+
+	//
+	// perform optional picmip operation, and clamp to the current upper
+	// OpenGL limit, scaling both axis down equally so we don't have to
+	// deal with a half mip resampling
+	//
+	for ( i = 0; i < parms->picmip || width > parms->maxTextureSize || height > parms->maxTextureSize; i++ ) {
+		temp = (byte *)malloc( Q_max( width >> 1, 1 ) * Q_max( height >> 1, 1 ) * 4 );
+		R_MipMap( pic, temp, width, height, parms->simpleMipMaps, parms->simd );
+		width >>= 1;
+		height >>= 1;
+		if (width < 1) {
+			width = 1;
+		}
+		if (height < 1) {
+			height = 1;
+		}
+		memcpy( pic, temp, width * height * 4 );
+		free( temp );
+	}
+
+	//
+	// verify if the alpha channel is being used or not
+	//
+	c = width*height;
+	scan = pic;
+	levels->samples = 3;
+	for ( i = 0; i < c; i++ )
+	{
+		if ( scan[i*4 + 3] != 255 )
+		{
+			levels->samples = 4;
+			break;
+		}
+	}
+
+	levels->width = width;
+	levels->height = height;
+	levels->numLevels = 1;
+
+	size = width * height * 4;
+	if ( parms->mipmap ) {
+		for ( int w = width, h = height; w > 1 || h > 1; levels->numLevels++ ) {
+			w = Q_max( w >> 1, 1 );
+			h = Q_max( h >> 1, 1 );
+			size += w * h * 4;
+		}
+	}
+
+	levels->data = (byte *)malloc( size );
+	memcpy( levels->data, pic, width * height * 4 );
+
+	if ( !parms->mipmap ) {
+		return;
+	}
+
+	if ( parms->simd && parms->hardwareGamma ) {
+		// only the intensity table, which is a plain scale
+		R_ScalePixels( levels->data, width * height, parms->intensityScale, true );
+	} else {
+		R_LightScaleTexture( levels->data, width * height, parms->lightScale );
+	}
+
+	byte *level = levels->data;
+	for ( i = 1; i < levels->numLevels; i++ ) {
+		byte *next = level + width * height * 4;
+
+		R_MipMap( level, next, width, height, parms->simpleMipMaps, parms->simd );
+		width >>= 1;
+		height >>= 1;
+		if (width < 1)
+			width = 1;
+		if (height < 1)
+			height = 1;
+
+		if ( parms->colorMipLevels )
+		{
+			R_BlendOverTexture( next, width * height, mipBlendColors[i] );
+		}
+
+		level = next;
+	}
+}
+
+/*
+===============
+R_FreeImageLevels
+===============
+*/
+void R_FreeImageLevels( imageLevels_t *levels ) {
+	free( levels->data );
+	levels->data = NULL;
+}
+
 /*
 ===============
 Upload32
 
+The GL side of a texture upload, everything else has been done by
+R_BuildImageLevels
 ===============
 */
-static void Upload32( unsigned *data,
-						 GLenum format,
+static void Upload32( const imageLevels_t *levels,
 						 qboolean mipmap,
-						 qboolean picmip,
 						 qboolean isLightmap,
 						 qboolean allowTC,
 						 int *pformat,
@@ -585,73 +589,14 @@ static void Upload32( unsigned *data,
 		uiTarget = GL_TEXTURE_RECTANGLE_ARB;
 	}
 
-	if (format == GL_RGBA)
+	if ( levels )
 	{
-		int			samples;
-		int			i, c;
-		byte		*scan;
-		float		rMax = 0, gMax = 0, bMax = 0;
-		int			width = *pUploadWidth;
-		int			height = *pUploadHeight;
-
-		//
-		// perform optional picmip operation
-		//
-		if ( picmip ) {
-			for(i = 0; i < r_picmip->integer; i++) {
-				R_MipMap( (byte *)data, width, height );
-				width >>= 1;
-				height >>= 1;
-				if (width < 1) {
-					width = 1;
-				}
-				if (height < 1) {
-					height = 1;
-				}
-			}
-		}
-
-		//
-		// clamp to the current upper OpenGL limit
-		// scale both axis down equally so we don't have to
-		// deal with a half mip resampling
-		//
-		while ( width > glConfig.maxTextureSize	|| height > glConfig.maxTextureSize ) {
-			R_MipMap( (byte *)data, width, height );
-			width >>= 1;
-			height >>= 1;
-		}
-
-		//
-		// scan the texture for each channel's max values
-		// and verify if the alpha channel is being used or not
-		//
-		c = width*height;
-		scan = ((byte *)data);
-		samples = 3;
-		for ( i = 0; i < c; i++ )
-		{
-			if ( scan[i*4+0] > rMax )
-			{
-				rMax = scan[i*4+0];
-			}
-			if ( scan[i*4+1] > gMax )
-			{
-				gMax = scan[i*4+1];
-			}
-			if ( scan[i*4+2] > bMax )
-			{
-				bMax = scan[i*4+2];
-			}
-			if ( scan[i*4 + 3] != 255 )
-			{
-				samples = 4;
-				break;
-			}
-		}
+		int			width = levels->width;
+		int			height = levels->height;
+		const byte	*data = levels->data;
 
 		// select proper internal format
-		if ( samples == 3 )
+		if ( levels->samples == 3 )
 		{
 			if ( glConfig.textureCompression == TC_S3TC && allowTC )
 			{
@@ -688,7 +633,7 @@ static void Upload32( unsigned *data,
 				*pformat = 3;
 			}
 		}
-		else if ( samples == 4 )
+		else if ( levels->samples == 4 )
 		{
 			if ( glConfig.textureCompression == TC_S3TC_DXT && allowTC)
 			{	// Compress both alpha and color
@@ -711,47 +656,19 @@ static void Upload32( unsigned *data,
 		*pUploadWidth = width;
 		*pUploadHeight = height;
 
-		// copy or resample data as appropriate for first MIP level
-		if (!mipmap)
-		{
-			qglTexImage2D( uiTarget, 0, *pformat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
-			goto done;
-		}
-
-		R_LightScaleTexture (data, width, height, (qboolean)!mipmap );
-
-		qglTexImage2D( uiTarget, 0, *pformat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
-
-		if (mipmap)
+		for ( int miplevel = 0; miplevel < levels->numLevels; miplevel++ )
 		{
-			int		miplevel;
-
-			miplevel = 0;
-			while (width > 1 || height > 1)
-			{
-				R_MipMap( (byte *)data, width, height );
-				width >>= 1;
-				height >>= 1;
-				if (width < 1)
-					width = 1;
-				if (height < 1)
-					height = 1;
-				miplevel++;
-
-				if ( r_colorMipLevels->integer )
-				{
-					R_BlendOverTexture( (byte *)data, width * height, mipBlendColors[miplevel] );
-				}
+			qglTexImage2D( uiTarget, miplevel, *pformat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
 
-				qglTexImage2D( uiTarget, miplevel, *pformat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data );
-			}
+			data += width * height * 4;
+			width >>= 1;
+			height >>= 1;
+			if (width < 1)
+				width = 1;
+			if (height < 1)
+				height = 1;
 		}
 	}
-	else
-	{
-	}
-
-done:
 
 	if (mipmap)
 	{
@@ -791,6 +708,8 @@ static void GL_ResetBinds(void)
 //
 void R_Images_DeleteLightMaps(void)
 {
+	R_ImageQueue_Finish();
+
 	for (AllocatedImages_t::iterator itImage = AllocatedImages.begin(); itImage != AllocatedImages.end(); /* empty */)
 	{
 		image_t *pImage = (*itImage).second;
@@ -814,6 +733,8 @@ void R_Images_DeleteLightMaps(void)
 //
 void R_Images_DeleteImage(image_t *pImage)
 {
+	R_ImageQueue_Finish();
+
 	// Even though we supply the image handle, we need to get the corresponding iterator entry...
 	//
 	AllocatedImages_t::iterator itImage = AllocatedImages.find(pImage->imgName);
@@ -832,6 +753,8 @@ void R_Images_DeleteImage(image_t *pImage)
 //
 void R_Images_Clear(void)
 {
+	R_ImageQueue_Finish();
+
 	image_t *pImage;
 	//	int iNumImages =
 					  R_Images_StartIteration();
@@ -872,6 +795,8 @@ qboolean RE_RegisterImages_LevelLoadEnd(void)
 {
 	ri->Printf( PRINT_DEVELOPER, S_COLOR_RED "RE_RegisterImages_LevelLoadEnd():\n");
 
+	R_ImageQueue_Finish();
+
 //	int iNumImages = AllocatedImages.size();	// more for curiosity, really.
 
 	qboolean imageDeleted = qtrue;
@@ -971,44 +896,13 @@ static image_t *R_FindImageFile_NoLoad(const char *name, qboolean mipmap, qboole
 
 /*
 ================
-R_CreateImage
+R_NewImage
 
-This is the only way any image_t are created
+Allocates and registers an image_t, leaving the texture to the caller
 ================
 */
-image_t *R_CreateImage( const char *name, const byte *pic, int width, int height,
-					   GLenum format, qboolean mipmap, qboolean allowPicmip, qboolean allowTC, int glWrapClampMode, bool bRectangle )
-{
-	image_t		*image;
-	qboolean	isLightmap = qfalse;
-
-	if (strlen(name) >= MAX_QPATH ) {
-		Com_Error (ERR_DROP, "R_CreateImage: \"%s\" is too long\n", name);
-	}
-
-	if(glConfig.clampToEdgeAvailable && glWrapClampMode == GL_CLAMP) {
-		glWrapClampMode = GL_CLAMP_TO_EDGE;
-	}
-
-	if (name[0] == '*')
-	{
-		const char *psLightMapNameSearchPos = strrchr(name,'/');
-		if (  psLightMapNameSearchPos && !strncmp( psLightMapNameSearchPos+1, "lightmap", 8 ) ) {
-			isLightmap = qtrue;
-		}
-	}
-
-	if ( (width&(width-1)) || (height&(height-1)) )
-	{
-		Com_Error( ERR_FATAL, "R_CreateImage: %s dimensions (%i x %i) not power of 2!\n",name,width,height);
-	}
-
-	image = R_FindImageFile_NoLoad(name, mipmap, allowPicmip, allowTC, glWrapClampMode );
-	if (image) {
-		return image;
-	}
-
-	image = (image_t*) Z_Malloc( sizeof( image_t ), TAG_IMAGE_T, qtrue );
+image_t *R_NewImage( const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode ) {
+	image_t *image = (image_t*) Z_Malloc( sizeof( image_t ), TAG_IMAGE_T, qtrue );
 //	memset(image,0,sizeof(*image));	// qtrue above does this
 
 	image->texnum = 1024 + giTextureBindNum++;	// ++ is of course staggeringly important...
@@ -1019,12 +913,24 @@ image_t *R_CreateImage( const char *name, const byte *pic, int width, int height
 
 	image->mipmap = !!mipmap;
 	image->allowPicmip = !!allowPicmip;
+	image->wrapClampMode = glWrapClampMode;
 
-	Q_strncpyz(image->imgName, name, sizeof(image->imgName));
+	const char *psNewName = GenerateImageMappingName(name);
+	Q_strncpyz(image->imgName, psNewName, sizeof(image->imgName));
+	AllocatedImages[ image->imgName ] = image;
 
-	image->width = width;
-	image->height = height;
-	image->wrapClampMode = glWrapClampMode;
+	return image;
+}
+
+/*
+================
+R_UploadImage
+
+Gives an image from R_NewImage its texture
+================
+*/
+void R_UploadImage( image_t *image, const imageLevels_t *levels, qboolean isLightmap, qboolean allowTC, bool bRectangle ) {
+	int glWrapClampMode = image->wrapClampMode;
 
 	if ( qglActiveTextureARB ) {
 		GL_SelectTexture( 0 );
@@ -1044,9 +950,8 @@ image_t *R_CreateImage( const char *name, const byte *pic, int width, int height
 		GL_Bind(image);
 	}
 
-	Upload32( (unsigned *)pic,	format,
+	Upload32( levels,
 								(qboolean)image->mipmap,
-								allowPicmip,
 								isLightmap,
 								allowTC,
 								&image->internalFormat,
@@ -1059,15 +964,71 @@ image_t *R_CreateImage( const char *name, const byte *pic, int width, int height
 	qglBindTexture( uiTarget, 0 );	//jfm: i don't know why this is here, but it breaks lightmaps when there's only 1
 	glState.currenttextures[glState.currenttmu] = 0;	//mark it not bound
 
-	const char *psNewName = GenerateImageMappingName(name);
-	Q_strncpyz(image->imgName, psNewName, sizeof(image->imgName));
-	AllocatedImages[ image->imgName ] = image;
-
 	if ( bRectangle )
 	{
 		qglDisable( uiTarget );
 		qglEnable( GL_TEXTURE_2D );
 	}
+}
+
+/*
+================
+R_CreateImage
+
+This is the only way any image_t are created, apart from the
+image queue's R_NewImage
+================
+*/
+image_t *R_CreateImage( const char *name, const byte *pic, int width, int height,
+					   GLenum format, qboolean mipmap, qboolean allowPicmip, qboolean allowTC, int glWrapClampMode, bool bRectangle )
+{
+	image_t		*image;
+	qboolean	isLightmap = qfalse;
+
+	if (strlen(name) >= MAX_QPATH ) {
+		Com_Error (ERR_DROP, "R_CreateImage: \"%s\" is too long\n", name);
+	}
+
+	if(glConfig.clampToEdgeAvailable && glWrapClampMode == GL_CLAMP) {
+		glWrapClampMode = GL_CLAMP_TO_EDGE;
+	}
+
+	if (name[0] == '*')
+	{
+		const char *psLightMapNameSearchPos = strrchr(name,'/');
+		if (  psLightMapNameSearchPos && !strncmp( psLightMapNameSearchPos+1, "lightmap", 8 ) ) {
+			isLightmap = qtrue;
+		}
+	}
+
+	if ( (width&(width-1)) || (height&(height-1)) )
+	{
+		Com_Error( ERR_FATAL, "R_CreateImage: %s dimensions (%i x %i) not power of 2!\n",name,width,height);
+	}
+
+	image = R_FindImageFile_NoLoad(name, mipmap, allowPicmip, allowTC, glWrapClampMode );
+	if (image) {
+		return image;
+	}
+
+	image = R_NewImage( name, mipmap, allowPicmip, glWrapClampMode );
+	image->width = width;
+	image->height = height;
+
+	if ( format == GL_RGBA )
+	{
+		imageBuildParms_t	parms;
+		imageLevels_t		levels;
+
+		R_GetImageBuildParms( &parms, mipmap, allowPicmip );
+		R_BuildImageLevels( &levels, (byte *)pic, width, height, &parms );
+		R_UploadImage( image, &levels, isLightmap, allowTC, bRectangle );
+		R_FreeImageLevels( &levels );
+	}
+	else
+	{
+		R_UploadImage( image, NULL, isLightmap, allowTC, bRectangle );
+	}
 
 	return image;
 }
@@ -1102,6 +1063,12 @@ image_t	*R_FindImageFile( const char *name, qboolean mipmap, qboolean allowPicmi
 		return image;
 	}
 
+	// let the image threads decode it, it's uploaded before anything is drawn
+	//
+	if ( R_ImageQueue_Active() ) {
+		return R_ImageQueue_Add( name, mipmap, allowPicmip, allowTC, glWrapClampMode );
+	}
+
 	//
 	// load the pic from disk
 	//
@@ -1116,11 +1083,12 @@ image_t	*R_FindImageFile( const char *name, qboolean mipmap, qboolean allowPicmi
 	if ( (width&(width-1)) || (height&(height-1)) )
 	{
 		ri->Printf( PRINT_ALL, "Refusing to load non-power-2-dims(%d,%d) pic \"%s\"...\n", width,height,name );
+		R_FreeImage( pic );
 		return NULL;
 	}
 
 	image = R_CreateImage( ( char * ) name, pic, width, height, GL_RGBA, mipmap, allowPicmip, allowTC, glWrapClampMode );
-	Z_Free( pic );
+	R_FreeImage( pic );
 	return image;
 }
 
@@ -1140,7 +1108,7 @@ static void R_CreateDlightImage( void )
 	if (pic)
 	{
 		tr.dlightImage = R_CreateImage("*dlight", pic, width, height, GL_RGBA, qfalse, qfalse, qfalse, GL_CLAMP );
-		Z_Free(pic);
+		R_FreeImage(pic);
 	}
 	else
 	{	// if we dont get a successful load
@@ -1268,16 +1236,15 @@ static void R_CreateFogImage( void ) {
 
 /*
 ==================
-R_CreateDefaultImage
+R_DefaultImageData
 ==================
 */
 #define	DEFAULT_SIZE	16
-static void R_CreateDefaultImage( void ) {
+static void R_DefaultImageData( byte data[DEFAULT_SIZE][DEFAULT_SIZE][4] ) {
 	int		x;
-	byte	data[DEFAULT_SIZE][DEFAULT_SIZE][4];
 
 	// the default image will be a box, to allow you to see the mapping coordinates
-	memset( data, 32, sizeof( data ) );
+	memset( data, 32, DEFAULT_SIZE * DEFAULT_SIZE * 4 );
 	for ( x = 0 ; x < DEFAULT_SIZE ; x++ ) {
 		data[0][x][0] =
 		data[0][x][1] =
@@ -1299,9 +1266,39 @@ static void R_CreateDefaultImage( void ) {
 		data[x][DEFAULT_SIZE-1][2] =
 		data[x][DEFAULT_SIZE-1][3] = 255;
 	}
+}
+
+/*
+==================
+R_CreateDefaultImage
+==================
+*/
+static void R_CreateDefaultImage( void ) {
+	byte	data[DEFAULT_SIZE][DEFAULT_SIZE][4];
+
+	R_DefaultImageData( data );
 	tr.defaultImage = R_CreateImage("*default", (byte *)data, DEFAULT_SIZE, DEFAULT_SIZE, GL_RGBA, qtrue, qfalse, qfalse, GL_REPEAT );
 }
 
+/*
+==================
+R_UploadDefaultImage
+
+Gives an image that failed to load the default image's texture
+==================
+*/
+void R_UploadDefaultImage( image_t *image ) {
+	byte				data[DEFAULT_SIZE][DEFAULT_SIZE][4];
+	imageBuildParms_t	parms;
+	imageLevels_t		levels;
+
+	R_DefaultImageData( data );
+	R_GetImageBuildParms( &parms, (qboolean)image->mipmap, qfalse );
+	R_BuildImageLevels( &levels, (byte *)data, DEFAULT_SIZE, DEFAULT_SIZE, &parms );
+	R_UploadImage( image, &levels, qfalse, qfalse, false );
+	R_FreeImageLevels( &levels );
+}
+
 /*
 ==================
 R_CreateBuiltinImages
@@ -1477,6 +1474,7 @@ void R_SetColorMappings( void ) {
 		}
 		s_intensitytable[i] = j;
 	}
+	s_intensityScale = r_intensity->value;
 }
 
 void R_SetGammaCorrectionLUT()
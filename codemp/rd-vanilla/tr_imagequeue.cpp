@@ -0,0 +1,535 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_imagequeue.cpp -- decodes images on worker threads
+//
+// With r_imageThreads set, R_FindImageFile reads the image file on the main
+// thread, since the file system isn't thread safe, and queues it.  A worker
+// decodes it, light scales it and builds its mip chain, and the main thread
+// uploads the result the next time it collects finished jobs.  Everything
+// queued is uploaded before render commands are issued, so nothing is ever
+// drawn with a missing texture.
+
+#include "tr_local.h"
+#include "tr_mipmap.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define MAX_IMAGE_JOBS		64
+#define MAX_IMAGE_THREADS	16
+
+typedef struct imageJob_s {
+	image_t				*image;			// NULL for imagebench
+	imageFile_t			file;
+	ImageLoaderFn		loader;
+	imageBuildParms_t	parms;
+	qboolean			allowTC;
+
+	// filled in by the worker
+	imageLevels_t		levels;
+	qboolean			failed;
+	int					usec;
+	bool				done;
+} imageJob_t;
+
+static struct {
+	std::vector<std::thread>	threads;
+	std::mutex					mutex;
+	std::condition_variable		wake;		// workers wait for jobs
+	std::condition_variable		done;		// the main thread waits for workers
+	bool						quit;
+
+	imageJob_t	jobs[MAX_IMAGE_JOBS];
+	int			head;		// oldest job not yet uploaded, main thread only
+	int			tail;		// one past the newest job
+	int			next;		// next job for a worker
+
+	uint32_t	benchHash;
+
+	// since the last report
+	int			numImages;
+	int			numFailed;
+	int64_t		readUsec;
+	int64_t		decodeUsec;
+	int64_t		waitUsec;
+	int64_t		uploadUsec;
+} iq;
+
+static int R_ImageLevelsSize( const imageLevels_t *levels ) {
+	int size = 0;
+
+	for ( int i = 0, w = levels->width, h = levels->height; i < levels->numLevels; i++ ) {
+		size += w * h * 4;
+		w = Q_max( w >> 1, 1 );
+		h = Q_max( h >> 1, 1 );
+	}
+
+	return size;
+}
+
+static uint32_t R_ImageLevelsHash( const imageLevels_t *levels ) {
+	return Q_HashFNV( levels->data, R_ImageLevelsSize( levels ) ) ^ ( levels->width << 16 ) ^ levels->height;
+}
+
+/*
+===============
+R_RunImageJob
+
+Decodes the file and builds the mip levels, on a worker or for imagebench
+on the main thread
+===============
+*/
+static void R_RunImageJob( imageJob_t *job ) {
+	const int64_t start = ri->Microseconds();
+	imageFile_t *file = &job->file;
+
+	job->loader( file );
+
+	if ( !file->pic ) {
+		job->failed = qtrue;
+	} else if ( ( file->width & ( file->width - 1 ) ) || ( file->height & ( file->height - 1 ) ) ) {
+		R_ImageError( file, "Refusing to load non-power-2-dims(%d,%d) pic \"%s\"...\n", file->width, file->height, file->name );
+		job->failed = qtrue;
+	} else {
+		R_BuildImageLevels( &job->levels, file->pic, file->width, file->height, &job->parms );
+	}
+
+	R_FreeImage( file->pic );
+	file->pic = NULL;
+
+	job->usec = (int)( ri->Microseconds() - start );
+}
+
+static void R_ImageThread( void ) {
+	std::unique_lock<std::mutex> lock( iq.mutex );
+
+	for ( ;; ) {
+		iq.wake.wait( lock, [] { return iq.quit || iq.next != iq.tail; } );
+		if ( iq.next == iq.tail ) {
+			return;
+		}
+
+		imageJob_t *job = &iq.jobs[iq.next++ % MAX_IMAGE_JOBS];
+
+		lock.unlock();
+		R_RunImageJob( job );
+		lock.lock();
+
+		job->done = true;
+		iq.done.notify_all();
+	}
+}
+
+/*
+===============
+R_ImageQueue_Upload
+
+Hands a finished job's levels to GL and frees everything it holds
+===============
+*/
+static void R_ImageQueue_Upload( imageJob_t *job ) {
+	const int64_t start = ri->Microseconds();
+
+	ri->FS_FreeFile( job->file.buffer );
+	job->file.buffer = NULL;
+
+	// a broken tga drops the game when it's loaded directly, but there's
+	// no good place to do that from here
+	job->file.fatal = qfalse;
+	R_ReportImageError( &job->file );
+
+	if ( !job->image ) {
+		if ( !job->failed ) {
+			iq.benchHash += R_ImageLevelsHash( &job->levels );
+		}
+	} else {
+		if ( job->failed ) {
+			ri->Printf( PRINT_WARNING, "WARNING: couldn't load %s, using the default image\n", job->file.name );
+			R_UploadDefaultImage( job->image );
+			iq.numFailed++;
+		} else {
+			R_UploadImage( job->image, &job->levels, qfalse, job->allowTC, false );
+		}
+
+		iq.numImages++;
+		iq.decodeUsec += job->usec;
+		iq.uploadUsec += ri->Microseconds() - start;
+	}
+
+	if ( job->levels.data ) {
+		R_FreeImageLevels( &job->levels );
+	}
+}
+
+/*
+===============
+R_ImageQueue_Collect
+
+Uploads finished jobs in the order they were queued, waiting for the
+oldest ones until no more than maxPending are left
+===============
+*/
+static void R_ImageQueue_Collect( int maxPending ) {
+	while ( iq.head != iq.tail ) {
+		imageJob_t *job = &iq.jobs[iq.head % MAX_IMAGE_JOBS];
+
+		{
+			std::unique_lock<std::mutex> lock( iq.mutex );
+
+			if ( !job->done ) {
+				if ( iq.tail - iq.head <= maxPending ) {
+					return;
+				}
+
+				const int64_t start = ri->Microseconds();
+				iq.done.wait( lock, [job] { return job->done; } );
+				iq.waitUsec += ri->Microseconds() - start;
+			}
+		}
+
+		R_ImageQueue_Upload( job );
+		iq.head++;
+	}
+}
+
+static void R_ImageQueue_Start( void ) {
+	const int numThreads = Com_Clampi( 1, MAX_IMAGE_THREADS, r_imageThreads->integer );
+
+	iq.quit = false;
+	for ( int i = 0; i < numThreads; i++ ) {
+		iq.threads.push_back( std::thread( R_ImageThread ) );
+	}
+}
+
+/*
+===============
+R_ImageQueue_Push
+
+Takes a job whose file has been read and hands it to the workers
+===============
+*/
+static void R_ImageQueue_Push( void ) {
+	if ( iq.threads.empty() ) {
+		R_ImageQueue_Start();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( iq.mutex );
+		iq.tail++;
+	}
+	iq.wake.notify_one();
+
+	// upload whatever is already done, so the main thread keeps up
+	R_ImageQueue_Collect( MAX_IMAGE_JOBS - 1 );
+}
+
+/*
+===============
+R_ImageQueue_NextJob
+
+Returns a free job, waiting for the oldest one if they're all in use
+===============
+*/
+static imageJob_t *R_ImageQueue_NextJob( void ) {
+	R_ImageQueue_Collect( MAX_IMAGE_JOBS - 1 );
+
+	imageJob_t *job = &iq.jobs[iq.tail % MAX_IMAGE_JOBS];
+
+	job->image = NULL;
+	job->levels.data = NULL;
+	job->failed = qfalse;
+	job->usec = 0;
+	job->done = false;
+
+	return job;
+}
+
+/*
+===============
+R_ImageQueue_Active
+===============
+*/
+qboolean R_ImageQueue_Active( void ) {
+	return (qboolean)( r_imageThreads->integer > 0 );
+}
+
+/*
+===============
+R_ImageQueue_Add
+
+Reads the image and queues it for the workers, returning the image_t it will
+be uploaded to.  Returns NULL if there's no such image.  An image that turns
+out to be broken gets the default texture.
+===============
+*/
+image_t *R_ImageQueue_Add( const char *name, qboolean mipmap, qboolean allowPicmip, qboolean allowTC, int glWrapClampMode ) {
+	imageJob_t *job = R_ImageQueue_NextJob();
+	const int64_t start = ri->Microseconds();
+
+	job->loader = R_ReadImage( name, &job->file );
+	iq.readUsec += ri->Microseconds() - start;
+
+	if ( !job->loader ) {
+		return NULL;
+	}
+
+	job->image = R_NewImage( name, mipmap, allowPicmip, glWrapClampMode );
+	job->allowTC = allowTC;
+	R_GetImageBuildParms( &job->parms, mipmap, allowPicmip );
+
+	R_ImageQueue_Push();
+
+	return job->image;
+}
+
+/*
+===============
+R_ImageQueue_Finish
+
+Waits for every queued image and uploads it
+===============
+*/
+void R_ImageQueue_Finish( void ) {
+	R_ImageQueue_Collect( 0 );
+}
+
+/*
+===============
+R_ImageQueue_Report
+
+Prints how image loading went since the last report
+===============
+*/
+void R_ImageQueue_Report( void ) {
+	R_ImageQueue_Finish();
+
+	if ( !iq.numImages ) {
+		return;
+	}
+
+	ri->Printf( PRINT_ALL, "%i images (%i failed) decoded on %i threads: %.1f ms decoding, main thread %.1f ms reading, %.1f ms waiting, %.1f ms uploading\n",
+		iq.numImages, iq.numFailed, (int)iq.threads.size(), iq.decodeUsec / 1000.0f,
+		iq.readUsec / 1000.0f, iq.waitUsec / 1000.0f, iq.uploadUsec / 1000.0f );
+
+	iq.numImages = iq.numFailed = 0;
+	iq.readUsec = iq.decodeUsec = iq.waitUsec = iq.uploadUsec = 0;
+}
+
+/*
+===============
+R_ImageQueue_Shutdown
+
+Uploads anything still queued and stops the workers
+===============
+*/
+void R_ImageQueue_Shutdown( void ) {
+	R_ImageQueue_Finish();
+
+	if ( iq.threads.empty() ) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( iq.mutex );
+		iq.quit = true;
+	}
+	iq.wake.notify_all();
+
+	for ( size_t i = 0; i < iq.threads.size(); i++ ) {
+		iq.threads[i].join();
+	}
+	iq.threads.clear();
+}
+
+static void R_ListBenchImages( const char *dir, std::vector<std::string>& names ) {
+	static const char *extensions[] = { ".jpg", ".tga", ".png" };
+
+	for ( size_t i = 0; i < ARRAY_LEN( extensions ); i++ ) {
+		int numFiles;
+		char **files = ri->FS_ListFiles( dir, extensions[i], &numFiles );
+
+		for ( int j = 0; j < numFiles; j++ ) {
+			names.push_back( va( "%s/%s", dir, files[j] ) );
+		}
+		ri->FS_FreeFileList( files );
+	}
+}
+
+/*
+===============
+R_ImageBench_f
+
+imagebench [directory]
+
+Decodes and mips every image in a directory on the main thread and then on
+the image threads, without touching GL, and checks both produce the same
+levels
+===============
+*/
+void R_ImageBench_f( void ) {
+	const char			*dir = ri->Cmd_Argc() > 1 ? ri->Cmd_Argv( 1 ) : "textures/imperial";
+	std::vector<std::string>	names;
+	size_t				i;
+
+	R_ListBenchImages( dir, names );
+
+	if ( names.empty() ) {
+		ri->Printf( PRINT_ALL, "imagebench: no images in %s\n", dir );
+		return;
+	}
+
+	R_ImageQueue_Finish();
+
+	// one at a time on the main thread
+	int64_t start = ri->Microseconds();
+	uint32_t serialHash = 0;
+	int numDecoded = 0;
+
+	for ( i = 0; i < names.size(); i++ ) {
+		imageJob_t job;
+
+		memset( &job, 0, sizeof( job ) );
+		job.loader = R_ReadImage( names[i].c_str(), &job.file );
+		if ( !job.loader ) {
+			continue;
+		}
+
+		R_GetImageBuildParms( &job.parms, qtrue, qtrue );
+		R_RunImageJob( &job );
+		ri->FS_FreeFile( job.file.buffer );
+
+		if ( !job.failed ) {
+			serialHash += R_ImageLevelsHash( &job.levels );
+			R_FreeImageLevels( &job.levels );
+			numDecoded++;
+		}
+	}
+
+	const int64_t serialUsec = ri->Microseconds() - start;
+
+	ri->Printf( PRINT_ALL, "imagebench: %i of %i images from %s, main thread %.1f ms\n", numDecoded, (int)names.size(), dir, serialUsec / 1000.0f );
+
+	if ( R_ImageQueue_Active() ) {
+		// the same through the image threads
+		start = ri->Microseconds();
+		iq.benchHash = 0;
+
+		for ( i = 0; i < names.size(); i++ ) {
+			imageJob_t *job = R_ImageQueue_NextJob();
+
+			job->loader = R_ReadImage( names[i].c_str(), &job->file );
+			if ( !job->loader ) {
+				continue;
+			}
+
+			R_GetImageBuildParms( &job->parms, qtrue, qtrue );
+			R_ImageQueue_Push();
+		}
+		R_ImageQueue_Finish();
+
+		const int64_t queuedUsec = ri->Microseconds() - start;
+
+		ri->Printf( PRINT_ALL, "imagebench: %i threads %.1f ms (%.2fx), %s\n", (int)iq.threads.size(), queuedUsec / 1000.0f,
+			(float)serialUsec / Q_max( queuedUsec, (int64_t)1 ), iq.benchHash == serialHash ? "levels match" : S_COLOR_RED "LEVELS DIFFER" );
+	} else {
+		ri->Printf( PRINT_ALL, "imagebench: set r_imageThreads to compare with the image threads\n" );
+	}
+}
+
+/*
+===============
+R_MipBench_f
+
+mipbench [directory]
+
+Builds the mip levels of every image in a directory with the scalar kernels
+and then the SIMD ones, and checks both produce the same levels
+===============
+*/
+void R_MipBench_f( void ) {
+	const char					*dir = ri->Cmd_Argc() > 1 ? ri->Cmd_Argv( 1 ) : "textures/imperial";
+	std::vector<std::string>	names;
+	int64_t						usec[2] = { 0, 0 };
+	int							numImages = 0, numPixels = 0, numDiffer = 0;
+
+	if ( !R_MipKernelsHaveSIMD() ) {
+		ri->Printf( PRINT_ALL, "mipbench: this build has no SIMD mip kernels\n" );
+		return;
+	}
+
+	R_ListBenchImages( dir, names );
+
+	for ( size_t i = 0; i < names.size(); i++ ) {
+		byte			*pic;
+		int				width, height;
+		imageLevels_t	levels[2];
+
+		R_LoadImage( names[i].c_str(), &pic, &width, &height );
+		if ( !pic ) {
+			continue;
+		}
+
+		if ( ( width & ( width - 1 ) ) || ( height & ( height - 1 ) ) ) {
+			R_FreeImage( pic );
+			continue;
+		}
+
+		// R_BuildImageLevels scribbles on the pic, so each pass gets a copy
+		byte *copy = (byte *)malloc( width * height * 4 );
+
+		for ( int pass = 0; pass < 2; pass++ ) {
+			imageBuildParms_t parms;
+
+			R_GetImageBuildParms( &parms, qtrue, qfalse );
+			parms.simd = (qboolean)pass;
+			memcpy( copy, pic, width * height * 4 );
+
+			const int64_t start = ri->Microseconds();
+			R_BuildImageLevels( &levels[pass], copy, width, height, &parms );
+			usec[pass] += ri->Microseconds() - start;
+		}
+
+		if ( memcmp( levels[0].data, levels[1].data, R_ImageLevelsSize( &levels[0] ) ) ) {
+			ri->Printf( PRINT_ALL, S_COLOR_RED "mipbench: %s differs\n", names[i].c_str() );
+			numDiffer++;
+		}
+
+		R_FreeImageLevels( &levels[0] );
+		R_FreeImageLevels( &levels[1] );
+		free( copy );
+		R_FreeImage( pic );
+
+		numImages++;
+		numPixels += width * height;
+	}
+
+	if ( !numImages ) {
+		ri->Printf( PRINT_ALL, "mipbench: no power of two images in %s\n", dir );
+		return;
+	}
+
+	ri->Printf( PRINT_ALL, "mipbench: %i images, %.1f Mpixels from %s, scalar %.1f ms, simd %.1f ms (%.2fx), %s\n",
+		numImages, numPixels / 1000000.0f, dir, usec[0] / 1000.0f, usec[1] / 1000.0f,
+		(float)usec[0] / Q_max( usec[1], (int64_t)1 ), numDiffer ? S_COLOR_RED "LEVELS DIFFER" : "levels match" );
+}
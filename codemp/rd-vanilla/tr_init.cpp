@@ -47,6 +47,10 @@ cvar_t	*r_znear;
 
 cvar_t	*r_skipBackEnd;
 
+cvar_t	*r_shaderCache;
+cvar_t	*r_imageThreads;
+cvar_t	*r_imageSIMD;
+
 cvar_t	*r_measureOverdraw;
 
 cvar_t	*r_inGameVideo;
@@ -281,6 +285,7 @@ void R_Splash()
 	}
 */
 	pImage = R_FindImageFile( "menu/splash", qfalse, qfalse, qfalse, GL_CLAMP);
+	R_ImageQueue_Finish();	// the splash is drawn right away, it can't wait for the image threads
 	extern void	RB_SetGL2D (void);
 	RB_SetGL2D();
 	if (pImage )
@@ -1524,6 +1529,9 @@ static consoleCommand_t	commands[] = {
 	{ "imagecacheinfo",		RE_RegisterImages_Info_f },
 	{ "modellist",			R_Modellist_f },
 	{ "modelcacheinfo",		RE_RegisterModels_Info_f },
+	{ "g2skinbench",		R_G2SkinBench_f },
+	{ "imagebench",			R_ImageBench_f },
+	{ "mipbench",			R_MipBench_f },
 };
 
 static const size_t numCommands = ARRAY_LEN( commands );
@@ -1630,6 +1638,9 @@ void R_Register( void )
 	r_lightmap							= ri->Cvar_Get( "r_lightmap",						"0",						CVAR_CHEAT, "" );
 	r_portalOnly						= ri->Cvar_Get( "r_portalOnly",						"0",						CVAR_CHEAT, "" );
 	r_skipBackEnd						= ri->Cvar_Get( "r_skipBackEnd",					"0",						CVAR_CHEAT, "" );
+	r_shaderCache						= ri->Cvar_Get( "r_shaderCache",					"1",						CVAR_ARCHIVE, "Load the shader text from shadercache.bin when the shader paks haven't changed" );
+	r_imageThreads						= ri->Cvar_Get( "r_imageThreads",					"4",						CVAR_ARCHIVE|CVAR_LATCH, "Threads to decode images on, 0 decodes them on the main thread" );
+	r_imageSIMD							= ri->Cvar_Get( "r_imageSIMD",						"1",						CVAR_ARCHIVE, "Use the SSE2 or NEON kernels for mipmaps and light scaling" );
 	r_measureOverdraw					= ri->Cvar_Get( "r_measureOverdraw",				"0",						CVAR_CHEAT, "" );
 	r_lodscale							= ri->Cvar_Get( "r_lodscale",						"5",						CVAR_NONE, "" );
 	r_norefresh							= ri->Cvar_Get( "r_norefresh",						"0",						CVAR_CHEAT, "" );
@@ -1804,6 +1815,8 @@ void RE_Shutdown( qboolean destroyWindow, qboolean restarting ) {
 	for ( size_t i = 0; i < numCommands; i++ )
 		ri->Cmd_RemoveCommand( commands[i].cmd );
 
+	R_ImageQueue_Shutdown();
+
 	if ( r_DynamicGlow && r_DynamicGlow->integer )
 	{
 		// Release the Glow Vertex Shader.
@@ -1881,6 +1894,7 @@ Touch all images to make sure they are resident
 */
 void RE_EndRegistration( void ) {
 	R_IssuePendingRenderCommands();
+	R_ImageQueue_Report();
 	if (!ri->Sys_LowPhysicalMemory()) {
 		RB_ShowImages();
 	}
@@ -2138,6 +2152,11 @@ refexport_t* GetRefAPI( int apiVersion, refimport_t *rimp ) {
 	//re.G2VertSpaceServer	= G2VertSpaceServer;
 
 	re.ext.Font_StrLenPixels				= RE_Font_StrLenPixelsNew;
+	re.ext.G2API_GetTraceCacheStats			= G2API_GetTraceCacheStats;
+	re.ext.G2API_GetBoneNumber				= G2API_GetBoneNumber;
+	re.ext.G2API_SetBoneAnglesNum			= G2API_SetBoneAnglesNum;
+	re.ext.G2API_SetBoneAnimNum				= G2API_SetBoneAnimNum;
+	re.ext.G2API_ResetVertSpace				= G2API_ResetVertSpace;
 
 	return &re;
 }
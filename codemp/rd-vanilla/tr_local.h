@@ -1211,6 +1211,9 @@ extern	cvar_t	*r_portalOnly;
 extern	cvar_t	*r_subdivisions;
 extern	cvar_t	*r_lodCurveError;
 extern	cvar_t	*r_skipBackEnd;
+extern	cvar_t	*r_shaderCache;
+extern	cvar_t	*r_imageThreads;
+extern	cvar_t	*r_imageSIMD;
 
 extern	cvar_t	*r_ignoreGLErrors;
 
@@ -1354,6 +1357,41 @@ image_t		*R_FindImageFile( const char *name, qboolean mipmap, qboolean allowPicm
 
 image_t		*R_CreateImage( const char *name, const byte *pic, int width, int height, GLenum format, qboolean mipmap, qboolean allowPicmip, qboolean allowTC, int wrapClampMode, bool bRectangle = false );
 
+typedef struct imageBuildParms_s {
+	qboolean	mipmap;
+	int			picmip;				// levels to drop
+	int			maxTextureSize;
+	qboolean	simpleMipMaps;
+	qboolean	colorMipLevels;
+	qboolean	simd;				// use the SSE2 or NEON mip and light scale kernels
+	qboolean	hardwareGamma;		// gamma is applied by the device or shaders, not baked into textures
+	float		intensityScale;		// r_intensity the light scale table was built from
+	byte		lightScale[256];	// the intensity table, and the gamma table on top without hardwareGamma
+} imageBuildParms_t;
+
+typedef struct imageLevels_s {
+	byte		*data;				// every mip level, one after another
+	int			width, height;		// of the first level
+	int			numLevels;
+	int			samples;			// 3 if the alpha is all 255, else 4
+} imageLevels_t;
+
+void		R_GetImageBuildParms( imageBuildParms_t *parms, qboolean mipmap, qboolean picmip );
+void		R_BuildImageLevels( imageLevels_t *levels, byte *pic, int width, int height, const imageBuildParms_t *parms );
+void		R_FreeImageLevels( imageLevels_t *levels );
+image_t		*R_NewImage( const char *name, qboolean mipmap, qboolean allowPicmip, int glWrapClampMode );
+void		R_UploadImage( image_t *image, const imageLevels_t *levels, qboolean isLightmap, qboolean allowTC, bool bRectangle );
+void		R_UploadDefaultImage( image_t *image );
+
+// tr_imagequeue.cpp
+qboolean	R_ImageQueue_Active( void );
+image_t		*R_ImageQueue_Add( const char *name, qboolean mipmap, qboolean allowPicmip, qboolean allowTC, int glWrapClampMode );
+void		R_ImageQueue_Finish( void );
+void		R_ImageQueue_Report( void );
+void		R_ImageQueue_Shutdown( void );
+void		R_ImageBench_f( void );
+void		R_MipBench_f( void );
+
 qboolean	R_GetModeInfo( int *width, int *height, int mode );
 
 void		R_SetColorMappings( void );
@@ -1858,6 +1896,30 @@ void		Multiply_3x4Matrix(mdxaBone_t *out, mdxaBone_t *in2, mdxaBone_t *in);
 extern qboolean R_LoadMDXM (model_t *mod, void *buffer, const char *name, qboolean &bAlreadyCached );
 extern qboolean R_LoadMDXA (model_t *mod, void *buffer, const char *name, qboolean &bAlreadyCached );
 void		RE_InsertModelIntoHash(const char *name, model_t *mod);
+
+// G2_bones.cpp
+void		G2_BuildBoneHash(model_t *mod);
+int			G2_Find_Bone_Number(const model_t *mod, const char *boneName);
+
+// G2_misc.cpp
+void		G2_BuildTraceBounds(model_t *mod);
+
+// G2_skinning.cpp
+typedef struct g2SkinVert_s {
+	float			weights[iMAX_G2_BONEWEIGHTS_PER_VERT];	// unused ones are 0
+	byte			bones[iMAX_G2_BONEWEIGHTS_PER_VERT];	// index into the surface's bone references
+	int				numWeights;
+} g2SkinVert_t;
+
+typedef struct g2SkinSurf_s {
+	unsigned int	usedBoneRefs;	// bit per bone reference a vert is weighted to
+	g2SkinVert_t	*verts;			// NULL if the surface has to be skinned the old way
+} g2SkinSurf_t;
+
+void		G2_BuildSkinStreams(model_t *mod);
+const g2SkinSurf_t *G2_GetSkinSurf(const model_t *mod, const mdxmSurface_t *surface);
+void		G2_SkinSurface(const mdxmSurface_t *surface, const g2SkinSurf_t *skin, const mdxaBone_t * const *bones, const float *scale, float *xyz, int xyzStride, float *normal, int normalStride);
+void		R_G2SkinBench_f(void);
 /*
 Ghoul2 Insert End
 */
@@ -0,0 +1,368 @@
+/*
+===========================================================================
+Copyright (C) 1999 - 2005, Id Software, Inc.
+Copyright (C) 2000 - 2013, Raven Software, Inc.
+Copyright (C) 2001 - 2013, Activision, Inc.
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_mipmap.cpp -- RGBA mip and light scale kernels
+//
+// The SIMD versions widen the bytes to 16 bits and do the same integer sums
+// as the scalar code, so the results match exactly.  The filter's divide by
+// 36 is a multiply by 58255 and a shift right by 21, which is exact for every
+// sum it can see (at most 36 * 255).  Light scaling converts to float and
+// truncates, which is exactly how the r_intensity table is built.  Pixels
+// the filter kernel wraps around for, at the start and end of each row, go
+// through the scalar code.
+
+#include "tr_mipmap.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+	#define MIP_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define MIP_NEON
+	#include <arm_neon.h>
+#endif
+
+#define MIP_DIV36_MUL	58255
+#define MIP_DIV36_SHIFT	21
+
+bool R_MipKernelsHaveSIMD( void ) {
+#if defined(MIP_SSE2) || defined(MIP_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+================
+R_MipMapBox
+================
+*/
+static void R_MipMapBox_Scalar( const uint8_t *in, uint8_t *out, int width, int height ) {
+	int		i, j;
+	int		row;
+
+	if ( width == 1 && height == 1 ) {
+		memcpy( out, in, 4 );
+		return;
+	}
+
+	row = width * 4;
+	width >>= 1;
+	height >>= 1;
+
+	if ( width == 0 || height == 0 ) {
+		width += height;	// get largest
+		for (i=0 ; i<width ; i++, out+=4, in+=8 ) {
+			out[0] = ( in[0] + in[4] )>>1;
+			out[1] = ( in[1] + in[5] )>>1;
+			out[2] = ( in[2] + in[6] )>>1;
+			out[3] = ( in[3] + in[7] )>>1;
+		}
+		return;
+	}
+
+	for (i=0 ; i<height ; i++, in+=row) {
+		for (j=0 ; j<width ; j++, out+=4, in+=8) {
+			out[0] = (in[0] + in[4] + in[row+0] + in[row+4])>>2;
+			out[1] = (in[1] + in[5] + in[row+1] + in[row+5])>>2;
+			out[2] = (in[2] + in[6] + in[row+2] + in[row+6])>>2;
+			out[3] = (in[3] + in[7] + in[row+3] + in[row+7])>>2;
+		}
+	}
+}
+
+#if defined(MIP_SSE2) || defined(MIP_NEON)
+static void R_MipMapBox_SIMD( const uint8_t *in, uint8_t *out, int width, int height ) {
+	const int row = width * 4;
+	const int outWidth = width >> 1;
+	const int outHeight = height >> 1;
+
+	if ( !outWidth || !outHeight ) {
+		R_MipMapBox_Scalar( in, out, width, height );
+		return;
+	}
+
+	for ( int i = 0; i < outHeight; i++ ) {
+		const uint8_t	*r0 = in + i * 2 * row;
+		const uint8_t	*r1 = r0 + row;
+		uint8_t			*o = out + i * outWidth * 4;
+		int				j;
+
+		// four output pixels from eight on each row
+		for ( j = 0; j + 4 <= outWidth; j += 4, r0 += 32, r1 += 32, o += 16 ) {
+#ifdef MIP_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i a0 = _mm_loadu_si128( (const __m128i *)r0 );
+			const __m128i a1 = _mm_loadu_si128( (const __m128i *)( r0 + 16 ) );
+			const __m128i b0 = _mm_loadu_si128( (const __m128i *)r1 );
+			const __m128i b1 = _mm_loadu_si128( (const __m128i *)( r1 + 16 ) );
+
+			// columns summed, two pixels per register
+			__m128i s0 = _mm_add_epi16( _mm_unpacklo_epi8( a0, zero ), _mm_unpacklo_epi8( b0, zero ) );
+			__m128i s1 = _mm_add_epi16( _mm_unpackhi_epi8( a0, zero ), _mm_unpackhi_epi8( b0, zero ) );
+			__m128i s2 = _mm_add_epi16( _mm_unpacklo_epi8( a1, zero ), _mm_unpacklo_epi8( b1, zero ) );
+			__m128i s3 = _mm_add_epi16( _mm_unpackhi_epi8( a1, zero ), _mm_unpackhi_epi8( b1, zero ) );
+
+			// then the pixel pairs
+			s0 = _mm_add_epi16( s0, _mm_srli_si128( s0, 8 ) );
+			s1 = _mm_add_epi16( s1, _mm_srli_si128( s1, 8 ) );
+			s2 = _mm_add_epi16( s2, _mm_srli_si128( s2, 8 ) );
+			s3 = _mm_add_epi16( s3, _mm_srli_si128( s3, 8 ) );
+
+			const __m128i lo = _mm_srli_epi16( _mm_unpacklo_epi64( s0, s1 ), 2 );
+			const __m128i hi = _mm_srli_epi16( _mm_unpacklo_epi64( s2, s3 ), 2 );
+			_mm_storeu_si128( (__m128i *)o, _mm_packus_epi16( lo, hi ) );
+#else
+			const uint8x16_t a0 = vld1q_u8( r0 );
+			const uint8x16_t a1 = vld1q_u8( r0 + 16 );
+			const uint8x16_t b0 = vld1q_u8( r1 );
+			const uint8x16_t b1 = vld1q_u8( r1 + 16 );
+
+			const uint16x8_t s0 = vaddl_u8( vget_low_u8( a0 ), vget_low_u8( b0 ) );
+			const uint16x8_t s1 = vaddl_u8( vget_high_u8( a0 ), vget_high_u8( b0 ) );
+			const uint16x8_t s2 = vaddl_u8( vget_low_u8( a1 ), vget_low_u8( b1 ) );
+			const uint16x8_t s3 = vaddl_u8( vget_high_u8( a1 ), vget_high_u8( b1 ) );
+
+			const uint16x8_t lo = vcombine_u16( vadd_u16( vget_low_u16( s0 ), vget_high_u16( s0 ) ), vadd_u16( vget_low_u16( s1 ), vget_high_u16( s1 ) ) );
+			const uint16x8_t hi = vcombine_u16( vadd_u16( vget_low_u16( s2 ), vget_high_u16( s2 ) ), vadd_u16( vget_low_u16( s3 ), vget_high_u16( s3 ) ) );
+			vst1q_u8( o, vcombine_u8( vshrn_n_u16( lo, 2 ), vshrn_n_u16( hi, 2 ) ) );
+#endif
+		}
+
+		for ( ; j < outWidth; j++, r0 += 8, r1 += 8, o += 4 ) {
+			o[0] = (r0[0] + r0[4] + r1[0] + r1[4])>>2;
+			o[1] = (r0[1] + r0[5] + r1[1] + r1[5])>>2;
+			o[2] = (r0[2] + r0[6] + r1[2] + r1[6])>>2;
+			o[3] = (r0[3] + r0[7] + r1[3] + r1[7])>>2;
+		}
+	}
+}
+#endif
+
+void R_MipMapBox( const uint8_t *in, uint8_t *out, int width, int height, bool simd ) {
+#if defined(MIP_SSE2) || defined(MIP_NEON)
+	if ( simd ) {
+		R_MipMapBox_SIMD( in, out, width, height );
+		return;
+	}
+#endif
+	R_MipMapBox_Scalar( in, out, width, height );
+}
+
+/*
+================
+R_MipMapFilter
+
+Proper linear filter
+================
+*/
+static inline void R_MipMapFilterPixel( const uint8_t *in, uint8_t *outpix, int i, int j, int inWidth, int inWidthMask, int inHeightMask ) {
+	const uint8_t *rm = in + ( ( i*2-1 ) & inHeightMask ) * inWidth * 4;
+	const uint8_t *r0 = in + ( ( i*2 ) & inHeightMask ) * inWidth * 4;
+	const uint8_t *r1 = in + ( ( i*2+1 ) & inHeightMask ) * inWidth * 4;
+	const uint8_t *r2 = in + ( ( i*2+2 ) & inHeightMask ) * inWidth * 4;
+	const int cm = ( ( j*2-1 ) & inWidthMask ) * 4;
+	const int c0 = ( ( j*2 ) & inWidthMask ) * 4;
+	const int c1 = ( ( j*2+1 ) & inWidthMask ) * 4;
+	const int c2 = ( ( j*2+2 ) & inWidthMask ) * 4;
+
+	for ( int k = 0 ; k < 4 ; k++ ) {
+		const int total =
+			1 * rm[cm+k] + 2 * rm[c0+k] + 2 * rm[c1+k] + 1 * rm[c2+k] +
+			2 * r0[cm+k] + 4 * r0[c0+k] + 4 * r0[c1+k] + 2 * r0[c2+k] +
+			2 * r1[cm+k] + 4 * r1[c0+k] + 4 * r1[c1+k] + 2 * r1[c2+k] +
+			1 * r2[cm+k] + 2 * r2[c0+k] + 2 * r2[c1+k] + 1 * r2[c2+k];
+		outpix[k] = total / 36;
+	}
+}
+
+#if defined(MIP_SSE2)
+// 1 2 2 1 across a row, for the output pixels at p + 4 and p + 12
+static inline __m128i R_MipMapFilterRow( const uint8_t *p ) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i w12 = _mm_set_epi16( 2, 2, 2, 2, 1, 1, 1, 1 );
+	const __m128i w21 = _mm_set_epi16( 1, 1, 1, 1, 2, 2, 2, 2 );
+	const __m128i a = _mm_loadu_si128( (const __m128i *)p );
+	const __m128i b = _mm_loadu_si128( (const __m128i *)( p + 8 ) );
+
+	__m128i x = _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( a, zero ), w12 ), _mm_mullo_epi16( _mm_unpackhi_epi8( a, zero ), w21 ) );
+	__m128i y = _mm_add_epi16( _mm_mullo_epi16( _mm_unpacklo_epi8( b, zero ), w12 ), _mm_mullo_epi16( _mm_unpackhi_epi8( b, zero ), w21 ) );
+	x = _mm_add_epi16( x, _mm_srli_si128( x, 8 ) );
+	y = _mm_add_epi16( y, _mm_srli_si128( y, 8 ) );
+
+	return _mm_unpacklo_epi64( x, y );
+}
+
+// 1 2 2 1 down the rows and the divide, two output pixels
+static inline void R_MipMapFilterPair( const uint8_t *rm, const uint8_t *r0, const uint8_t *r1, const uint8_t *r2, uint8_t *out ) {
+	const __m128i inner = _mm_add_epi16( R_MipMapFilterRow( r0 ), R_MipMapFilterRow( r1 ) );
+	const __m128i total = _mm_add_epi16( _mm_add_epi16( R_MipMapFilterRow( rm ), R_MipMapFilterRow( r2 ) ), _mm_add_epi16( inner, inner ) );
+	const __m128i q = _mm_srli_epi16( _mm_mulhi_epu16( total, _mm_set1_epi16( (short)MIP_DIV36_MUL ) ), MIP_DIV36_SHIFT - 16 );
+
+	_mm_storel_epi64( (__m128i *)out, _mm_packus_epi16( q, q ) );
+}
+#elif defined(MIP_NEON)
+static inline uint16x8_t R_MipMapFilterRow( const uint8_t *p ) {
+	static const uint16_t w12[8] = { 1, 1, 1, 1, 2, 2, 2, 2 };
+	static const uint16_t w21[8] = { 2, 2, 2, 2, 1, 1, 1, 1 };
+	const uint16x8_t wa = vld1q_u16( w12 );
+	const uint16x8_t wb = vld1q_u16( w21 );
+	const uint8x16_t a = vld1q_u8( p );
+	const uint8x16_t b = vld1q_u8( p + 8 );
+
+	const uint16x8_t x = vmlaq_u16( vmulq_u16( vmovl_u8( vget_low_u8( a ) ), wa ), vmovl_u8( vget_high_u8( a ) ), wb );
+	const uint16x8_t y = vmlaq_u16( vmulq_u16( vmovl_u8( vget_low_u8( b ) ), wa ), vmovl_u8( vget_high_u8( b ) ), wb );
+
+	return vcombine_u16( vadd_u16( vget_low_u16( x ), vget_high_u16( x ) ), vadd_u16( vget_low_u16( y ), vget_high_u16( y ) ) );
+}
+
+static inline void R_MipMapFilterPair( const uint8_t *rm, const uint8_t *r0, const uint8_t *r1, const uint8_t *r2, uint8_t *out ) {
+	const uint16x8_t inner = vaddq_u16( R_MipMapFilterRow( r0 ), R_MipMapFilterRow( r1 ) );
+	const uint16x8_t total = vaddq_u16( vaddq_u16( R_MipMapFilterRow( rm ), R_MipMapFilterRow( r2 ) ), vshlq_n_u16( inner, 1 ) );
+	const uint16x4_t mul = vdup_n_u16( MIP_DIV36_MUL );
+	const uint16x8_t q = vcombine_u16(
+		vshrn_n_u32( vmull_u16( vget_low_u16( total ), mul ), 16 ),
+		vshrn_n_u32( vmull_u16( vget_high_u16( total ), mul ), 16 ) );
+
+	vst1_u8( out, vmovn_u16( vshrq_n_u16( q, MIP_DIV36_SHIFT - 16 ) ) );
+}
+#endif
+
+void R_MipMapFilter( const uint8_t *in, uint8_t *out, int inWidth, int inHeight, bool simd ) {
+	const int outWidth = inWidth >> 1;
+	const int outHeight = inHeight >> 1;
+	const int inWidthMask = inWidth - 1;
+	const int inHeightMask = inHeight - 1;
+
+	if ( !outWidth || !outHeight ) {
+		// nothing to filter, the next level keeps the leading pixels
+		memmove( out, in, ( outWidth ? outWidth : 1 ) * ( outHeight ? outHeight : 1 ) * 4 );
+		return;
+	}
+
+	for ( int i = 0 ; i < outHeight ; i++ ) {
+		uint8_t	*o = out + i * outWidth * 4;
+		int		j = 0;
+
+#if defined(MIP_SSE2) || defined(MIP_NEON)
+		if ( simd && outWidth > 2 ) {
+			const uint8_t *rm = in + ( ( i*2-1 ) & inHeightMask ) * inWidth * 4;
+			const uint8_t *r0 = in + ( ( i*2 ) & inHeightMask ) * inWidth * 4;
+			const uint8_t *r1 = in + ( ( i*2+1 ) & inHeightMask ) * inWidth * 4;
+			const uint8_t *r2 = in + ( ( i*2+2 ) & inHeightMask ) * inWidth * 4;
+
+			// the first column wraps around
+			R_MipMapFilterPixel( in, o, i, 0, inWidth, inWidthMask, inHeightMask );
+
+			// reads pixels j*2-1 to j*2+4, so the last column is left for the scalar code
+			for ( j = 1; j + 1 <= outWidth - 2; j += 2 ) {
+				const int c = ( j*2-1 ) * 4;
+				R_MipMapFilterPair( rm + c, r0 + c, r1 + c, r2 + c, o + j * 4 );
+			}
+		}
+#endif
+
+		for ( ; j < outWidth ; j++ ) {
+			R_MipMapFilterPixel( in, o + j * 4, i, j, inWidth, inWidthMask, inHeightMask );
+		}
+	}
+}
+
+/*
+================
+R_ScalePixels
+================
+*/
+static void R_ScalePixels_Scalar( uint8_t *data, int numPixels, float scale ) {
+	uint8_t	table[256];
+
+	// the same as R_SetColorMappings
+	for ( int i = 0; i < 256; i++ ) {
+		int j = i * scale;
+		if ( j > 255 ) {
+			j = 255;
+		}
+		table[i] = j;
+	}
+
+	for ( int i = 0; i < numPixels; i++, data += 4 ) {
+		data[0] = table[data[0]];
+		data[1] = table[data[1]];
+		data[2] = table[data[2]];
+	}
+}
+
+void R_ScalePixels( uint8_t *data, int numPixels, float scale, bool simd ) {
+#if defined(MIP_SSE2) || defined(MIP_NEON)
+	if ( simd ) {
+		int i = 0;
+
+		if ( scale == 1.0f ) {
+			return;
+		}
+
+#ifdef MIP_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128 s = _mm_set_ps( 1.0f, scale, scale, scale );
+
+		for ( ; i + 4 <= numPixels; i += 4, data += 16 ) {
+			const __m128i px = _mm_loadu_si128( (const __m128i *)data );
+			const __m128i lo = _mm_unpacklo_epi8( px, zero );
+			const __m128i hi = _mm_unpackhi_epi8( px, zero );
+
+			const __m128i p0 = _mm_cvttps_epi32( _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( lo, zero ) ), s ) );
+			const __m128i p1 = _mm_cvttps_epi32( _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( lo, zero ) ), s ) );
+			const __m128i p2 = _mm_cvttps_epi32( _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( hi, zero ) ), s ) );
+			const __m128i p3 = _mm_cvttps_epi32( _mm_mul_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( hi, zero ) ), s ) );
+
+			// saturating packs do the clamp to 255
+			_mm_storeu_si128( (__m128i *)data, _mm_packus_epi16( _mm_packs_epi32( p0, p1 ), _mm_packs_epi32( p2, p3 ) ) );
+		}
+#else
+		const float sv[4] = { scale, scale, scale, 1.0f };
+		const float32x4_t s = vld1q_f32( sv );
+
+		for ( ; i + 4 <= numPixels; i += 4, data += 16 ) {
+			const uint8x16_t px = vld1q_u8( data );
+			const uint16x8_t lo = vmovl_u8( vget_low_u8( px ) );
+			const uint16x8_t hi = vmovl_u8( vget_high_u8( px ) );
+
+			const uint32x4_t p0 = vcvtq_u32_f32( vmulq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( lo ) ) ), s ) );
+			const uint32x4_t p1 = vcvtq_u32_f32( vmulq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( lo ) ) ), s ) );
+			const uint32x4_t p2 = vcvtq_u32_f32( vmulq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( hi ) ) ), s ) );
+			const uint32x4_t p3 = vcvtq_u32_f32( vmulq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( hi ) ) ), s ) );
+
+			const uint16x8_t q0 = vcombine_u16( vqmovn_u32( p0 ), vqmovn_u32( p1 ) );
+			const uint16x8_t q1 = vcombine_u16( vqmovn_u32( p2 ), vqmovn_u32( p3 ) );
+			vst1q_u8( data, vcombine_u8( vqmovn_u16( q0 ), vqmovn_u16( q1 ) ) );
+		}
+#endif
+
+		R_ScalePixels_Scalar( data, numPixels - i, scale );
+		return;
+	}
+#endif
+	R_ScalePixels_Scalar( data, numPixels, scale );
+}
@@ -0,0 +1,45 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// tr_mipmap.h -- RGBA mip and light scale kernels
+//
+// These don't depend on the rest of the renderer, so the unit tests can
+// check the SIMD versions against the scalar ones.  Every kernel gives
+// bit-identical results either way; asking for SIMD where it isn't
+// available just runs the scalar code.
+
+#pragma once
+
+#include <stdint.h>
+
+// Whether this build has SSE2 or NEON versions of the kernels.
+bool R_MipKernelsHaveSIMD( void );
+
+// The r_simpleMipMaps filter: quarters the texture into out, averaging each
+// 2x2 block.
+void R_MipMapBox( const uint8_t *in, uint8_t *out, int width, int height, bool simd );
+
+// The default filter: quarters the texture into out, with a 4x4 kernel that
+// wraps at the edges.
+void R_MipMapFilter( const uint8_t *in, uint8_t *out, int width, int height, bool simd );
+
+// Scales the RGB of each pixel by scale, clamping to 255, exactly like a
+// lookup in the r_intensity table.  The alpha is left alone.
+void R_ScalePixels( uint8_t *data, int numPixels, float scale, bool simd );
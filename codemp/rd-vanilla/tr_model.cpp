@@ -739,6 +739,7 @@ qboolean ServerLoadMDXA( model_t *mod, void *buffer, const char *mod_name, qbool
 
 	if (bAlreadyFound)
 	{
+		G2_BuildBoneHash(mod);
 		return qtrue;	// All done, stop here, do not LittleLong() etc. Do not pass go...
 	}
 
@@ -794,6 +795,7 @@ qboolean ServerLoadMDXA( model_t *mod, void *buffer, const char *mod_name, qbool
 			LS(pwIn[k]);
 	}
 #endif
+	G2_BuildBoneHash(mod);
 	return qtrue;
 }
 
@@ -882,6 +884,8 @@ qboolean ServerLoadMDXM( model_t *mod, void *buffer, const char *mod_name, qbool
 
 	if (bAlreadyFound)
 	{
+		G2_BuildTraceBounds(mod);
+		G2_BuildSkinStreams(mod);
 		return qtrue;	// All done. Stop, go no further, do not LittleLong(), do not pass Go...
 	}
 
@@ -1005,6 +1009,8 @@ qboolean ServerLoadMDXM( model_t *mod, void *buffer, const char *mod_name, qbool
 		lod = (mdxmLOD_t *)( (byte *)lod + lod->ofsEnd );
 	}
 
+	G2_BuildTraceBounds(mod);
+	G2_BuildSkinStreams(mod);
 	return qtrue;
 }
 
@@ -3953,6 +3953,145 @@ int COM_CompressShader( char *data_p )
 	return out - data_p;
 }
 
+/*
+====================
+Shader text cache
+
+The combined, compressed shader text and its name hash are written to
+shadercache.bin once they're built, so the next renderer start can skip
+reading and tokenizing every .shader file.  The key is the list of shader
+files and the checksums of the paks they're in, a shader file outside a pak
+turns the cache off.
+====================
+*/
+
+#define SHADER_CACHE_FILE		"shadercache.bin"
+#define SHADER_CACHE_IDENT		(('C'<<24)+('D'<<16)+('H'<<8)+'S')
+#define SHADER_CACHE_VERSION	1
+
+typedef struct shaderCacheHeader_s {
+	int		ident;
+	int		version;
+	int		keyLength;
+	int		textLength;		// including the terminating 0 and padding
+	int		numEntries;
+	// key, text, bucket sizes [MAX_SHADERTEXT_HASH], text offsets [numEntries]
+} shaderCacheHeader_t;
+
+static char *R_ShaderCacheKey( char **shaderFiles, int numShaderFiles, int *keyLength ) {
+	int		i, checksum, size = 0;
+
+	for ( i = 0; i < numShaderFiles; i++ ) {
+		size += strlen( shaderFiles[i] ) + 16;
+	}
+	size += 3;
+
+	char *key = (char *)Z_Malloc( size + 1, TAG_TEMP_WORKSPACE, qfalse );
+	char *out = key;
+
+	for ( i = 0; i < numShaderFiles; i++ ) {
+		if ( ri->FS_FileIsInPAK( va( "shaders/%s", shaderFiles[i] ), &checksum ) != 1 ) {
+			Z_Free( key );
+			return NULL;
+		}
+		out += Com_sprintf( out, size + 1 - ( out - key ), "%s %08x\n", shaderFiles[i], checksum );
+	}
+
+	// keep the arrays after the key and text aligned
+	while ( ( out - key ) & 3 ) {
+		*out++ = '\n';
+	}
+
+	*keyLength = out - key;
+	return key;
+}
+
+static qboolean R_LoadShaderCache( const char *key, int keyLength ) {
+	shaderCacheHeader_t	*header;
+	long				len;
+	int					i, j, n = 0;
+
+	len = ri->FS_ReadFile( SHADER_CACHE_FILE, (void **)&header );
+	if ( !header ) {
+		return qfalse;
+	}
+
+	const byte	*data = (const byte *)( header + 1 );
+	const int	*sizes = (const int *)( data + header->keyLength + header->textLength );
+	const int	*offsets = sizes + MAX_SHADERTEXT_HASH;
+
+	if ( len < (long)sizeof( *header ) || header->ident != SHADER_CACHE_IDENT || header->version != SHADER_CACHE_VERSION
+		|| header->keyLength != keyLength || header->textLength <= 0 || header->numEntries < 0
+		|| len != (long)( sizeof( *header ) + header->keyLength + header->textLength + ( MAX_SHADERTEXT_HASH + header->numEntries ) * sizeof( int ) )
+		|| memcmp( data, key, keyLength ) ) {
+		ri->FS_FreeFile( header );
+		return qfalse;
+	}
+
+	s_shaderText = (char *)ri->Hunk_Alloc( header->textLength, h_low );
+	memcpy( s_shaderText, data + keyLength, header->textLength );
+	s_shaderText[header->textLength - 1] = '\0';
+
+	char **hashMem = (char **)ri->Hunk_Alloc( ( header->numEntries + MAX_SHADERTEXT_HASH ) * sizeof( char * ), h_low );
+	for ( i = 0; i < MAX_SHADERTEXT_HASH; i++ ) {
+		shaderTextHashTable[i] = hashMem;
+		for ( j = 0; j < sizes[i]; j++, offsets++ ) {
+			if ( n++ >= header->numEntries || *offsets < 0 || *offsets >= header->textLength ) {
+				// damaged, start over from the shader files
+				KillTheShaderHashTable();
+				ri->FS_FreeFile( header );
+				return qfalse;
+			}
+			*hashMem++ = s_shaderText + *offsets;
+		}
+		*hashMem++ = NULL;
+	}
+
+	ri->Printf( PRINT_DEVELOPER, "...loaded %i shaders from " SHADER_CACHE_FILE "\n", header->numEntries );
+	ri->FS_FreeFile( header );
+	return qtrue;
+}
+
+static void R_WriteShaderCache( const char *key, int keyLength ) {
+	shaderCacheHeader_t	header;
+	int					i, j;
+
+	header.ident = SHADER_CACHE_IDENT;
+	header.version = SHADER_CACHE_VERSION;
+	header.keyLength = keyLength;
+	header.textLength = ( strlen( s_shaderText ) + 4 ) & ~3;
+	header.numEntries = 0;
+	for ( i = 0; i < MAX_SHADERTEXT_HASH; i++ ) {
+		for ( j = 0; shaderTextHashTable[i][j]; j++ ) {
+			header.numEntries++;
+		}
+	}
+
+	const int size = sizeof( header ) + keyLength + header.textLength + ( MAX_SHADERTEXT_HASH + header.numEntries ) * sizeof( int );
+	byte *buf = (byte *)Z_Malloc( size, TAG_TEMP_WORKSPACE, qfalse );
+	byte *out = buf;
+
+	memcpy( out, &header, sizeof( header ) );
+	out += sizeof( header );
+	memcpy( out, key, keyLength );
+	out += keyLength;
+	memset( out, 0, header.textLength );
+	strcpy( (char *)out, s_shaderText );
+	out += header.textLength;
+
+	int *sizes = (int *)out;
+	int *offsets = sizes + MAX_SHADERTEXT_HASH;
+	for ( i = 0; i < MAX_SHADERTEXT_HASH; i++ ) {
+		for ( j = 0; shaderTextHashTable[i][j]; j++ ) {
+			*offsets++ = shaderTextHashTable[i][j] - s_shaderText;
+		}
+		sizes[i] = j;
+	}
+
+	ri->FS_WriteFile( SHADER_CACHE_FILE, buf, size );
+	Z_Free( buf );
+}
+
 /*
 ====================
 ScanAndLoadShaderFiles
@@ -3988,6 +4127,15 @@ static void ScanAndLoadShaderFiles( void )
 		numShaderFiles = MAX_SHADER_FILES;
 	}
 
+	int cacheKeyLength = 0;
+	char *cacheKey = r_shaderCache->integer ? R_ShaderCacheKey( shaderFiles, numShaderFiles, &cacheKeyLength ) : NULL;
+
+	if ( cacheKey && R_LoadShaderCache( cacheKey, cacheKeyLength ) ) {
+		Z_Free( cacheKey );
+		ri->FS_FreeFileList( shaderFiles );
+		return;
+	}
+
 	// load and parse shader files
 	for ( i = 0; i < numShaderFiles; i++ )
 	{
@@ -4129,7 +4277,10 @@ static void ScanAndLoadShaderFiles( void )
 		SkipBracedSection( &p, 0 );
 	}
 
-	return;
+	if ( cacheKey ) {
+		R_WriteShaderCache( cacheKey, cacheKeyLength );
+		Z_Free( cacheKey );
+	}
 }
 
 /*
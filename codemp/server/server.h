@@ -126,7 +126,7 @@ typedef struct {
 	qboolean	demorecording;
 	qboolean	demowaiting;	// don't record until a non-delta message is sent
 	int			minDeltaFrame;	// the first non-delta frame stored in the demo.  cannot delta against frames older than this
-	fileHandle_t	demofile;
+	int			demostream;		// sv_demowriter stream, only valid while demorecording
 	qboolean	isBot;
 	int			botReliableAcknowledge; // for bots, need to maintain a separate reliableAcknowledge to record server messages into the demo file
 } demoInfo_t;
@@ -363,6 +363,48 @@ void SV_AutoRecordDemo( client_t *cl );
 void SV_StopAutoRecordDemos();
 void SV_BeginAutoRecordDemos();
 
+//
+// sv_demowriter.cpp
+//
+void SV_DemoWriterInit( void );
+void SV_DemoWriterShutdown( void );
+void SV_DemoWriterFrame( void );
+int SV_DemoWriterOpen( char *name, int nameSize );
+void SV_DemoWriterWrite( int stream, const void *data, int len );
+void SV_DemoWriterClose( int stream );
+
+//
+// sv_masterdemo.cpp
+//
+void SV_MasterDemoInit( void );
+void SV_MasterDemoStop( void );
+void SV_MasterDemoFrame( void );
+void SV_MasterDemoSnapshot( client_t *client, clientSnapshot_t *frame, const int *entityNums, int numEntities );
+void SV_MasterDemoServerCommand( client_t *client, const char *cmd );
+void SV_MasterDemoConfigstring( int index );
+
+//
+// sv_replay.cpp
+//
+void SV_ReplayInit( void );
+void SV_ReplayMapStart( void );
+void SV_ReplayStop( void );
+qboolean SV_ReplayRecording( void );
+qboolean SV_ReplayLoading( void );
+qboolean SV_ReplayPlaying( void );
+void SV_ReplayGameCvar( const char *name );
+void SV_ReplayInitGame( int levelTime, int randomSeed, int restart );
+void SV_ReplayRunFrame( int levelTime );
+void SV_ReplayFrameDone( void );
+void SV_ReplayBotFrame( int time );
+void SV_ReplayClientConnect( int clientNum, qboolean firstTime, qboolean isBot );
+void SV_ReplayClientBegin( int clientNum );
+void SV_ReplayClientUserinfoChanged( int clientNum );
+void SV_ReplayClientDisconnect( int clientNum );
+void SV_ReplayClientCommand( int clientNum );
+void SV_ReplayConsoleCommand( void );
+void SV_ReplayClientThink( int clientNum );
+
 //
 // sv_snapshot.c
 //
@@ -426,6 +468,7 @@ clipHandle_t SV_ClipHandleForEntity( const sharedEntity_t *ent );
 
 
 void SV_SectorList_f( void );
+void SV_G2TraceStats_f( void );
 
 
 int SV_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int maxcount );
@@ -436,6 +479,13 @@ int SV_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int
 // returns the number of pointers filled in
 // The world entity is never returned in this list.
 
+int SV_AreaEntitiesRadius( const vec3_t origin, float radius, int ignore, int contentmask, int flags, int *entityList, float *dists, int maxcount );
+// fills in a table of entity numbers with entities whose bounding boxes come
+// closer to origin than radius, in the same order SV_AreaEntities would give
+// them.  ignore is left out, contentmask and flags (RADIUS_*) narrow it down
+// further when set.  dists gets the distance from origin to each box if it
+// isn't NULL.
+
 
 int SV_PointContents( const vec3_t p, int passEntityNum );
 // returns the CONTENTS_* value from the world and all entities at the given point.
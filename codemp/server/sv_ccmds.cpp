@@ -1530,13 +1530,13 @@ void SV_WriteDemoMessage ( client_t *cl, msg_t *msg, int headerBytes ) {
 	// write the packet sequence
 	len = cl->netchan.outgoingSequence;
 	swlen = LittleLong( len );
-	FS_Write( &swlen, 4, cl->demo.demofile );
+	SV_DemoWriterWrite( cl->demo.demostream, &swlen, 4 );
 
 	// skip the packet sequencing information
 	len = msg->cursize - headerBytes;
 	swlen = LittleLong( len );
-	FS_Write( &swlen, 4, cl->demo.demofile );
-	FS_Write( msg->data + headerBytes, len, cl->demo.demofile );
+	SV_DemoWriterWrite( cl->demo.demostream, &swlen, 4 );
+	SV_DemoWriterWrite( cl->demo.demostream, msg->data + headerBytes, len );
 }
 
 void SV_StopRecordDemo( client_t *cl ) {
@@ -1549,16 +1549,18 @@ void SV_StopRecordDemo( client_t *cl ) {
 
 	// finish up
 	len = -1;
-	FS_Write (&len, 4, cl->demo.demofile);
-	FS_Write (&len, 4, cl->demo.demofile);
-	FS_FCloseFile (cl->demo.demofile);
-	cl->demo.demofile = 0;
+	SV_DemoWriterWrite( cl->demo.demostream, &len, 4 );
+	SV_DemoWriterWrite( cl->demo.demostream, &len, 4 );
+	SV_DemoWriterClose( cl->demo.demostream );
+	cl->demo.demostream = -1;
 	cl->demo.demorecording = qfalse;
 	Com_Printf ("Stopped demo for client %d.\n", cl - svs.clients);
 }
 
 // stops all recording demos
 void SV_StopAutoRecordDemos() {
+	SV_MasterDemoStop();
+
 	if ( svs.clients && sv_autoDemo->integer ) {
 		for ( client_t *client = svs.clients; client - svs.clients < sv_maxclients->integer; client++ ) {
 			if ( client->demo.demorecording) {
@@ -1638,12 +1640,12 @@ void SV_RecordDemo( client_t *cl, char *demoName ) {
 	// open the demo file
 	Q_strncpyz( cl->demo.demoName, demoName, sizeof( cl->demo.demoName ) );
 	Com_sprintf( name, sizeof( name ), "demos/%s.dm_%d", cl->demo.demoName, PROTOCOL_VERSION );
-	Com_Printf( "recording to %s.\n", name );
-	cl->demo.demofile = FS_FOpenFileWrite( name );
-	if ( !cl->demo.demofile ) {
-		Com_Printf ("ERROR: couldn't open.\n");
+	cl->demo.demostream = SV_DemoWriterOpen( name, sizeof( name ) );
+	if ( cl->demo.demostream < 0 ) {
+		Com_Printf ("ERROR: couldn't open %s.\n", name);
 		return;
 	}
+	Com_Printf( "recording to %s.\n", name );
 	cl->demo.demorecording = qtrue;
 
 	// don't start saving messages until a non-delta compressed message is received
@@ -1665,11 +1667,11 @@ void SV_RecordDemo( client_t *cl, char *demoName ) {
 
 	// write it to the demo file
 	len = LittleLong( cl->netchan.outgoingSequence - 1 );
-	FS_Write( &len, 4, cl->demo.demofile );
+	SV_DemoWriterWrite( cl->demo.demostream, &len, 4 );
 
 	len = LittleLong( msg.cursize );
-	FS_Write( &len, 4, cl->demo.demofile );
-	FS_Write( msg.data, msg.cursize, cl->demo.demofile );
+	SV_DemoWriterWrite( cl->demo.demostream, &len, 4 );
+	SV_DemoWriterWrite( cl->demo.demostream, msg.data, msg.cursize );
 
 	// the rest of the demo file will be copied from net messages
 }
@@ -1943,6 +1945,7 @@ void SV_AddOperatorCommands( void ) {
 	Cmd_AddCommand ("dumpuser", SV_DumpUser_f, "Prints the userinfo for a given userid" );
 	Cmd_AddCommand ("map_restart", SV_MapRestart_f, "Restart the current map" );
 	Cmd_AddCommand ("sectorlist", SV_SectorList_f);
+	Cmd_AddCommand ("g2tracestats", SV_G2TraceStats_f, "Show how often Ghoul2 traces reuse skeletons, 'reset' clears the counters" );
 	Cmd_AddCommand ("map", SV_Map_f, "Load a new map with cheats disabled" );
 	Cmd_SetCommandCompletionFunc( "map", SV_CompleteMapName );
 	Cmd_AddCommand ("devmap", SV_Map_f, "Load a new map with cheats enabled" );
@@ -0,0 +1,494 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// sv_demowriter.cpp -- writes server side demos from a background thread
+//
+// The server thread copies demo data into a single producer / single consumer
+// ring buffer and never touches the disk.  The writer thread drains the ring,
+// optionally gzips each demo, and writes it out.  The file system isn't thread
+// safe, so files are opened and closed on the server thread as plain stdio
+// files the writer can fwrite without going through the handle table.  The
+// writer flags a stream once its last byte is written, or a write failed, and
+// the next SV_DemoWriterFrame closes it and reports any error.
+//
+// If the ring fills up because the disk can't keep up, the server thread waits
+// for space rather than dropping data, and the stall is counted in demostats.
+
+#include "server.h"
+
+#include <zlib.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define MAX_DEMO_STREAMS	( MAX_CLIENTS * 2 )	// a client's last demo can still be closing when its next one opens
+#define DEMO_ZBUF_SIZE		( 64 * 1024 )
+
+enum {
+	DEMO_RECORD_DATA,
+	DEMO_RECORD_CLOSE
+};
+
+typedef struct demoRecord_s {
+	int		stream;
+	int		type;
+	int		len;			// bytes of data following the record
+} demoRecord_t;
+
+typedef struct demoStream_s {
+	// owned by the server thread
+	qboolean		inUse;
+	FILE			*file;
+	char			name[MAX_QPATH];
+	qboolean		compress;
+	byte			*zbuf;
+
+	// owned by the writer thread while the stream is open
+	z_stream		zs;
+
+	std::atomic<bool>	finished;	// set by the writer once the file can be closed
+	std::atomic<bool>	failed;		// set by the writer if a write came up short
+} demoStream_t;
+
+static cvar_t				*sv_demoCompress;
+static cvar_t				*sv_demoBufferSize;
+
+static demoStream_t			demoStreams[MAX_DEMO_STREAMS];
+
+static byte					*demoRing;
+static size_t				demoRingSize;
+static std::atomic<size_t>	demoRingWrite;		// total bytes ever queued, only the server thread stores it
+static std::atomic<size_t>	demoRingRead;		// total bytes ever written, only the writer thread stores it
+
+static std::thread			demoThread;
+static std::mutex			demoWakeMutex;
+static std::condition_variable	demoWake;		// the writer waits on this for data
+static std::condition_variable	demoSpace;		// and the server thread on this for room
+static std::atomic<bool>	demoQuit;
+
+// demostats
+static size_t				demoPeakQueued;
+static int					demoStalls;
+static int64_t				demoStallTime;		// microseconds
+static std::atomic<int64_t>	demoBytesIn;
+static std::atomic<int64_t>	demoBytesOut;
+
+/*
+==================
+SV_DemoRingCopyOut
+
+Copies len bytes starting at ring position pos, handling the wrap
+==================
+*/
+static void SV_DemoRingCopyOut( size_t pos, void *dest, size_t len ) {
+	const size_t offset = pos % demoRingSize;
+	const size_t first = Q_min( len, demoRingSize - offset );
+
+	memcpy( dest, demoRing + offset, first );
+	memcpy( (byte *)dest + first, demoRing, len - first );
+}
+
+static void SV_DemoRingCopyIn( size_t pos, const void *src, size_t len ) {
+	const size_t offset = pos % demoRingSize;
+	const size_t first = Q_min( len, demoRingSize - offset );
+
+	memcpy( demoRing + offset, src, first );
+	memcpy( demoRing, (const byte *)src + first, len - first );
+}
+
+/*
+==================
+SV_DemoWriterFile
+
+Writer thread, nothing more is written to a stream once a write fails
+==================
+*/
+static void SV_DemoWriterFile( demoStream_t *s, const byte *data, size_t len ) {
+	if ( s->failed.load( std::memory_order_relaxed ) ) {
+		return;
+	}
+
+	if ( fwrite( data, 1, len, s->file ) != len ) {
+		s->failed.store( true, std::memory_order_relaxed );
+		return;
+	}
+
+	demoBytesOut += len;
+}
+
+/*
+==================
+SV_DemoWriterOutput
+
+Writer thread, passes data through the stream's deflater if it has one
+==================
+*/
+static void SV_DemoWriterOutput( demoStream_t *s, const byte *data, size_t len, int flush ) {
+	if ( !s->compress ) {
+		if ( len ) {
+			SV_DemoWriterFile( s, data, len );
+		}
+		return;
+	}
+
+	s->zs.next_in = (Bytef *)data;
+	s->zs.avail_in = (uInt)len;
+
+	do {
+		s->zs.next_out = s->zbuf;
+		s->zs.avail_out = DEMO_ZBUF_SIZE;
+
+		deflate( &s->zs, flush );
+
+		const int have = DEMO_ZBUF_SIZE - s->zs.avail_out;
+		if ( have ) {
+			SV_DemoWriterFile( s, s->zbuf, have );
+		}
+	} while ( s->zs.avail_out == 0 );
+}
+
+/*
+==================
+SV_DemoWriterThread
+==================
+*/
+static void SV_DemoWriterThread( void ) {
+	for ( ;; ) {
+		size_t read = demoRingRead.load( std::memory_order_relaxed );
+		const size_t write = demoRingWrite.load( std::memory_order_acquire );
+
+		if ( read == write ) {
+			if ( demoQuit.load() ) {
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock( demoWakeMutex );
+			demoWake.wait_for( lock, std::chrono::milliseconds( 10 ) );
+			continue;
+		}
+
+		while ( read != write ) {
+			demoRecord_t	record;
+
+			SV_DemoRingCopyOut( read, &record, sizeof( record ) );
+			read += sizeof( record );
+
+			demoStream_t *s = &demoStreams[record.stream];
+
+			// hand the payload over in place, in two pieces if it wraps
+			size_t offset = read % demoRingSize;
+			size_t remaining = record.len;
+
+			while ( remaining ) {
+				const size_t piece = Q_min( remaining, demoRingSize - offset );
+
+				SV_DemoWriterOutput( s, demoRing + offset, piece, Z_NO_FLUSH );
+				demoBytesIn += piece;
+
+				remaining -= piece;
+				offset = 0;
+			}
+
+			read += record.len;
+
+			if ( record.type == DEMO_RECORD_CLOSE ) {
+				if ( s->compress ) {
+					SV_DemoWriterOutput( s, NULL, 0, Z_FINISH );
+					deflateEnd( &s->zs );
+				}
+
+				s->finished.store( true, std::memory_order_release );
+			}
+
+			// under the lock, so a server thread about to wait for room can't miss it
+			{
+				std::lock_guard<std::mutex> lock( demoWakeMutex );
+				demoRingRead.store( read, std::memory_order_release );
+			}
+			demoSpace.notify_one();
+		}
+	}
+}
+
+/*
+==================
+SV_DemoWriterWait
+
+Blocks the server thread until at most queued bytes are waiting for the writer
+==================
+*/
+static void SV_DemoWriterWait( size_t queued ) {
+	const size_t write = demoRingWrite.load( std::memory_order_relaxed );
+
+	demoWake.notify_one();
+
+	std::unique_lock<std::mutex> lock( demoWakeMutex );
+	demoSpace.wait( lock, [write, queued] { return write - demoRingRead.load( std::memory_order_acquire ) <= queued; } );
+}
+
+/*
+==================
+SV_DemoWriterPut
+
+Queues a record for the writer thread, waiting for room if the ring is full
+==================
+*/
+static void SV_DemoWriterPut( int stream, int type, const void *data, int len ) {
+	demoRecord_t	record;
+	const size_t	need = sizeof( record ) + len;
+	const size_t	write = demoRingWrite.load( std::memory_order_relaxed );
+
+	if ( write + need - demoRingRead.load( std::memory_order_acquire ) > demoRingSize ) {
+		const int64_t start = Sys_Microseconds();
+
+		demoStalls++;
+		SV_DemoWriterWait( demoRingSize - need );
+		demoStallTime += Sys_Microseconds() - start;
+	}
+
+	record.stream = stream;
+	record.type = type;
+	record.len = len;
+
+	SV_DemoRingCopyIn( write, &record, sizeof( record ) );
+	if ( len ) {
+		SV_DemoRingCopyIn( write + sizeof( record ), data, len );
+	}
+
+	demoRingWrite.store( write + need, std::memory_order_release );
+
+	demoPeakQueued = Q_max( demoPeakQueued, write + need - demoRingRead.load( std::memory_order_relaxed ) );
+}
+
+/*
+==================
+SV_DemoWriterCloseFinished
+
+Closes the files of streams the writer thread is done with
+==================
+*/
+static void SV_DemoWriterCloseFinished( void ) {
+	for ( int i = 0; i < MAX_DEMO_STREAMS; i++ ) {
+		demoStream_t *s = &demoStreams[i];
+
+		if ( s->inUse && s->finished.load( std::memory_order_acquire ) ) {
+			if ( fclose( s->file ) || s->failed.load( std::memory_order_relaxed ) ) {
+				Com_Printf( S_COLOR_YELLOW "WARNING: couldn't write all of %s, the disk may be full\n", s->name );
+			}
+			if ( s->zbuf ) {
+				Z_Free( s->zbuf );
+			}
+
+			s->file = NULL;
+			s->zbuf = NULL;
+			s->inUse = qfalse;
+		}
+	}
+}
+
+/*
+==================
+SV_DemoWriterFlush
+
+Blocks until everything queued is on disk
+==================
+*/
+static void SV_DemoWriterFlush( void ) {
+	SV_DemoWriterWait( 0 );
+	SV_DemoWriterCloseFinished();
+}
+
+/*
+==================
+SV_DemoWriterOpen
+
+Opens a demo file for writing, adding .gz to the name when sv_demoCompress is
+set.  Returns the stream number, or -1 if the file couldn't be opened.
+==================
+*/
+int SV_DemoWriterOpen( char *name, int nameSize ) {
+	int i;
+
+	if ( !demoRing ) {
+		demoRingSize = (size_t)Com_Clampi( 1, 256, sv_demoBufferSize->integer ) * 1024 * 1024;
+		demoRing = (byte *)Z_Malloc( demoRingSize, TAG_CLIENTS, qfalse );
+	}
+
+	if ( !demoThread.joinable() ) {
+		demoQuit = false;
+		demoThread = std::thread( SV_DemoWriterThread );
+	}
+
+	SV_DemoWriterCloseFinished();
+
+	for ( i = 0; i < MAX_DEMO_STREAMS && demoStreams[i].inUse; i++ ) {
+	}
+
+	if ( i == MAX_DEMO_STREAMS ) {
+		// everyone's old demos are still closing, wait for them
+		SV_DemoWriterFlush();
+
+		for ( i = 0; i < MAX_DEMO_STREAMS && demoStreams[i].inUse; i++ ) {
+		}
+
+		if ( i == MAX_DEMO_STREAMS ) {
+			return -1;
+		}
+	}
+
+	demoStream_t *s = &demoStreams[i];
+	const int level = Com_Clampi( 0, 9, sv_demoCompress->integer );
+
+	if ( level ) {
+		Q_strcat( name, nameSize, ".gz" );
+	}
+
+	s->file = FS_FOpenStdioWrite( name );
+	if ( !s->file ) {
+		return -1;
+	}
+	Q_strncpyz( s->name, name, sizeof( s->name ) );
+
+	s->compress = qfalse;
+	s->zbuf = NULL;
+
+	if ( level ) {
+		memset( &s->zs, 0, sizeof( s->zs ) );
+
+		// 16 + MAX_WBITS gets a gzip header, so the file just gunzips back into a regular demo
+		if ( deflateInit2( &s->zs, level, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY ) == Z_OK ) {
+			s->compress = qtrue;
+			s->zbuf = (byte *)Z_Malloc( DEMO_ZBUF_SIZE, TAG_DEFLATE, qfalse );
+		} else {
+			Com_Printf( "SV_DemoWriterOpen: couldn't start compression, writing %s uncompressed\n", name );
+		}
+	}
+
+	s->finished.store( false );
+	s->failed.store( false );
+	s->inUse = qtrue;
+
+	return i;
+}
+
+/*
+==================
+SV_DemoWriterWrite
+==================
+*/
+void SV_DemoWriterWrite( int stream, const void *data, int len ) {
+	assert( stream >= 0 && stream < MAX_DEMO_STREAMS && demoStreams[stream].inUse );
+
+	SV_DemoWriterPut( stream, DEMO_RECORD_DATA, data, len );
+}
+
+/*
+==================
+SV_DemoWriterClose
+
+The file is closed once the writer thread has caught up with it
+==================
+*/
+void SV_DemoWriterClose( int stream ) {
+	assert( stream >= 0 && stream < MAX_DEMO_STREAMS && demoStreams[stream].inUse );
+
+	SV_DemoWriterPut( stream, DEMO_RECORD_CLOSE, NULL, 0 );
+	demoWake.notify_one();
+}
+
+/*
+==================
+SV_DemoWriterFrame
+==================
+*/
+void SV_DemoWriterFrame( void ) {
+	if ( !demoThread.joinable() ) {
+		return;
+	}
+
+	if ( demoRingRead.load( std::memory_order_relaxed ) != demoRingWrite.load( std::memory_order_relaxed ) ) {
+		demoWake.notify_one();
+	}
+
+	SV_DemoWriterCloseFinished();
+}
+
+/*
+==================
+SV_DemoWriterShutdown
+
+Writes out everything still queued, then stops the thread
+==================
+*/
+void SV_DemoWriterShutdown( void ) {
+	if ( !demoThread.joinable() ) {
+		return;
+	}
+
+	demoQuit = true;
+	demoWake.notify_one();
+	demoThread.join();
+
+	SV_DemoWriterCloseFinished();
+
+	if ( demoRing ) {
+		Z_Free( demoRing );
+		demoRing = NULL;
+	}
+
+	demoRingWrite = 0;
+	demoRingRead = 0;
+}
+
+/*
+==================
+SV_DemoStats_f
+==================
+*/
+static void SV_DemoStats_f( void ) {
+	int open = 0;
+
+	for ( int i = 0; i < MAX_DEMO_STREAMS; i++ ) {
+		if ( demoStreams[i].inUse ) {
+			open++;
+		}
+	}
+
+	const size_t queued = demoRingWrite.load() - demoRingRead.load();
+
+	Com_Printf( "demo writer: %s, %i open demos\n", demoThread.joinable() ? "running" : "idle", open );
+	Com_Printf( "  buffer: %i KB queued, %i KB peak, %i KB size\n", (int)( queued / 1024 ), (int)( demoPeakQueued / 1024 ), (int)( demoRingSize / 1024 ) );
+	Com_Printf( "  written: %i KB in, %i KB to disk\n", (int)( demoBytesIn.load() / 1024 ), (int)( demoBytesOut.load() / 1024 ) );
+	Com_Printf( "  stalls: %i, %.1f ms total\n", demoStalls, demoStallTime / 1000.0 );
+}
+
+/*
+==================
+SV_DemoWriterInit
+==================
+*/
+void SV_DemoWriterInit( void ) {
+	sv_demoCompress = Cvar_Get( "sv_demoCompress", "0", CVAR_ARCHIVE, "gzip level (1-9) for server side demos, 0 to store them as is" );
+	sv_demoBufferSize = Cvar_Get( "sv_demoBufferSize", "8", CVAR_ARCHIVE | CVAR_LATCH, "Megabytes of demo data that can wait for the disk before the server stalls" );
+
+	Cmd_AddCommand( "demostats", SV_DemoStats_f, "Show server side demo writer statistics" );
+}
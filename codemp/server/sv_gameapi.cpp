@@ -22,6 +22,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 //Anything above this #include will be ignored by the compiler
 
 #include "server.h"
+#include "sv_gameapi.h"
 #include "botlib/botlib.h"
 #include "qcommon/stringed_ingame.h"
 #include "qcommon/RoffSystem.h"
@@ -41,68 +42,149 @@ static vm_t *gvm; // game vm, valid for legacy and new api
 // game vmMain calls
 //
 
+// Replays record the calls the engine makes into the game on its own, but not
+// the ones the game makes happen from inside another call, like bot usercmds,
+// since playing the outer call back makes them again.
+static int gameCallDepth;
+
+class GameCall {
+public:
+	const bool record;
+
+	GameCall() : record( !gameCallDepth++ && SV_ReplayRecording() ) {}
+	~GameCall() { gameCallDepth--; }
+};
+
 void GVM_InitGame( int levelTime, int randomSeed, int restart ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( SV_ReplayLoading() ) {
+		return;
+	}
 
 	ge->InitGame( levelTime, randomSeed, restart );
+
+	if ( call.record ) {
+		SV_ReplayInitGame( levelTime, randomSeed, restart );
+	}
 }
 
 void GVM_ShutdownGame( int restart ) {
 	VMSwap v( gvm );
 
+	SV_ReplayStop();
+
 	ge->ShutdownGame( restart );
 }
 
 char *GVM_ClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientConnect( clientNum, firstTime, isBot );
+	}
 
 	return ge->ClientConnect( clientNum, firstTime, isBot );
 }
 
 void GVM_ClientBegin( int clientNum ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientBegin( clientNum );
+	}
 
 	ge->ClientBegin( clientNum, qtrue );
 }
 
 qboolean GVM_ClientUserinfoChanged( int clientNum ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientUserinfoChanged( clientNum );
+	}
 
 	return ge->ClientUserinfoChanged( clientNum );
 }
 
 void GVM_ClientDisconnect( int clientNum ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientDisconnect( clientNum );
+	}
 
 	ge->ClientDisconnect( clientNum );
 }
 
 void GVM_ClientCommand( int clientNum ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientCommand( clientNum );
+	}
 
 	ge->ClientCommand( clientNum );
 }
 
 void GVM_ClientThink( int clientNum, usercmd_t *ucmd ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayClientThink( clientNum );
+	}
 
 	ge->ClientThink( clientNum, ucmd );
 }
 
 void GVM_RunFrame( int levelTime ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( SV_ReplayLoading() ) {
+		return;
+	}
+
+	if ( call.record ) {
+		SV_ReplayRunFrame( levelTime );
+	}
 
 	ge->RunFrame( levelTime );
+
+	if ( call.record ) {
+		SV_ReplayFrameDone();
+	}
 }
 
 qboolean GVM_ConsoleCommand( void ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( call.record ) {
+		SV_ReplayConsoleCommand();
+	}
 
 	return ge->ConsoleCommand();
 }
 
 int GVM_BotAIStartFrame( int time ) {
 	VMSwap v( gvm );
+	GameCall call;
+
+	if ( SV_ReplayLoading() ) {
+		return 0;
+	}
+
+	if ( call.record ) {
+		SV_ReplayBotFrame( time );
+	}
 
 	return ge->BotAIStartFrame( time );
 }
@@ -443,6 +525,51 @@ static void SV_GetUsercmd( int clientNum, usercmd_t *cmd ) {
 	*cmd = svs.clients[clientNum].lastUsercmd;
 }
 
+// Just the world part of SV_Trace, entities are the caller's problem.
+static void SV_TraceWorld( trace_t *results, const vec3_t start, const vec3_t mins, const vec3_t maxs, const vec3_t end, int contentmask ) {
+	if ( !mins ) {
+		mins = vec3_origin;
+	}
+	if ( !maxs ) {
+		maxs = vec3_origin;
+	}
+	CM_BoxTrace( results, start, end, mins, maxs, 0, contentmask, qfalse );
+	results->entityNum = results->fraction != 1.0 ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+}
+
+// Session data is kept here rather than in svs, which is cleared when the
+// server shuts down, so it lives exactly as long as the old session cvars.
+
+static byte sessionData[MAX_CLIENTS][MAX_SESSION_DATA];
+static int sessionDataSize[MAX_CLIENTS];
+
+void SV_SetSessionData( int clientNum, const void *data, int size ) {
+	if ( clientNum < 0 || clientNum >= MAX_CLIENTS ) {
+		Com_Error( ERR_DROP, "SV_SetSessionData: bad clientNum:%i", clientNum );
+		return;
+	}
+	if ( size < 0 || size > MAX_SESSION_DATA ) {
+		Com_Error( ERR_DROP, "SV_SetSessionData: bad size:%i", size );
+		return;
+	}
+	memcpy( sessionData[clientNum], data, size );
+	sessionDataSize[clientNum] = size;
+}
+
+int SV_GetSessionData( int clientNum, void *data, int size ) {
+	if ( clientNum < 0 || clientNum >= MAX_CLIENTS ) {
+		Com_Error( ERR_DROP, "SV_GetSessionData: bad clientNum:%i", clientNum );
+		return 0;
+	}
+	if ( size > sessionDataSize[clientNum] ) {
+		size = sessionDataSize[clientNum];
+	}
+	if ( size > 0 ) {
+		memcpy( data, sessionData[clientNum], size );
+	}
+	return sessionDataSize[clientNum];
+}
+
 static sharedEntity_t gLocalModifier;
 static sharedEntity_t *ConvertedEntity( sharedEntity_t *ent ) { //Return an entity with the memory shifted around to allow reading/modifying VM memory
 	int i = 0;
@@ -1403,6 +1530,21 @@ static qboolean SV_G2API_SetBoneAnim( void *ghoul2, const int modelIndex, const
 	return re->G2API_SetBoneAnim( *((CGhoul2Info_v *)ghoul2), modelIndex, boneName, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime );
 }
 
+static int SV_G2API_GetBoneNumber( void *ghoul2, int modelIndex, const char *boneName ) {
+	if ( !ghoul2 ) return -1;
+	return re->ext.G2API_GetBoneNumber( *((CGhoul2Info_v *)ghoul2), modelIndex, boneName );
+}
+
+static qboolean SV_G2API_SetBoneAnglesNum( void *ghoul2, int modelIndex, int boneNum, const vec3_t angles, const int flags, const int up, const int right, const int forward, int blendTime, int currentTime ) {
+	if ( !ghoul2 ) return qfalse;
+	return re->ext.G2API_SetBoneAnglesNum( *((CGhoul2Info_v *)ghoul2), modelIndex, boneNum, angles, flags, (const Eorientations)up, (const Eorientations)right, (const Eorientations)forward, blendTime, currentTime );
+}
+
+static qboolean SV_G2API_SetBoneAnimNum( void *ghoul2, const int modelIndex, int boneNum, const int startFrame, const int endFrame, const int flags, const float animSpeed, const int currentTime, const float setFrame, const int blendTime ) {
+	if ( !ghoul2 ) return qfalse;
+	return re->ext.G2API_SetBoneAnimNum( *((CGhoul2Info_v *)ghoul2), modelIndex, boneNum, startFrame, endFrame, flags, animSpeed, currentTime, setFrame, blendTime );
+}
+
 static qboolean SV_G2API_GetBoneAnim( void *ghoul2, const char *boneName, const int currentTime, float *currentFrame, int *startFrame, int *endFrame, int *flags, float *animSpeed, int *modelList, const int modelIndex ) {
 	CGhoul2Info_v &g2 = *((CGhoul2Info_v *)ghoul2);
 	return re->G2API_GetBoneAnim( g2, modelIndex, boneName, currentTime, currentFrame, startFrame, endFrame, flags, animSpeed, modelList );
@@ -1600,6 +1742,19 @@ static void GVM_Cvar_Set( const char *var_name, const char *value ) {
 	Cvar_VM_Set( var_name, value, VM_GAME );
 }
 
+static void GVM_SendConsoleCommand( int exec_when, const char *text ) {
+	// a replay already holds whatever the queued command led to
+	if ( SV_ReplayPlaying() && exec_when != EXEC_NOW ) {
+		return;
+	}
+	Cbuf_ExecuteText( exec_when, text );
+}
+
+static void GVM_Cvar_Register( vmCvar_t *vmCvar, const char *varName, const char *defaultValue, uint32_t flags ) {
+	Cvar_Register( vmCvar, varName, defaultValue, flags );
+	SV_ReplayGameCvar( varName );
+}
+
 void SV_InitGame( qboolean restart ) {
 	int i=0;
 	client_t *cl = NULL;
@@ -1631,7 +1786,7 @@ void SV_BindGame( void ) {
 		gi.TrueMalloc							= VM_Shifted_Alloc;
 		gi.TrueFree								= VM_Shifted_Free;
 		gi.SnapVector							= Sys_SnapVector;
-		gi.Cvar_Register						= Cvar_Register;
+		gi.Cvar_Register						= GVM_Cvar_Register;
 		gi.Cvar_Set								= GVM_Cvar_Set;
 		gi.Cvar_Update							= Cvar_Update;
 		gi.Cvar_VariableIntegerValue			= Cvar_VariableIntegerValue;
@@ -1661,7 +1816,7 @@ void SV_BindGame( void ) {
 		gi.LinkEntity							= SV_LinkEntity;
 		gi.LocateGameData						= SV_LocateGameData;
 		gi.PointContents						= SV_PointContents;
-		gi.SendConsoleCommand					= Cbuf_ExecuteText;
+		gi.SendConsoleCommand					= GVM_SendConsoleCommand;
 		gi.SendServerCommand					= SV_GameSendServerCommand;
 		gi.SetBrushModel						= SV_SetBrushModel;
 		gi.SetConfigstring						= SV_SetConfigstring;
@@ -1931,6 +2086,15 @@ void SV_BindGame( void ) {
 		gi.G2API_OverrideServer					= SV_G2API_OverrideServer;
 		gi.G2API_GetSurfaceName					= SV_G2API_GetSurfaceName;
 
+		gi.ext.G2API_GetBoneNumber				= SV_G2API_GetBoneNumber;
+		gi.ext.G2API_SetBoneAnglesNum			= SV_G2API_SetBoneAnglesNum;
+		gi.ext.G2API_SetBoneAnimNum				= SV_G2API_SetBoneAnimNum;
+		gi.ext.SetSessionData					= SV_SetSessionData;
+		gi.ext.GetSessionData					= SV_GetSessionData;
+		gi.ext.TraceWorld						= SV_TraceWorld;
+		gi.ext.EntitiesInRadius					= SV_AreaEntitiesRadius;
+		gi.ext.Microseconds						= Sys_Microseconds;
+
 		ret = GetGameAPI( GAME_API_VERSION, &gi );
 		if ( !ret ) {
 			//free VM?
@@ -65,3 +65,8 @@ void SV_BindGame( void );
 void SV_UnbindGame( void );
 void SV_InitGame( qboolean restart );
 void SV_RestartGame( void );
+
+#define MAX_SESSION_DATA	(256)
+
+void SV_SetSessionData( int clientNum, const void *data, int size );
+int SV_GetSessionData( int clientNum, void *data, int size );
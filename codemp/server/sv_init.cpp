@@ -28,6 +28,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include "qcommon/MiniHeap.h"
 #include "qcommon/stringed_ingame.h"
 #include "sv_gameapi.h"
+#include "icarus/Q3_Profile.h"
 
 /*
 ===============
@@ -129,6 +130,7 @@ void SV_SetConfigstring (int index, const char *val) {
 	// change the string in sv
 	Z_Free( sv.configstrings[index] );
 	sv.configstrings[index] = CopyString( val );
+	SV_MasterDemoConfigstring( index );
 
 	// send it to all the clients if we aren't
 	// spawning a new server
@@ -615,6 +617,9 @@ Ghoul2 Insert End
 	// to load during actual gameplay
 	sv.state = SS_LOADING;
 
+	// start a replay_record from before the game is loaded
+	SV_ReplayMapStart();
+
 	// load and spawn all other entities
 	SV_InitGameProgs();
 
@@ -838,6 +843,7 @@ static void SV_InitRef( void ) {
 	ri.Error = Com_Error;
 	ri.OPrintf = Com_OPrintf;
 	ri.Milliseconds = Sys_Milliseconds2; //FIXME: unix+mac need this
+	ri.Microseconds = Sys_Microseconds;
 	ri.Hunk_AllocateTempMemory = Hunk_AllocateTempMemory;
 	ri.Hunk_FreeTempMemory = Hunk_FreeTempMemory;
 	ri.Hunk_Alloc = Hunk_Alloc;
@@ -999,6 +1005,11 @@ void SV_Init (void) {
 
 	sv_banFile = Cvar_Get( "sv_banFile", "serverbans.dat", CVAR_ARCHIVE, "File to use to store bans and exceptions" );
 
+	ICARUS_ProfileInit();
+	SV_DemoWriterInit();
+	SV_MasterDemoInit();
+	SV_ReplayInit();
+
 	// initialize bot cvars so they are listed and can be set before loading the botlib
 	SV_BotInitCvars();
 
@@ -1069,6 +1080,18 @@ void SV_Shutdown( char *finalmsg )
 		SV_FinalMessage( finalmsg );
 	}
 
+	// finish any demos still being recorded and wait for the writer to get them on disk
+	if ( svs.clients ) {
+		for ( client_t *cl = svs.clients; cl - svs.clients < sv_maxclients->integer; cl++ ) {
+			if ( cl->demo.demorecording ) {
+				SV_StopRecordDemo( cl );
+			}
+		}
+	}
+	SV_MasterDemoStop();
+	SV_ReplayStop();
+	SV_DemoWriterShutdown();
+
 	SV_RemoveOperatorCommands();
 	SV_MasterShutdown();
 	SV_ChallengeShutdown();
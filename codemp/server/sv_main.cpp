@@ -26,6 +26,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include "ghoul2/ghoul2_shared.h"
 #include "sv_gameapi.h"
+#include "icarus/Q3_Profile.h"
 
 serverStatic_t	svs;				// persistant server info
 server_t		sv;					// local server
@@ -134,6 +135,8 @@ void SV_AddServerCommand( client_t *client, const char *cmd ) {
 	}
 	index = client->reliableSequence & ( MAX_RELIABLE_COMMANDS - 1 );
 	Q_strncpyz( client->reliableCommands[ index ], cmd, sizeof( client->reliableCommands[ index ] ) );
+
+	SV_MasterDemoServerCommand( client, cmd );
 }
 
 
@@ -1139,6 +1142,9 @@ void SV_Frame( int msec ) {
 		GVM_RunFrame( sv.time );
 	}
 
+	ICARUS_ProfileFrame();
+	SV_DemoWriterFrame();
+
 	//rww - RAGDOLL_BEGIN
 	re->G2API_SetTime(sv.time,0);
 	//rww - RAGDOLL_END
@@ -1153,6 +1159,9 @@ void SV_Frame( int msec ) {
 	// send messages back to the clients
 	SV_SendClientMessages();
 
+	// record the frame in the master demo
+	SV_MasterDemoFrame();
+
 	SV_CheckCvars();
 
 	// send a heartbeat to the master if needed
@@ -0,0 +1,928 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// sv_masterdemo.cpp -- one demo of the whole server instead of one per client
+//
+// With sv_masterDemo set, every server frame writes the entity states that
+// changed since the last frame once, plus for each client that got a snapshot
+// its playerstate delta, areabits and the changes to the list of entities
+// SV_BuildClientSnapshot decided it could see.  Reliable server commands are
+// stored once with the mask of clients they were queued for.
+//
+// mdemo_extract rebuilds a regular client demo for any client from that, with
+// the same snapshots and commands the client was sent.  It only needs the file
+// system, so it works without a map loaded.
+//
+// The file is a series of blocks, each a length and a huffman msg_t:
+//
+//	header:	version, protocol, checksum feed, configstrings, baselines
+//	frame:	world block	- time, changed configstrings, entity deltas
+//			event block	- commands and client snapshots, in the order they happened
+//	end:	a length of -1
+
+#include "server.h"
+
+#include <zlib.h>
+
+#if MAX_CLIENTS > 32
+#error Master demo client masks are 32 bits
+#endif
+
+#define MDEMO_VERSION		1
+#define MDEMO_BLOCK_SIZE	( 512 * 1024 )
+
+enum {
+	MDEMO_EVENT_END,
+	MDEMO_EVENT_COMMAND,
+	MDEMO_EVENT_SNAPSHOT
+};
+
+typedef struct mdemoClient_s {
+	qboolean		valid;			// ps and entities below are what the last recorded snapshot held
+	playerState_t	ps;
+	playerState_t	vps;
+	qboolean		hasVehicle;
+	byte			visible[MAX_GENTITIES / 8];
+} mdemoClient_t;
+
+typedef struct mdemoRecord_s {
+	qboolean		recording;
+	int				stream;
+	int				frames;
+
+	byte			*worldData;
+	byte			*eventData;
+	msg_t			events;
+
+	// the last states written, to delta against
+	entityState_t	world[MAX_GENTITIES];
+	byte			present[MAX_GENTITIES / 8];
+	qboolean		csChanged[MAX_CONFIGSTRINGS];
+	mdemoClient_t	clients[MAX_CLIENTS];
+
+	// broadcasts are queued to each client in turn, so they're merged into one command
+	char			pendingCommand[MAX_STRING_CHARS];
+	int				pendingMask;
+} mdemoRecord_t;
+
+static cvar_t			*sv_masterDemo;
+static mdemoRecord_t	*mdemo;
+
+#define MDEMO_BIT( bits, n )		( (bits)[(n) >> 3] & ( 1 << ( (n) & 7 ) ) )
+#define MDEMO_SETBIT( bits, n )		( (bits)[(n) >> 3] |= ( 1 << ( (n) & 7 ) ) )
+#define MDEMO_CLEARBIT( bits, n )	( (bits)[(n) >> 3] &= ~( 1 << ( (n) & 7 ) ) )
+
+static void SV_MasterDemoWritePlayerstate( msg_t *msg, playerState_t *from, playerState_t *to, qboolean isVehicle ) {
+#ifdef _ONEBIT_COMBO
+	MSG_WriteDeltaPlayerstate( msg, from, to, NULL, NULL, isVehicle );
+#else
+	MSG_WriteDeltaPlayerstate( msg, from, to, isVehicle );
+#endif
+}
+
+/*
+==================
+SV_MasterDemoWriteBlock
+==================
+*/
+static void SV_MasterDemoWriteBlock( msg_t *msg ) {
+	int len = LittleLong( msg->cursize );
+
+	SV_DemoWriterWrite( mdemo->stream, &len, 4 );
+	SV_DemoWriterWrite( mdemo->stream, msg->data, msg->cursize );
+}
+
+/*
+==================
+SV_MasterDemoStart
+==================
+*/
+static void SV_MasterDemoStart( void ) {
+	char			name[MAX_OSPATH], mapname[MAX_QPATH], date[64];
+	time_t			rawtime;
+	msg_t			msg;
+	entityState_t	nullstate;
+	int				i;
+
+	if ( !mdemo ) {
+		mdemo = (mdemoRecord_t *)Z_Malloc( sizeof( *mdemo ), TAG_CLIENTS, qtrue );
+	}
+
+	time( &rawtime );
+	strftime( date, sizeof( date ), "%Y-%m-%d_%H-%M-%S", localtime( &rawtime ) );
+	Q_strncpyz( mapname, Cvar_VariableString( "mapname" ), sizeof( mapname ) );
+	Q_strstrip( mapname, "\n\r;:.?*<>|\\/\"", NULL );
+	Com_sprintf( name, sizeof( name ), "demos/master/%s %s.mdm_%d", mapname, date, PROTOCOL_VERSION );
+
+	mdemo->stream = SV_DemoWriterOpen( name, sizeof( name ) );
+	if ( mdemo->stream < 0 ) {
+		Com_Printf( "ERROR: couldn't open %s, turning sv_masterDemo off.\n", name );
+		Cvar_Set( "sv_masterDemo", "0" );
+		return;
+	}
+	Com_Printf( "recording master demo to %s.\n", name );
+
+	mdemo->worldData = (byte *)Z_Malloc( MDEMO_BLOCK_SIZE, TAG_CLIENTS, qfalse );
+	mdemo->eventData = (byte *)Z_Malloc( MDEMO_BLOCK_SIZE, TAG_CLIENTS, qfalse );
+	MSG_Init( &mdemo->events, mdemo->eventData, MDEMO_BLOCK_SIZE );
+	mdemo->events.allowoverflow = qtrue;
+
+	Com_Memset( mdemo->present, 0, sizeof( mdemo->present ) );
+	Com_Memset( mdemo->csChanged, 0, sizeof( mdemo->csChanged ) );
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		mdemo->clients[i].valid = qfalse;
+	}
+	mdemo->pendingMask = 0;
+	mdemo->frames = 0;
+
+	// the header carries everything a gamestate does except the client number
+	MSG_Init( &msg, mdemo->worldData, MDEMO_BLOCK_SIZE );
+	MSG_WriteLong( &msg, MDEMO_VERSION );
+	MSG_WriteLong( &msg, PROTOCOL_VERSION );
+	MSG_WriteLong( &msg, sv.checksumFeed );
+
+	for ( i = 0; i < MAX_CONFIGSTRINGS; i++ ) {
+		if ( sv.configstrings[i][0] ) {
+			MSG_WriteShort( &msg, i );
+			MSG_WriteBigString( &msg, sv.configstrings[i] );
+		}
+	}
+	MSG_WriteShort( &msg, -1 );
+
+	Com_Memset( &nullstate, 0, sizeof( nullstate ) );
+	for ( i = 0; i < MAX_GENTITIES; i++ ) {
+		if ( sv.svEntities[i].baseline.number ) {
+			MSG_WriteDeltaEntity( &msg, &nullstate, &sv.svEntities[i].baseline, qtrue );
+		}
+	}
+	MSG_WriteBits( &msg, MAX_GENTITIES - 1, GENTITYNUM_BITS );
+
+	SV_MasterDemoWriteBlock( &msg );
+
+	mdemo->recording = qtrue;
+}
+
+/*
+==================
+SV_MasterDemoStop
+==================
+*/
+void SV_MasterDemoStop( void ) {
+	int len = -1;
+
+	if ( !mdemo || !mdemo->recording ) {
+		return;
+	}
+
+	SV_DemoWriterWrite( mdemo->stream, &len, 4 );
+	SV_DemoWriterClose( mdemo->stream );
+
+	Z_Free( mdemo->worldData );
+	Z_Free( mdemo->eventData );
+	mdemo->worldData = NULL;
+	mdemo->eventData = NULL;
+
+	mdemo->recording = qfalse;
+	Com_Printf( "Stopped master demo after %i frames.\n", mdemo->frames );
+}
+
+static void SV_MasterDemoFlushCommand( void ) {
+	if ( mdemo->pendingMask ) {
+		MSG_WriteByte( &mdemo->events, MDEMO_EVENT_COMMAND );
+		MSG_WriteLong( &mdemo->events, mdemo->pendingMask );
+		MSG_WriteString( &mdemo->events, mdemo->pendingCommand );
+		mdemo->pendingMask = 0;
+	}
+}
+
+/*
+==================
+SV_MasterDemoServerCommand
+
+Called for every reliable command queued for a client
+==================
+*/
+void SV_MasterDemoServerCommand( client_t *client, const char *cmd ) {
+	if ( !mdemo || !mdemo->recording ) {
+		return;
+	}
+
+	const int bit = 1 << ( client - svs.clients );
+
+	if ( mdemo->pendingMask && !( mdemo->pendingMask & bit ) && !strcmp( cmd, mdemo->pendingCommand ) ) {
+		mdemo->pendingMask |= bit;
+		return;
+	}
+
+	SV_MasterDemoFlushCommand();
+	Q_strncpyz( mdemo->pendingCommand, cmd, sizeof( mdemo->pendingCommand ) );
+	mdemo->pendingMask = bit;
+}
+
+/*
+==================
+SV_MasterDemoConfigstring
+==================
+*/
+void SV_MasterDemoConfigstring( int index ) {
+	if ( mdemo && mdemo->recording ) {
+		mdemo->csChanged[index] = qtrue;
+	}
+}
+
+/*
+==================
+SV_MasterDemoSnapshot
+
+Called by SV_BuildClientSnapshot with the sorted list of entities the client
+is about to be sent
+==================
+*/
+void SV_MasterDemoSnapshot( client_t *client, clientSnapshot_t *frame, const int *entityNums, int numEntities ) {
+	if ( !mdemo || !mdemo->recording ) {
+		return;
+	}
+
+	mdemoClient_t	*mc = &mdemo->clients[client - svs.clients];
+	msg_t			*msg = &mdemo->events;
+	byte			visible[MAX_GENTITIES / 8];
+	int				snapFlags = svs.snapFlagServerBit;
+	int				i;
+
+	if ( client->state != CS_ACTIVE ) {
+		snapFlags |= SNAPFLAG_NOT_ACTIVE;
+	}
+
+	SV_MasterDemoFlushCommand();
+
+	MSG_WriteByte( msg, MDEMO_EVENT_SNAPSHOT );
+	MSG_WriteByte( msg, client - svs.clients );
+	MSG_WriteByte( msg, mc->valid );
+	MSG_WriteByte( msg, snapFlags );
+	MSG_WriteByte( msg, frame->areabytes );
+	MSG_WriteData( msg, frame->areabits, frame->areabytes );
+
+	SV_MasterDemoWritePlayerstate( msg, mc->valid ? &mc->ps : NULL, &frame->ps, qfalse );
+	mc->ps = frame->ps;
+
+	MSG_WriteByte( msg, frame->ps.m_iVehicleNum ? 1 : 0 );
+	if ( frame->ps.m_iVehicleNum ) {
+		SV_MasterDemoWritePlayerstate( msg, ( mc->valid && mc->hasVehicle ) ? &mc->vps : NULL, &frame->vps, qtrue );
+		mc->vps = frame->vps;
+		mc->hasVehicle = qtrue;
+	} else {
+		mc->hasVehicle = qfalse;
+	}
+
+	// only the entities that came into or went out of view
+	if ( !mc->valid ) {
+		Com_Memset( mc->visible, 0, sizeof( mc->visible ) );
+	}
+
+	Com_Memset( visible, 0, sizeof( visible ) );
+	for ( i = 0; i < numEntities; i++ ) {
+		MDEMO_SETBIT( visible, entityNums[i] );
+	}
+
+	for ( i = 0; i < MAX_GENTITIES - 1; i++ ) {
+		if ( MDEMO_BIT( visible, i ) != MDEMO_BIT( mc->visible, i ) ) {
+			MSG_WriteBits( msg, i, GENTITYNUM_BITS );
+		}
+	}
+	MSG_WriteBits( msg, MAX_GENTITIES - 1, GENTITYNUM_BITS );
+
+	Com_Memcpy( mc->visible, visible, sizeof( visible ) );
+	mc->valid = qtrue;
+}
+
+/*
+==================
+SV_MasterDemoWriteFrame
+==================
+*/
+static void SV_MasterDemoWriteFrame( void ) {
+	msg_t			msg;
+	sharedEntity_t	*ent;
+	int				i;
+
+	MSG_Init( &msg, mdemo->worldData, MDEMO_BLOCK_SIZE );
+	msg.allowoverflow = qtrue;
+
+	MSG_WriteLong( &msg, sv.time );
+
+	for ( i = 0; i < MAX_CONFIGSTRINGS; i++ ) {
+		if ( mdemo->csChanged[i] ) {
+			MSG_WriteShort( &msg, i );
+			MSG_WriteBigString( &msg, sv.configstrings[i] );
+			mdemo->csChanged[i] = qfalse;
+		}
+	}
+	MSG_WriteShort( &msg, -1 );
+
+	// every entity a client could be sent, with the same tests as SV_AddEntitiesVisibleFromPoint
+	for ( i = 0; i < MAX_GENTITIES - 1; i++ ) {
+		qboolean sendable = qfalse;
+
+		if ( i < sv.num_entities ) {
+			ent = SV_GentityNum( i );
+			sendable = (qboolean)( ent->r.linked && !( ent->s.eFlags & EF_PERMANENT ) && !( ent->r.svFlags & SVF_NOCLIENT ) );
+		}
+
+		if ( sendable ) {
+			if ( MDEMO_BIT( mdemo->present, i ) ) {
+				MSG_WriteDeltaEntity( &msg, &mdemo->world[i], &ent->s, qfalse );
+			} else {
+				MSG_WriteDeltaEntity( &msg, &sv.svEntities[i].baseline, &ent->s, qtrue );
+				MDEMO_SETBIT( mdemo->present, i );
+			}
+			mdemo->world[i] = ent->s;
+		} else if ( MDEMO_BIT( mdemo->present, i ) ) {
+			MSG_WriteDeltaEntity( &msg, &mdemo->world[i], NULL, qtrue );
+			MDEMO_CLEARBIT( mdemo->present, i );
+		}
+	}
+	MSG_WriteBits( &msg, MAX_GENTITIES - 1, GENTITYNUM_BITS );
+
+	SV_MasterDemoFlushCommand();
+	MSG_WriteByte( &mdemo->events, MDEMO_EVENT_END );
+
+	if ( msg.overflowed || mdemo->events.overflowed ) {
+		Com_Printf( "WARNING: master demo frame overflowed, stopping.\n" );
+		SV_MasterDemoStop();
+		Cvar_Set( "sv_masterDemo", "0" );
+		return;
+	}
+
+	SV_MasterDemoWriteBlock( &msg );
+	SV_MasterDemoWriteBlock( &mdemo->events );
+	MSG_Init( &mdemo->events, mdemo->eventData, MDEMO_BLOCK_SIZE );
+	mdemo->events.allowoverflow = qtrue;
+
+	mdemo->frames++;
+}
+
+/*
+==================
+SV_MasterDemoFrame
+
+Called after the snapshots of a server frame have been sent
+==================
+*/
+void SV_MasterDemoFrame( void ) {
+	if ( !sv_masterDemo->integer || sv.state != SS_GAME ) {
+		SV_MasterDemoStop();
+		return;
+	}
+
+	if ( !mdemo || !mdemo->recording ) {
+		SV_MasterDemoStart();
+		return;
+	}
+
+	// clients that left start over from a full snapshot if the slot is reused
+	for ( int i = 0; i < sv_maxclients->integer; i++ ) {
+		if ( svs.clients[i].state < CS_PRIMED ) {
+			mdemo->clients[i].valid = qfalse;
+		}
+	}
+
+	SV_MasterDemoWriteFrame();
+}
+
+/*
+=============================================================================
+
+Extraction
+
+=============================================================================
+*/
+
+typedef struct mdemoReader_s {
+	fileHandle_t	file;
+	qboolean		compressed;
+	z_stream		zs;
+	byte			in[16384];
+} mdemoReader_t;
+
+typedef struct mdemoExtract_s {
+	mdemoReader_t	reader;
+	fileHandle_t	out;
+	byte			block[MDEMO_BLOCK_SIZE];
+
+	char			*configstrings[MAX_CONFIGSTRINGS];
+	int				checksumFeed;
+	entityState_t	baselines[MAX_GENTITIES];
+	entityState_t	world[MAX_GENTITIES];
+	byte			present[MAX_GENTITIES / 8];
+	mdemoClient_t	clients[MAX_CLIENTS];
+
+	// the client being extracted
+	int				clientNum;
+	int				serverTime;
+	qboolean		started;
+	int				sequence;
+	int				reliableSequence;
+	int				numCommands;
+	char			commands[MAX_RELIABLE_COMMANDS][MAX_STRING_CHARS];
+	int				numSnapEntities;
+	entityState_t	snapEntities[MAX_SNAPSHOT_ENTITIES];
+	playerState_t	snapPs;
+	playerState_t	snapVps;
+	int				snapshots;
+} mdemoExtract_t;
+
+static qboolean SV_MasterDemoRead( mdemoReader_t *r, void *buffer, int len ) {
+	if ( !r->compressed ) {
+		return (qboolean)( FS_Read( buffer, len, r->file ) == len );
+	}
+
+	r->zs.next_out = (Bytef *)buffer;
+	r->zs.avail_out = len;
+
+	while ( r->zs.avail_out ) {
+		if ( !r->zs.avail_in ) {
+			r->zs.avail_in = FS_Read( r->in, sizeof( r->in ), r->file );
+			r->zs.next_in = r->in;
+			if ( !r->zs.avail_in ) {
+				return qfalse;
+			}
+		}
+
+		const int err = inflate( &r->zs, Z_NO_FLUSH );
+		if ( err != Z_OK && !( err == Z_STREAM_END && !r->zs.avail_out ) ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+==================
+SV_MasterDemoReadBlock
+
+Returns qfalse at the end of the demo
+==================
+*/
+static qboolean SV_MasterDemoReadBlock( mdemoExtract_t *x, msg_t *msg ) {
+	int len;
+
+	if ( !SV_MasterDemoRead( &x->reader, &len, 4 ) ) {
+		return qfalse;
+	}
+
+	len = LittleLong( len );
+	if ( len < 0 ) {
+		return qfalse;
+	}
+	if ( len > MDEMO_BLOCK_SIZE ) {
+		Com_Printf( "Master demo block is too large (%i bytes).\n", len );
+		return qfalse;
+	}
+
+	MSG_Init( msg, x->block, sizeof( x->block ) );
+	if ( !SV_MasterDemoRead( &x->reader, x->block, len ) ) {
+		return qfalse;
+	}
+	msg->cursize = len;
+	MSG_BeginReading( msg );
+
+	return qtrue;
+}
+
+static void SV_MasterDemoSetConfigstring( mdemoExtract_t *x, int index, const char *s ) {
+	if ( index < 0 || index >= MAX_CONFIGSTRINGS ) {
+		Com_Error( ERR_DROP, "Master demo has bad configstring index %i", index );
+	}
+
+	if ( x->configstrings[index] ) {
+		Z_Free( x->configstrings[index] );
+	}
+	x->configstrings[index] = CopyString( s );
+}
+
+static void SV_MasterDemoWriteMessage( mdemoExtract_t *x, msg_t *msg ) {
+	int len;
+
+	len = LittleLong( x->sequence );
+	FS_Write( &len, 4, x->out );
+	len = LittleLong( msg->cursize );
+	FS_Write( &len, 4, x->out );
+	FS_Write( msg->data, msg->cursize, x->out );
+}
+
+/*
+==================
+SV_MasterDemoWriteGamestate
+
+Same as SV_CreateClientGameStateMessage
+==================
+*/
+static void SV_MasterDemoWriteGamestate( mdemoExtract_t *x ) {
+	byte			buf[MAX_MSGLEN];
+	msg_t			msg;
+	entityState_t	nullstate;
+	int				i;
+
+	MSG_Init( &msg, buf, sizeof( buf ) );
+
+	MSG_WriteLong( &msg, 0 );
+	MSG_WriteByte( &msg, svc_gamestate );
+	MSG_WriteLong( &msg, x->reliableSequence );
+
+	for ( i = 0; i < MAX_CONFIGSTRINGS; i++ ) {
+		if ( x->configstrings[i] && x->configstrings[i][0] ) {
+			MSG_WriteByte( &msg, svc_configstring );
+			MSG_WriteShort( &msg, i );
+			MSG_WriteBigString( &msg, x->configstrings[i] );
+		}
+	}
+
+	Com_Memset( &nullstate, 0, sizeof( nullstate ) );
+	for ( i = 0; i < MAX_GENTITIES; i++ ) {
+		if ( x->baselines[i].number ) {
+			MSG_WriteByte( &msg, svc_baseline );
+			MSG_WriteDeltaEntity( &msg, &nullstate, &x->baselines[i], qtrue );
+		}
+	}
+
+	MSG_WriteByte( &msg, svc_EOF );
+	MSG_WriteLong( &msg, x->clientNum );
+	MSG_WriteLong( &msg, x->checksumFeed );
+	MSG_WriteShort( &msg, 0 );
+	MSG_WriteByte( &msg, svc_EOF );
+
+	SV_MasterDemoWriteMessage( x, &msg );
+}
+
+/*
+==================
+SV_MasterDemoWriteSnapshot
+
+Same as SV_SendClientSnapshot, delta compressed against the previous snapshot
+==================
+*/
+static qboolean SV_MasterDemoWriteSnapshot( mdemoExtract_t *x, const mdemoClient_t *mc, int snapFlags, int areabytes, const byte *areabits ) {
+	byte			buf[MAX_MSGLEN];
+	msg_t			msg;
+	entityState_t	newEntities[MAX_SNAPSHOT_ENTITIES];
+	int				numNewEntities = 0;
+	int				i;
+
+	if ( !x->started ) {
+		SV_MasterDemoWriteGamestate( x );
+	}
+	x->sequence++;
+
+	for ( i = 0; i < MAX_GENTITIES - 1 && numNewEntities < MAX_SNAPSHOT_ENTITIES; i++ ) {
+		if ( MDEMO_BIT( mc->visible, i ) && MDEMO_BIT( x->present, i ) ) {
+			newEntities[numNewEntities++] = x->world[i];
+		}
+	}
+
+	MSG_Init( &msg, buf, sizeof( buf ) );
+	msg.allowoverflow = qtrue;
+
+	MSG_WriteLong( &msg, 0 );
+
+	for ( i = 0; i < x->numCommands; i++ ) {
+		MSG_WriteByte( &msg, svc_serverCommand );
+		MSG_WriteLong( &msg, ++x->reliableSequence );
+		MSG_WriteString( &msg, x->commands[i] );
+	}
+	x->numCommands = 0;
+
+	MSG_WriteByte( &msg, svc_snapshot );
+	MSG_WriteLong( &msg, x->serverTime );
+	MSG_WriteByte( &msg, x->started ? 1 : 0 );
+	MSG_WriteByte( &msg, snapFlags );
+	MSG_WriteByte( &msg, areabytes );
+	MSG_WriteData( &msg, areabits, areabytes );
+
+	SV_MasterDemoWritePlayerstate( &msg, x->started ? &x->snapPs : NULL, (playerState_t *)&mc->ps, qfalse );
+	if ( mc->ps.m_iVehicleNum ) {
+		const qboolean deltaVehicle = (qboolean)( x->started && x->snapPs.m_iVehicleNum );
+		SV_MasterDemoWritePlayerstate( &msg, deltaVehicle ? &x->snapVps : NULL, (playerState_t *)&mc->vps, qtrue );
+	}
+
+	// same walk as SV_EmitPacketEntities
+	int oldindex = 0, newindex = 0;
+	const int numOldEntities = x->started ? x->numSnapEntities : 0;
+
+	while ( newindex < numNewEntities || oldindex < numOldEntities ) {
+		const int newnum = ( newindex < numNewEntities ) ? newEntities[newindex].number : 9999;
+		const int oldnum = ( oldindex < numOldEntities ) ? x->snapEntities[oldindex].number : 9999;
+
+		if ( newnum == oldnum ) {
+			MSG_WriteDeltaEntity( &msg, &x->snapEntities[oldindex], &newEntities[newindex], qfalse );
+			oldindex++;
+			newindex++;
+		} else if ( newnum < oldnum ) {
+			MSG_WriteDeltaEntity( &msg, &x->baselines[newnum], &newEntities[newindex], qtrue );
+			newindex++;
+		} else {
+			MSG_WriteDeltaEntity( &msg, &x->snapEntities[oldindex], NULL, qtrue );
+			oldindex++;
+		}
+	}
+	MSG_WriteBits( &msg, MAX_GENTITIES - 1, GENTITYNUM_BITS );
+
+	MSG_WriteByte( &msg, svc_EOF );
+
+	if ( msg.overflowed ) {
+		Com_Printf( "Snapshot %i overflowed a message, stopping.\n", x->sequence );
+		return qfalse;
+	}
+
+	SV_MasterDemoWriteMessage( x, &msg );
+
+	Com_Memcpy( x->snapEntities, newEntities, numNewEntities * sizeof( newEntities[0] ) );
+	x->numSnapEntities = numNewEntities;
+	x->snapPs = mc->ps;
+	x->snapVps = mc->vps;
+	x->started = qtrue;
+	x->snapshots++;
+
+	return qtrue;
+}
+
+/*
+==================
+SV_MasterDemoReadWorld
+==================
+*/
+static void SV_MasterDemoReadWorld( mdemoExtract_t *x, msg_t *msg ) {
+	entityState_t	to;
+	int				index, num;
+
+	x->serverTime = MSG_ReadLong( msg );
+
+	while ( ( index = MSG_ReadShort( msg ) ) != -1 ) {
+		SV_MasterDemoSetConfigstring( x, index, MSG_ReadBigString( msg ) );
+	}
+
+	while ( ( num = MSG_ReadBits( msg, GENTITYNUM_BITS ) ) != MAX_GENTITIES - 1 ) {
+		MSG_ReadDeltaEntity( msg, MDEMO_BIT( x->present, num ) ? &x->world[num] : &x->baselines[num], &to, num );
+
+		if ( to.number == MAX_GENTITIES - 1 ) {
+			MDEMO_CLEARBIT( x->present, num );
+		} else {
+			x->world[num] = to;
+			MDEMO_SETBIT( x->present, num );
+		}
+	}
+}
+
+/*
+==================
+SV_MasterDemoReadEvents
+
+Returns qfalse once the extracted client has left
+==================
+*/
+static qboolean SV_MasterDemoReadEvents( mdemoExtract_t *x, msg_t *msg ) {
+	playerState_t	ps;
+	byte			areabits[MAX_MAP_AREA_BYTES];
+	int				event;
+
+	while ( ( event = MSG_ReadByte( msg ) ) != MDEMO_EVENT_END ) {
+		if ( msg->readcount > msg->cursize ) {
+			Com_Printf( "Master demo event block is truncated.\n" );
+			return qfalse;
+		}
+
+		if ( event == MDEMO_EVENT_COMMAND ) {
+			const int mask = MSG_ReadLong( msg );
+			const char *cmd = MSG_ReadString( msg );
+
+			if ( x->started && ( mask & ( 1 << x->clientNum ) ) ) {
+				if ( x->numCommands == MAX_RELIABLE_COMMANDS ) {
+					Com_Printf( "Client %i had too many pending commands, stopping.\n", x->clientNum );
+					return qfalse;
+				}
+				Q_strncpyz( x->commands[x->numCommands++], cmd, sizeof( x->commands[0] ) );
+			}
+			continue;
+		}
+
+		if ( event != MDEMO_EVENT_SNAPSHOT ) {
+			Com_Printf( "Bad master demo event %i.\n", event );
+			return qfalse;
+		}
+
+		const int clientNum = MSG_ReadByte( msg );
+		if ( clientNum >= MAX_CLIENTS ) {
+			Com_Printf( "Bad master demo client %i.\n", clientNum );
+			return qfalse;
+		}
+
+		mdemoClient_t *mc = &x->clients[clientNum];
+		const qboolean delta = (qboolean)MSG_ReadByte( msg );
+		const int snapFlags = MSG_ReadByte( msg );
+		const int areabytes = MSG_ReadByte( msg );
+
+		if ( areabytes > MAX_MAP_AREA_BYTES ) {
+			Com_Printf( "Bad master demo areabytes %i.\n", areabytes );
+			return qfalse;
+		}
+		MSG_ReadData( msg, areabits, areabytes );
+
+		if ( !delta ) {
+			mc->valid = qfalse;
+			mc->hasVehicle = qfalse;
+			Com_Memset( mc->visible, 0, sizeof( mc->visible ) );
+
+			// a new player in the slot we're extracting
+			if ( clientNum == x->clientNum && x->started ) {
+				return qfalse;
+			}
+		}
+
+		MSG_ReadDeltaPlayerstate( msg, mc->valid ? &mc->ps : NULL, &ps, qfalse );
+		mc->ps = ps;
+
+		if ( MSG_ReadByte( msg ) ) {
+			MSG_ReadDeltaPlayerstate( msg, ( mc->valid && mc->hasVehicle ) ? &mc->vps : NULL, &ps, qtrue );
+			mc->vps = ps;
+			mc->hasVehicle = qtrue;
+		} else {
+			mc->hasVehicle = qfalse;
+		}
+
+		int num;
+		while ( ( num = MSG_ReadBits( msg, GENTITYNUM_BITS ) ) != MAX_GENTITIES - 1 ) {
+			mc->visible[num >> 3] ^= 1 << ( num & 7 );
+		}
+		mc->valid = qtrue;
+
+		if ( clientNum == x->clientNum ) {
+			if ( !SV_MasterDemoWriteSnapshot( x, mc, snapFlags, areabytes, areabits ) ) {
+				return qfalse;
+			}
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+==================
+SV_MasterDemoOpen
+
+Tries the name as given, then with the master demo extensions
+==================
+*/
+static qboolean SV_MasterDemoOpen( mdemoReader_t *r, const char *base, char *name, int nameSize ) {
+	const char *formats[] = { "demos/%s", "demos/%s.mdm_%d", "demos/%s.mdm_%d.gz" };
+
+	for ( size_t i = 0; i < ARRAY_LEN( formats ); i++ ) {
+		Com_sprintf( name, nameSize, formats[i], base, PROTOCOL_VERSION );
+		if ( FS_FOpenFileRead( name, &r->file, qtrue ) > 0 ) {
+			break;
+		}
+		r->file = 0;
+	}
+
+	if ( !r->file ) {
+		return qfalse;
+	}
+
+	r->compressed = (qboolean)!Q_stricmp( COM_GetExtension( name ), "gz" );
+	if ( r->compressed ) {
+		Com_Memset( &r->zs, 0, sizeof( r->zs ) );
+		if ( inflateInit2( &r->zs, 16 + MAX_WBITS ) != Z_OK ) {
+			FS_FCloseFile( r->file );
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+==================
+SV_MasterDemoExtract_f
+
+mdemo_extract <master demo> <client number> [output name]
+==================
+*/
+static void SV_MasterDemoExtract_f( void ) {
+	char			name[MAX_OSPATH], outName[MAX_OSPATH];
+	msg_t			msg;
+	entityState_t	nullstate;
+	int				i, num;
+
+	if ( Cmd_Argc() < 3 ) {
+		Com_Printf( "usage: mdemo_extract <master demo> <client number> [output name]\n" );
+		return;
+	}
+
+	mdemoExtract_t *x = (mdemoExtract_t *)Z_Malloc( sizeof( *x ), TAG_TEMP_WORKSPACE, qtrue );
+
+	x->clientNum = atoi( Cmd_Argv( 2 ) );
+	if ( x->clientNum < 0 || x->clientNum >= MAX_CLIENTS ) {
+		Com_Printf( "Bad client number %s.\n", Cmd_Argv( 2 ) );
+		Z_Free( x );
+		return;
+	}
+
+	if ( !SV_MasterDemoOpen( &x->reader, Cmd_Argv( 1 ), name, sizeof( name ) ) ) {
+		Com_Printf( "Couldn't open master demo %s.\n", Cmd_Argv( 1 ) );
+		Z_Free( x );
+		return;
+	}
+
+	if ( !SV_MasterDemoReadBlock( x, &msg ) || MSG_ReadLong( &msg ) != MDEMO_VERSION || MSG_ReadLong( &msg ) != PROTOCOL_VERSION ) {
+		Com_Printf( "%s is not a version %i master demo.\n", name, MDEMO_VERSION );
+		goto done;
+	}
+
+	x->checksumFeed = MSG_ReadLong( &msg );
+
+	while ( ( i = MSG_ReadShort( &msg ) ) != -1 ) {
+		SV_MasterDemoSetConfigstring( x, i, MSG_ReadBigString( &msg ) );
+	}
+
+	Com_Memset( &nullstate, 0, sizeof( nullstate ) );
+	while ( ( num = MSG_ReadBits( &msg, GENTITYNUM_BITS ) ) != MAX_GENTITIES - 1 ) {
+		MSG_ReadDeltaEntity( &msg, &nullstate, &x->baselines[num], num );
+	}
+
+	if ( Cmd_Argc() > 3 ) {
+		Com_sprintf( outName, sizeof( outName ), "demos/%s.dm_%d", Cmd_Argv( 3 ), PROTOCOL_VERSION );
+	} else {
+		char base[MAX_OSPATH];
+
+		COM_StripExtension( COM_SkipPath( (char *)Cmd_Argv( 1 ) ), base, sizeof( base ) );
+		Com_sprintf( outName, sizeof( outName ), "demos/%s client %i.dm_%d", base, x->clientNum, PROTOCOL_VERSION );
+	}
+
+	x->out = FS_FOpenFileWrite( outName );
+	if ( !x->out ) {
+		Com_Printf( "Couldn't open %s.\n", outName );
+		goto done;
+	}
+
+	for ( ;; ) {
+		if ( !SV_MasterDemoReadBlock( x, &msg ) ) {
+			break;
+		}
+		SV_MasterDemoReadWorld( x, &msg );
+
+		if ( !SV_MasterDemoReadBlock( x, &msg ) || !SV_MasterDemoReadEvents( x, &msg ) ) {
+			break;
+		}
+	}
+
+	i = -1;
+	FS_Write( &i, 4, x->out );
+	FS_Write( &i, 4, x->out );
+	FS_FCloseFile( x->out );
+
+	if ( x->snapshots ) {
+		Com_Printf( "Wrote %i snapshots of client %i to %s.\n", x->snapshots, x->clientNum, outName );
+	} else {
+		Com_Printf( "Client %i is not in %s, %s is empty.\n", x->clientNum, name, outName );
+	}
+
+done:
+	if ( x->reader.compressed ) {
+		inflateEnd( &x->reader.zs );
+	}
+	FS_FCloseFile( x->reader.file );
+
+	for ( i = 0; i < MAX_CONFIGSTRINGS; i++ ) {
+		if ( x->configstrings[i] ) {
+			Z_Free( x->configstrings[i] );
+		}
+	}
+	Z_Free( x );
+}
+
+/*
+==================
+SV_MasterDemoInit
+==================
+*/
+void SV_MasterDemoInit( void ) {
+	sv_masterDemo = Cvar_Get( "sv_masterDemo", "0", CVAR_ARCHIVE, "Record one demo of the whole server, client demos can be taken out of it with mdemo_extract" );
+
+	Cmd_AddCommand( "mdemo_extract", SV_MasterDemoExtract_f, "Write a client demo from a master demo" );
+}
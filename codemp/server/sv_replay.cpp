@@ -0,0 +1,1121 @@
+/*
+===========================================================================
+Copyright (C) 2013 - 2015, OpenJK contributors
+
+This file is part of the OpenJK source code.
+
+OpenJK is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License version 2 as
+published by the Free Software Foundation.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, see <http://www.gnu.org/licenses/>.
+===========================================================================
+*/
+
+// sv_replay.cpp -- records everything the game module is given, and plays it back
+//
+// replay_record <name> records the next map into replays/<name>.rpl.  From the
+// moment the game is loaded until it shuts down, every call the engine makes
+// into it on its own is written down: frames, bot frames, usercmds, connects,
+// userinfo, client and console commands, along with the game cvars, the random
+// seeds and a checksum of the entities after each frame.  Calls the game makes
+// happen from inside another call, like bot usercmds, are left out because
+// playing the outer call back makes them again.
+//
+// replay_play <name> loads the map on a dedicated server, makes the recorded
+// calls as fast as it can with stand-ins for the clients, and reports how long
+// the game took per frame and whether it ended up in the same state every
+// frame.  Bots and NPCs think for themselves as usual.
+//
+// The file is a series of blocks, each a length and that many bytes of events,
+// ending with a length of -1.  Events hold raw structs, so a replay is only
+// good for builds of the same platform.
+
+#include "server.h"
+#include "server/sv_gameapi.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <vector>
+
+#define REPLAY_VERSION		2
+#define REPLAY_BLOCK_SIZE	( 256 * 1024 )
+#define REPLAY_MAX_EVENT	( 16 * 1024 )		// the block is written out before it gets closer to full than this
+#define REPLAY_MAX_STRING	BIG_INFO_STRING		// longer strings stop the recording, the playback can't be trusted without them
+#define REPLAY_MAX_CVARS	1024
+#define REPLAY_MAX_REPORT	10					// checksum mismatches printed
+
+enum {
+	REPLAY_EVENT_END,
+	REPLAY_EVENT_CVAR,
+	REPLAY_EVENT_INIT,
+	REPLAY_EVENT_FRAME,
+	REPLAY_EVENT_FRAME_DONE,
+	REPLAY_EVENT_BOT_FRAME,
+	REPLAY_EVENT_CONNECT,
+	REPLAY_EVENT_BEGIN,
+	REPLAY_EVENT_USERINFO,
+	REPLAY_EVENT_DISCONNECT,
+	REPLAY_EVENT_CLIENT_COMMAND,
+	REPLAY_EVENT_CONSOLE_COMMAND,
+	REPLAY_EVENT_USERCMD
+};
+
+typedef struct replayCvar_s {
+	char			name[MAX_QPATH];
+	char			value[MAX_CVAR_VALUE_STRING];
+} replayCvar_t;
+
+typedef struct replayRecord_s {
+	int				stream;
+	qboolean		initialized;		// the INIT event is written, cvars registered after it are written as they come
+	int				frames;
+	qboolean		failed;				// the current event didn't fit, it is dropped and the recording stopped
+
+	byte			block[REPLAY_BLOCK_SIZE];
+	int				blockSize;
+	int				eventStart;			// where the current event starts in the block
+
+	// the game's cvars, with the last value written
+	int				numCvars;
+	replayCvar_t	cvars[REPLAY_MAX_CVARS];
+} replayRecord_t;
+
+typedef struct replayReader_s {
+	fileHandle_t	file;
+	qboolean		compressed;
+	z_stream		zs;
+	byte			in[16384];
+
+	byte			block[REPLAY_BLOCK_SIZE];
+	int				blockSize;
+	int				readcount;
+	qboolean		overrun;
+} replayReader_t;
+
+static char				replayName[MAX_QPATH];		// set by replay_record until the next map starts recording
+static replayRecord_t	*replayRec;
+static qboolean			replayLoading;				// replay_play is loading the map, the game is left alone
+static qboolean			replayPlaying;
+
+/*
+==================
+SV_ReplayChecksum
+
+FNV-1a of the part of every entity the engine can see, and of the client
+playerstates
+==================
+*/
+static uint32_t SV_ReplayChecksum( void ) {
+	uint32_t	hash = Q_FNV_BASIS;
+	int			i;
+
+	for ( i = 0; i < sv.num_entities; i++ ) {
+		const sharedEntity_t *ent = SV_GentityNum( i );
+
+		hash = Q_HashFNV( &ent->s, sizeof( ent->s ), hash );
+		hash = Q_HashFNV( ent->modelScale, sizeof( ent->modelScale ), hash );
+		hash = Q_HashFNV( &ent->r, sizeof( ent->r ), hash );
+	}
+
+	for ( i = 0; i < sv_maxclients->integer; i++ ) {
+		hash = Q_HashFNV( SV_GameClientNum( i ), sizeof( playerState_t ), hash );
+	}
+
+	return hash;
+}
+
+/*
+=============================================================================
+
+Recording
+
+=============================================================================
+*/
+
+qboolean SV_ReplayRecording( void ) {
+	return (qboolean)( replayRec != NULL );
+}
+
+static void SV_ReplayWrite( const void *data, int len ) {
+	if ( replayRec->failed || replayRec->blockSize + len > REPLAY_BLOCK_SIZE ) {
+		replayRec->failed = qtrue;
+		return;
+	}
+
+	Com_Memcpy( replayRec->block + replayRec->blockSize, data, len );
+	replayRec->blockSize += len;
+}
+
+static void SV_ReplayWriteByte( int b ) {
+	const byte c = (byte)b;
+
+	SV_ReplayWrite( &c, 1 );
+}
+
+static void SV_ReplayWriteInt( int i ) {
+	SV_ReplayWrite( &i, sizeof( i ) );
+}
+
+static void SV_ReplayWriteString( const char *s ) {
+	const int len = (int)strlen( s );
+
+	if ( len >= REPLAY_MAX_STRING ) {
+		Com_Printf( S_COLOR_YELLOW "WARNING: replay string is %i characters long, the limit is %i.\n", len, REPLAY_MAX_STRING - 1 );
+		replayRec->failed = qtrue;
+		return;
+	}
+
+	SV_ReplayWriteInt( len );
+	SV_ReplayWrite( s, len );
+}
+
+// the arguments the game will read with Argc and Argv
+static void SV_ReplayWriteArgs( void ) {
+	const int argc = Cmd_Argc();
+
+	SV_ReplayWriteInt( argc );
+	for ( int i = 0; i < argc; i++ ) {
+		SV_ReplayWriteString( Cmd_Argv( i ) );
+	}
+}
+
+static void SV_ReplayFlush( void ) {
+	if ( replayRec->blockSize ) {
+		SV_DemoWriterWrite( replayRec->stream, &replayRec->blockSize, 4 );
+		SV_DemoWriterWrite( replayRec->stream, replayRec->block, replayRec->blockSize );
+		replayRec->blockSize = 0;
+	}
+	replayRec->eventStart = 0;
+}
+
+/*
+==================
+SV_ReplayEventFailed
+
+Drops an event that couldn't be written in full and stops the recording,
+a replay missing part of an event would play back differently
+==================
+*/
+static qboolean SV_ReplayEventFailed( void ) {
+	if ( !replayRec->failed ) {
+		replayRec->eventStart = replayRec->blockSize;
+		return qfalse;
+	}
+
+	Com_Printf( S_COLOR_YELLOW "WARNING: couldn't write a replay event, stopping the replay.\n" );
+	replayRec->blockSize = replayRec->eventStart;
+	replayRec->failed = qfalse;
+	SV_ReplayStop();
+	return qtrue;
+}
+
+// called after each event, events never span blocks
+static void SV_ReplayEndEvent( void ) {
+	if ( SV_ReplayEventFailed() ) {
+		return;
+	}
+
+	if ( replayRec->blockSize > REPLAY_BLOCK_SIZE - REPLAY_MAX_EVENT ) {
+		SV_ReplayFlush();
+	}
+}
+
+static void SV_ReplayWriteCvar( const replayCvar_t *cv ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_CVAR );
+	SV_ReplayWriteString( cv->name );
+	SV_ReplayWriteString( cv->value );
+	SV_ReplayEndEvent();
+}
+
+/*
+==================
+SV_ReplayMapStart
+
+Called by SV_SpawnServer just before the game is loaded
+==================
+*/
+void SV_ReplayMapStart( void ) {
+	char name[MAX_OSPATH];
+
+	if ( !replayName[0] ) {
+		return;
+	}
+
+	Com_sprintf( name, sizeof( name ), "replays/%s.rpl", replayName );
+	replayName[0] = '\0';
+
+	replayRec = (replayRecord_t *)Z_Malloc( sizeof( *replayRec ), TAG_CLIENTS, qtrue );
+	replayRec->stream = SV_DemoWriterOpen( name, sizeof( name ) );
+	if ( replayRec->stream < 0 ) {
+		Com_Printf( "ERROR: couldn't open %s, not recording a replay.\n", name );
+		Z_Free( replayRec );
+		replayRec = NULL;
+		return;
+	}
+	Com_Printf( "recording replay to %s.\n", name );
+
+	SV_ReplayWriteInt( REPLAY_VERSION );
+	SV_ReplayWriteInt( sizeof( usercmd_t ) );
+	SV_ReplayWriteString( Cvar_VariableString( "mapname" ) );
+	SV_ReplayWriteString( Cvar_InfoString_Big( CVAR_SERVERINFO ) );
+	if ( SV_ReplayEventFailed() ) {
+		return;
+	}
+	SV_ReplayFlush();
+}
+
+/*
+==================
+SV_ReplayStop
+==================
+*/
+void SV_ReplayStop( void ) {
+	int len = -1;
+
+	if ( !replayRec ) {
+		return;
+	}
+
+	SV_ReplayWriteByte( REPLAY_EVENT_END );
+	SV_ReplayFlush();
+	SV_DemoWriterWrite( replayRec->stream, &len, 4 );
+	SV_DemoWriterClose( replayRec->stream );
+
+	Com_Printf( "Stopped replay after %i frames.\n", replayRec->frames );
+
+	Z_Free( replayRec );
+	replayRec = NULL;
+}
+
+/*
+==================
+SV_ReplayGameCvar
+
+Called for every cvar the game registers
+==================
+*/
+void SV_ReplayGameCvar( const char *name ) {
+	if ( !replayRec ) {
+		return;
+	}
+
+	if ( ( Cvar_Flags( name ) & CVAR_INTERNAL ) || Q_stristr( name, "password" ) || strlen( name ) >= MAX_QPATH ) {
+		return;
+	}
+
+	for ( int i = 0; i < replayRec->numCvars; i++ ) {
+		if ( !Q_stricmp( replayRec->cvars[i].name, name ) ) {
+			return;
+		}
+	}
+
+	if ( replayRec->numCvars == REPLAY_MAX_CVARS ) {
+		Com_DPrintf( "SV_ReplayGameCvar: not recording %s, too many cvars\n", name );
+		return;
+	}
+
+	replayCvar_t *cv = &replayRec->cvars[replayRec->numCvars++];
+
+	Q_strncpyz( cv->name, name, sizeof( cv->name ) );
+	Cvar_VariableStringBuffer( name, cv->value, sizeof( cv->value ) );
+
+	if ( replayRec->initialized ) {
+		SV_ReplayWriteCvar( cv );
+	}
+}
+
+/*
+==================
+SV_ReplayInitGame
+
+Written once the game is up, after the values its cvars had when it read them
+==================
+*/
+void SV_ReplayInitGame( int levelTime, int randomSeed, int restart ) {
+	if ( !replayRec ) {
+		return;
+	}
+
+	for ( int i = 0; i < replayRec->numCvars; i++ ) {
+		SV_ReplayWriteCvar( &replayRec->cvars[i] );
+		if ( !replayRec ) {
+			return;
+		}
+	}
+
+	SV_ReplayWriteByte( REPLAY_EVENT_INIT );
+	SV_ReplayWriteInt( levelTime );
+	SV_ReplayWriteInt( randomSeed );
+	SV_ReplayWriteInt( restart );
+	SV_ReplayEndEvent();
+	if ( !replayRec ) {
+		return;
+	}
+
+	replayRec->initialized = qtrue;
+}
+
+/*
+==================
+SV_ReplayRunFrame
+
+The game reads its cvars at the start of a frame, so changes are written just
+before it.  rand is reseeded every frame so anything else in the process
+calling it doesn't throw the playback off.
+==================
+*/
+void SV_ReplayRunFrame( int levelTime ) {
+	char	value[MAX_CVAR_VALUE_STRING];
+	int		seed, i;
+
+	for ( i = 0; i < replayRec->numCvars; i++ ) {
+		replayCvar_t *cv = &replayRec->cvars[i];
+
+		Cvar_VariableStringBuffer( cv->name, value, sizeof( value ) );
+		if ( strcmp( value, cv->value ) ) {
+			Q_strncpyz( cv->value, value, sizeof( cv->value ) );
+			SV_ReplayWriteCvar( cv );
+			if ( !replayRec ) {
+				return;
+			}
+		}
+	}
+
+	seed = rand();
+	srand( seed );
+
+	SV_ReplayWriteByte( REPLAY_EVENT_FRAME );
+	SV_ReplayWriteInt( levelTime );
+	SV_ReplayWriteInt( seed );
+	SV_ReplayWriteInt( re->G2API_GetTime( levelTime ) );
+
+	// slots that are free for SV_BotAllocateClient, and the pings from SV_CalcPings
+	SV_ReplayWriteInt( sv_maxclients->integer );
+	for ( i = 0; i < sv_maxclients->integer; i++ ) {
+		SV_ReplayWriteByte( svs.clients[i].state != CS_FREE );
+		SV_ReplayWriteInt( SV_GameClientNum( i )->ping );
+	}
+	SV_ReplayEndEvent();
+}
+
+/*
+==================
+SV_ReplayFrameDone
+==================
+*/
+void SV_ReplayFrameDone( void ) {
+	if ( !replayRec ) {
+		return;
+	}
+
+	SV_ReplayWriteByte( REPLAY_EVENT_FRAME_DONE );
+	SV_ReplayWriteInt( SV_ReplayChecksum() );
+	if ( SV_ReplayEventFailed() ) {
+		return;
+	}
+
+	replayRec->frames++;
+	SV_ReplayFlush();
+}
+
+void SV_ReplayBotFrame( int time ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_BOT_FRAME );
+	SV_ReplayWriteInt( time );
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientConnect( int clientNum, qboolean firstTime, qboolean isBot ) {
+	byte	session[MAX_SESSION_DATA];
+	int		sessionSize = SV_GetSessionData( clientNum, session, sizeof( session ) );
+
+	SV_ReplayWriteByte( REPLAY_EVENT_CONNECT );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayWriteByte( firstTime );
+	SV_ReplayWriteByte( isBot );
+	SV_ReplayWriteString( svs.clients[clientNum].userinfo );
+	SV_ReplayWriteInt( sessionSize );
+	SV_ReplayWrite( session, sessionSize );
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientBegin( int clientNum ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_BEGIN );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayWrite( &svs.clients[clientNum].lastUsercmd, sizeof( usercmd_t ) );
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientUserinfoChanged( int clientNum ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_USERINFO );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayWriteString( svs.clients[clientNum].userinfo );
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientDisconnect( int clientNum ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_DISCONNECT );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientCommand( int clientNum ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_CLIENT_COMMAND );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayWriteArgs();
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayConsoleCommand( void ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_CONSOLE_COMMAND );
+	SV_ReplayWriteArgs();
+	SV_ReplayEndEvent();
+}
+
+void SV_ReplayClientThink( int clientNum ) {
+	SV_ReplayWriteByte( REPLAY_EVENT_USERCMD );
+	SV_ReplayWriteByte( clientNum );
+	SV_ReplayWrite( &svs.clients[clientNum].lastUsercmd, sizeof( usercmd_t ) );
+	SV_ReplayEndEvent();
+}
+
+/*
+==================
+SV_ReplayRecord_f
+==================
+*/
+static void SV_ReplayRecord_f( void ) {
+	if ( Cmd_Argc() != 2 ) {
+		Com_Printf( "usage: replay_record <name>\n" );
+		return;
+	}
+
+	if ( replayRec ) {
+		Com_Printf( "Already recording a replay, replay_stop first.\n" );
+		return;
+	}
+
+	Q_strncpyz( replayName, Cmd_Argv( 1 ), sizeof( replayName ) );
+	Q_strstrip( replayName, "\n\r;:.?*<>|\\/\"", NULL );
+	if ( !replayName[0] ) {
+		Com_Printf( "Bad replay name %s.\n", Cmd_Argv( 1 ) );
+		return;
+	}
+
+	Com_Printf( "replays/%s.rpl will be recorded from the next map load.\n", replayName );
+}
+
+/*
+==================
+SV_ReplayStop_f
+==================
+*/
+static void SV_ReplayStop_f( void ) {
+	if ( replayName[0] ) {
+		Com_Printf( "Not recording replays/%s.rpl after all.\n", replayName );
+		replayName[0] = '\0';
+	}
+
+	SV_ReplayStop();
+}
+
+/*
+=============================================================================
+
+Playback
+
+=============================================================================
+*/
+
+qboolean SV_ReplayLoading( void ) {
+	return replayLoading;
+}
+
+qboolean SV_ReplayPlaying( void ) {
+	return replayPlaying;
+}
+
+static qboolean SV_ReplayRead( replayReader_t *r, void *buffer, int len ) {
+	if ( !r->compressed ) {
+		return (qboolean)( FS_Read( buffer, len, r->file ) == len );
+	}
+
+	r->zs.next_out = (Bytef *)buffer;
+	r->zs.avail_out = len;
+
+	while ( r->zs.avail_out ) {
+		if ( !r->zs.avail_in ) {
+			r->zs.next_in = r->in;
+			r->zs.avail_in = FS_Read( r->in, sizeof( r->in ), r->file );
+			if ( !r->zs.avail_in ) {
+				return qfalse;
+			}
+		}
+
+		const int ret = inflate( &r->zs, Z_NO_FLUSH );
+		if ( ret == Z_STREAM_END && r->zs.avail_out ) {
+			return qfalse;
+		}
+		if ( ret != Z_OK && ret != Z_STREAM_END ) {
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+static qboolean SV_ReplayReadBlock( replayReader_t *r ) {
+	int len;
+
+	if ( !SV_ReplayRead( r, &len, 4 ) || len <= 0 || len > REPLAY_BLOCK_SIZE ) {
+		return qfalse;
+	}
+
+	r->blockSize = len;
+	r->readcount = 0;
+
+	return SV_ReplayRead( r, r->block, len );
+}
+
+static void SV_ReplayReadData( replayReader_t *r, void *data, int len ) {
+	if ( len < 0 || r->readcount + len > r->blockSize ) {
+		Com_Memset( data, 0, Q_max( len, 0 ) );
+		r->overrun = qtrue;
+		return;
+	}
+
+	Com_Memcpy( data, r->block + r->readcount, len );
+	r->readcount += len;
+}
+
+static int SV_ReplayReadByte( replayReader_t *r ) {
+	byte b;
+
+	SV_ReplayReadData( r, &b, 1 );
+
+	return b;
+}
+
+static int SV_ReplayReadInt( replayReader_t *r ) {
+	int i;
+
+	SV_ReplayReadData( r, &i, sizeof( i ) );
+
+	return i;
+}
+
+static void SV_ReplayReadString( replayReader_t *r, char *buffer, int size ) {
+	const int len = SV_ReplayReadInt( r );
+
+	if ( len < 0 || len >= size ) {
+		buffer[0] = '\0';
+		r->overrun = qtrue;
+		return;
+	}
+
+	SV_ReplayReadData( r, buffer, len );
+	buffer[len] = '\0';
+}
+
+static int SV_ReplayReadClient( replayReader_t *r ) {
+	const int clientNum = SV_ReplayReadByte( r );
+
+	if ( clientNum >= sv_maxclients->integer ) {
+		r->overrun = qtrue;
+		return 0;
+	}
+
+	return clientNum;
+}
+
+/*
+==================
+SV_ReplayReadArgs
+
+Quotes every argument, which tokenizes back into the same arguments since
+none of them can hold a quote
+==================
+*/
+static void SV_ReplayReadArgs( replayReader_t *r ) {
+	char	text[BIG_INFO_STRING], arg[REPLAY_MAX_STRING];
+	int		argc = SV_ReplayReadInt( r );
+
+	text[0] = '\0';
+	for ( int i = 0; i < argc && !r->overrun; i++ ) {
+		SV_ReplayReadString( r, arg, sizeof( arg ) );
+		Q_strcat( text, sizeof( text ), va( "%s\"%s\"", i ? " " : "", arg ) );
+	}
+
+	Cmd_TokenizeString( text );
+}
+
+/*
+==================
+SV_ReplayOpen
+
+Tries the name as given, then with the replay extensions
+==================
+*/
+static qboolean SV_ReplayOpen( replayReader_t *r, const char *base, char *name, int nameSize ) {
+	const char *formats[] = { "replays/%s", "replays/%s.rpl", "replays/%s.rpl.gz" };
+
+	for ( size_t i = 0; i < ARRAY_LEN( formats ); i++ ) {
+		Com_sprintf( name, nameSize, formats[i], base );
+		if ( FS_FOpenFileRead( name, &r->file, qtrue ) > 0 ) {
+			break;
+		}
+		r->file = 0;
+	}
+
+	if ( !r->file ) {
+		return qfalse;
+	}
+
+	r->compressed = (qboolean)!Q_stricmp( COM_GetExtension( name ), "gz" );
+	if ( r->compressed ) {
+		Com_Memset( &r->zs, 0, sizeof( r->zs ) );
+		if ( inflateInit2( &r->zs, 16 + MAX_WBITS ) != Z_OK ) {
+			FS_FCloseFile( r->file );
+			return qfalse;
+		}
+	}
+
+	return qtrue;
+}
+
+/*
+==================
+SV_ReplaySetCvar
+
+Latched cvars are only latched, so sv_maxclients and the like keep the value
+the server was started with
+==================
+*/
+static void SV_ReplaySetCvar( const char *name, const char *value ) {
+	const uint32_t flags = Cvar_Flags( name );
+
+	if ( flags & ( CVAR_INIT | CVAR_PROTECTED ) ) {
+		return;
+	}
+	if ( flags == CVAR_NONEXISTENT ) {
+		Cvar_Set( name, value );
+		return;
+	}
+
+	Cvar_Set2( name, value, 0, (qboolean)!( flags & CVAR_LATCH ) );
+}
+
+typedef struct replayPlayback_s {
+	replayReader_t		reader;
+
+	int					calls;
+	int64_t				initTime;
+	int64_t				frameTime;		// game time since the last frame finished
+	int					mismatches;
+	int					firstMismatch;
+	int					levelTime;
+} replayPlayback_t;
+
+/*
+==================
+SV_ReplayPlayEvent
+
+Makes one recorded call into the game, returns qfalse at the end of the replay
+==================
+*/
+static qboolean SV_ReplayPlayEvent( replayPlayback_t *p, int event, std::vector< int > &frameTimes, fileHandle_t csv ) {
+	replayReader_t	*r = &p->reader;
+	char			name[MAX_QPATH], value[MAX_INFO_STRING];
+	client_t		*cl;
+	usercmd_t		cmd;
+	int				clientNum, i, num;
+	int64_t			start;
+
+	switch ( event ) {
+	case REPLAY_EVENT_END:
+		return qfalse;
+
+	case REPLAY_EVENT_CVAR:
+		SV_ReplayReadString( r, name, sizeof( name ) );
+		SV_ReplayReadString( r, value, sizeof( value ) );
+		if ( !r->overrun ) {
+			SV_ReplaySetCvar( name, value );
+		}
+		return qtrue;
+
+	case REPLAY_EVENT_INIT: {
+		const int levelTime = SV_ReplayReadInt( r );
+		const int seed = SV_ReplayReadInt( r );
+		const int restart = SV_ReplayReadInt( r );
+
+		sv.time = levelTime;
+		start = Sys_Microseconds();
+		GVM_InitGame( levelTime, seed, restart );
+		p->initTime += Sys_Microseconds() - start;
+		return qtrue;
+	}
+
+	case REPLAY_EVENT_FRAME: {
+		const int levelTime = SV_ReplayReadInt( r );
+		const int seed = SV_ReplayReadInt( r );
+		const int g2Time = SV_ReplayReadInt( r );
+
+		svs.time += levelTime - sv.time;
+		sv.time = levelTime;
+		p->levelTime = levelTime;
+		re->G2API_SetTime( g2Time, 0 );
+
+		num = SV_ReplayReadInt( r );
+		for ( i = 0; i < num && !r->overrun; i++ ) {
+			const int taken = SV_ReplayReadByte( r );
+			const int ping = SV_ReplayReadInt( r );
+
+			if ( i >= sv_maxclients->integer ) {
+				continue;
+			}
+			// zombies are freed by SV_CheckTimeouts a few seconds after a drop
+			if ( !taken && svs.clients[i].state == CS_ZOMBIE ) {
+				svs.clients[i].state = CS_FREE;
+			}
+			SV_GameClientNum( i )->ping = ping;
+		}
+
+		srand( seed );
+		start = Sys_Microseconds();
+		GVM_RunFrame( levelTime );
+		p->frameTime += Sys_Microseconds() - start;
+		p->calls++;
+		return qtrue;
+	}
+
+	case REPLAY_EVENT_FRAME_DONE: {
+		const uint32_t recorded = (uint32_t)SV_ReplayReadInt( r );
+		const uint32_t checksum = SV_ReplayChecksum();
+
+		if ( checksum != recorded ) {
+			if ( !p->mismatches ) {
+				p->firstMismatch = (int)frameTimes.size();
+			}
+			if ( ++p->mismatches <= REPLAY_MAX_REPORT ) {
+				Com_Printf( "frame %i (level time %i): checksum %08x, recorded %08x\n", (int)frameTimes.size(), p->levelTime, checksum, recorded );
+			}
+		}
+
+		if ( csv ) {
+			const char *line = va( "%i,%i,%i,%08x,%i\n", (int)frameTimes.size(), p->levelTime, (int)p->frameTime, checksum, checksum == recorded );
+			FS_Write( line, strlen( line ), csv );
+		}
+
+		frameTimes.push_back( (int)p->frameTime );
+		p->frameTime = 0;
+		return qtrue;
+	}
+
+	case REPLAY_EVENT_BOT_FRAME:
+		num = SV_ReplayReadInt( r );
+		start = Sys_Microseconds();
+		GVM_BotAIStartFrame( num );
+		break;
+
+	case REPLAY_EVENT_CONNECT: {
+		byte session[MAX_SESSION_DATA];
+
+		clientNum = SV_ReplayReadClient( r );
+		const qboolean firstTime = (qboolean)SV_ReplayReadByte( r );
+		const qboolean isBot = (qboolean)SV_ReplayReadByte( r );
+		SV_ReplayReadString( r, value, sizeof( value ) );
+		num = SV_ReplayReadInt( r );
+		if ( num < 0 || num > MAX_SESSION_DATA ) {
+			r->overrun = qtrue;
+			return qfalse;
+		}
+		SV_ReplayReadData( r, session, num );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		// set the slot up the way SV_DirectConnect or SV_BotAllocateClient would,
+		// with no address so nothing is ever sent
+		cl = &svs.clients[clientNum];
+		if ( cl->state == CS_FREE || cl->state == CS_ZOMBIE ) {
+			Com_Memset( cl, 0, sizeof( *cl ) );
+		}
+		cl->gentity = SV_GentityNum( clientNum );
+		cl->gentity->s.number = clientNum;
+		if ( isBot ) {
+			cl->state = CS_ACTIVE;
+			cl->netchan.remoteAddress.type = NA_BOT;
+			cl->rate = 16384;
+		} else {
+			cl->state = CS_CONNECTED;
+		}
+		Q_strncpyz( cl->userinfo, value, sizeof( cl->userinfo ) );
+		SV_SetSessionData( clientNum, session, num );
+
+		start = Sys_Microseconds();
+		if ( GVM_ClientConnect( clientNum, firstTime, isBot ) ) {
+			if ( isBot ) {
+				SV_BotFreeClient( clientNum );
+			} else {
+				cl->state = CS_FREE;
+			}
+		}
+		break;
+	}
+
+	case REPLAY_EVENT_BEGIN:
+		clientNum = SV_ReplayReadClient( r );
+		SV_ReplayReadData( r, &cmd, sizeof( cmd ) );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		// as SV_ClientEnterWorld
+		cl = &svs.clients[clientNum];
+		cl->state = CS_ACTIVE;
+		cl->gentity = SV_GentityNum( clientNum );
+		cl->gentity->s.number = clientNum;
+		cl->lastUsercmd = cmd;
+
+		start = Sys_Microseconds();
+		GVM_ClientBegin( clientNum );
+		break;
+
+	case REPLAY_EVENT_USERINFO:
+		clientNum = SV_ReplayReadClient( r );
+		SV_ReplayReadString( r, value, sizeof( value ) );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		Q_strncpyz( svs.clients[clientNum].userinfo, value, sizeof( svs.clients[clientNum].userinfo ) );
+		start = Sys_Microseconds();
+		GVM_ClientUserinfoChanged( clientNum );
+		break;
+
+	case REPLAY_EVENT_DISCONNECT:
+		clientNum = SV_ReplayReadClient( r );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		start = Sys_Microseconds();
+		GVM_ClientDisconnect( clientNum );
+		p->frameTime += Sys_Microseconds() - start;
+		p->calls++;
+
+		// as SV_DropClient
+		cl = &svs.clients[clientNum];
+		if ( cl->netchan.remoteAddress.type == NA_BOT ) {
+			SV_BotFreeClient( clientNum );
+		} else {
+			cl->state = CS_ZOMBIE;
+		}
+		SV_SetUserinfo( clientNum, "" );
+		return qtrue;
+
+	case REPLAY_EVENT_CLIENT_COMMAND:
+		clientNum = SV_ReplayReadClient( r );
+		SV_ReplayReadArgs( r );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		start = Sys_Microseconds();
+		GVM_ClientCommand( clientNum );
+		break;
+
+	case REPLAY_EVENT_CONSOLE_COMMAND:
+		SV_ReplayReadArgs( r );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		start = Sys_Microseconds();
+		GVM_ConsoleCommand();
+		break;
+
+	case REPLAY_EVENT_USERCMD:
+		clientNum = SV_ReplayReadClient( r );
+		SV_ReplayReadData( r, &cmd, sizeof( cmd ) );
+		if ( r->overrun ) {
+			return qfalse;
+		}
+
+		svs.clients[clientNum].lastUsercmd = cmd;
+		start = Sys_Microseconds();
+		GVM_ClientThink( clientNum, NULL );
+		break;
+
+	default:
+		Com_Printf( "Bad replay event %i.\n", event );
+		r->overrun = qtrue;
+		return qfalse;
+	}
+
+	p->frameTime += Sys_Microseconds() - start;
+	p->calls++;
+
+	return qtrue;
+}
+
+static int SV_ReplayPercentile( const std::vector< int > &sorted, int percent ) {
+	return sorted[Q_min( (int)sorted.size() - 1, (int)( (int64_t)sorted.size() * percent / 100 ) )];
+}
+
+/*
+==================
+SV_ReplayPlay_f
+
+replay_play <replay> [csv name]
+==================
+*/
+static void SV_ReplayPlay_f( void ) {
+	char				name[MAX_OSPATH], mapname[MAX_QPATH], key[BIG_INFO_KEY], value[BIG_INFO_VALUE];
+	char				*serverinfo;
+	const char			*s;
+	std::vector< int >	frameTimes;
+	fileHandle_t		csv = 0;
+	int					event;
+
+	if ( Cmd_Argc() < 2 ) {
+		Com_Printf( "usage: replay_play <replay> [csv name]\n" );
+		return;
+	}
+
+	if ( !com_dedicated->integer ) {
+		Com_Printf( "Replays can only be played on a dedicated server.\n" );
+		return;
+	}
+
+	if ( replayRec || replayName[0] ) {
+		Com_Printf( "Can't play a replay while recording one.\n" );
+		return;
+	}
+
+	replayPlayback_t *p = (replayPlayback_t *)Z_Malloc( sizeof( *p ), TAG_TEMP_WORKSPACE, qtrue );
+	replayReader_t *r = &p->reader;
+
+	if ( !SV_ReplayOpen( r, Cmd_Argv( 1 ), name, sizeof( name ) ) ) {
+		Com_Printf( "Couldn't open replay %s.\n", Cmd_Argv( 1 ) );
+		Z_Free( p );
+		return;
+	}
+
+	serverinfo = (char *)Z_Malloc( BIG_INFO_STRING, TAG_TEMP_WORKSPACE, qfalse );
+
+	if ( !SV_ReplayReadBlock( r ) || SV_ReplayReadInt( r ) != REPLAY_VERSION || SV_ReplayReadInt( r ) != (int)sizeof( usercmd_t ) ) {
+		Com_Printf( "%s is not a version %i replay for this build.\n", name, REPLAY_VERSION );
+		goto done;
+	}
+
+	SV_ReplayReadString( r, mapname, sizeof( mapname ) );
+	SV_ReplayReadString( r, serverinfo, BIG_INFO_STRING );
+
+	if ( r->overrun || FS_ReadFile( va( "maps/%s.bsp", mapname ), NULL ) == -1 ) {
+		Com_Printf( "Can't find map %s for %s.\n", mapname, name );
+		goto done;
+	}
+
+	if ( Cmd_Argc() > 2 ) {
+		csv = FS_FOpenFileWrite( va( "replays/%s.csv", Cmd_Argv( 2 ) ) );
+		if ( csv ) {
+			const char *header = "frame,levelTime,usec,checksum,match\n";
+			FS_Write( header, strlen( header ), csv );
+		}
+	}
+
+	// start from nothing, like the recording did
+	SV_Shutdown( "Server is playing back a replay\n" );
+
+	s = serverinfo;
+	while ( Info_NextPair( &s, key, value ) && key[0] ) {
+		SV_ReplaySetCvar( key, value );
+	}
+	Cvar_Get( "g_gametype", "0", CVAR_SERVERINFO | CVAR_LATCH );
+
+	// load the map without SV_SpawnServer calling the game, the replay makes those calls
+	replayLoading = qtrue;
+	SV_SpawnServer( mapname, qtrue, eForceReload_NOTHING );
+	replayLoading = qfalse;
+
+	Com_Printf( "------ Playing replay %s ------\n", name );
+
+	replayPlaying = qtrue;
+	for ( ;; ) {
+		if ( r->readcount == r->blockSize && !SV_ReplayReadBlock( r ) ) {
+			Com_Printf( "%s ends without an end, it may have been cut short.\n", name );
+			break;
+		}
+
+		event = SV_ReplayReadByte( r );
+		if ( !SV_ReplayPlayEvent( p, event, frameTimes, csv ) ) {
+			if ( r->overrun ) {
+				Com_Printf( "%s is damaged.\n", name );
+			}
+			break;
+		}
+
+		// nobody acknowledges the reliable commands of the stand-ins, so they
+		// would overflow and get dropped
+		for ( int i = 0; i < sv_maxclients->integer; i++ ) {
+			client_t *cl = &svs.clients[i];
+
+			if ( cl->netchan.remoteAddress.type != NA_BOT ) {
+				cl->reliableAcknowledge = cl->reliableSequence;
+			}
+		}
+	}
+	replayPlaying = qfalse;
+
+	if ( frameTimes.empty() ) {
+		Com_Printf( "No frames were played.\n" );
+	} else {
+		int64_t total = 0;
+
+		for ( int t : frameTimes ) {
+			total += t;
+		}
+		std::sort( frameTimes.begin(), frameTimes.end() );
+
+		Com_Printf( "%i frames, %i game calls, %.1f ms total, %.1f ms to initialize\n", (int)frameTimes.size(), p->calls, total / 1000.0, p->initTime / 1000.0 );
+		Com_Printf( "usec per frame: mean %.1f, min %i, 50%% %i, 90%% %i, 99%% %i, max %i\n", (double)total / frameTimes.size(),
+			frameTimes.front(), SV_ReplayPercentile( frameTimes, 50 ), SV_ReplayPercentile( frameTimes, 90 ), SV_ReplayPercentile( frameTimes, 99 ), frameTimes.back() );
+
+		if ( p->mismatches ) {
+			Com_Printf( S_COLOR_YELLOW "%i of %i frame checksums differ from the recording, starting at frame %i\n", p->mismatches, (int)frameTimes.size(), p->firstMismatch );
+		} else {
+			Com_Printf( "All %i frame checksums match the recording.\n", (int)frameTimes.size() );
+		}
+	}
+
+	SV_Shutdown( "Replay finished\n" );
+
+done:
+	if ( csv ) {
+		FS_FCloseFile( csv );
+	}
+	if ( r->compressed ) {
+		inflateEnd( &r->zs );
+	}
+	FS_FCloseFile( r->file );
+	Z_Free( serverinfo );
+	Z_Free( p );
+}
+
+/*
+==================
+SV_ReplayInit
+==================
+*/
+void SV_ReplayInit( void ) {
+	Cmd_AddCommand( "replay_record", SV_ReplayRecord_f, "Record everything the game is given on the next map, for replay_play" );
+	Cmd_AddCommand( "replay_stop", SV_ReplayStop_f, "Stop recording a replay" );
+	Cmd_AddCommand( "replay_play", SV_ReplayPlay_f, "Play a replay back as fast as possible, timing the game and checking it plays out the same" );
+}
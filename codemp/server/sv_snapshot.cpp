@@ -638,6 +638,8 @@ static void SV_BuildClientSnapshot( client_t *client ) {
 		}
 		frame->num_entities++;
 	}
+
+	SV_MasterDemoSnapshot( client, frame, entityNumbers.snapshotEntities, entityNumbers.numSnapshotEntities );
 }
 
 
@@ -100,6 +100,24 @@ void SV_SectorList_f( void ) {
 	}
 }
 
+/*
+===============
+SV_G2TraceStats_f
+
+How much Ghoul2 trace work was shared between traces since the last reset
+===============
+*/
+void SV_G2TraceStats_f( void ) {
+	g2TraceCacheStats_t	stats;
+
+	re->ext.G2API_GetTraceCacheStats( &stats, (qboolean)( Cmd_Argc() > 1 && !Q_stricmp( Cmd_Argv( 1 ), "reset" ) ) );
+
+	Com_Printf( "%i ghoul2 traces, %i reused the skeleton (%.1f%%), %i reused transformed verts (%.1f%%)\n",
+		stats.traces,
+		stats.skeletonHits, stats.traces ? 100.0f * stats.skeletonHits / stats.traces : 0.0f,
+		stats.vertHits, stats.traces ? 100.0f * stats.vertHits / stats.traces : 0.0f );
+}
+
 /*
 ===============
 SV_CreateworldSector
@@ -450,6 +468,130 @@ int SV_AreaEntities( const vec3_t mins, const vec3_t maxs, int *entityList, int
 
 
 
+typedef struct radiusParms_s {
+	const float	*origin;
+	float		radius;
+	vec3_t		mins, maxs;
+	int			ignore;
+	int			contentmask;
+	int			flags;
+	int			*list;
+	float		*dists;
+	int			count, maxcount;
+} radiusParms_t;
+
+/*
+====================
+SV_AreaEntitiesRadius_r
+
+Walks the sectors the way SV_AreaEntities_r does, so the order matches
+====================
+*/
+static void SV_AreaEntitiesRadius_r( worldSector_t *node, radiusParms_t *rp ) {
+	svEntity_t	*check, *next;
+	sharedEntity_t *gcheck;
+	float		d, dist;
+	int			i, num;
+
+	for ( check = node->entities  ; check ; check = next ) {
+		next = check->nextEntityInWorldSector;
+
+		gcheck = SV_GEntityForSvEntity( check );
+		num = check - sv.svEntities;
+
+		if ( gcheck->r.absmin[0] > rp->maxs[0]
+		|| gcheck->r.absmin[1] > rp->maxs[1]
+		|| gcheck->r.absmin[2] > rp->maxs[2]
+		|| gcheck->r.absmax[0] < rp->mins[0]
+		|| gcheck->r.absmax[1] < rp->mins[1]
+		|| gcheck->r.absmax[2] < rp->mins[2]) {
+			continue;
+		}
+
+		if ( num == rp->ignore ) {
+			continue;
+		}
+		if ( rp->contentmask && !( gcheck->r.contents & rp->contentmask ) ) {
+			continue;
+		}
+		if ( ( rp->flags & RADIUS_PLAYERS ) && num >= MAX_CLIENTS ) {
+			continue;
+		}
+
+		// distance from the edge of the bounding box, worked out the way
+		// the game always has so nothing on the edge changes sides
+		dist = 0;
+		for ( i = 0 ; i < 3 ; i++ ) {
+			if ( rp->origin[i] < gcheck->r.absmin[i] ) {
+				d = gcheck->r.absmin[i] - rp->origin[i];
+			} else if ( rp->origin[i] > gcheck->r.absmax[i] ) {
+				d = rp->origin[i] - gcheck->r.absmax[i];
+			} else {
+				d = 0;
+			}
+			dist += d * d;
+		}
+		dist = sqrtf( dist );
+		if ( dist >= rp->radius ) {
+			continue;
+		}
+
+		if ( rp->count == rp->maxcount ) {
+			Com_DPrintf ("SV_AreaEntitiesRadius: MAXCOUNT\n");
+			return;
+		}
+
+		rp->list[rp->count] = num;
+		if ( rp->dists ) {
+			rp->dists[rp->count] = dist;
+		}
+		rp->count++;
+	}
+
+	if (node->axis == -1) {
+		return;		// terminal node
+	}
+
+	// recurse down both sides
+	if ( rp->maxs[node->axis] > node->dist ) {
+		SV_AreaEntitiesRadius_r ( node->children[0], rp );
+	}
+	if ( rp->count < rp->maxcount && rp->mins[node->axis] < node->dist ) {
+		SV_AreaEntitiesRadius_r ( node->children[1], rp );
+	}
+}
+
+/*
+================
+SV_AreaEntitiesRadius
+================
+*/
+int SV_AreaEntitiesRadius( const vec3_t origin, float radius, int ignore, int contentmask, int flags, int *entityList, float *dists, int maxcount ) {
+	radiusParms_t	rp;
+	int				i;
+
+	rp.origin = origin;
+	rp.radius = radius;
+	for ( i = 0 ; i < 3 ; i++ ) {
+		rp.mins[i] = origin[i] - radius;
+		rp.maxs[i] = origin[i] + radius;
+	}
+	rp.ignore = ignore;
+	rp.contentmask = contentmask;
+	rp.flags = flags;
+	rp.list = entityList;
+	rp.dists = dists;
+	rp.count = 0;
+	rp.maxcount = maxcount;
+
+	if ( radius > 0 ) {
+		SV_AreaEntitiesRadius_r( sv_worldSectors, &rp );
+	}
+
+	return rp.count;
+}
+
+
 //===========================================================================
 
 
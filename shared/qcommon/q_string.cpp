@@ -244,6 +244,40 @@ const char *Q_stristr( const char *s, const char *find )
 	return s;
 }
 
+#define Q_FNV_PRIME		16777619u
+
+uint32_t Q_HashFNV( const void *data, size_t len, uint32_t hash )
+{
+	const unsigned char *p = (const unsigned char *)data;
+
+	for ( size_t i = 0; i < len; i++ )
+	{
+		hash = ( hash ^ p[i] ) * Q_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+uint32_t Q_HashStringFNV( const char *s, uint32_t hash )
+{
+	for ( ; *s; s++ )
+	{
+		hash = ( hash ^ *(const unsigned char *)s ) * Q_FNV_PRIME;
+	}
+
+	return hash;
+}
+
+uint32_t Q_HashStringFNVNoCase( const char *s, uint32_t hash )
+{
+	for ( ; *s; s++ )
+	{
+		hash = ( hash ^ (uint32_t)tolower( *(const unsigned char *)s ) ) * Q_FNV_PRIME;
+	}
+
+	return hash;
+}
+
 int Q_PrintStrlen( const char *string ) {
 	int			len;
 	const char	*p;
@@ -35,6 +35,13 @@ const char *Q_strchrs( const char *string, const char *search );
 
 void Q_strstrip( char *string, const char *strip, const char *repl );
 
+// 32 bit FNV-1a, for hash tables and checksums.  Pass a previous result as
+// hash to continue it.
+#define Q_FNV_BASIS		2166136261u
+uint32_t Q_HashFNV( const void *data, size_t len, uint32_t hash = Q_FNV_BASIS );
+uint32_t Q_HashStringFNV( const char *s, uint32_t hash = Q_FNV_BASIS );
+uint32_t Q_HashStringFNVNoCase( const char *s, uint32_t hash = Q_FNV_BASIS );
+
 #if defined (_MSC_VER)
 	// vsnprintf is ISO/IEC 9899:1999
 	// abstracting this to make it portable
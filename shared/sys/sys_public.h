@@ -100,6 +100,7 @@ void	Sys_Print( const char *msg );
 // any game related timing information should come from event timestamps
 int		Sys_Milliseconds (bool baseTime = false);
 int		Sys_Milliseconds2(void);
+int64_t	Sys_Microseconds(void);
 void	Sys_Sleep( int msec );
 
 void	Sys_SnapVector( float *v );
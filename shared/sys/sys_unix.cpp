@@ -23,6 +23,7 @@ along with this program; if not, see <http://www.gnu.org/licenses/>.
 #include <stdarg.h>
 #include <stdlib.h>
 #include <sys/time.h>
+#include <time.h>
 #include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -105,6 +106,28 @@ int Sys_Milliseconds2( void )
     return Sys_Milliseconds(false);
 }
 
+/*
+================
+Sys_Microseconds
+
+Monotonic, for profiling only
+================
+*/
+int64_t Sys_Microseconds( void )
+{
+	static struct timespec base;
+	struct timespec now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	if ( !base.tv_sec && !base.tv_nsec )
+	{
+		base = now;
+	}
+
+	return (int64_t)( now.tv_sec - base.tv_sec ) * 1000000 + ( now.tv_nsec - base.tv_nsec ) / 1000;
+}
+
 /*
 ==================
 Sys_RandomBytes
@@ -107,6 +107,29 @@ int Sys_Milliseconds2( void )
 	return Sys_Milliseconds(false);
 }
 
+/*
+================
+Sys_Microseconds
+
+Monotonic, for profiling only
+================
+*/
+int64_t Sys_Microseconds( void )
+{
+	static LARGE_INTEGER frequency, base;
+	LARGE_INTEGER now;
+
+	if ( !frequency.QuadPart )
+	{
+		QueryPerformanceFrequency( &frequency );
+		QueryPerformanceCounter( &base );
+	}
+
+	QueryPerformanceCounter( &now );
+
+	return ( now.QuadPart - base.QuadPart ) * 1000000 / frequency.QuadPart;
+}
+
 /*
 ================
 Sys_RandomBytes
@@ -0,0 +1,290 @@
+#include "game/g_thinkqueue.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	const int frameMsec = 50;
+
+	uint32_t Hash( uint32_t a, uint32_t b, uint32_t c )
+	{
+		uint32_t h = a * 0x9e3779b1u ^ b * 0x85ebca77u ^ c * 0xc2b2ae3du;
+		h ^= h >> 15;
+		h *= 0x2c1b3c6du;
+		h ^= h >> 12;
+		return h;
+	}
+
+	// A cut down G_RunFrame: entities think when their nextthink comes
+	// around, and "active" ones (missiles, movers...) do something every
+	// frame.  Thinking spawns, frees and reschedules entities, including
+	// ones other than the thinker.  Every visit that does something is
+	// logged, so a world that uses the queue has to log exactly what one
+	// that visits everything does.
+	class World
+	{
+	public:
+		explicit World( bool useQueue, uint32_t seed, int numStart )
+			: useQueue( useQueue )
+			, seed( seed )
+		{
+			ThinkQueue_Clear( &queue );
+			ents.resize( THINKQUEUE_MAX_ENTITIES );
+			for( int i = 0; i < numStart; i++ )
+			{
+				const int num = Spawn();
+				if( Random( 0, num, 0 ) % 3 == 0 )
+				{
+					SetThink( num, 1 + Random( 0, num, 1 ) % 2000 );
+				}
+				ents[ num ].active = Random( 0, num, 2 ) % 10 == 0;
+			}
+		}
+
+		void RunFrame()
+		{
+			time += frameMsec;
+			frame++;
+
+			if( !useQueue )
+			{
+				for( int i = 0; i < numEntities; i++ )
+				{
+					if( ents[ i ].inuse )
+					{
+						Visit( i );
+					}
+				}
+				return;
+			}
+
+			ThinkQueue_BeginFrame( &queue, time );
+			for( int i = ThinkQueue_Next( &queue, -1, numEntities ); i != -1; i = ThinkQueue_Next( &queue, i, numEntities ) )
+			{
+				if( ents[ i ].inuse )
+				{
+					Visit( i );
+				}
+				Settle( i );
+			}
+		}
+
+		std::vector< int > log;
+		int visits = 0;
+
+	private:
+		struct Ent
+		{
+			bool inuse = false;
+			bool active = false;
+			int nextthink = 0;
+		};
+
+		uint32_t Random( int num, int what, int salt ) const
+		{
+			return Hash( seed ^ frame, num * 64 + what, salt );
+		}
+
+		int Spawn()
+		{
+			int num = 0;
+			while( num < numEntities && ents[ num ].inuse )
+			{
+				num++;
+			}
+			if( num == THINKQUEUE_MAX_ENTITIES )
+			{
+				return -1;
+			}
+			if( num == numEntities )
+			{
+				numEntities++;
+			}
+			ents[ num ] = Ent();
+			ents[ num ].inuse = true;
+			ThinkQueue_Wake( &queue, num );
+			return num;
+		}
+
+		void Free( int num )
+		{
+			ents[ num ] = Ent();
+			ThinkQueue_Remove( &queue, num );
+		}
+
+		// what G_SetNextThink does in the game
+		void SetThink( int num, int t )
+		{
+			ents[ num ].nextthink = t;
+			ThinkQueue_WakeAt( &queue, num, t, time );
+		}
+
+		void Visit( int num )
+		{
+			Ent& ent = ents[ num ];
+			visits++;
+
+			if( ent.active )
+			{
+				log.push_back( frame );
+				log.push_back( num );
+				if( Random( num, 0, 3 ) % 50 == 0 )
+				{
+					Act( num );
+				}
+			}
+
+			if( ent.nextthink > 0 && ent.nextthink <= time )
+			{
+				ent.nextthink = 0;
+				log.push_back( frame );
+				log.push_back( -num - 1 );
+				Act( num );
+			}
+		}
+
+		void Act( int num )
+		{
+			int other;
+
+			switch( Random( num, 1, 4 ) % 8 )
+			{
+			case 0:
+				Free( num );
+				break;
+			case 1:
+				other = Spawn();
+				if( other != -1 )
+				{
+					SetThink( other, time + Random( num, 2, 5 ) % 300 );
+					ents[ other ].active = Random( num, 3, 6 ) % 4 == 0;
+				}
+				break;
+			case 2:
+				// poke somebody else, maybe in this frame
+				other = Random( num, 4, 7 ) % numEntities;
+				if( ents[ other ].inuse )
+				{
+					SetThink( other, time + Random( num, 5, 8 ) % 3 * frameMsec );
+				}
+				break;
+			case 3:
+				ents[ num ].active = !ents[ num ].active;
+				break;
+			case 4:
+				// think again, possibly on the next frame
+				SetThink( num, time + 1 + Random( num, 6, 9 ) % 1000 );
+				break;
+			case 5:
+				// and again, without waiting a frame
+				SetThink( num, time );
+				break;
+			default:
+				SetThink( num, time + 1 + Random( num, 7, 10 ) % 5000 );
+				break;
+			}
+		}
+
+		void Settle( int num )
+		{
+			const Ent& ent = ents[ num ];
+
+			if( !ent.inuse )
+			{
+				ThinkQueue_Remove( &queue, num );
+			}
+			else if( !ent.active && !( ent.nextthink > 0 && ent.nextthink <= time ) )
+			{
+				ThinkQueue_Sleep( &queue, num, ent.nextthink > 0 ? ent.nextthink : 0 );
+			}
+		}
+
+		bool useQueue;
+		uint32_t seed;
+		thinkQueue_t queue;
+		std::vector< Ent > ents;
+		int numEntities = 0;
+		int time = 0;
+		uint32_t frame = 0;
+	};
+}
+
+BOOST_AUTO_TEST_SUITE( thinkqueue )
+
+BOOST_AUTO_TEST_CASE( same_order_as_full_scan )
+{
+	for( uint32_t seed = 1; seed <= 8; seed++ )
+	{
+		World scan( false, seed, 300 );
+		World queued( true, seed, 300 );
+		for( int frame = 0; frame < 2000; frame++ )
+		{
+			scan.RunFrame();
+			queued.RunFrame();
+		}
+		BOOST_TEST_CONTEXT( "seed " << seed )
+		{
+			BOOST_CHECK( !scan.log.empty() );
+			BOOST_CHECK( scan.log == queued.log );
+			BOOST_CHECK_LT( queued.visits, scan.visits );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( wakes_in_time_order )
+{
+	thinkQueue_t queue;
+	ThinkQueue_Clear( &queue );
+
+	for( int i = 0; i < 100; i++ )
+	{
+		ThinkQueue_Sleep( &queue, i, 1000 - i * 10 );
+	}
+	// an earlier wake replaces the later one, a later one is ignored
+	ThinkQueue_WakeAt( &queue, 0, 5, 0 );
+	ThinkQueue_WakeAt( &queue, 99, 5000, 0 );
+
+	ThinkQueue_BeginFrame( &queue, 5 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, -1, 100 ), 0 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, 0, 100 ), -1 );
+
+	ThinkQueue_BeginFrame( &queue, 45 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, 0, 100 ), 96 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, 96, 100 ), 97 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, 99, 100 ), -1 );
+	BOOST_CHECK( ThinkQueue_IsAsleep( &queue, 95 ) );
+	BOOST_CHECK( ThinkQueue_AnyAsleep( &queue, 1, 96 ) );
+	BOOST_CHECK( !ThinkQueue_AnyAsleep( &queue, 96, 100 ) );
+
+	// removed entities never come back
+	ThinkQueue_Remove( &queue, 50 );
+	ThinkQueue_BeginFrame( &queue, 2000 );
+	BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, 49, 100 ), 51 );
+}
+
+BOOST_AUTO_TEST_CASE( survives_heap_overflow )
+{
+	thinkQueue_t queue;
+	ThinkQueue_Clear( &queue );
+
+	// lots of rescheduling leaves stale entries behind
+	for( int round = 0; round < THINKQUEUE_MAX_WAKES / 4; round++ )
+	{
+		for( int i = 0; i < 8; i++ )
+		{
+			ThinkQueue_Sleep( &queue, i, 100000 - round * 8 - i );
+		}
+	}
+	BOOST_CHECK_LE( queue.numWakes, THINKQUEUE_MAX_WAKES );
+
+	ThinkQueue_BeginFrame( &queue, 100000 );
+	for( int i = 0; i < 8; i++ )
+	{
+		BOOST_CHECK_EQUAL( ThinkQueue_Next( &queue, i - 1, 8 ), i );
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,179 @@
+#include "rd-vanilla/tr_mipmap.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+	const int sizes[][ 2 ] = {
+		{ 1, 1 }, { 2, 1 }, { 1, 2 }, { 1, 8 }, { 16, 1 },
+		{ 2, 2 }, { 4, 4 }, { 8, 2 }, { 2, 8 }, { 8, 8 },
+		{ 16, 4 }, { 32, 32 }, { 64, 32 }, { 4, 128 }, { 256, 256 }
+	};
+
+	std::vector< uint8_t > RandomTexture( int width, int height, uint32_t seed )
+	{
+		std::vector< uint8_t > pixels( width * height * 4 );
+		for( uint8_t& p : pixels )
+		{
+			seed = seed * 1664525u + 1013904223u;
+			p = seed >> 24;
+		}
+		// make sure the extremes are in there
+		pixels[ 0 ] = 255;
+		pixels[ pixels.size() - 1 ] = 0;
+		return pixels;
+	}
+
+	std::vector< uint8_t > MipLevel( const std::vector< uint8_t >& in, int width, int height, bool filter, bool simd )
+	{
+		const int outWidth = width > 1 ? width >> 1 : 1;
+		const int outHeight = height > 1 ? height >> 1 : 1;
+		std::vector< uint8_t > out( outWidth * outHeight * 4, 0xcd );
+		if( filter )
+		{
+			R_MipMapFilter( in.data(), out.data(), width, height, simd );
+		}
+		else
+		{
+			R_MipMapBox( in.data(), out.data(), width, height, simd );
+		}
+		return out;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE( mipmap )
+
+BOOST_AUTO_TEST_CASE( box_matches_scalar )
+{
+	for( const auto& size : sizes )
+	{
+		const auto in = RandomTexture( size[ 0 ], size[ 1 ], size[ 0 ] * 31 + size[ 1 ] );
+		BOOST_TEST_CONTEXT( size[ 0 ] << "x" << size[ 1 ] )
+		{
+			const auto scalar = MipLevel( in, size[ 0 ], size[ 1 ], false, false );
+			const auto simd = MipLevel( in, size[ 0 ], size[ 1 ], false, true );
+			BOOST_CHECK( scalar == simd );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( box_averages )
+{
+	const uint8_t in[ 16 ] = {
+		0, 10, 255, 255,	4, 20, 255, 1,
+		8, 30, 255, 2,		255, 41, 255, 3
+	};
+	uint8_t out[ 4 ];
+	for( bool simd : { false, true } )
+	{
+		R_MipMapBox( in, out, 2, 2, simd );
+		BOOST_CHECK_EQUAL( out[ 0 ], ( 0 + 4 + 8 + 255 ) >> 2 );
+		BOOST_CHECK_EQUAL( out[ 1 ], ( 10 + 20 + 30 + 41 ) >> 2 );
+		BOOST_CHECK_EQUAL( out[ 2 ], 255 );
+		BOOST_CHECK_EQUAL( out[ 3 ], ( 255 + 1 + 2 + 3 ) >> 2 );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( filter_matches_scalar )
+{
+	for( const auto& size : sizes )
+	{
+		const auto in = RandomTexture( size[ 0 ], size[ 1 ], size[ 0 ] * 17 + size[ 1 ] );
+		BOOST_TEST_CONTEXT( size[ 0 ] << "x" << size[ 1 ] )
+		{
+			const auto scalar = MipLevel( in, size[ 0 ], size[ 1 ], true, false );
+			const auto simd = MipLevel( in, size[ 0 ], size[ 1 ], true, true );
+			BOOST_CHECK( scalar == simd );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( filter_keeps_solid_colors )
+{
+	// the largest sum the filter sees, and the divide has to be exact for it
+	std::vector< uint8_t > in( 16 * 16 * 4, 255 );
+	for( bool simd : { false, true } )
+	{
+		const auto out = MipLevel( in, 16, 16, true, simd );
+		BOOST_CHECK( out == std::vector< uint8_t >( 8 * 8 * 4, 255 ) );
+	}
+}
+
+BOOST_AUTO_TEST_CASE( full_chain_matches_scalar )
+{
+	for( bool filter : { false, true } )
+	{
+		int width = 128, height = 32;
+		auto scalar = RandomTexture( width, height, 1234 );
+		auto simd = scalar;
+		while( width > 1 || height > 1 )
+		{
+			scalar = MipLevel( scalar, width, height, filter, false );
+			simd = MipLevel( simd, width, height, filter, true );
+			BOOST_CHECK( scalar == simd );
+			width = width > 1 ? width >> 1 : 1;
+			height = height > 1 ? height >> 1 : 1;
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( scale_matches_scalar )
+{
+	const float scales[] = { 1.0f, 1.1f, 1.5f, 1.99f, 2.0f, 3.7f, 8.0f };
+	// odd pixel counts so the tail is covered as well
+	const int counts[] = { 1, 3, 4, 7, 64, 1023 };
+
+	for( float scale : scales )
+	{
+		for( int count : counts )
+		{
+			auto scalar = RandomTexture( count, 1, count );
+			auto simd = scalar;
+			const auto original = scalar;
+
+			R_ScalePixels( scalar.data(), count, scale, false );
+			R_ScalePixels( simd.data(), count, scale, true );
+
+			BOOST_TEST_CONTEXT( "scale " << scale << ", " << count << " pixels" )
+			{
+				BOOST_CHECK( scalar == simd );
+				for( int i = 0; i < count; i++ )
+				{
+					BOOST_CHECK_EQUAL( simd[ i * 4 + 3 ], original[ i * 4 + 3 ] );
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( scale_matches_intensity_table )
+{
+	// every byte value, the way R_SetColorMappings builds its table
+	const float scale = 1.3f;
+	std::vector< uint8_t > pixels( 256 * 4 );
+	for( int i = 0; i < 256; i++ )
+	{
+		pixels[ i * 4 + 0 ] = pixels[ i * 4 + 1 ] = pixels[ i * 4 + 2 ] = i;
+		pixels[ i * 4 + 3 ] = 255 - i;
+	}
+	for( bool simd : { false, true } )
+	{
+		auto scaled = pixels;
+		R_ScalePixels( scaled.data(), 256, scale, simd );
+		for( int i = 0; i < 256; i++ )
+		{
+			int j = i * scale;
+			if( j > 255 )
+			{
+				j = 255;
+			}
+			BOOST_CHECK_EQUAL( scaled[ i * 4 ], j );
+			BOOST_CHECK_EQUAL( scaled[ i * 4 + 3 ], 255 - i );
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()